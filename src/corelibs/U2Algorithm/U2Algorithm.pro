@@ -2,6 +2,8 @@ include (U2Algorithm.pri)
 
 # Input
 HEADERS += src/misc/BinaryFindOpenCL.h \
+           src/misc/BitMaskLookupTable.h \
+           src/misc/BitParallelMatcher.h \
            src/misc/BitsTable.h \
            src/misc/CDSearchTaskFactory.h \
            src/misc/DnaAssemblyMultiTask.h \
@@ -15,6 +17,7 @@ HEADERS += src/misc/BinaryFindOpenCL.h \
            src/misc/RollingArray.h \
            src/misc/RollingMatrix.h \
            src/misc/SequenceContentFilterTask.h \
+           src/misc/SequenceRegExp.h \
            src/misc/SyncSort.h \
            src/molecular_geometry/GeomUtils.h \
            src/molecular_geometry/MolecularSurface.h \
@@ -80,6 +83,7 @@ HEADERS += src/misc/BinaryFindOpenCL.h \
            src/util_msa_distance/MSADistanceAlgorithmSimilarity.h \
            src/util_msa_distance/MSADistanceAlgorithmHammingRevCompl.h \
            src/util_msa_distance/MSADistanceAlgorithmRegistry.h \
+           src/util_msa_distance/MSADistanceBitsetEngine.h \
            src/util_msaedit/CreateSubalignmentTask.h \
            src/util_msaedit/MAlignmentUtilTasks.h \
            src/util_msaedit/color_schemes/ColorSchemeUtils.h \
@@ -113,6 +117,8 @@ HEADERS += src/misc/BinaryFindOpenCL.h \
            src/util_gpu/opencl/OpenCLUtils.h
 
 SOURCES += src/misc/BinaryFindOpenCL.cpp \
+           src/misc/BitMaskLookupTable.cpp \
+           src/misc/BitParallelMatcher.cpp \
            src/misc/BitsTable.cpp \
            src/misc/DnaAssemblyMultiTask.cpp \
            src/misc/EnzymeModel.cpp \
@@ -120,6 +126,7 @@ SOURCES += src/misc/BinaryFindOpenCL.cpp \
            src/misc/FindAlgorithmTask.cpp \
            src/misc/GenomeAssemblyMultiTask.cpp \
            src/misc/SequenceContentFilterTask.cpp \
+           src/misc/SequenceRegExp.cpp \
            src/molecular_geometry/GeomUtils.cpp \
            src/molecular_geometry/MolecularSurface.cpp \
            src/molecular_geometry/MolecularSurfaceFactoryRegistry.cpp \
@@ -179,6 +186,7 @@ SOURCES += src/misc/BinaryFindOpenCL.cpp \
            src/util_msa_distance/MSADistanceAlgorithmSimilarity.cpp \
            src/util_msa_distance/MSADistanceAlgorithmHammingRevCompl.cpp \
            src/util_msa_distance/MSADistanceAlgorithmRegistry.cpp \
+           src/util_msa_distance/MSADistanceBitsetEngine.cpp \
            src/util_msaedit/CreateSubalignmentTask.cpp \
            src/util_msaedit/MAlignmentUtilTasks.cpp \
            src/util_msaedit/color_schemes/ColorSchemeUtils.cpp \
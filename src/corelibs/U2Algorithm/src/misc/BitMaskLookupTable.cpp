@@ -0,0 +1,125 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2SafePoints.h>
+
+#include "BitMaskLookupTable.h"
+
+namespace U2 {
+
+const int BitMaskLookupTable::MAX_PREFIX_BITS = 22;
+
+BitMaskLookupTable::BitMaskLookupTable()
+    : values(NULL), size(0), prefixBits(0), shift(0), prefixMask(0)
+{
+
+}
+
+void BitMaskLookupTable::build(const quint64 *newValues, qint64 newSize, int valueBits) {
+    clear();
+    values = newValues;
+    size = newSize;
+    CHECK(NULL != values && size > 0, );
+    // the table stores 32-bit indexes
+    CHECK(size <= qint64(0xFFFFFFFF), );
+    SAFE_POINT(valueBits > 0 && valueBits <= 64, "Invalid value bits count", );
+
+    int bits = 1;
+    while (bits < MAX_PREFIX_BITS && bits < valueBits && (qint64(1) << (bits + 1)) <= size) {
+        bits++;
+    }
+    prefixBits = bits;
+    shift = valueBits - prefixBits;
+    prefixMask = (quint64(1) << prefixBits) - 1;
+
+    const quint64 entriesCount = quint64(1) << prefixBits;
+    table.resize(int(entriesCount) + 1);
+    qint64 i = 0;
+    for (quint64 prefix = 0; prefix < entriesCount; prefix++) {
+        while (i < size && (values[i] >> shift) < prefix) {
+            i++;
+        }
+        table[int(prefix)] = quint32(i);
+    }
+    table[int(entriesCount)] = quint32(size);
+}
+
+void BitMaskLookupTable::clear() {
+    values = NULL;
+    size = 0;
+    prefixBits = 0;
+    shift = 0;
+    prefixMask = 0;
+    table.clear();
+}
+
+bool BitMaskLookupTable::isEmpty() const {
+    return table.isEmpty();
+}
+
+int BitMaskLookupTable::getPrefixBits() const {
+    return prefixBits;
+}
+
+qint64 BitMaskLookupTable::getMemoryUsage() const {
+    return qint64(table.size()) * sizeof(quint32);
+}
+
+qint64 BitMaskLookupTable::find(quint64 value, quint64 filter) const {
+    if (isEmpty()) {
+        return binarySearch(values, size, value, filter);
+    }
+
+    const quint64 filteredValue = value & filter;
+    // the prefixes of all matching values are between these two, they differ in the bits that are cut by the filter
+    const quint64 firstPrefix = (filteredValue >> shift) & prefixMask;
+    const quint64 lastPrefix = firstPrefix | ((~filter >> shift) & prefixMask);
+
+    const qint64 high = table[int(lastPrefix) + 1];
+    const qint64 low = lowerBound(values, table[int(firstPrefix)], high, filteredValue, filter);
+    if (low < high && (values[low] & filter) == filteredValue) {
+        return low;
+    }
+    return -1;
+}
+
+qint64 BitMaskLookupTable::binarySearch(const quint64 *values, qint64 size, quint64 value, quint64 filter) {
+    const quint64 filteredValue = value & filter;
+    const qint64 low = lowerBound(values, 0, size, filteredValue, filter);
+    if (low < size && (values[low] & filter) == filteredValue) {
+        return low;
+    }
+    return -1;
+}
+
+qint64 BitMaskLookupTable::lowerBound(const quint64 *values, qint64 low, qint64 high, quint64 filteredValue, quint64 filter) {
+    while (low < high) {
+        const qint64 mid = low + (high - low) / 2;
+        if ((values[mid] & filter) < filteredValue) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+}   // namespace U2
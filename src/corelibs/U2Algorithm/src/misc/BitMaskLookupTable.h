@@ -0,0 +1,80 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_BIT_MASK_LOOKUP_TABLE_H_
+#define _U2_BIT_MASK_LOOKUP_TABLE_H_
+
+#include <QVector>
+
+#include <U2Core/global.h>
+
+namespace U2 {
+
+/**
+ * Accelerates searching in a sorted array of bit masks, like the genome aligner index.
+ * The table maps the first bits of a value to the range of the array where the values
+ * with these first bits are stored, so a lookup costs one access to the table and a binary search
+ * in a range of a few elements instead of ~log2(size) cache misses in the whole array.
+ *
+ * The array is not copied: it must stay unchanged while the table is used.
+ */
+class U2ALGORITHM_EXPORT BitMaskLookupTable {
+public:
+    BitMaskLookupTable();
+
+    /**
+     * Builds the table for the ascending sorted @values. Only the @valueBits low bits of the values may be set.
+     * The table size is chosen to have about one value per table entry, but is limited by MAX_PREFIX_BITS.
+     */
+    void build(const quint64 *values, qint64 size, int valueBits);
+    void clear();
+
+    bool isEmpty() const;
+    int getPrefixBits() const;
+    qint64 getMemoryUsage() const;
+
+    /**
+     * Returns the index of the first array value that is equal to @value after applying the @filter to both of them,
+     * or -1 if there is no such value. The filter must select the high bits of values (like 111..1100..00),
+     * the result is the same as the result of binarySearch().
+     */
+    qint64 find(quint64 value, quint64 filter) const;
+
+    /** The same search without the table */
+    static qint64 binarySearch(const quint64 *values, qint64 size, quint64 value, quint64 filter);
+
+    static const int MAX_PREFIX_BITS;
+
+private:
+    static qint64 lowerBound(const quint64 *values, qint64 low, qint64 high, quint64 filteredValue, quint64 filter);
+
+    const quint64 *values;
+    qint64 size;
+    int prefixBits;
+    int shift;
+    quint64 prefixMask;
+    // table[p] is the index of the first value whose prefix is not less than p
+    QVector<quint32> table;
+};
+
+}   // namespace U2
+
+#endif // _U2_BIT_MASK_LOOKUP_TABLE_H_
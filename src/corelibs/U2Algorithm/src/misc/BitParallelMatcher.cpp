@@ -0,0 +1,284 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <U2Core/U2SafePoints.h>
+
+#include "BitParallelMatcher.h"
+#include "FindAlgorithm.h"
+
+namespace U2 {
+
+const int BitParallelMatcher::WORD_BITS = 64;
+
+namespace {
+
+const int CHARS_COUNT = 256;
+
+inline int bitsCount(quint64 value) {
+    value = value - ((value >> 1) & Q_UINT64_C(0x5555555555555555));
+    value = (value & Q_UINT64_C(0x3333333333333333)) + ((value >> 2) & Q_UINT64_C(0x3333333333333333));
+    value = (value + (value >> 4)) & Q_UINT64_C(0x0F0F0F0F0F0F0F0F);
+    return int((value * Q_UINT64_C(0x0101010101010101)) >> 56);
+}
+
+bool isMatched(char seqChar, char patternChar, bool useAmbiguousBases) {
+    if (!useAmbiguousBases) {
+        return seqChar == patternChar;
+    }
+    // FindAlgorithm::cmpAmbiguous() accepts ASCII characters only
+    return seqChar >= 0 && patternChar >= 0 && FindAlgorithm::cmpAmbiguous(seqChar, patternChar);
+}
+
+}   // namespace
+
+BitParallelMatcher::BitParallelMatcher()
+    : patternLen(0), maxErr(0), insDel(false), wordsCount(0), lastBit(0), score(0),
+      windowWidth(0), lastColumnIndex(0), columnsCount(0)
+{
+
+}
+
+BitParallelMatcher::BitParallelMatcher(const char *pattern, int patternLen, int maxErr, bool insDel, bool useAmbiguousBases)
+    : patternLen(patternLen), maxErr(maxErr), insDel(insDel), wordsCount(0), lastBit(0), score(0),
+      windowWidth(0), lastColumnIndex(0), columnsCount(0)
+{
+    SAFE_POINT(NULL != pattern && patternLen > 0, "Invalid pattern", );
+    SAFE_POINT(maxErr >= 0 && maxErr < patternLen, "Invalid maximum error count", );
+
+    wordsCount = (patternLen + WORD_BITS - 1) / WORD_BITS;
+    lastBit = Q_UINT64_C(1) << ((patternLen - 1) % WORD_BITS);
+
+    peq.fill(0, CHARS_COUNT * wordsCount);
+    for (int c = 0; c < CHARS_COUNT; c++) {
+        quint64 *charPeq = peq.data() + c * wordsCount;
+        for (int i = 0; i < patternLen; i++) {
+            if (isMatched(char(c), pattern[i], useAmbiguousBases)) {
+                charPeq[i / WORD_BITS] |= Q_UINT64_C(1) << (i % WORD_BITS);
+            }
+        }
+    }
+
+    if (insDel) {
+        windowWidth = patternLen + maxErr;
+        windowPv.resize(windowWidth * wordsCount);
+        windowMv.resize(windowWidth * wordsCount);
+        windowChars.resize(windowWidth);
+    }
+    reset();
+}
+
+void BitParallelMatcher::reset() {
+    // the distance to the pattern prefix of 'y + 1' characters is 'y + 1' before the sequence start
+    score = patternLen;
+    pv.fill(~Q_UINT64_C(0), insDel ? wordsCount : 0);
+    mv.fill(0, insDel ? wordsCount : 0);
+    lastColumnIndex = 0;
+    columnsCount = 0;
+
+    if (!insDel) {
+        states.fill(0, (maxErr + 1) * wordsCount);
+        for (int d = 0; d <= maxErr; d++) {
+            for (int i = 0; i < d; i++) {
+                states[d * wordsCount + i / WORD_BITS] |= Q_UINT64_C(1) << (i % WORD_BITS);
+            }
+        }
+        score = maxErr + 1;
+    }
+}
+
+void BitParallelMatcher::addCharInsDelSingleWord(quint64 eq) {
+    const quint64 Pv = pv[0];
+    const quint64 Mv = mv[0];
+    const quint64 Xv = eq | Mv;
+    const quint64 Xh = (((eq & Pv) + Pv) ^ Pv) | eq;
+    quint64 Ph = Mv | ~(Xh | Pv);
+    quint64 Mh = Pv & Xh;
+    if (0 != (Ph & lastBit)) {
+        score++;
+    } else if (0 != (Mh & lastBit)) {
+        score--;
+    }
+    // the horizontal delta of the row above the pattern is 0: any sequence position can be the alignment start
+    Ph <<= 1;
+    Mh <<= 1;
+    pv[0] = Mh | ~(Xv | Ph);
+    mv[0] = Ph & Xv;
+}
+
+void BitParallelMatcher::addCharInsDelBlocked(const quint64 *eq) {
+    quint64 *P = pv.data();
+    quint64 *M = mv.data();
+    int hIn = 0;
+    for (int w = 0; w < wordsCount; w++) {
+        quint64 Eq = eq[w];
+        const quint64 Pv = P[w];
+        const quint64 Mv = M[w];
+        const quint64 Xv = Eq | Mv;
+        if (hIn < 0) {
+            Eq |= 1;
+        }
+        const quint64 Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+        quint64 Ph = Mv | ~(Xh | Pv);
+        quint64 Mh = Pv & Xh;
+
+        // the horizontal delta of the word's last row is carried to the next word
+        const quint64 highBit = (w + 1 == wordsCount) ? lastBit : (Q_UINT64_C(1) << (WORD_BITS - 1));
+        int hOut = 0;
+        if (0 != (Ph & highBit)) {
+            hOut = 1;
+        } else if (0 != (Mh & highBit)) {
+            hOut = -1;
+        }
+
+        Ph <<= 1;
+        Mh <<= 1;
+        if (hIn < 0) {
+            Mh |= 1;
+        } else if (hIn > 0) {
+            Ph |= 1;
+        }
+        P[w] = Mh | ~(Xv | Ph);
+        M[w] = Ph & Xv;
+        hIn = hOut;
+    }
+    score += hIn;
+}
+
+void BitParallelMatcher::addCharSubst(const quint64 *eq) {
+    quint64 *R = states.data();
+    // a state is updated from the previous values of itself and of the state with one mismatch less
+    for (int d = maxErr; d >= 0; d--) {
+        quint64 *Rd = R + d * wordsCount;
+        const quint64 *RdLess = (d > 0) ? Rd - wordsCount : NULL;
+        quint64 carry = 1;
+        quint64 carryLess = 1;
+        for (int w = 0; w < wordsCount; w++) {
+            const quint64 value = Rd[w];
+            quint64 newValue = ((value << 1) | carry) & eq[w];
+            carry = value >> (WORD_BITS - 1);
+            if (NULL != RdLess) {
+                newValue |= (RdLess[w] << 1) | carryLess;
+                carryLess = RdLess[w] >> (WORD_BITS - 1);
+            }
+            Rd[w] = newValue;
+        }
+    }
+
+    score = maxErr + 1;
+    for (int d = 0; d <= maxErr; d++) {
+        if (0 != (R[d * wordsCount + wordsCount - 1] & lastBit)) {
+            score = d;
+            break;
+        }
+    }
+}
+
+void BitParallelMatcher::storeLastColumn(char c) {
+    lastColumnIndex = (0 == columnsCount) ? 0 : (lastColumnIndex + 1) % windowWidth;
+    columnsCount++;
+    const int offset = lastColumnIndex * wordsCount;
+    for (int w = 0; w < wordsCount; w++) {
+        windowPv[offset + w] = pv[w];
+        windowMv[offset + w] = mv[w];
+    }
+    windowChars[lastColumnIndex] = uchar(c);
+}
+
+bool BitParallelMatcher::isBoundaryColumn(int x) const {
+    // the columns before the window and before the sequence start have DynTable initial values
+    const int age = windowWidth - 1 - x;
+    return x < 0 || age >= columnsCount;
+}
+
+int BitParallelMatcher::getRingIndex(int x) const {
+    const int age = windowWidth - 1 - x;
+    return (lastColumnIndex - age + windowWidth) % windowWidth;
+}
+
+int BitParallelMatcher::getValue(int x, int y) const {
+    if (y < 0) {
+        return 0;
+    }
+    if (isBoundaryColumn(x)) {
+        return y + 1;
+    }
+    // the value is the sum of the vertical deltas from the row above the pattern, where it is 0
+    const int offset = getRingIndex(x) * wordsCount;
+    int value = 0;
+    const int lastWord = y / WORD_BITS;
+    for (int w = 0; w <= lastWord; w++) {
+        const quint64 mask = (w < lastWord) ? ~Q_UINT64_C(0) : (~Q_UINT64_C(0) >> (WORD_BITS - 1 - y % WORD_BITS));
+        value += bitsCount(windowPv[offset + w] & mask) - bitsCount(windowMv[offset + w] & mask);
+    }
+    return value;
+}
+
+bool BitParallelMatcher::isMatch(int x, int y) const {
+    if (isBoundaryColumn(x)) {
+        return false;
+    }
+    const quint64 *charPeq = peq.constData() + windowChars[getRingIndex(x)] * wordsCount;
+    return 0 != (charPeq[y / WORD_BITS] & (Q_UINT64_C(1) << (y % WORD_BITS)));
+}
+
+int BitParallelMatcher::getLastLen() const {
+    CHECK(insDel, patternLen);
+
+    // DynTable::getLen() unrolled into a loop, the preference order of the steps is the same
+    int x = windowWidth - 1;
+    int y = patternLen - 1;
+    int len = 0;
+    while (y >= 0) {
+        const int v = getValue(x, y);
+        const bool match = isMatch(x, y);
+        const int d = getValue(x - 1, y - 1);
+        if (match && v == d) {
+            len++;
+            x--;
+            y--;
+        } else if (v == getValue(x, y - 1) + 1) {
+            y--;
+        } else if (!match && v == d + 1) {
+            len++;
+            x--;
+            y--;
+        } else {
+            len++;
+            x--;
+        }
+    }
+    return len;
+}
+
+quint64 BitParallelMatcher::estimateMemoryUsageInBytes(int patternLen, int maxErr, bool insDel) {
+    const quint64 wordsCount = (patternLen + WORD_BITS - 1) / WORD_BITS;
+    quint64 result = CHARS_COUNT * wordsCount * sizeof(quint64);
+    if (insDel) {
+        const quint64 windowWidth = patternLen + maxErr;
+        result += (2 * (windowWidth + 1) * wordsCount) * sizeof(quint64) + windowWidth;
+    } else {
+        result += (maxErr + 1) * wordsCount * sizeof(quint64);
+    }
+    return result;
+}
+
+}   // namespace U2
@@ -0,0 +1,122 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_BIT_PARALLEL_MATCHER_H_
+#define _U2_BIT_PARALLEL_MATCHER_H_
+
+#include <QVector>
+
+#include <U2Core/global.h>
+
+namespace U2 {
+
+/**
+ * Bit-parallel replacement of DynTable for the approximate pattern search.
+ * The matcher keeps the last column of the pattern-to-sequence distance table as bit vectors
+ * and updates it for a sequence character with O(patternLen / 64) word operations:
+ * with insertions and deletions by Myers' algorithm (the blocked variant for patterns longer than 64),
+ * with substitutions only by the shift-add algorithm that counts up to 'maxErr' mismatches.
+ *
+ * getLast() and getLastLen() return the same values as DynTable of 'patternLen + maxErr' columns does
+ * after matching all pattern rows with the same characters, except that the distances greater than
+ * 'maxErr' are returned as 'maxErr + 1' in the substitutions mode.
+ */
+class U2ALGORITHM_EXPORT BitParallelMatcher {
+public:
+    BitParallelMatcher();
+    BitParallelMatcher(const char *pattern, int patternLen, int maxErr, bool insDel, bool useAmbiguousBases);
+
+    /** Forgets all added characters */
+    void reset();
+
+    /** Adds the next sequence character: the table gets a new last column */
+    void addChar(char c) {
+        const quint64 *eq = peq.constData() + uchar(c) * wordsCount;
+        if (insDel) {
+            if (1 == wordsCount) {
+                addCharInsDelSingleWord(*eq);
+            } else {
+                addCharInsDelBlocked(eq);
+            }
+            storeLastColumn(c);
+        } else {
+            addCharSubst(eq);
+        }
+    }
+
+    /** Distance between the pattern and the best sequence part ending at the last added character */
+    int getLast() const {
+        return score;
+    }
+
+    /** Length of the sequence part of the best alignment, it is chosen the same way as DynTable does */
+    int getLastLen() const;
+
+    int getPatternLength() const {
+        return patternLen;
+    }
+
+    static quint64 estimateMemoryUsageInBytes(int patternLen, int maxErr, bool insDel);
+
+    static const int WORD_BITS;
+
+private:
+    void addCharInsDelSingleWord(quint64 eq);
+    void addCharInsDelBlocked(const quint64 *eq);
+    void addCharSubst(const quint64 *eq);
+    void storeLastColumn(char c);
+
+    /** DynTable values and match flags of the window: 'x' is a column in [0, windowWidth), 'y' is a pattern row */
+    int getValue(int x, int y) const;
+    bool isMatch(int x, int y) const;
+    bool isBoundaryColumn(int x) const;
+    int getRingIndex(int x) const;
+
+    int patternLen;
+    int maxErr;
+    bool insDel;
+    int wordsCount;
+    quint64 lastBit;
+    int score;
+
+    // peq[c * wordsCount + w]: bit 'b' of the word 'w' is set if the character 'c' matches the pattern character 'w * 64 + b'
+    QVector<quint64> peq;
+
+    // Myers' vertical positive and negative deltas of the last column
+    QVector<quint64> pv;
+    QVector<quint64> mv;
+
+    // the last 'windowWidth' columns of the deltas and the characters, they are needed to restore the alignment length
+    int windowWidth;
+    QVector<quint64> windowPv;
+    QVector<quint64> windowMv;
+    QVector<uchar> windowChars;
+    int lastColumnIndex;
+    qint64 columnsCount;
+
+    // shift-add states: bit 'b' of the state 'd' is set if the pattern prefix of 'b + 1' characters has at most 'd' mismatches
+    QVector<quint64> states;
+};
+
+}   // namespace U2
+
+#endif // _U2_BIT_PARALLEL_MATCHER_H_
@@ -27,10 +27,11 @@
 #include <U2Core/TextUtils.h>
 #include <U2Core/U2SafePoints.h>
 
-#include <U2Algorithm/DynTable.h>
 #include <U2Algorithm/RollingArray.h>
 
+#include "BitParallelMatcher.h"
 #include "FindAlgorithm.h"
+#include "SequenceRegExp.h"
 
 namespace U2 {
 
@@ -80,8 +81,8 @@ bool FindAlgorithmResult::lessByRegionStartPos(const U2::FindAlgorithmResult &r1
 
 class StrandContext {
 public:
-    StrandContext(int width, int height, bool insDel, const char* p)
-        : dynTable(width, height, insDel), pattern(p)
+    StrandContext(const char* p, int patternLen, int maxErr, bool insDel, bool useAmbiguousBases)
+        : matcher(NULL == p ? BitParallelMatcher() : BitParallelMatcher(p, patternLen, maxErr, insDel, useAmbiguousBases)), pattern(p)
     {
     }
 
@@ -90,14 +91,16 @@ public:
     {
     }
 
+    explicit StrandContext(const char * p) : pattern(p) {}
+
     StrandContext() : pattern(NULL) {}
 
-    static quint64 estimateRamUsageForOneContext(int width, int height)
+    static quint64 estimateRamUsageForOneContext(int patternLen, int maxErr, bool insDel)
     {
-        return DynTable::estimateTableSizeInBytes(width, height);
+        return BitParallelMatcher::estimateMemoryUsageInBytes(patternLen, maxErr, insDel);
     }
 
-    DynTable dynTable;
+    BitParallelMatcher matcher;
     RollingArray<char> rollArr;
     const char* pattern;
     FindAlgorithmResult res;
@@ -163,19 +166,17 @@ static void findInAmino(    FindAlgorithmResultsListener* rl,
         "Invalid alphabet detected!", );
 
     int seqLen = QByteArray(seq).size();
-    int width =  patternLen + maxErr;
-    int height = patternLen;
 
     QByteArray revPattern(pattern);
     TextUtils::reverse(revPattern.data(), patternLen);
 
     StrandContext context[] = {
-        StrandContext(width, height, insDel, pattern),
-        StrandContext(width, height, insDel, pattern),
-        StrandContext(width, height, insDel, pattern),
-        StrandContext(width, height, insDel, revPattern.data()),
-        StrandContext(width, height, insDel, revPattern.data()),
-        StrandContext(width, height, insDel, revPattern.data())
+        StrandContext(pattern, patternLen, maxErr, insDel, false),
+        StrandContext(pattern, patternLen, maxErr, insDel, false),
+        StrandContext(pattern, patternLen, maxErr, insDel, false),
+        StrandContext(revPattern.data(), patternLen, maxErr, insDel, false),
+        StrandContext(revPattern.data(), patternLen, maxErr, insDel, false),
+        StrandContext(revPattern.data(), patternLen, maxErr, insDel, false)
     };
 
     int onePercentLen = range.length / 100;
@@ -194,30 +195,26 @@ static void findInAmino(    FindAlgorithmResultsListener* rl,
     {
         for (int ci = conStart; ci < conEnd && !stopFlag; ci++) {
             StrandContext& ctx = context[3 * ci + translStrand];
-            DynTable& dt = ctx.dynTable;
-            const char* p = ctx.pattern;
+            BitParallelMatcher& matcher = ctx.matcher;
             FindAlgorithmResult& res = ctx.res;
 
-            for (int j=0; j < patternLen && !stopFlag; j++) { //TODO: optimize -> specialize loops
-                int k = cycleIndex(seqLen, i);
-                char amino = ci == 0 ?
-                    aminoTT->translate3to1( seq[k],
-                                            seq[cycleIndex(seqLen, k + 1)],
-                                            seq[cycleIndex(seqLen, k + 2)]) :  //direct amino
-                    aminoTT->translate3to1(complMap.at( (quint8) seq[cycleIndex(seqLen, k + 2)]),
-                                           complMap.at((quint8) seq[cycleIndex(seqLen, k + 1)]),
-                                           complMap.at( (quint8)seq[k]) ); //compl amino
-
-                bool matched = (amino == p[j]);
-                dt.match(j, matched);
-            }
-            int err = dt.getLast();
+            int k = cycleIndex(seqLen, i);
+            char amino = ci == 0 ?
+                aminoTT->translate3to1( seq[k],
+                                        seq[cycleIndex(seqLen, k + 1)],
+                                        seq[cycleIndex(seqLen, k + 2)]) :  //direct amino
+                aminoTT->translate3to1(complMap.at( (quint8) seq[cycleIndex(seqLen, k + 2)]),
+                                       complMap.at((quint8) seq[cycleIndex(seqLen, k + 1)]),
+                                       complMap.at( (quint8)seq[k]) ); //compl amino
+            matcher.addChar(amino);
+
+            int err = matcher.getLast();
             if (!res.isEmpty() && (err > maxErr || (i - res.region.startPos) >= patternLenInNucl)) {
                 rl->onResult(res);
                 res.clear();
             }
             if (err <= maxErr) {
-                int newLen = dt.getLastLen();
+                int newLen = matcher.getLastLen();
                 newLen *= 3;
                 if (res.isEmpty() || res.err > err || (res.err == err && newLen < res.region.length)) {
                     SAFE_POINT( newLen + 3  * maxErr >= patternLenInNucl, "Internal algorithm error!", );
@@ -237,7 +234,6 @@ static void findInAmino(    FindAlgorithmResultsListener* rl,
                     }
                 }
             }
-            dt.shiftColumn();
             if (leftTillPercent == 0) {
                 percentsCompleted = qMin(percentsCompleted+1,100);
                 leftTillPercent = onePercentLen;
@@ -464,8 +460,63 @@ static void sendResultToListener( int resultStartPos, int resultLength, U2Strand
     rl->onResult(res);
 }
 
-static void regExpSearch(   const QString &refSequence,
-                            const QRegExp &regExp,
+/** Sends the regular expression matches in a sequence part or in its amino translation to the results listener */
+class RegExpMatchesListener : public SequenceRegExpListener {
+public:
+    RegExpMatchesListener(const U2Strand &searchStrand,
+                          const U2Region &sequenceRange,
+                          int currentStrand,
+                          int tailCutted,
+                          int totalStrandCount,
+                          bool refSeqIsAminoTranslation,
+                          int aminoFrameNumber,
+                          int cyclePoint,
+                          int &percentsCompleted,
+                          FindAlgorithmResultsListener *rl)
+        : searchStrand(searchStrand), sequenceRange(sequenceRange), currentStrand(currentStrand), tailCutted(tailCutted),
+          totalStrandCount(totalStrandCount), refSeqIsAminoTranslation(refSeqIsAminoTranslation), aminoFrameNumber(aminoFrameNumber),
+          cyclePoint(cyclePoint), percentsCompleted(percentsCompleted), rl(rl)
+    {
+
+    }
+
+    void onMatch(int foundStartPos, int foundLength) {
+        // remember that there are a few iterations, so a single one yields
+        // 1 / @conEnd of total progress
+        percentsCompleted = int(( 100 * qint64(foundStartPos) * ( currentStrand + 1 ) )
+            / ( sequenceRange.length * totalStrandCount ));
+
+        int resultStartPos = refSeqIsAminoTranslation ? foundStartPos * 3 : foundStartPos;
+        CHECK(resultStartPos < cyclePoint || sequenceRange.startPos != 0, );
+
+        const int resultLen = refSeqIsAminoTranslation ? foundLength * 3 : foundLength;
+        prepareResultPosition( sequenceRange.startPos + (refSeqIsAminoTranslation * aminoFrameNumber),
+                               sequenceRange.length - (refSeqIsAminoTranslation * aminoFrameNumber),
+                               resultStartPos,
+                               resultLen,
+                               searchStrand );
+        resultStartPos -= (searchStrand.isCompementary() && refSeqIsAminoTranslation ? tailCutted : 0);
+
+        sendResultToListener( resultStartPos, resultLen, searchStrand, rl );
+    }
+
+private:
+    const U2Strand searchStrand;
+    const U2Region sequenceRange;
+    const int currentStrand;
+    const int tailCutted;
+    const int totalStrandCount;
+    const bool refSeqIsAminoTranslation;
+    const int aminoFrameNumber;
+    const int cyclePoint;
+    int &percentsCompleted;
+    FindAlgorithmResultsListener *rl;
+};
+
+static void regExpSearch(   const char *refSequence,
+                            int refSequenceLength,
+                            SequenceRegExp &seqRegExp,
+                            const QRegExp &regExp, // is used if 'seqRegExp' does not support the pattern
                             const U2Strand &searchStrand,
                             const U2Region &sequenceRange,
                             int maxResultLen,
@@ -483,50 +534,31 @@ static void regExpSearch(   const QString &refSequence,
         cyclePoint = sequenceRange.endPos();
     }
 
+    RegExpMatchesListener listener(searchStrand, sequenceRange, currentStrand, tailCutted, totalStrandCount,
+                                   refSeqIsAminoTranslation, aminoFrameNumber, cyclePoint, percentsCompleted, rl);
+    if (seqRegExp.isValid()) {
+        seqRegExp.findAll(refSequence, refSequenceLength, maxResultLen, &listener, stopFlag);
+        return;
+    }
+
+    const QString refString = QString(QByteArray(refSequence, refSequenceLength));
     int foundStartPos = 0;
     while ( 0 == stopFlag
-        && -1 != ( foundStartPos = regExp.indexIn( refSequence, foundStartPos ) ) )
+        && -1 != ( foundStartPos = regExp.indexIn( refString, foundStartPos ) ) )
     {
-        // remember that there are a few iterations, so a single one yields
-        // 1 / @conEnd of total progress
-        percentsCompleted = ( 100 * foundStartPos * ( currentStrand + 1 ) )
-            / ( sequenceRange.length * totalStrandCount );
-
         const int foundLength = regExp.matchedLength( );
         if ( maxResultLen >= foundLength ) {
-            int resultStartPos = refSeqIsAminoTranslation ? foundStartPos * 3 : foundStartPos;
-            if (resultStartPos < cyclePoint || sequenceRange.startPos != 0) {
-                const int resultLen = refSeqIsAminoTranslation ? foundLength * 3 : foundLength;
-                prepareResultPosition( sequenceRange.startPos + (refSeqIsAminoTranslation * aminoFrameNumber),
-                                       sequenceRange.length - (refSeqIsAminoTranslation * aminoFrameNumber),
-                                       resultStartPos,
-                                       resultLen,
-                                       searchStrand );
-                resultStartPos -= (searchStrand.isCompementary() && refSeqIsAminoTranslation ? tailCutted : 0);
-
-                sendResultToListener( resultStartPos, resultLen, searchStrand, rl );
-            }
+            listener.onMatch( foundStartPos, foundLength );
         }
 
         // try to find smaller substrings starting from the same position
         int substrLength = qMin(foundLength - 1, maxResultLen);
         while ( 0 == stopFlag && 0 < substrLength
-            && foundStartPos == ( regExp.indexIn( refSequence.left( foundStartPos + substrLength ), foundStartPos ) ) )
+            && foundStartPos == ( regExp.indexIn( refString.left( foundStartPos + substrLength ), foundStartPos ) ) )
         {
             const int foundSubstrLength = regExp.matchedLength( );
             if ( maxResultLen >= foundSubstrLength ) {
-                int resultStartPos = refSeqIsAminoTranslation ? foundStartPos * 3 : foundStartPos;
-                if (resultStartPos < cyclePoint || sequenceRange.startPos != 0) {
-                    const int resultLen = refSeqIsAminoTranslation ? foundSubstrLength * 3 : foundSubstrLength;
-                    prepareResultPosition( sequenceRange.startPos + (refSeqIsAminoTranslation * aminoFrameNumber),
-                                           sequenceRange.length - (refSeqIsAminoTranslation * aminoFrameNumber),
-                                           resultStartPos,
-                                           resultLen,
-                                           searchStrand );
-                    resultStartPos -= (searchStrand.isCompementary() && refSeqIsAminoTranslation ? tailCutted : 0);
-
-                    sendResultToListener( resultStartPos, resultLen, searchStrand, rl );
-                }
+                listener.onMatch( foundStartPos, foundSubstrLength );
             }
             substrLength = foundSubstrLength - 1;
         }
@@ -542,7 +574,8 @@ static void findInAmino_regExp( FindAlgorithmResultsListener *rl,
                                 const char *seq,
                                 const U2Region &range,
                                 bool searchIsCircular,
-                                const char *pattern,
+                                SequenceRegExp &seqRegExp,
+                                const QRegExp &regExp,
                                 int maxRegExpResult,
                                 int &stopFlag,
                                 int &percentsCompleted )
@@ -552,9 +585,6 @@ static void findInAmino_regExp( FindAlgorithmResultsListener *rl,
     int conStart = isDirect( strand )? 0 : 1;
     int conEnd =  isComplement( strand ) ? 2 : 1;
 
-    QRegExp regExp( pattern );
-    SAFE_POINT( regExp.isValid( ), "Invalid regular expression supplied!", );
-
     int maxAminoResult = maxRegExpResult * 3;
     int seqLen = QByteArray(seq).size();
 
@@ -577,7 +607,6 @@ static void findInAmino_regExp( FindAlgorithmResultsListener *rl,
                 len = range.length - aminoFrameNumber;
             }
 
-            QString translation;
             QByteArray rawTranslation(len + bufferSize + 1, 0);
             U2Strand resultStrand;
             const int translationLen = (len + bufferSize) / 3;
@@ -596,18 +625,16 @@ static void findInAmino_regExp( FindAlgorithmResultsListener *rl,
 
                 resultStrand = U2Strand::Direct;
             }
-            translation = QString( QByteArray( rawTranslation.data(), translationLen ) );
-
 
             if (searchIsCircular) {
                 U2Region cirRange = range;
                 cirRange.length += (seqLen == range.length && range.startPos == 0) ? bufferSize : 0;
 
-                regExpSearch( translation, regExp, resultStrand, cirRange, maxRegExpResult, ci,
+                regExpSearch( rawTranslation.constData(), translationLen, seqRegExp, regExp, resultStrand, cirRange, maxRegExpResult, ci,
                               (len + bufferSize) % 3, conEnd, true, aminoFrameNumber,
                               percentsCompleted, stopFlag, rl, len);
             } else {
-                regExpSearch( translation, regExp, resultStrand, range, maxAminoResult, ci,
+                regExpSearch( rawTranslation.constData(), translationLen, seqRegExp, regExp, resultStrand, range, maxAminoResult, ci,
                               (len + bufferSize) % 3, conEnd, true, aminoFrameNumber,
                               percentsCompleted, stopFlag, rl );
             }
@@ -628,8 +655,17 @@ static void findRegExp( FindAlgorithmResultsListener *rl,
                         int &stopFlag,
                         int &percentsCompleted )
 {
+    // QRegExp is kept for the patterns with back references and assertions only
+    SequenceRegExp seqRegExp( pattern );
+    QRegExp regExp;
+    if ( !seqRegExp.isValid( ) ) {
+        algoLog.trace( QString( "The regular expression is searched by QRegExp: %1" ).arg( seqRegExp.getError( ) ) );
+        regExp = QRegExp( pattern );
+        SAFE_POINT( regExp.isValid( ), "Invalid regular expression supplied!", );
+    }
+
     if ( NULL != aminoTT ) {
-        findInAmino_regExp( rl, aminoTT, complTT, strand, seq, range, searchIsCircular, pattern,
+        findInAmino_regExp( rl, aminoTT, complTT, strand, seq, range, searchIsCircular, seqRegExp, regExp,
             maxRegExpResult, stopFlag, percentsCompleted );
         return;
     }
@@ -639,23 +675,16 @@ static void findRegExp( FindAlgorithmResultsListener *rl,
     int seqLen = QByteArray(seq).size();
     const int conStart = isDirect( strand ) ? 0 : 1;
     const int conEnd =  isComplement( strand ) ? 2 : 1;
-
-    QRegExp regExp( pattern );
-    SAFE_POINT( regExp.isValid( ), "Invalid regular expression supplied!", );
+    const int substrLength = qMin(range.length, seqLen - range.startPos);
 
     for ( int ci = conStart; ci < conEnd && !stopFlag; ++ci ) {
-        QString substr;
-        QByteArray tmp( range.length + 1, 0 );
-        char *complSeq = NULL;
+        QByteArray substr;
         U2Strand resultStrand;
 
         if ( ci == 1 ) { // complementary
-            complSeq = tmp.data( );
-            TextUtils::translate( complTT->getOne2OneMapper( ), seq + range.startPos,
-                                  qMin(range.length, seqLen - range.startPos),
-                                  complSeq );
-            TextUtils::reverse( complSeq, qMin(range.length, seqLen - range.startPos) );
-            substr = QString( QByteArray( complSeq, qMin(range.length, seqLen - range.startPos) ) );
+            substr.resize( substrLength );
+            TextUtils::translate( complTT->getOne2OneMapper( ), seq + range.startPos, substrLength, substr.data( ) );
+            TextUtils::reverse( substr.data( ), substrLength );
             if (searchIsCircular) {
                 int bufferSize = getCircularOverlap(seq, range,
                                                  (range.length > maxRegExpResult) ? maxRegExpResult - 1 : range.length);
@@ -668,12 +697,12 @@ static void findRegExp( FindAlgorithmResultsListener *rl,
 
             resultStrand = U2Strand::Complementary;
         } else { // direct
-            substr = QString( QByteArray( seq + range.startPos,
-                                          qMin(range.length, seqLen - range.startPos ) ));
+            // the sequence is not copied unless the circular overlap is appended
+            substr = QByteArray::fromRawData( seq + range.startPos, substrLength );
             if (searchIsCircular) {
                 int bufferSize = getCircularOverlap(seq, range,
                                                  (range.length > maxRegExpResult) ? maxRegExpResult - 1 : range.length);
-                substr += QString( QByteArray( seq, bufferSize));
+                substr += QByteArray( seq, bufferSize);
             }
             resultStrand = U2Strand::Direct;
         }
@@ -683,15 +712,60 @@ static void findRegExp( FindAlgorithmResultsListener *rl,
             if (range.length == seqLen && range.startPos == 0) {
                 cirRange.length += (range.length > maxRegExpResult) ? maxRegExpResult - 1 : range.length;
             }
-            regExpSearch( substr, regExp, resultStrand, cirRange, maxRegExpResult, ci, 0, conEnd, false, 0,
+            regExpSearch( substr.constData( ), substr.size( ), seqRegExp, regExp, resultStrand, cirRange, maxRegExpResult, ci, 0, conEnd, false, 0,
                 percentsCompleted, stopFlag, rl, seqLen);
         } else {
-            regExpSearch( substr, regExp, resultStrand, range, maxRegExpResult, ci, 0, conEnd, false, 0,
+            regExpSearch( substr.constData( ), substr.size( ), seqRegExp, regExp, resultStrand, range, maxRegExpResult, ci, 0, conEnd, false, 0,
                           percentsCompleted, stopFlag, rl );
         }
     }
 }
 
+// compares all pattern characters with a sequence character at once, 'end' is the end of the sequence part to search in
+static void find_subst_bitParallel( FindAlgorithmResultsListener* rl,
+                                    FindAlgorithmStrand strand,
+                                    const char* sequence,
+                                    const U2Region& range,
+                                    int end,
+                                    const char* pattern,
+                                    const char* complPattern,
+                                    int patternLen,
+                                    bool useAmbiguousBases,
+                                    int maxErr,
+                                    int& stopFlag,
+                                    int& percentsCompleted )
+{
+    StrandContext context[] = {
+        StrandContext(pattern, patternLen, maxErr, false, useAmbiguousBases),
+        StrandContext(complPattern, patternLen, maxErr, false, useAmbiguousBases)
+    };
+
+    int onePercentLen = range.length/100;
+    int leftTillPercent = onePercentLen;
+    percentsCompleted = 0;
+
+    int conStart = isDirect(strand)? 0 : 1;
+    int conEnd =  isComplement(strand) ? 2 : 1;
+    SAFE_POINT( conStart < conEnd, "Internal algorithm error: incorrect strand order!", );
+
+    // 'i' is the last position of the compared sequence part
+    for (int i = range.startPos; i < end && !stopFlag; i++) {
+        const int startPos = i - patternLen + 1;
+        for (int ci = conStart; ci < conEnd; ci++) {
+            BitParallelMatcher& matcher = context[ci].matcher;
+            matcher.addChar(sequence[i]);
+            if (startPos >= range.startPos && matcher.getLast() <= maxErr) {
+                const U2Strand resultStrand = (ci == 1) ? U2Strand::Complementary : U2Strand::Direct;
+                rl->onResult(FindAlgorithmResult(U2Region(startPos, patternLen), false, resultStrand, matcher.getLast()));
+            }
+        }
+        if (startPos >= range.startPos && --leftTillPercent <= 0) {
+            percentsCompleted = qMin(percentsCompleted+1,100);
+            leftTillPercent = onePercentLen;
+        }
+    }
+}
+
 static void find_subst( FindAlgorithmResultsListener* rl,
                         DNATranslation* aminoTT,
                         DNATranslation* complTT,
@@ -727,8 +801,8 @@ static void find_subst( FindAlgorithmResultsListener* rl,
     }
 
     StrandContext context[] = {
-        StrandContext(0, 0, false, pattern),
-        StrandContext(0, 0, false, complPattern)
+        StrandContext(pattern),
+        StrandContext(complPattern)
     };
 
     int onePercentLen = range.length/100;
@@ -750,6 +824,14 @@ static void find_subst( FindAlgorithmResultsListener* rl,
     } else {
         sequence = seq;
     }
+
+    // a pattern that fits a machine word is faster compared with the bit-parallel algorithm
+    if (patternLen <= BitParallelMatcher::WORD_BITS) {
+        find_subst_bitParallel( rl, strand, sequence, range, end, pattern, complPattern, patternLen, useAmbiguousBases, maxErr,
+            stopFlag, percentsCompleted );
+        return;
+    }
+
     for (int i = range.startPos;
          i < end - patternLen + 1 && !stopFlag; i++, leftTillPercent--) {
         for (int ci = conStart; ci < conEnd && !stopFlag; ci++) {
@@ -844,6 +926,7 @@ void FindAlgorithm::find(
         TextUtils::reverse(complPattern, patternLen);
     }
 
+    // the matcher keeps a window of 'width' columns to restore the alignment lengths
     int width =  patternLen + maxErr;
     int height = patternLen;
 
@@ -855,8 +938,8 @@ void FindAlgorithm::find(
 
     try {
         StrandContext context[] = {
-            StrandContext(width, height, insDel, pattern),
-            StrandContext(width, height, insDel, complPattern)
+            StrandContext(pattern, patternLen, maxErr, insDel, useAmbiguousBases),
+            StrandContext(complPattern, patternLen, maxErr, insDel, useAmbiguousBases)
         };
 
         int onePercentLen = range.length/100;
@@ -872,16 +955,12 @@ void FindAlgorithm::find(
         for (int i=range.startPos; i < end && !stopFlag; i++, leftTillPercent--) {
             for (int ci = conStart; ci < conEnd && !stopFlag; ci++) {
                 StrandContext& ctx = context[ci];
-                DynTable& dt = ctx.dynTable;
-                const char* p = ctx.pattern;
+                BitParallelMatcher& matcher = ctx.matcher;
                 FindAlgorithmResult& res = ctx.res;
 
-                for (int j=0; j<patternLen && !stopFlag; j++) {
-                    bool matched = seq[ cycleIndex( seqLen, i) ] == p[j];
-                    dt.match(j, matched);
-                }
+                matcher.addChar(seq[ cycleIndex( seqLen, i) ]);
 
-                int err = dt.getLast();
+                int err = matcher.getLast();
 
                 if (!res.isEmpty() && (err > maxErr || (i-res.region.startPos) >= patternLen)) {
                     rl->onResult(res);
@@ -889,7 +968,7 @@ void FindAlgorithm::find(
                 }
 
                 if (err <= maxErr) {
-                    int newLen = dt.getLastLen();
+                    int newLen = matcher.getLastLen();
                     if (res.isEmpty() || res.err > err || (res.err == err && newLen < res.region.length)) {
                         int newStart = i-newLen+1;
                         bool boundaryCheck = (range.contains(newStart) && range.contains(newStart + newLen - 1));
@@ -908,7 +987,6 @@ void FindAlgorithm::find(
                     }
                 }
 
-                dt.shiftColumn();
                 if (leftTillPercent == 0) {
                     percentsCompleted = qMin(percentsCompleted+1,100);
                     leftTillPercent = onePercentLen;
@@ -939,8 +1017,7 @@ int FindAlgorithm::estimateRamUsageInMbytes(const FindAlgorithmPatternSettings p
     quint64 ramUsage = 0;
 
     if(FindAlgorithmPatternSettings_InsDel == patternSettings) {
-        ramUsage = 2 * StrandContext::estimateRamUsageForOneContext(patternLength + maxError,
-                                                                        patternLength);
+        ramUsage = 2 * StrandContext::estimateRamUsageForOneContext(patternLength, maxError, true);
         if(searchInAminoTT) {
             ramUsage *= 4;
         }
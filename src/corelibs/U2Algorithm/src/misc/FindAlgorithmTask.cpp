@@ -20,6 +20,7 @@
  */
 
 #include <QtCore/QTextStream>
+#include <QtCore/QtAlgorithms>
 
 #include <U2Core/TextUtils.h>
 #include <U2Core/DNATranslation.h>
@@ -40,8 +41,81 @@ namespace U2 {
 
 class StrandContext;
 
+namespace {
+
+const int PARALLEL_SEARCH_CHUNK_SIZE = 1024 * 1024;
+
+bool canSearchInParallel(const FindAlgorithmTaskSettings& config) {
+    CHECK(FindAlgorithmPatternSettings_InsDel == config.patternSettings || FindAlgorithmPatternSettings_Subst == config.patternSettings, false);
+    CHECK(NULL == config.proteinTT, false);
+    const U2Region& range = config.searchRegion;
+    const bool circularRange = range.endPos() > config.sequence.size() || (config.searchIsCircular && range.endPos() == config.sequence.size());
+    return !circularRange && range.length >= 2 * PARALLEL_SEARCH_CHUNK_SIZE;
+}
+
+/**
+ * Length of the chunk part that is searched in only to get the same results near the chunk border as the search in the whole range gets.
+ * With insertions and deletions the distances do not depend on the chunk start after '2 * patternLen' characters,
+ * the alignment lengths are restored from the last 'patternLen + maxErr' characters
+ * and a result is reported at most 'patternLen' characters after its start.
+ */
+int getChunkWarmUpLength(const FindAlgorithmTaskSettings& config) {
+    if (FindAlgorithmPatternSettings_InsDel == config.patternSettings) {
+        return 4 * config.pattern.length() + config.maxErr;
+    }
+    return config.pattern.length();
+}
+
+/**
+ * Collects the results that start in the chunk part the chunk is responsible for.
+ * With the limited results count only the first results by position are kept,
+ * the chunk is stopped when the next results can't start before them.
+ */
+class ChunkResultsFilter : public FindAlgorithmResultsListener {
+public:
+    ChunkResultsFilter(FindAlgorithmResultsListener* listener, const U2Region& ownRegion, int maxResults, int maxResultShift, int& stopFlag)
+        : listener(listener), ownRegion(ownRegion), maxResults(maxResults), maxResultShift(maxResultShift), stopFlag(stopFlag) {}
+
+    virtual void onResult(const FindAlgorithmResult& r) {
+        if (r.err == FindAlgorithmResult::NOT_ENOUGH_MEMORY_ERROR) {
+            listener->onResult(r);
+            stopFlag = true;
+            return;
+        }
+        CHECK(ownRegion.contains(r.region.startPos), );
+        if (FindAlgorithmSettings::MAX_RESULT_TO_FIND_UNLIMITED == maxResults) {
+            results.append(r);
+            return;
+        }
+
+        QList<FindAlgorithmResult>::iterator place = qUpperBound(results.begin(), results.end(), r, FindAlgorithmResult::lessByRegionStartPos);
+        results.insert(place, r);
+        if (results.size() > maxResults) {
+            results.removeLast();
+        }
+        // the results are reported almost in the order of their positions, a later result starts at most 'maxResultShift' characters before the current one
+        if (results.size() == maxResults && results.last().region.startPos < r.region.startPos - maxResultShift) {
+            stopFlag = true;
+        }
+    }
+
+    const QList<FindAlgorithmResult>& getResults() const {
+        return results;
+    }
+
+private:
+    FindAlgorithmResultsListener* listener;
+    U2Region ownRegion;
+    int maxResults;
+    int maxResultShift;
+    int& stopFlag;
+    QList<FindAlgorithmResult> results;
+};
+
+}   // namespace
+
 FindAlgorithmTask::FindAlgorithmTask(const FindAlgorithmTaskSettings& s)
-: Task (tr("Find in sequence task"), TaskFlag_None), config(s)
+: Task (tr("Find in sequence task"), canSearchInParallel(s) ? TaskFlags(TaskFlag_NoRun) : TaskFlags(TaskFlag_None)), config(s)
 {
     if(s.countTask){
         GCOUNTER(cvar, tvar, "FindAlgorithmTask");
@@ -53,6 +127,25 @@ FindAlgorithmTask::FindAlgorithmTask(const FindAlgorithmTaskSettings& s)
     addTaskResource(TaskResourceUsage(RESOURCE_MEMORY,
         FindAlgorithm::estimateRamUsageInMbytes(config.patternSettings, NULL != config.proteinTT,
         config.pattern.length(), config.maxErr), true));
+
+    if (canSearchInParallel(config)) {
+        // the neighbour chunks share the warm-up parts of each other
+        SequenceWalkerConfig c;
+        c.seq = config.sequence.constData();
+        c.seqSize = config.sequence.size();
+        c.range = config.searchRegion;
+        c.complTrans = NULL;
+        c.aminoTrans = NULL;
+        c.strandToWalk = StrandOption_DirectOnly;
+        c.overlapSize = 2 * getChunkWarmUpLength(config);
+        c.chunkSize = qMax(PARALLEL_SEARCH_CHUNK_SIZE, 4 * c.overlapSize);
+        c.lastChunkExtraLen = int(c.chunkSize / 2);
+        c.nThreads = MAX_PARALLEL_SUBTASKS_AUTO;
+
+        tpm = Progress_SubTasksBased;
+        // a chunk is stopped by its cancel flag when it has found enough results, it must not cancel the others
+        addSubTask(new SequenceWalkerTask(c, this, tr("Find in sequence parallel"), TaskFlags(TaskFlag_NoRun) | TaskFlag_FailOnSubtaskError));
+    }
 }
 
 void FindAlgorithmTask::run() {
@@ -74,6 +167,57 @@ void FindAlgorithmTask::run() {
         stateInfo.progress);
 }
 
+void FindAlgorithmTask::onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti) {
+    const U2Region chunk = t->getGlobalRegion();
+    const int warmUpLength = t->getGlobalConfig().overlapSize / 2;
+    const qint64 ownStart = t->hasLeftOverlap() ? chunk.startPos + warmUpLength : chunk.startPos;
+    const qint64 ownEnd = t->hasRightOverlap() ? chunk.endPos() - warmUpLength : chunk.endPos();
+    const int maxResultShift = 2 * (config.pattern.length() + config.maxErr);
+    ChunkResultsFilter filter(this, U2Region(ownStart, ownEnd - ownStart), config.maxResult2Find, maxResultShift, ti.cancelFlag);
+
+    // the task cancel is propagated to the chunk cancel flag
+    FindAlgorithm::find(&filter,
+        config.proteinTT,
+        config.complementTT,
+        config.strand,
+        config.patternSettings,
+        config.useAmbiguousBases,
+        config.sequence.constData(),
+        config.sequence.size(),
+        false,
+        chunk,
+        config.pattern.constData(),
+        config.pattern.length(),
+        config.maxErr,
+        config.maxRegExpResult,
+        ti.cancelFlag,
+        ti.progress);
+
+    QMutexLocker locker(&lock);
+    chunkResults.insert(ownStart, filter.getResults());
+}
+
+QList<Task*> FindAlgorithmTask::onSubTaskFinished(Task* subTask) {
+    QList<Task*> res;
+    CHECK(!subTask->isCanceled() && !subTask->hasError(), res);
+    CHECK(!isCanceled() && !hasError(), res);
+
+    // the chunks are finished in any order, the results are merged by position
+    QList<FindAlgorithmResult> mergedResults;
+    foreach (const QList<FindAlgorithmResult>& results, chunkResults) {
+        mergedResults << results;
+    }
+    chunkResults.clear();
+    qStableSort(mergedResults.begin(), mergedResults.end(), FindAlgorithmResult::lessByRegionStartPos);
+    if (FindAlgorithmSettings::MAX_RESULT_TO_FIND_UNLIMITED != config.maxResult2Find && mergedResults.size() > config.maxResult2Find) {
+        mergedResults = mergedResults.mid(0, config.maxResult2Find);
+    }
+
+    QMutexLocker locker(&lock);
+    newResults << mergedResults;
+    return res;
+}
+
 void FindAlgorithmTask::onResult(const FindAlgorithmResult& r) {
     if (r.err == FindAlgorithmResult::NOT_ENOUGH_MEMORY_ERROR) {
         stateInfo.cancelFlag = true;
@@ -81,14 +225,15 @@ void FindAlgorithmTask::onResult(const FindAlgorithmResult& r) {
         taskLog.error(error);
         return;
     }
-    if(config.maxResult2Find != FindAlgorithmSettings::MAX_RESULT_TO_FIND_UNLIMITED && newResults.size() >= config.maxResult2Find){
-        stateInfo.cancelFlag = true;
-        return;
-    }
     if(stateInfo.isCoR()){
         return;
     }
     lock.lock();
+    if(config.maxResult2Find != FindAlgorithmSettings::MAX_RESULT_TO_FIND_UNLIMITED && newResults.size() >= config.maxResult2Find){
+        stateInfo.cancelFlag = true;
+        lock.unlock();
+        return;
+    }
     newResults.append(r);
     lock.unlock();
 }
@@ -22,11 +22,13 @@
 #ifndef _U2_FIND_ENZYMES_TASK_H_
 #define _U2_FIND_ENZYMES_TASK_H_
 
+#include <U2Core/SequenceWalkerTask.h>
 #include <U2Core/Task.h>
 #include <U2Core/U2Region.h>
 
 #include "FindAlgorithm.h"
 
+#include <QtCore/QMap>
 #include <QtCore/QMutex>
 
 namespace U2 {
@@ -44,13 +46,19 @@ public:
     bool        countTask;
 };
 
-class U2ALGORITHM_EXPORT FindAlgorithmTask : public Task, public FindAlgorithmResultsListener {
+/**
+ * Long non-circular nucleotide regions are searched for with substitutions or insertions and deletions
+ * in parallel chunks, the other searches are run in one thread.
+ */
+class U2ALGORITHM_EXPORT FindAlgorithmTask : public Task, public FindAlgorithmResultsListener, public SequenceWalkerCallback {
     Q_OBJECT
 public:
     FindAlgorithmTask(const FindAlgorithmTaskSettings& s);
 
     virtual void run();
     virtual void onResult(const FindAlgorithmResult& r);
+    virtual void onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti);
+    virtual QList<Task*> onSubTaskFinished(Task* subTask);
 
     QList<FindAlgorithmResult> popResults();
 
@@ -62,6 +70,8 @@ private:
     bool    complementRun;
 
     QList<FindAlgorithmResult> newResults;
+    // the own region start of a parallel chunk -> the results of the chunk
+    QMap<qint64, QList<FindAlgorithmResult> > chunkResults;
     QMutex lock;
 };
 
@@ -0,0 +1,746 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <algorithm>
+
+#include <U2Core/U2SafePoints.h>
+
+#include "SequenceRegExp.h"
+
+namespace U2 {
+
+const int SequenceRegExp::MAX_FULL_DFA_STATES = 1024;
+const int SequenceRegExp::MAX_CACHED_DFA_STATES = 4096;
+
+namespace {
+
+const int BYTES_COUNT = 256;
+const int BOS_SYMBOL = 256;     // the beginning of the searched sequence part, it is matched by '^'
+const int EOS_SYMBOL = 257;     // the end of the searched sequence part, it is matched by '$'
+const int SYMBOLS_COUNT = 258;
+const int SYMBOL_SET_WORDS = (SYMBOLS_COUNT + 63) / 64;
+
+const int MAX_REPEAT_COUNT = 1000;
+const int MAX_NODE_DEPTH = 256;
+const int MAX_NFA_STATES = 100000;
+
+const int DEAD_STATE = 0;
+const int START_STATE = 1;
+
+// limits the count of the NFA states visited while the full DFA is built
+const qint64 MAX_FULL_DFA_WORK = 16 * 1024 * 1024;
+
+// the stop flag is checked once per this count of scanned characters
+const int STOP_FLAG_CHECK_PERIOD = 64 * 1024;
+
+class SymbolSet {
+public:
+    SymbolSet() {
+        std::fill(words, words + SYMBOL_SET_WORDS, Q_UINT64_C(0));
+    }
+
+    void add(int symbol) {
+        words[symbol / 64] |= Q_UINT64_C(1) << (symbol % 64);
+    }
+
+    void addRange(int first, int last) {
+        for (int symbol = first; symbol <= last; symbol++) {
+            add(symbol);
+        }
+    }
+
+    void unite(const SymbolSet &other) {
+        for (int i = 0; i < SYMBOL_SET_WORDS; i++) {
+            words[i] |= other.words[i];
+        }
+    }
+
+    /** The boundary symbols are not changed */
+    void invertBytes() {
+        for (int i = 0; i < BYTES_COUNT / 64; i++) {
+            words[i] = ~words[i];
+        }
+    }
+
+    quint64 words[SYMBOL_SET_WORDS];
+};
+
+QByteArray getStateKey(const QVector<int> &nfaStates) {
+    return QByteArray(reinterpret_cast<const char *>(nfaStates.constData()), nfaStates.size() * int(sizeof(int)));
+}
+
+bool isHexDigit(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+int hexDigitValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    return (c >= 'a' && c <= 'f') ? c - 'a' + 10 : c - 'A' + 10;
+}
+
+bool isAlphaNumeric(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+}   // namespace
+
+/** Parses the pattern and builds the NFA of the expression */
+class SequenceRegExpCompiler {
+public:
+    SequenceRegExpCompiler(SequenceRegExp &re, const QByteArray &pattern);
+
+    /** Returns false and sets the expression error if the pattern is invalid or not supported */
+    bool compile();
+
+private:
+    enum NodeType {
+        Node_Symbols,
+        Node_Concatenation,
+        Node_Alternatives,
+        Node_Repeat
+    };
+
+    struct Node {
+        NodeType type;
+        int symbolSet;
+        QVector<int> children;
+        int minCount;
+        int maxCount;   // -1 if the count is not limited
+        int depth;
+    };
+
+    // the parsers return -1 on errors
+    int parseAlternatives();
+    int parseConcatenation();
+    int parseRepeat();
+    int parseAtom();
+    int parseClass();
+    bool parseEscape(SymbolSet &symbols, int &symbol);
+    bool parseCounts(int &minCount, int &maxCount);
+    bool parseNumber(int &number);
+
+    bool atEnd() const;
+    void setError(const QString &message);
+
+    int addNode(NodeType type, int symbolSet = -1);
+    int addSymbolsNode(const SymbolSet &symbols);
+    bool addChild(int node, int child);
+
+    /** Builds the states of the node in the backward direction: 'next' is the state after the node */
+    int buildNfa(int node, int next, bool reverse);
+    int addNfaState(SequenceRegExp::NfaStateType type, int out, int out1, int symbolSet);
+    bool isNfaTooLarge() const;
+
+    SequenceRegExp &re;
+    const QByteArray pattern;
+    int pos;
+    int groupDepth;
+    QVector<Node> nodes;
+};
+
+SequenceRegExpCompiler::SequenceRegExpCompiler(SequenceRegExp &re, const QByteArray &pattern)
+    : re(re), pattern(pattern), pos(0), groupDepth(0)
+{
+
+}
+
+bool SequenceRegExpCompiler::compile() {
+    const int root = parseAlternatives();
+    CHECK(-1 != root, false);
+    CHECK_EXT(atEnd(), setError(QString("Unexpected '%1'").arg(pattern[pos])), false);
+
+    SymbolSet anyByte;
+    anyByte.addRange(0, BYTES_COUNT - 1);
+    re.symbolSets.resize(re.symbolSets.size() + SYMBOL_SET_WORDS);
+    const int anyByteSet = re.symbolSets.size() / SYMBOL_SET_WORDS - 1;
+    std::copy(anyByte.words, anyByte.words + SYMBOL_SET_WORDS, re.symbolSets.data() + anyByteSet * SYMBOL_SET_WORDS);
+
+    const int match = addNfaState(SequenceRegExp::NfaState_Match, -1, -1, -1);
+    re.forwardStart = buildNfa(root, match, false);
+
+    const int reversed = buildNfa(root, match, true);
+    const int loop = addNfaState(SequenceRegExp::NfaState_Split, reversed, -1, -1);
+    const int anyByteState = addNfaState(SequenceRegExp::NfaState_Symbols, loop, -1, anyByteSet);
+    re.nfa[loop].out1 = anyByteState;
+    re.reverseStart = loop;
+
+    CHECK_EXT(!isNfaTooLarge(), re.error = "The regular expression is too large", false);
+    return true;
+}
+
+int SequenceRegExpCompiler::parseAlternatives() {
+    const int first = parseConcatenation();
+    CHECK(-1 != first, -1);
+    CHECK(!atEnd() && '|' == pattern[pos], first);
+
+    const int node = addNode(Node_Alternatives);
+    CHECK(addChild(node, first), -1);
+    while (!atEnd() && '|' == pattern[pos]) {
+        pos++;
+        const int alternative = parseConcatenation();
+        CHECK(-1 != alternative, -1);
+        CHECK(addChild(node, alternative), -1);
+    }
+    return node;
+}
+
+int SequenceRegExpCompiler::parseConcatenation() {
+    const int node = addNode(Node_Concatenation);
+    while (!atEnd() && '|' != pattern[pos] && ')' != pattern[pos]) {
+        const int child = parseRepeat();
+        CHECK(-1 != child, -1);
+        CHECK(addChild(node, child), -1);
+    }
+    return node;
+}
+
+int SequenceRegExpCompiler::parseRepeat() {
+    int node = parseAtom();
+    while (-1 != node && !atEnd()) {
+        int minCount = 0;
+        int maxCount = -1;
+        const char c = pattern[pos];
+        if ('*' == c) {
+            pos++;
+        } else if ('+' == c) {
+            pos++;
+            minCount = 1;
+        } else if ('?' == c) {
+            pos++;
+            maxCount = 1;
+        } else if ('{' == c) {
+            pos++;
+            CHECK(parseCounts(minCount, maxCount), -1);
+        } else {
+            break;
+        }
+
+        const int repeat = addNode(Node_Repeat);
+        nodes[repeat].minCount = minCount;
+        nodes[repeat].maxCount = maxCount;
+        CHECK(addChild(repeat, node), -1);
+        node = repeat;
+    }
+    return node;
+}
+
+int SequenceRegExpCompiler::parseAtom() {
+    const char c = pattern[pos++];
+    SymbolSet symbols;
+    switch (c) {
+    case '(': {
+        if (!atEnd() && '?' == pattern[pos]) {
+            CHECK_EXT(pos + 1 < pattern.size() && ':' == pattern[pos + 1], setError("Assertions are not supported"), -1);
+            pos += 2;
+        }
+        CHECK_EXT(++groupDepth <= MAX_NODE_DEPTH, setError("Too many nested groups"), -1);
+        const int node = parseAlternatives();
+        CHECK(-1 != node, -1);
+        CHECK_EXT(!atEnd() && ')' == pattern[pos], setError("Missing ')'"), -1);
+        pos++;
+        groupDepth--;
+        return node;
+    }
+    case '*':
+    case '+':
+    case '?':
+    case '{':
+        setError("Nothing to repeat");
+        return -1;
+    case '[':
+        return parseClass();
+    case '.':
+        symbols.addRange(0, BYTES_COUNT - 1);
+        break;
+    case '^':
+        symbols.add(BOS_SYMBOL);
+        break;
+    case '$':
+        symbols.add(EOS_SYMBOL);
+        break;
+    case '\\': {
+        int symbol = -1;
+        CHECK(parseEscape(symbols, symbol), -1);
+        if (-1 != symbol) {
+            symbols.add(symbol);
+        }
+        break;
+    }
+    default:
+        symbols.add(uchar(c));
+        break;
+    }
+    return addSymbolsNode(symbols);
+}
+
+int SequenceRegExpCompiler::parseClass() {
+    SymbolSet symbols;
+    bool negated = false;
+    if (!atEnd() && '^' == pattern[pos]) {
+        negated = true;
+        pos++;
+    }
+
+    // ']' is a usual character at the beginning of the class
+    bool first = true;
+    forever {
+        CHECK_EXT(!atEnd(), setError("Missing ']'"), -1);
+        if (']' == pattern[pos] && !first) {
+            pos++;
+            break;
+        }
+        first = false;
+
+        int low = uchar(pattern[pos++]);
+        if ('\\' == low) {
+            CHECK(parseEscape(symbols, low), -1);
+            CHECK_OPERATION(-1 != low, continue);
+        }
+
+        if (pos + 1 < pattern.size() && '-' == pattern[pos] && ']' != pattern[pos + 1]) {
+            pos++;
+            int high = uchar(pattern[pos++]);
+            if ('\\' == high) {
+                SymbolSet escaped;
+                CHECK(parseEscape(escaped, high), -1);
+                CHECK_EXT(-1 != high, setError("Invalid character range"), -1);
+            }
+            CHECK_EXT(low <= high, setError("Invalid character range"), -1);
+            symbols.addRange(low, high);
+        } else {
+            symbols.add(low);
+        }
+    }
+
+    if (negated) {
+        symbols.invertBytes();
+    }
+    return addSymbolsNode(symbols);
+}
+
+bool SequenceRegExpCompiler::parseEscape(SymbolSet &symbols, int &symbol) {
+    CHECK_EXT(!atEnd(), setError("Unfinished escape sequence"), false);
+    const char c = pattern[pos++];
+    symbol = -1;
+
+    SymbolSet escaped;
+    switch (c) {
+    case 'd':
+    case 'D':
+        escaped.addRange('0', '9');
+        break;
+    case 's':
+    case 'S':
+        escaped.add(' ');
+        escaped.addRange('\t', '\r');
+        break;
+    case 'w':
+    case 'W':
+        escaped.addRange('0', '9');
+        escaped.addRange('A', 'Z');
+        escaped.addRange('a', 'z');
+        escaped.add('_');
+        break;
+    case 'a':
+        symbol = '\a';
+        return true;
+    case 'f':
+        symbol = '\f';
+        return true;
+    case 'n':
+        symbol = '\n';
+        return true;
+    case 'r':
+        symbol = '\r';
+        return true;
+    case 't':
+        symbol = '\t';
+        return true;
+    case 'v':
+        symbol = '\v';
+        return true;
+    case 'x': {
+        int value = 0;
+        int digits = 0;
+        for (; digits < 4 && !atEnd() && isHexDigit(pattern[pos]); digits++) {
+            value = value * 16 + hexDigitValue(pattern[pos++]);
+        }
+        CHECK_EXT(digits > 0 && value < BYTES_COUNT, setError("Invalid hexadecimal escape sequence"), false);
+        symbol = value;
+        return true;
+    }
+    case '0': {
+        int value = 0;
+        for (int digits = 0; digits < 3 && !atEnd() && pattern[pos] >= '0' && pattern[pos] <= '7'; digits++) {
+            value = value * 8 + (pattern[pos++] - '0');
+        }
+        CHECK_EXT(value < BYTES_COUNT, setError("Invalid octal escape sequence"), false);
+        symbol = value;
+        return true;
+    }
+    default:
+        // back references, word boundaries and the other letters
+        CHECK_EXT(!isAlphaNumeric(c), setError(QString("Unsupported escape sequence '\\%1'").arg(c)), false);
+        symbol = uchar(c);
+        return true;
+    }
+
+    if ('D' == c || 'S' == c || 'W' == c) {
+        escaped.invertBytes();
+    }
+    symbols.unite(escaped);
+    return true;
+}
+
+bool SequenceRegExpCompiler::parseCounts(int &minCount, int &maxCount) {
+    const bool hasMinCount = parseNumber(minCount);
+    if (!atEnd() && ',' == pattern[pos]) {
+        pos++;
+        int count = 0;
+        maxCount = parseNumber(count) ? count : -1;
+    } else {
+        CHECK_EXT(hasMinCount, setError("Invalid quantifier"), false);
+        maxCount = minCount;
+    }
+    CHECK_EXT(!atEnd() && '}' == pattern[pos], setError("Invalid quantifier"), false);
+    pos++;
+    CHECK_EXT(-1 == maxCount || minCount <= maxCount, setError("Invalid quantifier"), false);
+    CHECK_EXT(minCount <= MAX_REPEAT_COUNT && maxCount <= MAX_REPEAT_COUNT, setError("Too large quantifier"), false);
+    return true;
+}
+
+bool SequenceRegExpCompiler::parseNumber(int &number) {
+    number = 0;
+    const int start = pos;
+    while (!atEnd() && pattern[pos] >= '0' && pattern[pos] <= '9') {
+        number = qMin(number * 10 + (pattern[pos++] - '0'), MAX_REPEAT_COUNT + 1);
+    }
+    return pos > start;
+}
+
+bool SequenceRegExpCompiler::atEnd() const {
+    return pos >= pattern.size();
+}
+
+void SequenceRegExpCompiler::setError(const QString &message) {
+    re.error = QString("%1 at position %2 of the regular expression").arg(message).arg(pos);
+}
+
+int SequenceRegExpCompiler::addNode(NodeType type, int symbolSet) {
+    Node node;
+    node.type = type;
+    node.symbolSet = symbolSet;
+    node.minCount = 0;
+    node.maxCount = -1;
+    node.depth = 0;
+    nodes.append(node);
+    return nodes.size() - 1;
+}
+
+int SequenceRegExpCompiler::addSymbolsNode(const SymbolSet &symbols) {
+    const int symbolSet = re.symbolSets.size() / SYMBOL_SET_WORDS;
+    re.symbolSets.resize(re.symbolSets.size() + SYMBOL_SET_WORDS);
+    std::copy(symbols.words, symbols.words + SYMBOL_SET_WORDS, re.symbolSets.data() + symbolSet * SYMBOL_SET_WORDS);
+    return addNode(Node_Symbols, symbolSet);
+}
+
+bool SequenceRegExpCompiler::addChild(int node, int child) {
+    Node &parent = nodes[node];
+    parent.children.append(child);
+    parent.depth = qMax(parent.depth, nodes[child].depth + 1);
+    CHECK_EXT(parent.depth <= MAX_NODE_DEPTH, setError("The regular expression is too complex"), false);
+    return true;
+}
+
+int SequenceRegExpCompiler::buildNfa(int node, int next, bool reverse) {
+    CHECK(!isNfaTooLarge(), next);
+    const Node &n = nodes[node];
+    switch (n.type) {
+    case Node_Symbols:
+        return addNfaState(SequenceRegExp::NfaState_Symbols, next, -1, n.symbolSet);
+    case Node_Concatenation: {
+        const int count = n.children.size();
+        for (int i = 0; i < count; i++) {
+            next = buildNfa(n.children[reverse ? i : count - 1 - i], next, reverse);
+        }
+        return next;
+    }
+    case Node_Alternatives: {
+        int start = buildNfa(n.children.last(), next, reverse);
+        for (int i = n.children.size() - 2; i >= 0; i--) {
+            const int alternative = buildNfa(n.children[i], next, reverse);
+            start = addNfaState(SequenceRegExp::NfaState_Split, alternative, start, -1);
+        }
+        return start;
+    }
+    case Node_Repeat: {
+        const int child = n.children.first();
+        int start = next;
+        if (-1 == n.maxCount) {
+            const int loop = addNfaState(SequenceRegExp::NfaState_Split, -1, next, -1);
+            const int body = buildNfa(child, loop, reverse);
+            re.nfa[loop].out = body;
+            start = loop;
+        } else {
+            // the optional repetitions are nested: (x(x)?)?
+            for (int i = n.minCount; i < n.maxCount && !isNfaTooLarge(); i++) {
+                const int body = buildNfa(child, start, reverse);
+                start = addNfaState(SequenceRegExp::NfaState_Split, body, next, -1);
+            }
+        }
+        for (int i = 0; i < n.minCount && !isNfaTooLarge(); i++) {
+            start = buildNfa(child, start, reverse);
+        }
+        return start;
+    }
+    }
+    FAIL("Unexpected regular expression node", next);
+}
+
+int SequenceRegExpCompiler::addNfaState(SequenceRegExp::NfaStateType type, int out, int out1, int symbolSet) {
+    SequenceRegExp::NfaState state;
+    state.type = type;
+    state.out = out;
+    state.out1 = out1;
+    state.symbolSet = symbolSet;
+    re.nfa.append(state);
+    return re.nfa.size() - 1;
+}
+
+bool SequenceRegExpCompiler::isNfaTooLarge() const {
+    return re.nfa.size() > MAX_NFA_STATES;
+}
+
+/************************************************************************/
+/* SequenceRegExp */
+/************************************************************************/
+SequenceRegExp::SequenceRegExp(const QByteArray &pattern)
+    : forwardStart(-1), reverseStart(-1), classesCount(0), closureGeneration(0)
+{
+    SequenceRegExpCompiler compiler(*this, pattern);
+    CHECK(compiler.compile(), );
+
+    initSymbolClasses();
+    closureMarks.fill(0, nfa.size());
+    initDfa(forwardDfa, forwardStart, BOS_SYMBOL);
+    initDfa(reverseDfa, reverseStart, EOS_SYMBOL);
+    buildFullDfa(forwardDfa);
+    buildFullDfa(reverseDfa);
+}
+
+bool SequenceRegExp::isValid() const {
+    return error.isEmpty();
+}
+
+const QString & SequenceRegExp::getError() const {
+    return error;
+}
+
+void SequenceRegExp::findAll(const char *seq, int seqLen, int maxMatchLength, SequenceRegExpListener *listener, const int &stopFlag) {
+    SAFE_POINT(isValid(), "Invalid regular expression", );
+    SAFE_POINT(NULL != listener, "Regular expression listener is NULL", );
+    CHECK(seqLen > 0 && maxMatchLength > 0, );
+
+    QBitArray starts;
+    findMatchStarts(seq, seqLen, starts, stopFlag);
+
+    QVector<int> lengths;
+    for (int i = 0; i < seqLen && 0 == stopFlag; i++) {
+        CHECK_OPERATION(starts.testBit(i), continue);
+        getMatchLengths(seq, seqLen, i, maxMatchLength, lengths);
+        for (int j = lengths.size() - 1; j >= 0; j--) {
+            listener->onMatch(i, lengths[j]);
+        }
+    }
+}
+
+void SequenceRegExp::findMatchStarts(const char *seq, int seqLen, QBitArray &starts, const int &stopFlag) {
+    starts = QBitArray(seqLen);
+    const int *classes = symbolClasses.constData();
+    const int bosClass = classes[BOS_SYMBOL];
+
+    // the reversed expression is matched backwards: a match ends at a start of the expression match
+    int state = reverseDfa.boundaryStartState;
+    for (int i = seqLen - 1; i >= 0; i--) {
+        CHECK(0 != i % STOP_FLAG_CHECK_PERIOD || 0 == stopFlag, );
+        state = getNextState(reverseDfa, state, classes[uchar(seq[i])]);
+        if (reverseDfa.accepting.at(state) || (0 == i && reverseDfa.accepting.at(getNextState(reverseDfa, state, bosClass)))) {
+            starts.setBit(i);
+        }
+    }
+}
+
+void SequenceRegExp::getMatchLengths(const char *seq, int seqLen, int startPos, int maxMatchLength, QVector<int> &lengths) {
+    lengths.clear();
+    const int *classes = symbolClasses.constData();
+    const int eosClass = classes[EOS_SYMBOL];
+    const int endPos = int(qMin(qint64(seqLen), qint64(startPos) + maxMatchLength));
+
+    int state = 0 == startPos ? forwardDfa.boundaryStartState : START_STATE;
+    for (int i = startPos; i < endPos; i++) {
+        state = getNextState(forwardDfa, state, classes[uchar(seq[i])]);
+        CHECK_BREAK(DEAD_STATE != state);
+        if (forwardDfa.accepting.at(state) || (i + 1 == seqLen && forwardDfa.accepting.at(getNextState(forwardDfa, state, eosClass)))) {
+            lengths.append(i - startPos + 1);
+        }
+    }
+}
+
+void SequenceRegExp::initSymbolClasses() {
+    // the symbols that belong to the same sets are not distinguished by the automaton
+    const int setsCount = symbolSets.size() / SYMBOL_SET_WORDS;
+    QHash<QByteArray, int> classIds;
+    symbolClasses.resize(SYMBOLS_COUNT);
+    for (int symbol = 0; symbol < SYMBOLS_COUNT; symbol++) {
+        QByteArray signature(setsCount, 0);
+        for (int set = 0; set < setsCount; set++) {
+            signature[set] = containsSymbol(set, symbol) ? 1 : 0;
+        }
+        int classId = classIds.value(signature, -1);
+        if (-1 == classId) {
+            classId = classSymbols.size();
+            classIds.insert(signature, classId);
+            classSymbols.append(symbol);
+        }
+        symbolClasses[symbol] = classId;
+    }
+    classesCount = classSymbols.size();
+}
+
+void SequenceRegExp::initDfa(Dfa &dfa, int nfaStart, int boundarySymbol) {
+    dfa.pinnedStatesCount = 0;
+    dfa.cacheClearsCount = 0;
+    getDfaState(dfa, QVector<int>());
+    getDfaState(dfa, getClosure(QVector<int>() << nfaStart));
+    const int afterBoundary = getNextState(dfa, START_STATE, symbolClasses[boundarySymbol]);
+    dfa.boundaryStartState = getUnionState(dfa, START_STATE, afterBoundary);
+    dfa.pinnedStatesCount = dfa.stateSets.size();
+}
+
+void SequenceRegExp::buildFullDfa(Dfa &dfa) {
+    qint64 work = 0;
+    for (int state = 0; state < dfa.stateSets.size(); state++) {
+        CHECK(dfa.stateSets.size() <= MAX_FULL_DFA_STATES && work <= MAX_FULL_DFA_WORK, );
+        work += qint64(dfa.stateSets[state].size()) * classesCount;
+        for (int symbolClass = 0; symbolClass < classesCount; symbolClass++) {
+            getNextState(dfa, state, symbolClass);
+        }
+    }
+}
+
+int SequenceRegExp::buildTransition(Dfa &dfa, int state, int symbolClass) {
+    const int symbol = classSymbols[symbolClass];
+    QVector<int> nextNfaStates;
+    foreach (int nfaState, dfa.stateSets[state]) {
+        const NfaState &s = nfa[nfaState];
+        if (NfaState_Symbols == s.type && containsSymbol(s.symbolSet, symbol)) {
+            nextNfaStates.append(s.out);
+        }
+    }
+
+    const int cacheClearsCount = dfa.cacheClearsCount;
+    const int next = getDfaState(dfa, getClosure(nextNfaStates));
+    // the state has another id if the cache has been cleared
+    if (cacheClearsCount == dfa.cacheClearsCount || state < dfa.pinnedStatesCount) {
+        dfa.transitions[state * classesCount + symbolClass] = next;
+    }
+    return next;
+}
+
+int SequenceRegExp::getUnionState(Dfa &dfa, int state1, int state2) {
+    const QVector<int> nfaStates1 = dfa.stateSets[state1];
+    const QVector<int> nfaStates2 = dfa.stateSets[state2];
+    QVector<int> nfaStates(nfaStates1.size() + nfaStates2.size());
+    QVector<int>::iterator end = std::set_union(nfaStates1.constBegin(), nfaStates1.constEnd(),
+                                                nfaStates2.constBegin(), nfaStates2.constEnd(), nfaStates.begin());
+    nfaStates.resize(int(end - nfaStates.begin()));
+    return getDfaState(dfa, nfaStates);
+}
+
+int SequenceRegExp::getDfaState(Dfa &dfa, const QVector<int> &nfaStates) {
+    const QByteArray key = getStateKey(nfaStates);
+    const int existing = dfa.stateIds.value(key, -1);
+    CHECK(-1 == existing, existing);
+
+    if (dfa.stateSets.size() >= MAX_CACHED_DFA_STATES) {
+        clearDfaCache(dfa);
+    }
+
+    bool accepting = false;
+    foreach (int nfaState, nfaStates) {
+        accepting = accepting || NfaState_Match == nfa[nfaState].type;
+    }
+
+    const int id = dfa.stateSets.size();
+    dfa.stateIds.insert(key, id);
+    dfa.stateSets.append(nfaStates);
+    dfa.accepting.append(accepting);
+    dfa.transitions.insert(dfa.transitions.size(), classesCount, -1);
+    return id;
+}
+
+void SequenceRegExp::clearDfaCache(Dfa &dfa) {
+    dfa.cacheClearsCount++;
+    dfa.stateSets.resize(dfa.pinnedStatesCount);
+    dfa.accepting.resize(dfa.pinnedStatesCount);
+    dfa.transitions.fill(-1, dfa.pinnedStatesCount * classesCount);
+    dfa.stateIds.clear();
+    for (int i = 0; i < dfa.pinnedStatesCount; i++) {
+        dfa.stateIds.insert(getStateKey(dfa.stateSets[i]), i);
+    }
+}
+
+QVector<int> SequenceRegExp::getClosure(const QVector<int> &nfaStates) {
+    if (INT_MAX == closureGeneration) {
+        closureMarks.fill(0);
+        closureGeneration = 0;
+    }
+    closureGeneration++;
+
+    // only the states with symbols and the match state are kept: the split states do not make the DFA states differ
+    QVector<int> result;
+    QVector<int> stack = nfaStates;
+    while (!stack.isEmpty()) {
+        const int nfaState = stack.last();
+        stack.resize(stack.size() - 1);
+        CHECK_OPERATION(closureGeneration != closureMarks[nfaState], continue);
+        closureMarks[nfaState] = closureGeneration;
+
+        const NfaState &s = nfa[nfaState];
+        if (NfaState_Split == s.type) {
+            stack.append(s.out1);
+            stack.append(s.out);
+        } else {
+            result.append(nfaState);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool SequenceRegExp::containsSymbol(int symbolSet, int symbol) const {
+    return 0 != (symbolSets[symbolSet * SYMBOL_SET_WORDS + symbol / 64] & (Q_UINT64_C(1) << (symbol % 64)));
+}
+
+}   // namespace U2
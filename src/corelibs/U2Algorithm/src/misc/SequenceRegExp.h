@@ -0,0 +1,144 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_SEQUENCE_REG_EXP_H_
+#define _U2_SEQUENCE_REG_EXP_H_
+
+#include <QBitArray>
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <U2Core/global.h>
+
+namespace U2 {
+
+class U2ALGORITHM_EXPORT SequenceRegExpListener {
+public:
+    virtual ~SequenceRegExpListener() {}
+
+    /** 'startPos' is relative to the searched sequence part, 'length' is greater than 0 */
+    virtual void onMatch(int startPos, int length) = 0;
+};
+
+/**
+ * Regular expression search in raw sequence data.
+ * The expression is compiled to a DFA over the classes of the bytes it can distinguish,
+ * if the DFA has too many states they are built lazily while the sequence is scanned.
+ *
+ * The supported syntax is the part of the QRegExp syntax that describes sequences:
+ * characters, '.', character classes and ranges, '\d \D \s \S \w \W \xhh' escapes, groups, alternatives,
+ * quantifiers and the '^' and '$' anchors that match at the boundaries of the searched sequence part.
+ * Back references and assertions are not supported: isValid() returns false for them.
+ */
+class U2ALGORITHM_EXPORT SequenceRegExp {
+    friend class SequenceRegExpCompiler;
+public:
+    SequenceRegExp(const QByteArray &pattern);
+
+    bool isValid() const;
+
+    const QString & getError() const;
+
+    /**
+     * Reports all nonempty matches of at most 'maxMatchLength' characters, including overlapping ones:
+     * in the order of their start positions, the longer matches go first for the same start position.
+     * The sequence is scanned backwards once to find the match starts, then the matches are verified
+     * from these positions only.
+     */
+    void findAll(const char *seq, int seqLen, int maxMatchLength, SequenceRegExpListener *listener, const int &stopFlag);
+
+    static const int MAX_FULL_DFA_STATES;
+    static const int MAX_CACHED_DFA_STATES;
+
+private:
+    enum NfaStateType {
+        NfaState_Symbols,
+        NfaState_Split,
+        NfaState_Match
+    };
+
+    struct NfaState {
+        NfaStateType type;
+        int out;
+        int out1;
+        int symbolSet;
+    };
+
+    struct Dfa {
+        // 'classesCount' next states for each state, -1 if the transition is not built yet
+        QVector<int> transitions;
+        // sorted NFA states: the states with symbols and the match state only
+        QVector< QVector<int> > stateSets;
+        QVector<bool> accepting;
+        QHash<QByteArray, int> stateIds;
+        // the start states are not removed when the cache is cleared
+        int pinnedStatesCount;
+        int cacheClearsCount;
+        // the start state followed by the optional boundary symbol
+        int boundaryStartState;
+    };
+
+    void initSymbolClasses();
+    void initDfa(Dfa &dfa, int nfaStart, int boundarySymbol);
+    void buildFullDfa(Dfa &dfa);
+
+    int getNextState(Dfa &dfa, int state, int symbolClass) {
+        const int next = dfa.transitions.constData()[state * classesCount + symbolClass];
+        return -1 != next ? next : buildTransition(dfa, state, symbolClass);
+    }
+    int buildTransition(Dfa &dfa, int state, int symbolClass);
+    int getUnionState(Dfa &dfa, int state1, int state2);
+    int getDfaState(Dfa &dfa, const QVector<int> &nfaStates);
+    void clearDfaCache(Dfa &dfa);
+    QVector<int> getClosure(const QVector<int> &nfaStates);
+    bool containsSymbol(int symbolSet, int symbol) const;
+
+    void findMatchStarts(const char *seq, int seqLen, QBitArray &starts, const int &stopFlag);
+    void getMatchLengths(const char *seq, int seqLen, int startPos, int maxMatchLength, QVector<int> &lengths);
+
+    QString error;
+
+    // 256 bytes and 2 boundary symbols, SYMBOL_SET_WORDS words for each set
+    QVector<quint64> symbolSets;
+    QVector<NfaState> nfa;
+    int forwardStart;
+    // the reversed expression preceded by any characters
+    int reverseStart;
+
+    QVector<int> symbolClasses;
+    QVector<int> classSymbols;
+    int classesCount;
+
+    Dfa forwardDfa;
+    Dfa reverseDfa;
+
+    QVector<int> closureMarks;
+    int closureGeneration;
+
+    Q_DISABLE_COPY(SequenceRegExp)
+};
+
+}   // namespace U2
+
+#endif // _U2_SEQUENCE_REG_EXP_H_
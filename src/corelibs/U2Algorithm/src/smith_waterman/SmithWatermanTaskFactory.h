@@ -32,6 +32,15 @@ class SmithWatermanTaskFactory {            //for ADV search only
 public:
     virtual Task* getTaskInstance(const SmithWatermanSettings& config,
                                   const QString& taskName) const = 0;
+    // Searches all patterns of @configs in one sequence walking it once per batch.
+    // The settings must differ only in patterns, result listeners and callbacks.
+    // Returns NULL if the realization does not support batches, use getTaskInstance() then.
+    virtual Task* getBatchTaskInstance(const QList<SmithWatermanSettings>& configs,
+                                       const QString& taskName) const {
+        Q_UNUSED(configs);
+        Q_UNUSED(taskName);
+        return NULL;
+    }
     virtual bool hasAdvancedSettings() const { return false; }
     virtual void execAdvancedDialog() {}
     virtual ~SmithWatermanTaskFactory() {}
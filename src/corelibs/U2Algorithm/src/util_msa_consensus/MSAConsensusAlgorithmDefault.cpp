@@ -22,6 +22,7 @@
 #include "MSAConsensusAlgorithmDefault.h"
 
 #include <U2Core/MAlignment.h>
+#include <QtCore/QVarLengthArray>
 #include <QtCore/QVector>
 
 namespace U2 {
@@ -53,10 +54,10 @@ char MSAConsensusAlgorithmDefault::getConsensusCharAndScore(const MAlignment& ms
     //TODO: use var-length array!
     QVector<QPair<int, char> > freqs(32);
     int ch = MAlignment_GapChar;
-    int nSeq = seqIdx.isEmpty() ? msa.getNumRows() : seqIdx.size();
+    QVarLengthArray<char, 1024> columnChars(seqIdx.isEmpty() ? msa.getNumRows() : seqIdx.size());
+    int nSeq = msa.getColumn(pos, columnChars.data(), seqIdx);
     for (int seq = 0; seq < nSeq; seq++) {
-        uchar c = (uchar)msa.charAt( seqIdx.isEmpty() ? seq : seqIdx[ seq ],
-                                     pos);
+        uchar c = (uchar)columnChars[seq];
         if (c >= 'A' && c <= 'Z') {
             int idx = c - 'A';
             assert(idx >=0 && idx <= freqs.size());
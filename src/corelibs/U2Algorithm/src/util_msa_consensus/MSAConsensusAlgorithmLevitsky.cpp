@@ -123,10 +123,12 @@ MSAConsensusAlgorithmLevitsky::MSAConsensusAlgorithmLevitsky(MSAConsensusAlgorit
 
     int* freqsData = globalFreqs.data();
     int len = ma.getLength();
-    foreach (const MAlignmentRow& row, ma.getRows()) {
+    QByteArray rowData;
+    for (int rowIndex = 0, nRows = ma.getNumRows(); rowIndex < nRows; rowIndex++) {
+        ma.getRowSlice(rowIndex, U2Region(0, len), rowData);
+        const char* rowChars = rowData.constData();
         for (int i = 0; i < len; i++) {
-            char c = row.charAt(i);
-            registerHit(freqsData, c);
+            registerHit(freqsData, rowChars[i]);
         }
     }
 }
@@ -138,10 +140,10 @@ char MSAConsensusAlgorithmLevitsky::getConsensusChar(const MAlignment& msa, int
     memset(localFreqs.data(), 0, localFreqs.size() * 4);
 
     int* freqsData = localFreqs.data();
-    int nSeq =( seqIdx.isEmpty() ? msa.getNumRows() : seqIdx.size());
+    QVarLengthArray<char, 1024> columnChars(seqIdx.isEmpty() ? msa.getNumRows() : seqIdx.size());
+    int nSeq = msa.getColumn(column, columnChars.data(), seqIdx);
     for (int seq = 0; seq < nSeq; seq++) {
-        char c = msa.charAt( seqIdx.isEmpty() ? seq : seqIdx [seq] , column);
-        registerHit(freqsData, c);
+        registerHit(freqsData, columnChars[seq]);
     }
 
     //find all symbols with freq > threshold, select one with the lowest global freq
@@ -24,6 +24,7 @@
 
 #include <U2Core/MAlignment.h>
 
+#include <QtCore/QVarLengthArray>
 #include <QtCore/QVector>
 #include <QtCore/QPair>
 
@@ -133,10 +134,10 @@ uchar MSAConsensusUtils::getColumnFreqs(const MAlignment& ma, int pos, QVector<i
     uchar maxC = 0;
     int  maxCFreq = 0;
     int* freqs = freqsByChar.data();
-    int nSeq = seqIdx.isEmpty() ? ma.getNumRows() : seqIdx.size();
-    for (qint64 seq = 0; seq < nSeq; seq++) {
-        uchar c = (uchar)ma.charAt( seqIdx.isEmpty() ? seq : seqIdx[ seq ],
-                                    pos);
+    QVarLengthArray<char, 1024> columnChars(seqIdx.isEmpty() ? ma.getNumRows() : seqIdx.size());
+    int nSeq = ma.getColumn(pos, columnChars.data(), seqIdx);
+    for (int seq = 0; seq < nSeq; seq++) {
+        uchar c = (uchar)columnChars[seq];
         freqs[c]++;
         if (c!=MAlignment_GapChar && freqs[c] > maxCFreq) {
             maxCFreq = freqs[c];
@@ -152,9 +153,10 @@ uchar MSAConsensusUtils::getColumnFreqs(const MAlignment& ma, int pos, QVector<i
 quint32 MSAConsensusUtils::packConsensusCharsToInt(const MAlignment& msa, int pos, const int* mask4, bool gapsAffectPercents) {
     QVector<QPair<int, char> > freqs(32);
     int numNoGaps = 0;
-    int nSeq = msa.getNumRows();
+    QVarLengthArray<char, 1024> columnChars(msa.getNumRows());
+    int nSeq = msa.getColumn(pos, columnChars.data());
     for (int seq = 0; seq < nSeq; seq++) {
-        uchar c = (uchar)msa.charAt(seq, pos);
+        uchar c = (uchar)columnChars[seq];
         if (c >= 'A' && c <= 'Z') {
             int idx = c - 'A';
             freqs[idx].first++;
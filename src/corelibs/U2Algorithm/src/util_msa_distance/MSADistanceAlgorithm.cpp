@@ -21,7 +21,10 @@
 
 #include "MSADistanceAlgorithm.h"
 
+#include <U2Core/AppContext.h>
+#include <U2Core/AppSettings.h>
 #include <U2Core/DNAAlphabet.h>
+#include <U2Core/U2SafePoints.h>
 
 namespace U2 {
 
@@ -57,7 +60,7 @@ void MSADistanceAlgorithmFactory::resetFlag( DistanceAlgorithmFlag flag ){
 // Algorithm
 
 MSADistanceAlgorithm::MSADistanceAlgorithm(MSADistanceAlgorithmFactory* _factory, const MAlignment& _ma)
-: Task(tr("MSA distance algorithm \"%1\" task").arg(_factory->getName()), TaskFlag_None)
+: Task(tr("MSA distance algorithm \"%1\" task").arg(_factory->getName()), TaskFlags_FOSCOE)
 , factory(_factory)
 , ma(_ma)
 , excludeGaps(true)
@@ -112,6 +115,142 @@ void MSADistanceAlgorithm::fillTable() {
     }
 }
 
+const int MSADistanceAlgorithm::TILE_ROWS = 32;
+
+struct MSADistanceTilesContext {
+    MSADistanceTilesContext(MSADistanceBitsetEngine* engine, MSADistanceBitsetEngine::Measure measure)
+        : engine(engine), measure(measure) {}
+
+    QScopedPointer<MSADistanceBitsetEngine> engine;
+    MSADistanceBitsetEngine::Measure    measure;
+    // tile (first row tile, second row tile), the second tile is not less than the first one
+    QVector< QPair<int, int> >          tiles;
+    QAtomicInt                          nextTile;
+    QAtomicInt                          processedTiles;
+};
+
+// Builds the engine of the algorithm
+class MSADistanceEngineTask : public Task {
+public:
+    MSADistanceEngineTask(MSADistanceAlgorithm* algorithm)
+        : Task(MSADistanceAlgorithm::tr("Prepare the distance matrix rows"), TaskFlag_None), algorithm(algorithm), engine(NULL),
+          measure(MSADistanceBitsetEngine::Measure_Matches) {}
+    ~MSADistanceEngineTask() {
+        delete engine;
+    }
+
+    void run() {
+        engine = algorithm->createEngine(measure, stateInfo);
+    }
+
+    MSADistanceBitsetEngine* takeEngine() {
+        MSADistanceBitsetEngine* result = engine;
+        engine = NULL;
+        return result;
+    }
+
+    MSADistanceBitsetEngine::Measure getMeasure() const {
+        return measure;
+    }
+
+private:
+    MSADistanceAlgorithm*               algorithm;
+    MSADistanceBitsetEngine*            engine;
+    MSADistanceBitsetEngine::Measure    measure;
+};
+
+// Takes the tiles of the context one by one until they are over
+class MSADistanceTilesTask : public Task {
+public:
+    MSADistanceTilesTask(MSADistanceAlgorithm* algorithm, MSADistanceTilesContext& context)
+        : Task(MSADistanceAlgorithm::tr("Fill the distance matrix tiles"), TaskFlag_None), algorithm(algorithm), context(context) {}
+
+    void run() {
+        algorithm->processTiles(context, stateInfo);
+    }
+
+private:
+    MSADistanceAlgorithm*       algorithm;
+    MSADistanceTilesContext&    context;
+};
+
+MSADistanceAlgorithm::~MSADistanceAlgorithm() {
+}
+
+void MSADistanceAlgorithm::prepare() {
+    addSubTask(new MSADistanceEngineTask(this));
+}
+
+QList<Task*> MSADistanceAlgorithm::onSubTaskFinished(Task* subTask) {
+    QList<Task*> result;
+    MSADistanceEngineTask* engineTask = dynamic_cast<MSADistanceEngineTask*>(subTask);
+    CHECK(NULL != engineTask, result);
+    CHECK(!isCanceled() && !hasError(), result);
+    MSADistanceBitsetEngine* engine = engineTask->takeEngine();
+    CHECK(NULL != engine, result);
+
+    tilesContext.reset(new MSADistanceTilesContext(engine, engineTask->getMeasure()));
+    const int tilesCount = (engine->getRowCount() + TILE_ROWS - 1) / TILE_ROWS;
+    for (int tile1 = 0; tile1 < tilesCount; tile1++) {
+        for (int tile2 = tile1; tile2 < tilesCount; tile2++) {
+            tilesContext->tiles << qMakePair(tile1, tile2);
+        }
+    }
+
+    // the scheduler decides how many of them run at the same time
+    const int tasksCount = qBound(1, AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount(), tilesContext->tiles.size());
+    for (int i = 0; i < tasksCount; i++) {
+        result << new MSADistanceTilesTask(this, *tilesContext);
+    }
+    return result;
+}
+
+void MSADistanceAlgorithm::run() {
+    CHECK(tilesContext.isNull(), );
+    fillTable();
+}
+
+MSADistanceBitsetEngine* MSADistanceAlgorithm::createEngine(MSADistanceBitsetEngine::Measure& , U2OpStatus& ) {
+    return NULL;
+}
+
+QList<QByteArray> MSADistanceAlgorithm::getPaddedRows(U2OpStatus& os) const {
+    QList<QByteArray> rows;
+    const int length = ma.getLength();
+    foreach (const MAlignmentRow& row, ma.getRows()) {
+        rows << row.toByteArray(length, os);
+        CHECK_OP(os, QList<QByteArray>());
+    }
+    return rows;
+}
+
+void MSADistanceAlgorithm::processTiles(MSADistanceTilesContext& context, U2OpStatus& os) {
+    const int nSeq = context.engine->getRowCount();
+    QVector<int> results(TILE_ROWS);
+    while (!os.isCanceled()) {
+        const int tile = context.nextTile.fetchAndAddRelaxed(1);
+        if (tile >= context.tiles.size()) {
+            break;
+        }
+        const int firstRow1 = context.tiles[tile].first * TILE_ROWS;
+        const int firstRow2 = context.tiles[tile].second * TILE_ROWS;
+        const int endRow1 = qMin(nSeq, firstRow1 + TILE_ROWS);
+        const int endRow2 = qMin(nSeq, firstRow2 + TILE_ROWS);
+        for (int i = firstRow1; i < endRow1; i++) {
+            const int firstColumn = qMax(i, firstRow2);
+            const int count = endRow2 - firstColumn;
+            if (count <= 0) {
+                continue;
+            }
+            context.engine->compare(i, firstColumn, count, context.measure, results.data());
+            QMutexLocker locker(&lock);
+            for (int j = 0; j < count; j++) {
+                setDistanceValue(i, firstColumn + j, results[j]);
+            }
+        }
+        stateInfo.setProgress(context.processedTiles.fetchAndAddRelaxed(1) * 100 / context.tiles.size());
+    }
+}
 
 MSADistanceMatrix::MSADistanceMatrix(const MSADistanceAlgorithm *algo, bool _usePercents)
 : distanceTable(algo->distanceTable), usePercents(_usePercents), excludeGaps(false) {
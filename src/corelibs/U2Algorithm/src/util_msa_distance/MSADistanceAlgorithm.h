@@ -27,6 +27,9 @@
 #include <U2Core/MAlignment.h>
 #include <QtCore/QVarLengthArray>
 #include <QtCore/QMutex>
+#include <QtCore/QScopedPointer>
+
+#include "MSADistanceBitsetEngine.h"
 
 namespace U2 {
 
@@ -34,6 +37,7 @@ class MAlignment;
 class MSADistanceAlgorithm;
 class DNAAlphabet;
 class MSADistanceMatrix;
+struct MSADistanceTilesContext;
 
 enum DistanceAlgorithmFlag {
     DistanceAlgorithmFlag_Nucleic = 1 << 0,
@@ -79,8 +83,17 @@ class U2ALGORITHM_EXPORT MSADistanceAlgorithm : public Task {
     Q_OBJECT
 
     friend class MSADistanceMatrix;
+    friend class MSADistanceEngineTask;
+    friend class MSADistanceTilesTask;
 public:
     MSADistanceAlgorithm(MSADistanceAlgorithmFactory* factory, const MAlignment& ma);
+    ~MSADistanceAlgorithm();
+
+    virtual void prepare();
+
+    virtual void run();
+
+    virtual QList<Task*> onSubTaskFinished(Task* subTask);
 
     int getSimilarity(int row1, int row2);
 
@@ -104,10 +117,21 @@ private:
     varLengthMatrix              distanceTable;
     MSADistanceAlgorithmFactory* factory;
     MemoryLocker                 memoryLocker;
+    QScopedPointer<MSADistanceTilesContext> tilesContext;
+
+    void processTiles(MSADistanceTilesContext& context, U2OpStatus& os);
 
 protected:
     virtual void fillTable();
+    // Returns the engine that fills the table or NULL if the table is filled by fillTable(). It is called in a subtask thread.
+    // The rows are split into tiles and the tiles are processed by several subtasks
+    virtual MSADistanceBitsetEngine* createEngine(MSADistanceBitsetEngine::Measure& measure, U2OpStatus& os);
+    // Returns the alignment rows padded with gaps to the alignment length
+    QList<QByteArray> getPaddedRows(U2OpStatus& os) const;
     virtual int calculateSimilarity(int , int ){return 0;}
+
+    static const int TILE_ROWS;
+
     MAlignment                                  ma;
     QMutex                                      lock;
     bool                                        excludeGaps;
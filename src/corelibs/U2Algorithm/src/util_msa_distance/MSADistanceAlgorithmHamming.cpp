@@ -22,6 +22,7 @@
 #include "MSADistanceAlgorithmHamming.h"
 
 #include <U2Core/MAlignment.h>
+#include <U2Core/U2SafePoints.h>
 
 namespace U2 {
 
@@ -54,29 +55,11 @@ MSADistanceAlgorithm* MSADistanceAlgorithmFactoryHamming::createAlgorithm(const
 //////////////////////////////////////////////////////////////////////////
 // Algorithm
 
-void MSADistanceAlgorithmHamming::run() {
-    int nSeq = ma.getNumRows();
-    for (int i = 0; i < nSeq; i++) {
-        for (int j = i; j < nSeq; j++) {
-            int sim = 0;
-            for (int k = 0; k < ma.getLength(); k++) {
-                if (isCanceled()) {
-                    return;
-                }
-                bool dissimilar = (ma.charAt(i, k) != ma.charAt(j, k));
-
-                if(!excludeGaps){
-                    if (dissimilar) sim++;
-                }else{
-                    if (dissimilar && (ma.charAt(i, k)!=MAlignment_GapChar && ma.charAt(j, k)!=MAlignment_GapChar)) sim++;
-                }
-            }
-            lock.lock();
-            setDistanceValue(i, j, sim);
-            lock.unlock();
-        }
-        stateInfo.setProgress(i * 100 / nSeq);
-    }
+MSADistanceBitsetEngine* MSADistanceAlgorithmHamming::createEngine(MSADistanceBitsetEngine::Measure& measure, U2OpStatus& os) {
+    QList<QByteArray> rows = getPaddedRows(os);
+    CHECK_OP_EXT(os, os.setError(tr("An unexpected error has occurred during running the Hamming algorithm.")), NULL);
+    measure = excludeGaps ? MSADistanceBitsetEngine::Measure_MismatchesExcludeGaps : MSADistanceBitsetEngine::Measure_Mismatches;
+    return new MSADistanceBitsetEngine(rows, QList<QByteArray>(), ma.getLength());
 }
 
 } //namespace
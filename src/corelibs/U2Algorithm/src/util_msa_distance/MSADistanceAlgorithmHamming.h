@@ -54,7 +54,8 @@ public:
     MSADistanceAlgorithmHamming(MSADistanceAlgorithmFactoryHamming* f, const MAlignment& ma)
         : MSADistanceAlgorithm(f, ma){ isSimilarity = false;}
 
-    virtual void run();
+protected:
+    virtual MSADistanceBitsetEngine* createEngine(MSADistanceBitsetEngine::Measure& measure, U2OpStatus& os);
 };
 
 }//namespace
@@ -25,7 +25,6 @@
 #include <U2Core/DNATranslation.h>
 #include <U2Core/MAlignment.h>
 #include <U2Core/TextUtils.h>
-#include <U2Core/U2OpStatusUtils.h>
 #include <U2Core/U2SafePoints.h>
 
 
@@ -54,48 +53,26 @@ MSADistanceAlgorithm* MSADistanceAlgorithmFactoryHammingRevCompl::createAlgorith
 //////////////////////////////////////////////////////////////////////////
 // Algorithm
 
-void MSADistanceAlgorithmHammingRevCompl::run() {
+MSADistanceBitsetEngine* MSADistanceAlgorithmHammingRevCompl::createEngine(MSADistanceBitsetEngine::Measure& measure, U2OpStatus& os) {
     DNATranslation* compTT = AppContext::getDNATranslationRegistry()->
         lookupComplementTranslation(ma.getAlphabet());
 
     assert (compTT != NULL);
 
     DNATranslation* trans = compTT ;
-    int nSeq = ma.getNumRows();
-    MAlignment revtransl;
-    revtransl.setAlphabet(ma.getAlphabet());
-    U2OpStatus2Log os;
-    for (int i = 0; i < nSeq; i++) {
-        if (isCanceled()) {
-            return;
-        }
-        QByteArray arr = ma.getRow(i).toByteArray(ma.getLength(), os);
+    QList<QByteArray> rows = getPaddedRows(os);
+    CHECK_OP_EXT(os, os.setError(tr("An unexpected error has occurred during running"
+                                     " the Hamming reverse-complement algorithm.")), NULL);
+    QList<QByteArray> revComplRows;
+    foreach (QByteArray arr, rows) {
+        CHECK(!os.isCanceled(), NULL);
         trans->translate(arr.data(), arr.length());
         TextUtils::reverse(arr.data(), arr.length());
-
-        revtransl.addRow(ma.getRow(i).getName(), arr, os);
-
-        CHECK_OP_EXT(os, setError(tr("An unexpected error has occurred during running"
-                                      " the Hamming reverse-complement algorithm.")),);
+        revComplRows << arr;
     }
 
-    for (int i = 0; i < nSeq; i++) {
-        for (int j = i; j < nSeq; j++) {
-            int sim = 0;
-            for (int k = 0; k < ma.getLength(); k++) {
-                if (isCanceled()) {
-                    return;
-                }
-                if (ma.charAt(i, k) == revtransl.charAt(j, k)) {
-                    sim++;
-                }
-            }
-            lock.lock();
-            setDistanceValue(i, j, sim);
-            lock.unlock();
-        }
-        stateInfo.setProgress(i * 100 / nSeq);
-    }
+    measure = MSADistanceBitsetEngine::Measure_Matches;
+    return new MSADistanceBitsetEngine(rows, revComplRows, ma.getLength());
 }
 
 } //namespace
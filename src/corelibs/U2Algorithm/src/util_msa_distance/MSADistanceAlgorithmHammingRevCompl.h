@@ -48,7 +48,8 @@ public:
     MSADistanceAlgorithmHammingRevCompl(MSADistanceAlgorithmFactoryHammingRevCompl* f, const MAlignment& ma)
         : MSADistanceAlgorithm(f, ma){}
 
-    virtual void run();
+protected:
+    virtual MSADistanceBitsetEngine* createEngine(MSADistanceBitsetEngine::Measure& measure, U2OpStatus& os);
 };
 
 }//namespace
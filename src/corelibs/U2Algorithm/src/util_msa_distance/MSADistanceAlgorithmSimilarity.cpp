@@ -22,6 +22,7 @@
 #include "MSADistanceAlgorithmSimilarity.h"
 
 #include <U2Core/MAlignment.h>
+#include <U2Core/U2SafePoints.h>
 
 namespace U2 {
 
@@ -54,30 +55,11 @@ MSADistanceAlgorithm* MSADistanceAlgorithmFactorySimilarity::createAlgorithm(con
 //////////////////////////////////////////////////////////////////////////
 // Algorithm
 
-void MSADistanceAlgorithmSimilarity::run() {
-    int nSeq = ma.getNumRows();
-    for (int i = 0; i < nSeq; i++) {
-        for (int j = i; j < nSeq; j++) {
-            int sim = 0;
-            for (int k = 0; k < ma.getLength(); k++) {
-                if (isCanceled()) {
-                    return;
-                }
-                bool similar = (ma.charAt(i, k) == ma.charAt(j, k));
-
-                if(!excludeGaps){
-                    if (similar) sim++;
-                }else{
-                    if (similar && ma.charAt(i, k)!=MAlignment_GapChar) sim++;
-                }
-
-            }
-            lock.lock();
-            setDistanceValue(i, j, sim);
-            lock.unlock();
-        }
-        stateInfo.setProgress(i * 100 / nSeq);
-    }
+MSADistanceBitsetEngine* MSADistanceAlgorithmSimilarity::createEngine(MSADistanceBitsetEngine::Measure& measure, U2OpStatus& os) {
+    QList<QByteArray> rows = getPaddedRows(os);
+    CHECK_OP_EXT(os, os.setError(tr("An unexpected error has occurred during running the similarity algorithm.")), NULL);
+    measure = excludeGaps ? MSADistanceBitsetEngine::Measure_MatchesExcludeGaps : MSADistanceBitsetEngine::Measure_Matches;
+    return new MSADistanceBitsetEngine(rows, QList<QByteArray>(), ma.getLength());
 }
 
 } //namespace
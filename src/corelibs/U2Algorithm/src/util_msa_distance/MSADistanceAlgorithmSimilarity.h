@@ -54,7 +54,8 @@ public:
     MSADistanceAlgorithmSimilarity(MSADistanceAlgorithmFactorySimilarity* f, const MAlignment& ma)
         : MSADistanceAlgorithm(f, ma){isSimilarity = true;}
 
-    virtual void run();
+protected:
+    virtual MSADistanceBitsetEngine* createEngine(MSADistanceBitsetEngine::Measure& measure, U2OpStatus& os);
 };
 
 }//namespace
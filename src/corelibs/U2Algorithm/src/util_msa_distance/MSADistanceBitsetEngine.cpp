@@ -0,0 +1,155 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QtCore/QtAlgorithms>
+
+#include <U2Core/MAlignment.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "MSADistanceBitsetEngine.h"
+
+namespace U2 {
+
+static void collectChars(const QList<QByteArray>& rows, QVector<qint16>& charCodes, int& lastCode) {
+    foreach (const QByteArray& row, rows) {
+        const char* data = row.constData();
+        for (int i = 0, n = row.length(); i < n; i++) {
+            qint16& code = charCodes[uchar(data[i])];
+            if (code < 0) {
+                code = ++lastCode;
+            }
+        }
+    }
+}
+
+MSADistanceBitsetEngine::MSADistanceBitsetEngine(const QList<QByteArray>& rows, const QList<QByteArray>& columnRows, int _length)
+    : rowCount(rows.size()), length(_length), planesCount(0)
+{
+    SAFE_POINT(columnRows.isEmpty() || columnRows.size() == rows.size(), "Invalid number of column rows", );
+    wordsPerRow = (length + 63) / 64;
+    lastWordMask = length % 64 == 0 ? ~quint64(0) : (quint64(1) << (length % 64)) - 1;
+
+    charCodes.fill(-1, 256);
+    charCodes[uchar(MAlignment_GapChar)] = 0;
+    int lastCode = 0;
+    collectChars(rows, charCodes, lastCode);
+    collectChars(columnRows, charCodes, lastCode);
+    while ((1 << planesCount) <= lastCode) {
+        planesCount++;
+    }
+
+    packRows(rows, rowsData);
+    if (!columnRows.isEmpty()) {
+        packRows(columnRows, columnRowsData);
+    }
+}
+
+void MSADistanceBitsetEngine::packRows(const QList<QByteArray>& rows, QVector<quint64>& data) const {
+    // row layout: 'planesCount' code bit planes, then the gap plane
+    const int rowSize = (planesCount + 1) * wordsPerRow;
+    data.fill(0, rows.size() * rowSize);
+    quint64* rowData = data.data();
+    foreach (const QByteArray& row, rows) {
+        SAFE_POINT(row.length() == length, "Alignment row is not padded", );
+        const char* chars = row.constData();
+        quint64* gaps = rowData + planesCount * wordsPerRow;
+        for (int pos = 0; pos < length; pos++) {
+            const int code = charCodes[uchar(chars[pos])];
+            const quint64 bit = quint64(1) << (pos % 64);
+            const int word = pos / 64;
+            if (code == 0) {
+                gaps[word] |= bit;
+                continue;
+            }
+            for (int plane = 0; plane < planesCount; plane++) {
+                if (code & (1 << plane)) {
+                    rowData[plane * wordsPerRow + word] |= bit;
+                }
+            }
+        }
+        rowData += rowSize;
+    }
+}
+
+const quint64* MSADistanceBitsetEngine::getRowData(const QVector<quint64>& data, int row) const {
+    return data.constData() + qint64(row) * (planesCount + 1) * wordsPerRow;
+}
+
+int MSADistanceBitsetEngine::compare(int row1, int row2, Measure measure) const {
+    int result = 0;
+    compare(row1, row2, 1, measure, &result);
+    return result;
+}
+
+template <int measure>
+static int compareRowData(const quint64* data1, const quint64* data2, int planesCount, int wordsPerRow, quint64 lastWordMask) {
+    const quint64* gaps1 = data1 + planesCount * wordsPerRow;
+    const quint64* gaps2 = data2 + planesCount * wordsPerRow;
+    int result = 0;
+    for (int word = 0; word < wordsPerRow; word++) {
+        // the gap code is 0 and other codes are not, so equal planes mean equal chars
+        const quint64 valid = word + 1 == wordsPerRow ? lastWordMask : ~quint64(0);
+        quint64 equal = valid;
+        for (int plane = 0; plane < planesCount; plane++) {
+            const int idx = plane * wordsPerRow + word;
+            equal &= ~(data1[idx] ^ data2[idx]);
+        }
+        switch (measure) {
+        case MSADistanceBitsetEngine::Measure_Mismatches:
+            result += qPopulationCount(~equal & valid);
+            break;
+        case MSADistanceBitsetEngine::Measure_MismatchesExcludeGaps:
+            result += qPopulationCount(~equal & ~gaps1[word] & ~gaps2[word] & valid);
+            break;
+        case MSADistanceBitsetEngine::Measure_Matches:
+            result += qPopulationCount(equal);
+            break;
+        case MSADistanceBitsetEngine::Measure_MatchesExcludeGaps:
+            result += qPopulationCount(equal & ~gaps1[word]);
+            break;
+        }
+    }
+    return result;
+}
+
+void MSADistanceBitsetEngine::compare(int row1, int firstRow2, int count, Measure measure, int* results) const {
+    const quint64* data1 = getRowData(rowsData, row1);
+    const QVector<quint64>& data2Vector = columnRowsData.isEmpty() ? rowsData : columnRowsData;
+    for (int i = 0; i < count; i++) {
+        const quint64* data2 = getRowData(data2Vector, firstRow2 + i);
+        switch (measure) {
+        case Measure_Mismatches:
+            results[i] = compareRowData<Measure_Mismatches>(data1, data2, planesCount, wordsPerRow, lastWordMask);
+            break;
+        case Measure_MismatchesExcludeGaps:
+            results[i] = compareRowData<Measure_MismatchesExcludeGaps>(data1, data2, planesCount, wordsPerRow, lastWordMask);
+            break;
+        case Measure_Matches:
+            results[i] = compareRowData<Measure_Matches>(data1, data2, planesCount, wordsPerRow, lastWordMask);
+            break;
+        case Measure_MatchesExcludeGaps:
+            results[i] = compareRowData<Measure_MatchesExcludeGaps>(data1, data2, planesCount, wordsPerRow, lastWordMask);
+            break;
+        }
+    }
+}
+
+} //namespace
@@ -0,0 +1,80 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MSA_DISTANCE_BITSET_ENGINE_H_
+#define _U2_MSA_DISTANCE_BITSET_ENGINE_H_
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QVector>
+
+#include <U2Core/global.h>
+
+namespace U2 {
+
+// Compares alignment rows column by column with 64-bit words instead of chars.
+// Every char of the alignment gets a code (the gap code is 0), each bit of the codes is stored
+// in a separate bit plane of the row, plus a plane with gap positions. Two chars are equal
+// when all their plane bits are equal, so 64 columns are compared by a few xor operations
+// and the matches are counted with popcount.
+class U2ALGORITHM_EXPORT MSADistanceBitsetEngine {
+public:
+    enum Measure {
+        // number of columns with different chars
+        Measure_Mismatches,
+        // number of columns with different chars, columns with a gap in any row are skipped
+        Measure_MismatchesExcludeGaps,
+        // number of columns with equal chars
+        Measure_Matches,
+        // number of columns with equal chars, gap-gap columns are skipped
+        Measure_MatchesExcludeGaps
+    };
+
+    // 'rows' must be padded with gaps to the alignment length.
+    // If 'columnRows' is not empty, row i is compared with columnRows[j] instead of rows[j],
+    // it must have the same size as 'rows'.
+    MSADistanceBitsetEngine(const QList<QByteArray>& rows, const QList<QByteArray>& columnRows, int length);
+
+    int getRowCount() const {return rowCount;}
+
+    // Returns the measure value for row1 and (column) row2
+    int compare(int row1, int row2, Measure measure) const;
+
+    // Calculates values for row1 and the (column) rows [firstRow2, firstRow2 + count), 'results' must have 'count' elements
+    void compare(int row1, int firstRow2, int count, Measure measure, int* results) const;
+
+private:
+    void packRows(const QList<QByteArray>& rows, QVector<quint64>& data) const;
+    const quint64* getRowData(const QVector<quint64>& data, int row) const;
+
+    int                 rowCount;
+    int                 length;
+    int                 wordsPerRow;
+    int                 planesCount;
+    quint64             lastWordMask;
+    QVector<qint16>     charCodes;
+    QVector<quint64>    rowsData;
+    QVector<quint64>    columnRowsData;
+};
+
+} //namespace
+
+#endif
@@ -22,30 +22,42 @@
 #include "SArrayIndex.h"
 #include "SArrayIndexSerializer.h"
 
+#include <U2Core/AppContext.h>
+#include <U2Core/AppResources.h>
+#include <U2Core/AppSettings.h>
 #include <U2Core/Log.h>
 #include <U2Core/Timer.h>
 #include <U2Core/U2SafePoints.h>
 
 #include <U2Core/DNASequenceObject.h>
 
+#include <QtCore/QAtomicInt>
 #include <QtCore/QFile>
+#include <QtCore/QVector>
+
+#include <algorithm>
 
 namespace U2 {
 
+static int getIdealThreadCount() {
+    return AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount();
+}
+
 
 CreateSArrayIndexTask::CreateSArrayIndexTask(const char* _seq, quint32 _size, quint32 _w, char _unknownChar,
                                             const quint32* _bitTable, quint32 _bitCharLen,
                                             quint32 _skipGap, quint32 _gapOffset)
-:Task("Create SArray index", TaskFlag_None),
+:Task("Create SArray index", TaskFlags_FOSCOE),
 index(NULL), seq(_seq), size(_size), w(_w),
 unknownChar(_unknownChar), bitTable(_bitTable), bitCharLen(_bitCharLen),
-skipGap(_skipGap), gapOffset(_gapOffset), indexFileName(""), refFileName("")
+skipGap(_skipGap), gapOffset(_gapOffset), indexFileName(""), refFileName(""),
+buildTask(NULL)
 {
     prebuiltIdx = false;
 }
 
 CreateSArrayIndexTask::CreateSArrayIndexTask( const U2SequenceObject* obj, int windowSize, bool useBitMask, bool _prebuiltIdx, const QString &idxFN,const QString &refFN )
-    :Task("Create SArray index", TaskFlag_None),
+    :Task("Create SArray index", TaskFlags_FOSCOE),
       index(NULL),
       w(windowSize),
       unknownChar('\0'),
@@ -53,7 +65,8 @@ CreateSArrayIndexTask::CreateSArrayIndexTask( const U2SequenceObject* obj, int w
       gapOffset(0),
       prebuiltIdx(_prebuiltIdx),
       indexFileName(idxFN),
-      refFileName(refFN)
+      refFileName(refFN),
+      buildTask(NULL)
 {
     seqArray = obj->getWholeSequenceData(stateInfo);
     CHECK_OP(stateInfo, );
@@ -78,21 +91,62 @@ CreateSArrayIndexTask::~CreateSArrayIndexTask() {
     }
 }
 
+void CreateSArrayIndexTask::prepare() {
+    CHECK(!prebuiltIdx, );
+    buildTask = new SArrayIndexBuildTask(this);
+    addSubTask(buildTask);
+}
+
+QList<Task*> CreateSArrayIndexTask::onSubTaskFinished(Task* subTask) {
+    QList<Task*> res;
+    CHECK(subTask == buildTask && !isCanceled() && !hasError(), res);
+    CHECK(index->hasUnsortedBuckets(), res);
+
+    // the scheduler runs as many of them at once as the thread resource allows
+    const int sortTasksCount = qMax(1, getIdealThreadCount());
+    for (int i = 0; i < sortTasksCount; i++) {
+        res << new SArrayIndexSortTask(index);
+    }
+    return res;
+}
+
 void CreateSArrayIndexTask::run() {
     if (prebuiltIdx) {
         index = new SArrayIndex(seq, bitTable, bitCharLen);
         SArrayIndexSerializer::deserialize(index, indexFileName, stateInfo);
     } else {
-        index = new SArrayIndex(seq, size, w, stateInfo, unknownChar, bitTable, bitCharLen, skipGap, gapOffset);
+        index->completeSort();
         SArrayIndexSerializer::serialize(index, indexFileName, refFileName);
     }
 }
 
+void CreateSArrayIndexTask::createIndex(TaskStateInfo& ti) {
+    index = new SArrayIndex(seq, size, w, ti, unknownChar, bitTable, bitCharLen, skipGap, gapOffset, true);
+}
+
 void CreateSArrayIndexTask::cleanup() {
     delete index;
     index = 0;
 }
 
+SArrayIndexBuildTask::SArrayIndexBuildTask(CreateSArrayIndexTask* createTask)
+    : Task(tr("Build SArray index"), TaskFlag_None), createTask(createTask)
+{
+}
+
+void SArrayIndexBuildTask::run() {
+    createTask->createIndex(stateInfo);
+}
+
+SArrayIndexSortTask::SArrayIndexSortTask(SArrayIndex* index)
+    : Task(tr("Sort SArray index"), TaskFlag_None), index(index)
+{
+}
+
+void SArrayIndexSortTask::run() {
+    index->sortBuckets(stateInfo);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // index
 SArrayIndex::SArrayIndex(const char *_seqStart, const quint32* _bitTable, int _bitCharLen)
@@ -101,17 +155,18 @@ arrLen(0), sArray(NULL), bitMask(NULL), bitFilter(0),
 wCharsInMask(0), wAfterBits(0),
 bitTable(_bitTable), bitCharLen(_bitCharLen),
 seqStart(_seqStart), seqLen(0),
-l1Step(0), L1_SIZE(0), l1bitMask(NULL)
+l1Step(0), L1_SIZE(0), l1bitMask(NULL), sortContext(NULL)
 {
 
 }
 
 
 SArrayIndex::SArrayIndex(const char* seq, quint32 seqSize,  quint32 _len, TaskStateInfo& ti,
-                         char unknownChar, const quint32* _bitTable,  int _bitCharLen, int _gap, int _gapOffset)
+                         char unknownChar, const quint32* _bitTable,  int _bitCharLen, int _gap, int _gapOffset,
+                         bool sortInBuckets)
                          : w(_len), w4(_len/4), wRest(_len%4), skipGap(_gap), gapOffset(_gapOffset),
                          bitTable(_bitTable), bitCharLen(_bitCharLen),
-                         l1Step(0), L1_SIZE(0), l1bitMask(NULL)
+                         l1Step(0), L1_SIZE(0), l1bitMask(NULL), sortContext(NULL)
 {
     quint64 t1 = GTimer::currentTimeMicros();
     seqLen = seqSize;
@@ -212,27 +267,18 @@ SArrayIndex::SArrayIndex(const char* seq, quint32 seqSize,  quint32 _len, TaskSt
     }
 
     //now sort sArray. Use bit-mask if available
-    if (bitMask!=NULL)  {
+    if (sortInBuckets && arrLen >= BUCKET_SORT_MIN_SIZE) {
+        distributeToBuckets();
+        quint64 t2 = GTimer::currentTimeMicros();
+        perfLog.details(QString("SArray index buckets creation time: %1").arg(double(t2-t1)/(1000*1000)));
+        return;
+    } else if (bitMask != NULL) {
         sortBit(bitMask, 0, arrLen);
         //sortBitClassic(bitMask, 0, arrLen-1);
-
-        //create L1 cache for bitMask
-        if (arrLen < 200*1000) {
-            L1_SIZE = arrLen;
-            l1Step = 1;
-            l1bitMask = bitMask;
-        } else {
-            L1_SIZE = 8192;
-            l1bitMask = new quint32[L1_SIZE];
-            l1Step = arrLen / L1_SIZE;
-            for (int i=0; i < L1_SIZE; i++) {
-                l1bitMask[i] = bitMask[i*l1Step];
-            }
-            l1bitMask[L1_SIZE-1] = bitMask[arrLen-1];
-        }
     } else {
         sort(sArray, 0, arrLen);
     }
+    createL1Cache();
 
     quint64 t2 = GTimer::currentTimeMicros();
     perfLog.details(QString("SArray index creation time: %1").arg(double(t2-t1)/(1000*1000)));
@@ -242,7 +288,20 @@ SArrayIndex::SArrayIndex(const char* seq, quint32 seqSize,  quint32 _len, TaskSt
 #endif
 }
 
+/// The buckets of the index while they are not sorted
+struct SArrayIndexSortContext {
+    SArrayIndexSortContext() : bucketShift(0), bucketsCount(0) {}
+
+    int                         bucketShift;    // the bucket of a bit mask is its high bits
+    int                         bucketsCount;
+    QVector<quint32>            bucketStarts;
+    QVector<int>                sortOrder;      // the biggest buckets are sorted first to balance the tasks
+    QAtomicInt                  nextBucket;
+    QAtomicInt                  sortedCount;
+};
+
 SArrayIndex::~SArrayIndex() {
+    delete sortContext;
     delete[] sArray;
     if (bitMask!=l1bitMask) {
         delete[] l1bitMask;
@@ -250,6 +309,127 @@ SArrayIndex::~SArrayIndex() {
     delete bitMask;
 }
 
+void SArrayIndex::createL1Cache() {
+    CHECK(bitMask != NULL, );
+    //create L1 cache for bitMask
+    if (arrLen < 200*1000) {
+        L1_SIZE = arrLen;
+        l1Step = 1;
+        l1bitMask = bitMask;
+    } else {
+        L1_SIZE = 8192;
+        l1bitMask = new quint32[L1_SIZE];
+        l1Step = arrLen / L1_SIZE;
+        for (int i=0; i < L1_SIZE; i++) {
+            l1bitMask[i] = bitMask[i*l1Step];
+        }
+        l1bitMask[L1_SIZE-1] = bitMask[arrLen-1];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// sorting in buckets
+
+namespace {
+
+bool isBucketBigger(const QPair<quint32, int>& b1, const QPair<quint32, int>& b2) {
+    return b1.first > b2.first;
+}
+
+}
+
+quint32 SArrayIndex::getBucket(int idx) const {
+    if (bitMask != NULL) {
+        return bitMask[idx] >> sortContext->bucketShift;
+    }
+    return uchar(*sarr2seq(sArray + idx));
+}
+
+void SArrayIndex::distributeToBuckets() {
+    sortContext = new SArrayIndexSortContext();
+    if (bitMask != NULL) {
+        const int maskBits = bitCharLen * wCharsInMask;
+        const int bucketBits = qMin(maskBits, MAX_BUCKET_BITS);
+        sortContext->bucketShift = maskBits - bucketBits;
+        sortContext->bucketsCount = 1 << bucketBits;
+    } else {
+        // the sequences are compared with qstrncmp: the first char gives the order of buckets
+        sortContext->bucketsCount = 256;
+    }
+
+    QVector<quint32> offsets(sortContext->bucketsCount, 0);
+    for (int i = 0; i < arrLen; i++) {
+        offsets[getBucket(i)]++;
+    }
+
+    sortContext->bucketStarts.resize(sortContext->bucketsCount + 1);
+    QVector< QPair<quint32, int> > bucketSizes;
+    quint32 pos = 0;
+    for (int bucket = 0; bucket < sortContext->bucketsCount; bucket++) {
+        const quint32 bucketSize = offsets[bucket];
+        sortContext->bucketStarts[bucket] = pos;
+        offsets[bucket] = pos;
+        pos += bucketSize;
+        if (bucketSize > 1) {
+            bucketSizes << qMakePair(bucketSize, bucket);
+        }
+    }
+    sortContext->bucketStarts[sortContext->bucketsCount] = pos;
+
+    std::stable_sort(bucketSizes.begin(), bucketSizes.end(), isBucketBigger);
+    for (int i = 0; i < bucketSizes.size(); i++) {
+        sortContext->sortOrder << bucketSizes[i].second;
+    }
+
+    // the relative order of suffixes in a bucket is kept
+    quint32* newSArray = new quint32[arrLen];
+    quint32* newBitMask = bitMask == NULL ? NULL : new quint32[arrLen];
+    for (int i = 0; i < arrLen; i++) {
+        const quint32 newPos = offsets[getBucket(i)]++;
+        newSArray[newPos] = sArray[i];
+        if (newBitMask != NULL) {
+            newBitMask[newPos] = bitMask[i];
+        }
+    }
+    delete[] sArray;
+    sArray = newSArray;
+    if (bitMask != NULL) {
+        delete[] bitMask;
+        bitMask = newBitMask;
+    }
+}
+
+bool SArrayIndex::hasUnsortedBuckets() const {
+    return sortContext != NULL;
+}
+
+void SArrayIndex::sortBuckets(TaskStateInfo& ti) {
+    CHECK(sortContext != NULL, );
+    while (!ti.cancelFlag) {
+        const int orderIdx = sortContext->nextBucket.fetchAndAddRelaxed(1);
+        if (orderIdx >= sortContext->sortOrder.size()) {
+            break;
+        }
+        const int bucket = sortContext->sortOrder[orderIdx];
+        const int start = sortContext->bucketStarts[bucket];
+        const int len = sortContext->bucketStarts[bucket + 1] - start;
+        if (bitMask != NULL) {
+            sortBit(bitMask, start, len);
+        } else {
+            sort(sArray, start, len);
+        }
+        const int sorted = sortContext->sortedCount.fetchAndAddRelaxed(len) + len;
+        ti.setProgress(int(qint64(sorted) * 100 / arrLen));
+    }
+}
+
+void SArrayIndex::completeSort() {
+    CHECK(sortContext != NULL, );
+    delete sortContext;
+    sortContext = NULL;
+    createL1Cache();
+}
+
 quint32 SArrayIndex::getBitValue(const char *seq) const {
     quint32 bitValue = 0;
     for (int i = 0; i < wCharsInMask; i++) {
@@ -32,10 +32,16 @@ namespace U2 {
 class SArrayIndex;
 class U2SequenceObject;
 class BitsTable;
+struct SArrayIndexSortContext;
 
-/// A task to create SArrayIndex
+/**
+ * A task to create SArrayIndex.
+ * A big array is split into buckets by prefix by a subtask and the buckets are sorted by several subtasks,
+ * so the sorting threads are limited by the task scheduler resources.
+ */
 class U2ALGORITHM_EXPORT CreateSArrayIndexTask : public Task {
     Q_OBJECT
+    friend class SArrayIndexBuildTask;
 public:
     CreateSArrayIndexTask(const U2SequenceObject* obj, int windowSize, bool useBitMask = false,
                         bool prebuiltIdx = false, const QString &fileName = "", const QString &refFileName = "");
@@ -44,6 +50,8 @@ public:
                         quint32 skipGap = 0, quint32 _gapOffset=0);
     ~CreateSArrayIndexTask();
 
+    void prepare();
+    QList<Task*> onSubTaskFinished(Task* subTask);
     void run();
     void cleanup();
 
@@ -54,6 +62,8 @@ public:
     const quint32* getBitTable() const {return bitTable; }
 
 private:
+    void createIndex(TaskStateInfo& ti);
+
     QByteArray      seqArray;
     const char*     seq;
     quint32         size;
@@ -67,6 +77,29 @@ private:
     QString         indexFileName;
     QString         refFileName;
     BitsTable       bt;
+    Task*           buildTask;
+};
+
+/// Creates the index of CreateSArrayIndexTask with unsorted buckets
+class SArrayIndexBuildTask : public Task {
+    Q_OBJECT
+public:
+    SArrayIndexBuildTask(CreateSArrayIndexTask* createTask);
+    void run();
+
+private:
+    CreateSArrayIndexTask* createTask;
+};
+
+/// Sorts the buckets of the index, several tasks share the buckets of one index
+class SArrayIndexSortTask : public Task {
+    Q_OBJECT
+public:
+    SArrayIndexSortTask(SArrayIndex* index);
+    void run();
+
+private:
+    SArrayIndex* index;
 };
 
 /// Main SArrayIndex structure
@@ -85,11 +118,22 @@ public:
 
     //qlt - quick lookup table, size = 0 disable it's usage
     SArrayIndex(const char *serStart, const quint32* bitTable, int bitCharLen);
+    /**
+     * If sortInBuckets is set, a big array is only split into buckets by prefix: the buckets are sorted by sortBuckets(),
+     * that can be called from several threads at once, and the index is ready after completeSort()
+     */
     SArrayIndex(const char* seq, quint32 size,  quint32 w, TaskStateInfo& ti,
-        char unknownChar=0, const quint32* bitTable = NULL, int bitCharLen = 0, int skipGap = 0, int gapOffset=0);
+        char unknownChar=0, const quint32* bitTable = NULL, int bitCharLen = 0, int skipGap = 0, int gapOffset=0,
+        bool sortInBuckets = false);
 
     virtual ~SArrayIndex();
 
+    bool hasUnsortedBuckets() const;
+    /** Sorts the buckets until none is left */
+    void sortBuckets(TaskStateInfo& ti);
+    /** Completes the index when all buckets are sorted */
+    void completeSort();
+
     quint32 getBitValue(const char *seq) const;
     bool find(SAISearchContext* c, const char* seq);
     bool findBit(SAISearchContext* c, quint32 bitValue, const char* seq);
@@ -142,12 +186,20 @@ private:
 
     quint32*        l1bitMask; // compressed bitMask. Used to localize range before accessing to the real bitMask
 
+    SArrayIndexSortContext* sortContext;    // the buckets while they are not sorted
+
     void sort(quint32* x, int off, int len);
     void sortBit(quint32* x, int off, int len);
 
     void sortBitClassic(quint32* x, int off, int len);
     int  partition(quint32* x, int p, int r);
 
+    void createL1Cache();
+
+    // sorting in buckets: the suffixes are distributed to buckets by the prefix, then the buckets are sorted
+    void distributeToBuckets();
+    inline quint32 getBucket(int idx) const;
+
     //swaps bit mask values. Swap corresponding sArray values too
     inline void swapBit(quint32* x1, quint32* x2) const;
 
@@ -160,6 +212,9 @@ private:
     inline quint32 med3Bit(quint32* x, quint32 a, quint32 b, quint32 c);
 
     void debugCheck(char c);
+
+    static const int BUCKET_SORT_MIN_SIZE = 64 * 1024;
+    static const int MAX_BUCKET_BITS = 16;
 };
 
 
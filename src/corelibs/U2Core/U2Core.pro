@@ -135,6 +135,7 @@ HEADERS += src/cmdline/CMDLineCoreOptions.h \
            src/io/InputStream.h \
            src/io/IOAdapter.h \
            src/io/LocalFileAdapter.h \
+           src/io/MemoryMappedFileAdapter.h \
            src/io/OutputStream.h \
            src/io/RingBuffer.h \
            src/io/StringAdapter.h \
@@ -204,6 +205,7 @@ HEADERS += src/cmdline/CMDLineCoreOptions.h \
            src/tasks/shared_db/ImportToDatabaseTask.h \
            src/util/AnnotationCreationPattern.h \
            src/util/AssemblyImporter.h \
+           src/util/BoundedLockFreeQueue.h \
            src/util/DatatypeSerializeUtils.h \
            src/util/FileAndDirectoryUtils.h \
            src/util/FilesIterator.h \
@@ -343,6 +345,7 @@ SOURCES += src/cmdline/CMDLineCoreOptions.cpp \
            src/io/HttpFileAdapter.cpp \
            src/io/IOAdapter.cpp \
            src/io/LocalFileAdapter.cpp \
+           src/io/MemoryMappedFileAdapter.cpp \
            src/io/StringAdapter.cpp \
            src/io/VFSAdapter.cpp \
            src/io/VirtualFileSystem.cpp \
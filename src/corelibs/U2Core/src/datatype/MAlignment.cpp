@@ -61,6 +61,7 @@ MAlignmentRow::MAlignmentRow(const MAlignmentRow &r, MAlignment* al)
     : alignment(al),
       sequence(r.sequence),
       gaps(r.gaps),
+      gapsLengthSums(r.gapsLengthSums),
       initialRowInDb(r.initialRowInDb)
 {
     SAFE_POINT(alignment != NULL, "Parent MAlignment is NULL", );
@@ -249,7 +250,60 @@ void MAlignmentRow::setSequence(const DNASequence& newSequence) {
 }
 
 char MAlignmentRow::charAt(int pos) const {
-    return MsaRowUtils::charAt(sequence.seq, gaps, pos);
+    CHECK(pos >= 0, MAlignment_GapChar);
+
+    int gapsLength = 0;
+    const int gapIndex = findGapIndex(pos);
+    if (gapIndex >= 0) {
+        const U2MsaGap& gap = gaps[gapIndex];
+        CHECK(pos >= gap.offset + gap.gap, MAlignment_GapChar);
+        gapsLength = gapsLengthSums[gapIndex];
+    }
+
+    const int index = pos - gapsLength;
+    CHECK(index < sequence.length(), MAlignment_GapChar);
+    return sequence.seq.at(index);
+}
+
+void MAlignmentRow::getChars(int pos, int count, char* out) const {
+    CHECK(count > 0, );
+    const int endPos = pos + count;
+
+    // Leading positions outside the row
+    if (pos < 0) {
+        const int outsideCount = qMin(-pos, count);
+        memset(out, MAlignment_GapChar, outsideCount);
+        out += outsideCount;
+        pos += outsideCount;
+    }
+
+    const char* seqData = sequence.seq.constData();
+    const int seqLength = sequence.length();
+    int gapIndex = findGapIndex(pos);
+    while (pos < endPos) {
+        // Inside the gap
+        if (gapIndex >= 0 && pos < gaps[gapIndex].offset + gaps[gapIndex].gap) {
+            const int gapCount = qMin(endPos, int(gaps[gapIndex].offset + gaps[gapIndex].gap)) - pos;
+            memset(out, MAlignment_GapChar, gapCount);
+            out += gapCount;
+            pos += gapCount;
+            continue;
+        }
+
+        // Chars between the gap and the next one (or till the end of the row)
+        const int charsEnd = (gapIndex + 1 < gaps.size()) ? int(gaps[gapIndex + 1].offset) : endPos;
+        if (pos >= charsEnd) {
+            gapIndex++;
+            continue;
+        }
+        const int charsCount = qMin(endPos, charsEnd) - pos;
+        const int seqPos = pos - (gapIndex >= 0 ? gapsLengthSums[gapIndex] : 0);
+        const int copiedCount = qBound(0, seqLength - seqPos, charsCount);
+        memcpy(out, seqData + seqPos, copiedCount);
+        memset(out + copiedCount, MAlignment_GapChar, charsCount - copiedCount);
+        out += charsCount;
+        pos += charsCount;
+    }
 }
 
 void MAlignmentRow::insertGaps(int pos, int count, U2OpStatus& os) {
@@ -314,10 +368,10 @@ void MAlignmentRow::insertGaps(int pos, int count, U2OpStatus& os) {
             else {
                 U2MsaGap newGap(pos, count);
                 gaps.append(newGap);
-                return;
             }
         }
     }
+    updateGapsIndex();
 }
 
 void MAlignmentRow::mergeConsecutiveGaps() {
@@ -347,17 +401,44 @@ void MAlignmentRow::mergeConsecutiveGaps() {
         }
     }
     gaps = newGapModel;
+    updateGapsIndex();
 }
 
 void MAlignmentRow::removeTrailingGaps() {
+    updateGapsIndex();
     if (gaps.isEmpty()) {
         return;
     }
 
     // If the last char in the row is gap, remove the last gap
-    if (MAlignment_GapChar == charAt(MsaRowUtils::getRowLength(sequence.constData(), gaps) - 1)) {
+    if (MAlignment_GapChar == charAt(getRowLengthWithoutTrailing() - 1)) {
         gaps.removeLast();
+        gapsLengthSums.removeLast();
+    }
+}
+
+void MAlignmentRow::updateGapsIndex() {
+    gapsLengthSums.resize(gaps.size());
+    int gapsLength = 0;
+    for (int i = 0; i < gaps.size(); ++i) {
+        gapsLength += gaps[i].gap;
+        gapsLengthSums[i] = gapsLength;
+    }
+}
+
+int MAlignmentRow::findGapIndex(int pos) const {
+    // Binary search of the first gap that starts after the position
+    int left = 0;
+    int right = gaps.size();
+    while (left < right) {
+        const int middle = (left + right) / 2;
+        if (gaps[middle].offset <= pos) {
+            left = middle + 1;
+        } else {
+            right = middle;
+        }
     }
+    return left - 1;
 }
 
 void MAlignmentRow::removeChars(int pos, int count, U2OpStatus& os) {
@@ -421,11 +502,13 @@ bool MAlignmentRow::isRowContentEqual(const MAlignmentRow& row) const {
 }
 
 int MAlignmentRow::getUngappedPosition(int pos) const {
-    return MsaRowUtils::getUngappedPosition(sequence.seq, gaps, pos);
+    CHECK(MAlignment_GapChar != charAt(pos), -1);
+    const int gapIndex = findGapIndex(pos);
+    return pos - (gapIndex >= 0 ? gapsLengthSums[gapIndex] : 0);
 }
 
 int MAlignmentRow::getBaseCount(int before) const {
-    const int rowLength = MsaRowUtils::getRowLength(sequence.seq, gaps);
+    const int rowLength = getRowLengthWithoutTrailing();
     const int trimmedRowPos = before < rowLength ? before : rowLength;
     return MsaRowUtils::getUngappedPosition(sequence.seq, gaps, trimmedRowPos, true);
 }
@@ -518,6 +601,7 @@ void MAlignmentRow::removeGapsFromGapModel(int pos, int count) {
     }
 
     gaps = newGapModel;
+    updateGapsIndex();
 }
 
 void MAlignmentRow::crop(int pos, int count, U2OpStatus& os) {
@@ -1327,6 +1411,34 @@ char MAlignment::charAt(int rowIndex, int pos) const {
     return c;
 }
 
+int MAlignment::getColumn(int pos, char* column, const QVector<qint64>& rowIndexes) const {
+    const int rowsCount = rowIndexes.isEmpty() ? rows.size() : rowIndexes.size();
+    for (int i = 0; i < rowsCount; i++) {
+        const int rowIndex = rowIndexes.isEmpty() ? i : rowIndexes[i];
+        SAFE_POINT(rowIndex >= 0 && rowIndex < rows.size(), "Invalid row index!", i);
+        const MAlignmentRow& row = rows.at(rowIndex);
+
+        // the sequence position of a row without gaps is the column position
+        int seqPos = pos;
+        if (!row.gaps.isEmpty()) {
+            const int gapIndex = row.findGapIndex(pos);
+            if (gapIndex >= 0) {
+                const U2MsaGap& gap = row.gaps[gapIndex];
+                seqPos = (pos < gap.offset + gap.gap) ? -1 : pos - row.gapsLengthSums[gapIndex];
+            }
+        }
+        const QByteArray& seq = row.sequence.seq;
+        column[i] = (seqPos >= 0 && seqPos < seq.length()) ? seq.constData()[seqPos] : MAlignment_GapChar;
+    }
+    return rowsCount;
+}
+
+void MAlignment::getRowSlice(int rowIndex, const U2Region& region, QByteArray& slice) const {
+    SAFE_POINT(rowIndex >= 0 && rowIndex < rows.size(), "Invalid row index!", );
+    slice.resize(region.length);
+    rows.at(rowIndex).getChars(region.startPos, region.length, slice.data());
+}
+
 void MAlignment::setRowGapModel(int rowIndex, const QList<U2MsaGap>& gapModel) {
     SAFE_POINT(rowIndex >= 0 && rowIndex < getNumRows(), "Invalid row index!", );
     MAlignmentRow& row = rows[rowIndex];
@@ -147,6 +147,12 @@ public:
      */
     char charAt(int pos) const;
 
+    /**
+     * Copies 'count' chars of the row starting from the specified position to 'out', gaps included.
+     * Positions outside the row bounds are filled with gaps.
+     */
+    void getChars(int pos, int count, char* out) const;
+
     /** Length of the sequence without gaps */
     inline int getUngappedLength() const;
 
@@ -239,6 +245,12 @@ private:
     /** Removing gaps from the row between position 'pos' and 'pos + count' */
     void removeGapsFromGapModel(int pos, int count);
 
+    /** Rebuilds the gaps index, must be called after every modification of the gaps model */
+    void updateGapsIndex();
+
+    /** Returns the index of the last gap that starts at or before the position, or -1 if there is no such gap */
+    int findGapIndex(int pos) const;
+
     void setParentAlignment(MAlignment* newAl) { alignment = newAl; }
 
     MAlignment*         alignment;
@@ -253,13 +265,19 @@ private:
      */
     QList<U2MsaGap>     gaps;
 
+    /**
+     * Gaps index: the total length of the gaps [0, i] for every gap 'i'.
+     * A position is mapped to the sequence with a binary search over the gaps model.
+     */
+    QVector<int>        gapsLengthSums;
+
     /** The row in the database */
     U2MsaRow            initialRowInDb;
 };
 
 
 inline int MAlignmentRow::getGapsLength() const {
-    return MsaRowUtils::getGapsLength(gaps);
+    return gapsLengthSums.isEmpty() ? 0 : gapsLengthSums.last();
 }
 
 inline int MAlignmentRow::getCoreStart() const {
@@ -271,7 +289,7 @@ inline int MAlignmentRow::getCoreEnd() const {
 }
 
 inline int MAlignmentRow::getRowLengthWithoutTrailing() const {
-    return MsaRowUtils::getRowLength(sequence.seq, gaps);
+    return sequence.length() + getGapsLength();
 }
 
 inline int MAlignmentRow::getUngappedLength() const {
@@ -281,6 +299,7 @@ inline int MAlignmentRow::getUngappedLength() const {
 inline bool MAlignmentRow::simplify() {
     if (gaps.count() > 0) {
         gaps.clear();
+        gapsLengthSums.clear();
         return true;
     }
     return false;
@@ -401,6 +420,20 @@ public:
     /** Returns a character (a gap or a non-gap) in the specified row and position */
     char charAt(int rowIndex, int pos) const;
 
+    /**
+     * Fills 'column' with the chars of all rows at the specified position.
+     * If 'rowIndexes' is not empty, only the listed rows are taken in the listed order.
+     * The buffer is allocated by the caller, it must fit a char per taken row.
+     * Returns the number of the filled chars.
+     */
+    int getColumn(int pos, char* column, const QVector<qint64>& rowIndexes = QVector<qint64>()) const;
+
+    /**
+     * Fills 'slice' with the chars of the row in the specified region.
+     * Positions outside the row bounds are filled with gaps.
+     */
+    void getRowSlice(int rowIndex, const U2Region& region, QByteArray& slice) const;
+
     /**
      * Inserts 'count' gaps into the specified position.
      * Can increase the overall alignment length.
@@ -70,7 +70,10 @@ Document* DbiDocumentFormat::loadDocument(IOAdapter* io, const U2DbiRef& dstDbiR
     //3. close db
     QString url = io->getURL().getURLString();
     U2DbiRef srcDbiRef(id, url);
-    DbiConnection handle(srcDbiRef, true, os);
+    // the objects of the document are read by views and tasks in several threads
+    QHash<QString, QString> properties;
+    properties[U2DbiOptions::U2_DBI_LOCKING_MODE] = "wal";
+    DbiConnection handle(srcDbiRef, true, os, properties);
     CHECK_OP(os, NULL);
 
     U2ObjectDbi* odbi = handle.dbi->getObjectDbi();
@@ -146,7 +149,10 @@ void DbiDocumentFormat::storeDocument(Document* d, IOAdapter* ioAdapter, U2OpSta
     const QString url = ioAdapter->getURL().getURLString();
 
     const U2DbiRef dstDbiRef(id, url);
-    DbiConnection dstCon(dstDbiRef, true, os);
+    // the saved sequences are stored packed to reduce the file size
+    QHash<QString, QString> properties;
+    properties[U2DbiOptions::U2_DBI_SEQUENCE_PACKING] = U2DbiOptions::U2_DBI_VALUE_ON;
+    DbiConnection dstCon(dstDbiRef, true, os, properties);
     CHECK_OP(os, );
     Q_UNUSED(dstCon);
 
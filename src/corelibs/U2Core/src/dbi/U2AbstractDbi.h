@@ -250,6 +250,10 @@ public:
         U2DbiUtils::logNotSupported(U2DbiFeature_WriteAssembly, getRootDbi(), os);
     }
 
+    virtual void addPackedReads(const U2DataId&, U2DbiIterator<U2AssemblyRead>*, U2OpStatus& os) {
+        U2DbiUtils::logNotSupported(U2DbiFeature_WriteAssembly, getRootDbi(), os);
+    }
+
     virtual void pack(const U2DataId&, U2AssemblyPackStat&, U2OpStatus& os) {
         U2DbiUtils::logNotSupported(U2DbiFeature_AssemblyReadsPacking, getRootDbi(), os);
     }
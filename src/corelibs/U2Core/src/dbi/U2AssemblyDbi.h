@@ -55,7 +55,7 @@ public:
 /** Additional reads info used during reads import into assembly */
 class U2AssemblyReadsImportInfo {
 public:
-    U2AssemblyReadsImportInfo(U2AssemblyReadsImportInfo *parentInfo = NULL) : nReads(0), packed(false), parentInfo(parentInfo) {}
+    U2AssemblyReadsImportInfo(U2AssemblyReadsImportInfo *parentInfo = NULL) : nReads(0), packed(false), prepacked(false), parentInfo(parentInfo) {}
 
     /** Number of reads added during import */
     qint64 nReads;
@@ -63,6 +63,9 @@ public:
     /** Specifies if assembly was packed at import time*/
     bool packed;
 
+    /** Specifies if the reads have their packed rows assigned by the caller: the rows are stored as is */
+    bool prepacked;
+
     /* Place where to save pack statistics */
     U2AssemblyPackStat packStat;
 
@@ -196,6 +199,15 @@ public:
     */
     virtual void addReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os) = 0;
 
+    /**
+        Adds reads with the packed rows already assigned by the caller,
+        e.g. during the import of coordinate-sorted reads. The rows are stored as is.
+        Reads got their ids assigned.
+
+        Requires: U2DbiFeature_WriteAssembly feature support.
+    */
+    virtual void addPackedReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os) = 0;
+
     /**
         Packs assembly rows: assigns packedViewRow value (i.e. read's vertical position in view)
         for every read in assembly so that reads do not overlap.
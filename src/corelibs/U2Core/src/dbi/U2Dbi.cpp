@@ -40,6 +40,8 @@ const QString U2DbiOptions::U2_DBI_VALUE_ON("1");
 
 const QString U2DbiOptions::U2_DBI_LOCKING_MODE("locking_mode");
 
+const QString U2DbiOptions::U2_DBI_SEQUENCE_PACKING("sequence_packing");
+
 //////////////////////////////////////////////////////////////////////////
 // U2DbiFactory
 
@@ -75,8 +75,13 @@ public :
     /** Init time DBI parameter value. Indicates boolean 'Yes' or 'true'. */
     static const QString U2_DBI_VALUE_ON;
 
-    /** SQLite only: "exclusive" (default) or "normal" mode. */
+    /** SQLite only: "exclusive" (default), "normal" or "wal" mode.
+        The "wal" mode uses the normal locking and the WAL journal, reads are done with a read-only connection per thread. */
     static const QString U2_DBI_LOCKING_MODE;
+
+    /** SQLite only: U2_DBI_VALUE_ON stores the new nucleotide sequence chunks 2-bit packed.
+        The databases with the packed chunks can't be read by the versions older than 1.25. Off by default. */
+    static const QString U2_DBI_SEQUENCE_PACKING;
 };
 
 /**
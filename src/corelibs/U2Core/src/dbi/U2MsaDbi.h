@@ -120,6 +120,13 @@ public:
      */
     virtual void updateGapModel(const U2DataId& msaId, qint64 msaRowId, const QList<U2MsaGap>& gapModel, U2OpStatus& os) = 0;
 
+    /**
+     * Sets new gap models for several rows of a MSA at once.
+     * All rows are updated in a single transaction and tracked as a single modification step.
+     * Requires: U2DbiFeature_WriteMsa feature support
+     */
+    virtual void updateGapModels(const U2DataId& msaId, const QMap<qint64, QList<U2MsaGap> >& rowsGapModel, U2OpStatus& os) = 0;
+
     /**
      * Updates positions of the rows in the database according to the order in the list
      * Be careful, all IDs must exactly match IDs of the MSA!
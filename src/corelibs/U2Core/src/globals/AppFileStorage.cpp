@@ -171,6 +171,7 @@ void AppFileStorage::addFileInfo(const FileStorage::FileInfo &info, FileStorage:
     CHECK_OP(os, );
 
     if (info.isFileToFileInfo()) {
+        QMutexLocker lock(&processFilesMutex);
         process.addFile(info.getInfo());
     }
 }
@@ -184,6 +185,7 @@ QString AppFileStorage::getFileInfo(const QString &url, const QString &role, Fil
     if (!info.isEmpty()) {
         FileStorage::FileInfo i(url, role, info);
         if (i.isFileToFileInfo()) {
+            QMutexLocker lock(&processFilesMutex);
             process.addFile(info);
         }
     }
@@ -195,6 +197,7 @@ void AppFileStorage::addFileOwner(const FileStorage::FileInfo &info, FileStorage
     CHECK_OP(os, );
     if (exists) {
         if (info.isFileToFileInfo()) {
+            QMutexLocker lock(&processFilesMutex);
             process.addFile(info.getInfo());
         }
     } else {
@@ -238,6 +241,7 @@ void removeDirIfEmpty(const QString &url) {
 }
 
 void AppFileStorage::unregisterWorkflowProcess(FileStorage::WorkflowProcess &process, U2OpStatus & /*os*/) {
+    QMutexLocker lock(&processFilesMutex);
     process.unuseFiles();
 
     removeDirIfEmpty(process.tempDirectory);
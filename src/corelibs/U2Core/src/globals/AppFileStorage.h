@@ -110,6 +110,8 @@ private:
     QString storageDir;
 
     QMutex cleanupMutex;
+    /* Guards the used files of the workflow processes: the tasks of one workflow can run in parallel */
+    mutable QMutex processFilesMutex;
 }; // AppFileStorage
 
 /** Describes role types for the storage */
@@ -43,6 +43,9 @@
 #include <Psapi.h>
 #include <Winbase.h> //for IsProcessorFeaturePresent
 #endif
+#ifdef _MSC_VER
+#include <intrin.h> //for __cpuid, __cpuidex and _xgetbv
+#endif
 
 namespace U2 {
 
@@ -234,6 +237,31 @@ bool AppResourcePool::isSSE2Enabled() {
     return answer;
 }
 
+bool AppResourcePool::isAVX2Enabled() {
+    bool answer = false;
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+    //cpuid 0x1: ecx bit 27 is OSXSAVE, bit 28 is AVX
+    //xgetbv 0: bits 1 and 2 tell that the OS saves xmm and ymm registers
+    //cpuid 0x7: ebx bit 5 is AVX2
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuid(info, 1);
+        bool osSupportsYmm = (info[2] & (1<<27)) != 0 && (info[2] & (1<<28)) != 0
+            && (_xgetbv(0) & 0x6) == 0x6;
+        if (osSupportsYmm) {
+            __cpuidex(info, 7, 0);
+            answer = ((info[1] & (1<<5)) != 0);
+        }
+    }
+#elif defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+    //the builtin checks both the cpuid flag and the OS support of ymm registers
+    __builtin_cpu_init();
+    answer = __builtin_cpu_supports("avx2");
+#endif
+    return answer;
+}
+
 void AppResourcePool::registerResource(AppResource* r) {
     SAFE_POINT(NULL != r,"",);
     SAFE_POINT(!resources.contains(r->getResourceId()), QString("Duplicate resource: ").arg(r->getResourceId()),);
@@ -274,6 +274,8 @@ public:
 
     static bool isSSE2Enabled();
 
+    static bool isAVX2Enabled();
+
     void registerResource(AppResource* r);
     AppResource* getResource(int id) const;
 
@@ -47,7 +47,8 @@ void MSAMemento::setState(const MAlignment& state){
 }
 
 MAlignmentObject::MAlignmentObject(const QString& name, const U2EntityRef& msaRef, const QVariantMap& hintsMap, const MAlignment &alnData)
-    : GObject(GObjectTypes::MULTIPLE_ALIGNMENT, name, hintsMap), cachedMAlignment(alnData), memento(new MSAMemento)
+    : GObject(GObjectTypes::MULTIPLE_ALIGNMENT, name, hintsMap), cachedMAlignment(alnData), memento(new MSAMemento),
+      deferEdits(false), deferredLengthChanged(false)
 {
     entityRef = msaRef;
 
@@ -57,11 +58,20 @@ MAlignmentObject::MAlignmentObject(const QString& name, const U2EntityRef& msaRe
 }
 
 MAlignmentObject::~MAlignmentObject(){
+    // there is no one to report to and nothing to reload: the edits are written or lost with an error in the log
+    U2OpStatusImpl os;
+    writeDeferredEdits(os);
+    if (os.hasError()) {
+        coreLog.error(tr("The alignment changes were not saved: %1").arg(os.getError()));
+    }
     emit si_invalidateAlignmentObject();
     delete memento;
 }
 
 void MAlignmentObject::setTrackMod(U2TrackModType trackMod, U2OpStatus& os) {
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
+
     // Prepare the connection
     DbiConnection con(entityRef.dbiRef, os);
     CHECK_OP(os, );
@@ -81,12 +91,13 @@ const MAlignment & MAlignmentObject::getMAlignment() const {
 void MAlignmentObject::updateCachedMAlignment(const MAlignmentModInfo &mi, const QList<qint64> &removedRowIds)
 {
     ensureDataLoaded();
+    U2OpStatus2Log os;
+    flushDeferredEdits(os);
+    SAFE_POINT_OP(os, );
+
     emit si_startMsaUpdating();
 
     MAlignment maBefore = cachedMAlignment;
-    QString oldName = maBefore.getName();
-
-    U2OpStatus2Log os;
 
     if (mi.alignmentLengthChanged) {
         qint64 msaLength = MsaDbiUtils::getMsaLength(entityRef, os);
@@ -132,6 +143,10 @@ void MAlignmentObject::updateCachedMAlignment(const MAlignmentModInfo &mi, const
         }
     }
 
+    notifyAlignmentChanged(maBefore, mi, removedRowIds);
+}
+
+void MAlignmentObject::notifyAlignmentChanged(const MAlignment &maBefore, const MAlignmentModInfo &mi, const QList<qint64> &removedRowIds) {
     setModified(true);
     if (!mi.middleState) {
         emit si_alignmentChanged(maBefore, mi);
@@ -143,7 +158,7 @@ void MAlignmentObject::updateCachedMAlignment(const MAlignmentModInfo &mi, const
         }
 
         const QString newName = cachedMAlignment.getName();
-        if (oldName != newName) {
+        if (maBefore.getName() != newName) {
             setGObjectNameNotDbi(newName);
         }
     }
@@ -155,10 +170,46 @@ void MAlignmentObject::updateCachedMAlignment(const MAlignmentModInfo &mi, const
     }
 }
 
+void MAlignmentObject::flushDeferredEdits(U2OpStatus &os) {
+    writeDeferredEdits(os);
+    if (os.hasError()) {
+        // the cached alignment has the edits that are not in the database
+        updateCachedMAlignment();
+    }
+}
+
+void MAlignmentObject::writeDeferredEdits(U2OpStatus &os) {
+    CHECK(!deferredRowIds.isEmpty() || deferredLengthChanged, );
+
+    QMap<qint64, QList<U2MsaGap> > rowsGapModel;
+    foreach (qint64 rowId, deferredRowIds) {
+        const int rowIndex = cachedMAlignment.getRowIndexByRowId(rowId, os);
+        CHECK_OP(os, );
+        rowsGapModel[rowId] = cachedMAlignment.getRow(rowIndex).getGapModel();
+    }
+    const bool lengthChanged = deferredLengthChanged;
+    deferredRowIds.clear();
+    deferredLengthChanged = false;
+
+    DbiOperationsBlock opBlock(entityRef.dbiRef, os);
+    Q_UNUSED(opBlock);
+    CHECK_OP(os, );
+
+    if (!rowsGapModel.isEmpty()) {
+        MsaDbiUtils::updateRowsGapModel(entityRef, rowsGapModel, os);
+        CHECK_OP(os, );
+    }
+    if (lengthChanged) {
+        MsaDbiUtils::updateMsaLength(entityRef, cachedMAlignment.getLength(), os);
+    }
+}
+
 void MAlignmentObject::setMAlignment(const MAlignment& newMa, MAlignmentModInfo mi, const QVariantMap& hints) {
     SAFE_POINT(!isStateLocked(), "Alignment state is locked!", );
 
     U2OpStatus2Log os;
+    flushDeferredEdits(os);
+    SAFE_POINT_OP(os, );
     MsaDbiUtils::updateMsa(entityRef, newMa, os);
     SAFE_POINT_OP(os, );
 
@@ -192,9 +243,13 @@ void MAlignmentObject::saveState(){
     const MAlignment &msa = getMAlignment();
     emit si_completeStateChanged(false);
     memento->setState(msa);
+    deferEdits = true;
 }
 
-void MAlignmentObject::releaseState() {
+void MAlignmentObject::releaseState(U2OpStatus &os) {
+    deferEdits = false;
+    flushDeferredEdits(os);
+
     if(!isStateLocked()) {
         emit si_completeStateChanged(true);
 
@@ -243,13 +298,39 @@ void MAlignmentObject::insertGap(U2Region rows, int pos, int count) {
         rowIdsToInsert.append(rowId);
     }
 
-    U2OpStatus2Log os;
-    MsaDbiUtils::insertGaps(entityRef, rowIdsToInsert, pos, count, os);
-    SAFE_POINT_OP(os, );
+    // the inserted gaps shift all columns to the right of the position
+    const U2Region modifiedColumns(pos, qMax(msa.getLength() - pos, 0) + count);
 
     MAlignmentModInfo mi;
     mi.sequenceListChanged = false;
     mi.modifiedRowIds = rowIdsToInsert;
+    mi.modifiedColumns = modifiedColumns;
+
+    if (deferEdits) {
+        SAFE_POINT(0 <= pos && pos <= msa.getLength() && 0 < count, "Invalid gaps insertion parameters!", );
+        emit si_startMsaUpdating();
+        const MAlignment maBefore = cachedMAlignment;
+
+        // the same gap model calculation as MsaDbiUtils::insertGaps() performs in the database
+        for (int i = startSeq; i < endSeq; ++i) {
+            const MAlignmentRow &row = cachedMAlignment.getRow(i);
+            QList<U2MsaGap> gapModel = row.getGapModel();
+            MsaDbiUtils::calculateGapModelAfterInsert(gapModel, pos, count);
+            MsaDbiUtils::removeTrailingGap(gapModel, row.getUngappedLength());
+            cachedMAlignment.setRowGapModel(i, gapModel);
+        }
+        cachedMAlignment.setLength(maBefore.getLength() + count);
+
+        deferredRowIds += rowIdsToInsert.toSet();
+        deferredLengthChanged = true;
+        notifyAlignmentChanged(maBefore, mi, QList<qint64>());
+        return;
+    }
+
+    U2OpStatus2Log os;
+    MsaDbiUtils::insertGaps(entityRef, rowIdsToInsert, pos, count, os);
+    SAFE_POINT_OP(os, );
+
     updateCachedMAlignment(mi);
 }
 
@@ -325,28 +406,48 @@ int MAlignmentObject::deleteGap( const U2Region &rows, int pos, int maxGaps, U2O
     }
     QList<qint64> modifiedRowIds;
     modifiedRowIds.reserve( rows.length );
+    const U2Region modifiedColumns( pos, getLength( ) - pos );
+
+    const bool allRowsAffected = ( rows.startPos == 0 && rows.length == getNumRows( ) );
 
     MAlignment msa = getMAlignment( );
-    // iterate through given rows to update each of them in DB
+    const MAlignment maBefore = msa;
+    // iterate through given rows to update each of them in DB (or in the cache only, if the edits are deferred)
     for ( int rowCount = rows.startPos; rowCount < rows.endPos( ); ++rowCount ) {
         msa.removeChars( rowCount, pos, removingGapColumnCount, os );
         CHECK_OP( os, 0 );
 
         const MAlignmentRow &row = msa.getRow( rowCount );
-        MsaDbiUtils::updateRowGapModel( entityRef, row.getRowId( ), row.getGapModel( ), os );
-        CHECK_OP( os, 0 );
+        if ( deferEdits ) {
+            cachedMAlignment.setRowGapModel( rowCount, row.getGapModel( ) );
+        } else {
+            MsaDbiUtils::updateRowGapModel( entityRef, row.getRowId( ), row.getGapModel( ), os );
+            CHECK_OP( os, 0 );
+        }
         modifiedRowIds << row.getRowId( );
     }
-    if (rows.startPos == 0 && rows.length == getNumRows()) {
+    if ( allRowsAffected ) {
         // delete columns
-        MsaDbiUtils::updateMsaLength( entityRef, getLength() - removingGapColumnCount, os);
-        CHECK_OP( os, 0);
+        if ( deferEdits ) {
+            cachedMAlignment.setLength( maBefore.getLength( ) - removingGapColumnCount );
+            deferredLengthChanged = true;
+        } else {
+            MsaDbiUtils::updateMsaLength( entityRef, getLength() - removingGapColumnCount, os);
+            CHECK_OP( os, 0);
+        }
     }
 
     MAlignmentModInfo mi;
     mi.sequenceListChanged = false;
     mi.modifiedRowIds = modifiedRowIds;
-    updateCachedMAlignment(mi);
+    mi.modifiedColumns = modifiedColumns;
+    if ( deferEdits ) {
+        deferredRowIds += modifiedRowIds.toSet( );
+        emit si_startMsaUpdating( );
+        notifyAlignmentChanged( maBefore, mi, QList<qint64>( ) );
+    } else {
+        updateCachedMAlignment( mi );
+    }
     return removingGapColumnCount;
 }
 
@@ -359,6 +460,8 @@ void MAlignmentObject::removeRow(int rowIdx) {
     qint64 rowId = row.getRowDBInfo().rowId;
 
     U2OpStatus2Log os;
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
     MsaDbiUtils::removeRow(entityRef, rowId, os);
     SAFE_POINT_OP(os, );
 
@@ -375,6 +478,9 @@ void MAlignmentObject::removeRow(int rowIdx) {
 void MAlignmentObject::updateRow(int rowIdx, const QString& name, const QByteArray& seqBytes, const QList<U2MsaGap>& gapModel, U2OpStatus& os) {
     SAFE_POINT(!isStateLocked(), "Alignment state is locked!", );
 
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
+
     const MAlignment &msa = getMAlignment();
     SAFE_POINT(rowIdx >= 0 && rowIdx < msa.getNumRows(), "Invalid row index!", );
     const MAlignmentRow& row = msa.getRow(rowIdx);
@@ -393,6 +499,8 @@ void MAlignmentObject::setGObjectName(const QString& newName) {
 
     if (!isStateLocked()) {
         U2OpStatus2Log os;
+        flushDeferredEdits(os);
+        CHECK_OP(os, );
         MsaDbiUtils::renameMsa(entityRef, newName, os);
         CHECK_OP(os, );
 
@@ -459,8 +567,11 @@ void MAlignmentObject::removeRegion(int startPos, int startRow, int nBases, int
     for (; it != end; it++) {
         modifiedRowIds << it->getRowId();
     }
+    const U2Region modifiedColumns(startPos, msa.getLength() - startPos);
 
     U2OpStatus2Log os;
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
     MsaDbiUtils::removeRegion(entityRef, modifiedRowIds, startPos, nBases, os);
     SAFE_POINT_OP(os, );
 
@@ -481,6 +592,9 @@ void MAlignmentObject::removeRegion(int startPos, int startRow, int nBases, int
     if (track || !removedRows.isEmpty()) {
         MAlignmentModInfo mi;
         mi.modifiedRowIds = modifiedRowIds;
+        if (removedRows.isEmpty()) {
+            mi.modifiedColumns = modifiedColumns;
+        }
         updateCachedMAlignment(mi, removedRows);
     }
     if (!removedRows.isEmpty()) {
@@ -497,6 +611,8 @@ void MAlignmentObject::replaceCharacter(int startPos, int rowIndex, char newChar
     //msa.setAlphabet(newAlphabet);
 
     U2OpStatus2Log os;
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
     if (newChar != MAlignment_GapChar) {
         MsaDbiUtils::replaceCharacterInRow(entityRef, modifiedRowId, startPos, newChar, os);
     } else {
@@ -510,6 +626,7 @@ void MAlignmentObject::replaceCharacter(int startPos, int rowIndex, char newChar
     mi.sequenceListChanged = false;
     mi.alignmentLengthChanged = false;
     mi.modifiedRowIds << modifiedRowId;
+    mi.modifiedColumns = U2Region(startPos, 1);
 
     if (newChar != ' ' && !msa.getAlphabet()->contains(newChar)) {
         const DNAAlphabet *alp = U2AlphabetUtils::findBestAlphabet(QByteArray(1, newChar));
@@ -535,6 +652,8 @@ void MAlignmentObject::renameRow(int rowIdx, const QString& newName) {
     qint64 rowId = row.getRowDBInfo().rowId;
 
     U2OpStatus2Log os;
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
     MsaDbiUtils::renameRow(entityRef, rowId, newName, os);
     SAFE_POINT_OP(os, );
 
@@ -557,6 +676,8 @@ void MAlignmentObject::crop(U2Region window, const QSet<QString>& rowNames) {
     }
 
     U2OpStatus2Log os;
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
     MsaDbiUtils::crop(entityRef, rowIds, window.startPos, window.length, os);
     SAFE_POINT_OP(os, );
 
@@ -630,6 +751,9 @@ void MAlignmentObject::deleteColumnWithGaps(int requiredGapCount) {
 void MAlignmentObject::updateGapModel(QMap<qint64, QList<U2MsaGap> > rowsGapModel, U2OpStatus& os) {
     SAFE_POINT(!isStateLocked(), "Alignment state is locked!", );
 
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
+
     const MAlignment &msa = getMAlignment();
 
     QList<qint64> modifiedRowIds;
@@ -671,6 +795,8 @@ void MAlignmentObject::moveRowsBlock(int firstRow, int numRows, int shift)
     }
 
     U2OpStatusImpl os;
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
     MsaDbiUtils::moveRows(entityRef, rowsToMove, shift, os);
     CHECK_OP(os, );
 
@@ -680,6 +806,9 @@ void MAlignmentObject::moveRowsBlock(int firstRow, int numRows, int shift)
 void MAlignmentObject::updateRowsOrder(const QList<qint64>& rowIds, U2OpStatus& os) {
     SAFE_POINT(!isStateLocked(), "Alignment state is locked!", );
 
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
+
     MsaDbiUtils::updateRowsOrder(entityRef, rowIds, os);
     CHECK_OP(os, );
 
@@ -709,7 +838,13 @@ int MAlignmentObject::shiftRegion( int startPos, int startRow, int nBases, int n
                     break;
                 }
             }
-            if (increaseAlignmentLen) {
+            if (increaseAlignmentLen && deferEdits) {
+                emit si_startMsaUpdating();
+                const MAlignment maBefore = cachedMAlignment;
+                cachedMAlignment.setLength(startPos + nBases + shift);
+                deferredLengthChanged = true;
+                notifyAlignmentChanged(maBefore, MAlignmentModInfo(), QList<qint64>());
+            } else if (increaseAlignmentLen) {
                 MsaDbiUtils::updateMsaLength(entityRef, startPos + nBases + shift, os);
                 SAFE_POINT_OP( os, 0 );
                 updateCachedMAlignment();
@@ -787,6 +922,8 @@ void MAlignmentObject::sortRowsByList(const QStringList& order) {
     CHECK(msa.getRowsIds() != cachedMAlignment.getRowsIds(), );
 
     U2OpStatusImpl os;
+    flushDeferredEdits(os);
+    CHECK_OP(os, );
     MsaDbiUtils::updateRowsOrder(entityRef, msa.getRowsIds(), os);
     SAFE_POINT_OP(os, );
 
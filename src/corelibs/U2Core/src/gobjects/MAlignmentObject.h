@@ -58,6 +58,8 @@ public:
     bool alphabetChanged;
     QVariantMap hints;
     QList<qint64> modifiedRowIds;
+    /** Columns which content could be modified. If the region is empty, all columns are considered modified */
+    U2Region modifiedColumns;
     MAlignmentModType type;
 
 private:
@@ -188,8 +190,20 @@ public:
         const QList<qint64> &removedRowIds = QList<qint64>());
     void sortRowsByList(const QStringList& order);
 
+    /**
+     * While the state is saved, gap-only edits (insertGap, deleteGap, shiftRegion) are applied
+     * to the cached alignment only. They are written to the database in a single transaction
+     * when the state is released or before any other modification of the alignment.
+     */
     void saveState();
-    void releaseState();
+    /** Writes the deferred edits with flushDeferredEdits(), the state is released even if they are not written */
+    void releaseState(U2OpStatus &os);
+
+    /**
+     * Writes the deferred gap-only edits, if any, to the database.
+     * If they are not written, the error is set and the cached alignment is reloaded from the database, so the edits are dropped.
+     */
+    void flushDeferredEdits(U2OpStatus &os);
 
 signals:
     void si_startMsaUpdating();
@@ -214,8 +228,18 @@ private:
      */
     int getMaxWidthOfGapRegion( const U2Region &rows, int pos, int maxGaps, U2OpStatus &os );
 
+    /** Writes the deferred edits to the database and forgets them even if they are not written */
+    void writeDeferredEdits(U2OpStatus &os);
+
+    /** Emits the signals about the cached alignment change */
+    void notifyAlignmentChanged(const MAlignment &maBefore, const MAlignmentModInfo &mi, const QList<qint64> &removedRowIds);
+
     MAlignment      cachedMAlignment;
     MSAMemento*     memento;
+
+    bool            deferEdits;
+    QSet<qint64>    deferredRowIds;
+    bool            deferredLengthChanged;
 };
 
 
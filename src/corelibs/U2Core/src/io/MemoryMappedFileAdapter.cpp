@@ -0,0 +1,250 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "MemoryMappedFileAdapter.h"
+
+#include <U2Core/U2SafePoints.h>
+
+#include <QtCore/QFile>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace U2 {
+
+MemoryMappedFileAdapterFactory::MemoryMappedFileAdapterFactory(QObject* o) : IOAdapterFactory(o) {
+    name = tr("Memory mapped local file");
+}
+
+IOAdapter* MemoryMappedFileAdapterFactory::createIOAdapter() {
+    return new MemoryMappedFileAdapter(this);
+}
+
+MemoryMappedFileAdapter::MemoryMappedFileAdapter(MemoryMappedFileAdapterFactory* factory, QObject* o)
+    : IOAdapter(factory, o), f(NULL), mappedData(NULL), fileSize(0), currentPos(0)
+{
+}
+
+bool MemoryMappedFileAdapter::open(const GUrl& url, IOAdapterMode m) {
+    SAFE_POINT(!isOpen(), "Adapter is already opened!", false);
+    SAFE_POINT(m == IOAdapterMode_Read, "Memory mapped files can be opened only for reading!", false);
+
+    if (url.isEmpty()) {
+        return false;
+    }
+    f = new QFile(url.getURLString());
+    if (!f->open(QIODevice::ReadOnly)) {
+        delete f;
+        f = NULL;
+        return false;
+    }
+    fileSize = f->size();
+    currentPos = 0;
+    if (fileSize > 0) {
+        mappedData = reinterpret_cast<const char*>(f->map(0, fileSize));
+        if (NULL == mappedData) {
+            coreLog.error(tr("Can't map file '%1' into memory: %2").arg(url.getURLString()).arg(f->errorString()));
+            f->close();
+            delete f;
+            f = NULL;
+            fileSize = 0;
+            return false;
+        }
+        adviseSequentialAccess();
+    }
+    return true;
+}
+
+void MemoryMappedFileAdapter::close() {
+    SAFE_POINT(isOpen(), "Adapter is not opened!",);
+    if (NULL != mappedData) {
+        f->unmap(reinterpret_cast<uchar*>(const_cast<char*>(mappedData)));
+        mappedData = NULL;
+    }
+    f->close();
+    delete f;
+    f = NULL;
+    fileSize = 0;
+    currentPos = 0;
+}
+
+qint64 MemoryMappedFileAdapter::readBlock(char* data, qint64 size) {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    const char* view = NULL;
+    qint64 len = readBlockView(view, size);
+    if (len > 0) {
+        memcpy(data, view, len);
+    }
+    return len;
+}
+
+qint64 MemoryMappedFileAdapter::readUntil(char* buff, qint64 maxSize, const QBitArray& readTerminators,
+                                          TerminatorHandling th, bool* terminatorFound)
+{
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    const char* start = mappedData + currentPos;
+    const qint64 available = qMin(maxSize, fileSize - currentPos);
+
+    qint64 len = 0;
+    while (len < available && !readTerminators[(uchar)start[len]]) {
+        len++;
+    }
+    bool found = len < available;
+    qint64 consumed = len;
+    if (found && th != Term_Exclude) {
+        while (consumed < available && readTerminators[(uchar)start[consumed]]) {
+            consumed++;
+        }
+        if (th == Term_Include) {
+            len = consumed;
+        }
+    }
+    memcpy(buff, start, len);
+    currentPos += consumed;
+
+    if (terminatorFound != NULL) {
+        *terminatorFound = found;
+    }
+    return len;
+}
+
+qint64 MemoryMappedFileAdapter::readLine(char* buff, qint64 maxSize, bool* terminatorFound) {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    const char* start = mappedData + currentPos;
+    const qint64 available = qMin(maxSize, fileSize - currentPos);
+
+    qint64 len = 0;
+    while (len < available && start[len] != '\n' && start[len] != '\r') {
+        len++;
+    }
+    bool found = len < available;
+    memcpy(buff, start, len);
+    currentPos += len;
+    if (found) {
+        currentPos += (start[len] == '\r' && currentPos + 1 < fileSize && start[len + 1] == '\n') ? 2 : 1;
+    }
+
+    if (terminatorFound != NULL) {
+        *terminatorFound = found;
+    }
+    return len;
+}
+
+qint64 MemoryMappedFileAdapter::readLineView(const char*& data, bool* terminatorFound) {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    if (currentPos >= fileSize) {
+        data = NULL;
+        return -1;
+    }
+    data = mappedData + currentPos;
+    const qint64 available = fileSize - currentPos;
+
+    qint64 len = 0;
+    while (len < available && data[len] != '\n' && data[len] != '\r') {
+        len++;
+    }
+    bool found = len < available;
+    currentPos += len;
+    if (found) {
+        currentPos += (data[len] == '\r' && currentPos + 1 < fileSize && data[len + 1] == '\n') ? 2 : 1;
+    }
+
+    if (terminatorFound != NULL) {
+        *terminatorFound = found;
+    }
+    return len;
+}
+
+qint64 MemoryMappedFileAdapter::readBlockView(const char*& data, qint64 maxSize) {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    qint64 len = qMax(qint64(0), qMin(maxSize, fileSize - currentPos));
+    data = mappedData + currentPos;
+    currentPos += len;
+    return len;
+}
+
+qint64 MemoryMappedFileAdapter::writeBlock(const char* data, qint64 size) {
+    Q_UNUSED(data);
+    Q_UNUSED(size);
+    FAIL("Memory mapped file adapter is read-only!", -1);
+}
+
+bool MemoryMappedFileAdapter::skip(qint64 nBytes) {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", false);
+    qint64 newPos = currentPos + nBytes;
+    if (newPos < 0 || newPos > fileSize) {
+        return false;
+    }
+    currentPos = newPos;
+    return true;
+}
+
+qint64 MemoryMappedFileAdapter::left() const {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    return fileSize - currentPos;
+}
+
+int MemoryMappedFileAdapter::getProgress() const {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    CHECK(fileSize > 0, 100);
+    return int(100 * float(currentPos) / fileSize);
+}
+
+qint64 MemoryMappedFileAdapter::bytesRead() const {
+    return currentPos;
+}
+
+GUrl MemoryMappedFileAdapter::getURL() const {
+    CHECK(NULL != f, GUrl());
+    return GUrl(f->fileName(), GUrl_File);
+}
+
+QString MemoryMappedFileAdapter::errorString() const {
+    CHECK(NULL != f, QString());
+    return f->errorString();
+}
+
+void MemoryMappedFileAdapter::releasePages(qint64 startPos, qint64 length) {
+#ifdef Q_OS_UNIX
+    CHECK(NULL != mappedData, );
+    const qint64 pageSize = sysconf(_SC_PAGESIZE);
+    // the mapping starts at a page boundary, the released region must be aligned too
+    qint64 alignedStart = (startPos + pageSize - 1) / pageSize * pageSize;
+    qint64 alignedEnd = qMin(startPos + length, fileSize) / pageSize * pageSize;
+    CHECK(alignedEnd > alignedStart, );
+    madvise(const_cast<char*>(mappedData) + alignedStart, alignedEnd - alignedStart, MADV_DONTNEED);
+#else
+    Q_UNUSED(startPos);
+    Q_UNUSED(length);
+#endif
+}
+
+void MemoryMappedFileAdapter::adviseSequentialAccess() {
+#ifdef Q_OS_UNIX
+    if (0 != madvise(const_cast<char*>(mappedData), fileSize, MADV_SEQUENTIAL)) {
+        coreLog.trace(QString("madvise(MADV_SEQUENTIAL) failed for %1").arg(f->fileName()));
+    }
+#endif
+}
+
+}//namespace
@@ -0,0 +1,122 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MEMORY_MAPPED_FILE_ADAPTER_H_
+#define _U2_MEMORY_MAPPED_FILE_ADAPTER_H_
+
+#include <U2Core/IOAdapter.h>
+
+#include <QtCore/QFileInfo>
+
+class QFile;
+
+namespace U2 {
+
+class U2CORE_EXPORT MemoryMappedFileAdapterFactory : public IOAdapterFactory {
+    Q_OBJECT
+public:
+    MemoryMappedFileAdapterFactory(QObject* p = NULL);
+
+    virtual IOAdapter* createIOAdapter();
+
+    virtual IOAdapterId getAdapterId() const {return BaseIOAdapters::MEMORY_MAPPED_LOCAL_FILE;}
+
+    virtual const QString& getAdapterName() const {return name;}
+
+    virtual bool isIOModeSupported(IOAdapterMode m) const {return m == IOAdapterMode_Read;} //mapped files are read-only
+
+    virtual TriState isResourceAvailable(const GUrl& url) const {return QFileInfo(url.getURLString()).exists() ? TriState_Yes : TriState_No;}
+
+protected:
+    QString name;
+};
+
+/**
+ * Read-only adapter for local files that maps the whole file into the address space.
+ * In addition to the usual IOAdapter interface it provides a zero-copy "view" API:
+ * the returned pointers point directly into the mapping and stay valid until the adapter is closed.
+ * Formats can opt into it with qobject_cast<MemoryMappedFileAdapter*>(io).
+ */
+class U2CORE_EXPORT MemoryMappedFileAdapter : public IOAdapter {
+    Q_OBJECT
+public:
+    MemoryMappedFileAdapter(MemoryMappedFileAdapterFactory* f, QObject* o = NULL);
+    ~MemoryMappedFileAdapter() {if (isOpen()) close();}
+
+    virtual bool open(const GUrl& url, IOAdapterMode m);
+
+    virtual bool isOpen() const {return f != NULL;}
+
+    virtual void close();
+
+    virtual qint64 readBlock(char* data, qint64 maxSize);
+
+    virtual qint64 readUntil(char* buff, qint64 maxSize, const QBitArray& readTerminators,
+        TerminatorHandling th, bool* terminatorFound = 0);
+
+    virtual qint64 readLine(char* buff, qint64 maxSize, bool* terminatorFound = 0);
+
+    virtual qint64 writeBlock(const char* data, qint64 size);
+
+    virtual bool skip(qint64 nBytes);
+
+    virtual qint64 left() const;
+
+    virtual int getProgress() const;
+
+    virtual qint64 bytesRead() const;
+
+    virtual GUrl getURL() const;
+
+    virtual QString errorString() const;
+
+    /**
+     * Sets @data to the beginning of the next line and moves the position after the line terminator ("\n" or "\r\n").
+     * Returns the length of the line without the terminator, -1 at the end of the file.
+     */
+    qint64 readLineView(const char*& data, bool* terminatorFound = 0);
+
+    /**
+     * Sets @data to the current position and moves the position by at most @maxSize bytes.
+     * Returns the length of the block, 0 at the end of the file.
+     */
+    qint64 readBlockView(const char*& data, qint64 maxSize);
+
+    /** Returns the whole mapped file */
+    const char* getMappedData() const {return mappedData;}
+
+    qint64 getMappedSize() const {return fileSize;}
+
+    /** Tells the OS that the pages of the region won't be needed soon, the mapping stays valid */
+    void releasePages(qint64 startPos, qint64 length);
+
+private:
+    void adviseSequentialAccess();
+
+    QFile*      f;
+    const char* mappedData;
+    qint64      fileSize;
+    qint64      currentPos;
+};
+
+}//namespace
+
+#endif
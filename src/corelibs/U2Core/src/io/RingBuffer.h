@@ -9,6 +9,7 @@ namespace U2 {
 		inline int read(char* dest, int n, int index = 0) const;
 		inline void append(const char* src, int n);
 		int length() const {return len;}
+		void clear() {len = 0; start = 0;}
 		char* rawData() const {return data;}
 	private:
 		char* data; // buffer area
@@ -21,6 +21,17 @@
 
 #include <qendian.h>
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/AppSettings.h>
+#include <U2Core/Log.h>
+#include <U2Core/UserApplicationsSettings.h>
+
 #include "LocalFileAdapter.h"
 
 #include "ZlibAdapter.h"
@@ -54,10 +65,13 @@ void addAccessPoint( GZipIndex& index, int bits, qint64 in, qint64 out, quint32
     if (left < quint32(GZipIndex::WINSIZE)) {
         window.append( QByteArray( wnd, GZipIndex::WINSIZE - left ) );
     }
-    next.window = qCompress( window ).toBase64();
+    next.window = qCompress( window );
     index.points.append( next );
 }
 
+const quint32 INDEX_FILE_MAGIC = 0x555A4749; // "UGZI"
+const quint32 INDEX_FILE_VERSION = 2;
+
 } // anonymous namespace
 
 namespace U2 {
@@ -70,17 +84,39 @@ public:
     qint64 compress(const char* inBuff, qint64 inSize, bool finish = false);
     bool isCompressing() const {return doCompression;}
     qint64 getPos() const;
+    // 'true' when the whole compressed file is read
+    bool isEof() const {return eof;}
     bool skip( const GZipIndexAccessPoint& index, qint64 offset );
+
+    // starts building of the access points index, must be called before the first read
+    void startIndexing();
+    bool isIndexComplete() const {return indexComplete;}
+    GZipIndex* takeIndex();
 private:
+    bool restartStream();
+    void stopIndexing();
+    void updateIndex(const char* out, qint64 outLen, bool streamEnd);
+
     static const int CHUNK = 16384;
     z_stream strm;
     char buf[CHUNK];
     IOAdapter* io;
     bool doCompression;
     qint64 curPos; // position of uncompressed file
+    qint64 totalIn; // position of compressed file
+    bool rawMode; // 'true' after skipping to an access point: the stream is continued without the gzip header
+    bool eof;
+
+    GZipIndex* index; // index being built
+    bool indexComplete;
+    qint64 lastPointOut;
+    char* window; // the last WINSIZE bytes of uncompressed data
+    int windowPos;
 };
 
-GzipUtil::GzipUtil(IOAdapter* io, bool doCompression) : io(io), doCompression(doCompression), curPos( 0 )
+GzipUtil::GzipUtil(IOAdapter* io, bool doCompression)
+    : io(io), doCompression(doCompression), curPos( 0 ), totalIn( 0 ), rawMode( false ), eof( false ),
+      index( NULL ), indexComplete( false ), lastPointOut( 0 ), window( NULL ), windowPos( 0 )
 {
 //#ifdef _DEBUG
     memset(buf, 0xDD, CHUNK);
@@ -112,6 +148,83 @@ GzipUtil::~GzipUtil()
     } else {
         inflateEnd(&strm);
     }
+    stopIndexing();
+}
+
+void GzipUtil::startIndexing() {
+    assert(!doCompression && 0 == curPos && NULL == index);
+    index = new GZipIndex();
+    indexComplete = false;
+    lastPointOut = 0;
+    window = new char[GZipIndex::WINSIZE];
+    memset(window, 0, GZipIndex::WINSIZE);
+    windowPos = 0;
+}
+
+void GzipUtil::stopIndexing() {
+    delete index;
+    index = NULL;
+    indexComplete = false;
+    delete[] window;
+    window = NULL;
+}
+
+GZipIndex* GzipUtil::takeIndex() {
+    assert(indexComplete);
+    GZipIndex* result = index;
+    index = NULL;
+    stopIndexing();
+    return result;
+}
+
+void GzipUtil::updateIndex(const char* out, qint64 outLen, bool streamEnd) {
+    // keep the sliding window of the uncompressed data
+    while (outLen > 0) {
+        int len = qMin(outLen, qint64(GZipIndex::WINSIZE - windowPos));
+        memcpy(window + windowPos, out, len);
+        windowPos = (windowPos + len) % GZipIndex::WINSIZE;
+        out += len;
+        outLen -= len;
+    }
+    if (streamEnd) {
+        return;
+    }
+
+    /* at the end of a deflate block that is not the last one (see zran.c) */
+    if ((strm.data_type & 128) && !(strm.data_type & 64) && (curPos == 0 || curPos - lastPointOut > GZipIndex::SPAN)) {
+        addAccessPoint(*index, strm.data_type & 7, totalIn, curPos, GZipIndex::WINSIZE - windowPos, window);
+        lastPointOut = curPos;
+    }
+}
+
+bool GzipUtil::restartStream() {
+    if (rawMode) {
+        /* skip the gzip trailer (CRC32 and ISIZE) of the member continued from an access point */
+        int trailer = 8;
+        while (trailer > 0) {
+            if (strm.avail_in == 0) {
+                qint64 len = io->readBlock(buf, CHUNK);
+                if (len <= 0) {
+                    return len == 0;
+                }
+                strm.avail_in = len;
+                strm.next_in = (Bytef*)buf;
+            }
+            int n = qMin(trailer, int(strm.avail_in));
+            strm.next_in += n;
+            strm.avail_in -= n;
+            totalIn += n;
+            trailer -= n;
+        }
+        rawMode = false;
+    }
+    /* the next gzip member can follow */
+    Bytef* nextIn = strm.next_in;
+    uInt availIn = strm.avail_in;
+    inflateEnd(&strm);
+    strm.next_in = nextIn;
+    strm.avail_in = availIn;
+    return Z_OK == inflateInit2(&strm, 32 + 15);
 }
 
 qint64 GzipUtil::getPos() const {
@@ -121,6 +234,7 @@ qint64 GzipUtil::getPos() const {
 qint64 GzipUtil::uncompress(char* outBuff, qint64 outSize)
 {
     /* Based on gun.c (example from zlib, copyrighted (C) 2003, 2005 Mark Adler) */
+    const qint64 startPos = curPos;
     strm.avail_out = outSize;
     strm.next_out = (Bytef*)outBuff;
     do {
@@ -132,40 +246,50 @@ qint64 GzipUtil::uncompress(char* outBuff, qint64 outSize)
         }
         if (strm.avail_in == quint32(-1)) {
             // TODO log error
+            stopIndexing();
             return -1;
         }
-        if (strm.avail_in == 0)
+        if (strm.avail_in == 0) {
+            // the whole file is read
+            eof = true;
+            indexComplete = (NULL != index);
             break;
+        }
 
-        int ret = inflate(&strm, Z_SYNC_FLUSH);
+        const char* out = (const char*)strm.next_out;
+        const uInt availIn = strm.avail_in;
+        const uInt availOut = strm.avail_out;
+        /* stop at the end of each block if the index is being built */
+        int ret = inflate(&strm, (NULL != index) ? Z_BLOCK : Z_SYNC_FLUSH);
         assert(ret != Z_STREAM_ERROR);  /* state not clobbered */
+        totalIn += availIn - strm.avail_in;
+        curPos += availOut - strm.avail_out;
+        if (NULL != index && (ret == Z_OK || ret == Z_STREAM_END)) {
+            updateIndex(out, availOut - strm.avail_out, ret == Z_STREAM_END);
+        }
         switch (ret) {
             case Z_NEED_DICT:
             case Z_DATA_ERROR:
             case Z_MEM_ERROR:
+                stopIndexing();
                 return -1;
             case Z_STREAM_END:
-            {
-                qint64 readBytes = 0;
-                readBytes = outSize - strm.avail_out;
-                inflateReset(&strm);
-                inflateInit2(&strm, 32 + 15);
-
-                return readBytes;
-            }
+                if (!restartStream()) {
+                    stopIndexing();
+                    return -1;
+                }
+                return curPos - startPos;
             case Z_BUF_ERROR:
             case Z_FINISH:
-                curPos += outSize - strm.avail_out;
-                return outSize - strm.avail_out;
+                return curPos - startPos;
         }
-        if (strm.avail_out != 0 && strm.avail_in != 0) {
+        if (NULL == index && strm.avail_out != 0 && strm.avail_in != 0) {
             assert(0);
             break;
         }
     } while (strm.avail_out != 0);
-    curPos += outSize - strm.avail_out;
 
-    return outSize - strm.avail_out;
+    return curPos - startPos;
 }
 
 qint64 GzipUtil::compress(const char* inBuff, qint64 inSize, bool finish)
@@ -212,21 +336,37 @@ bool GzipUtil::skip( const GZipIndexAccessPoint& here, qint64 offset ) {
     if( NULL == localIO ) {
         return false;
     }
-    ok = localIO->skip( here.in - ( here.bits ? 1 : 0 ) );
+    const QByteArray window = GZipIndex::unpackWindow( here.window );
+    if( window.size() != GZipIndex::WINSIZE ) {
+        return false;
+    }
+    // the data is not read sequentially anymore
+    stopIndexing();
+
+    const qint64 inPos = here.in - ( here.bits ? 1 : 0 );
+    ok = localIO->skip( inPos - localIO->bytesRead() );
     if ( !ok ) {
         return false;
     }
+    inflateEnd( &strm );
+    strm.avail_in = 0;
+    strm.next_in = Z_NULL;
     inflateInit2( &strm, -15 );
+    rawMode = true;
+    eof = false;
+    totalIn = inPos;
+    curPos = here.out;
     if ( here.bits ) {
         char chr = 0;
         ok = io->getChar( &chr );
         if( !ok ) {
             return false;
         }
-        ret = chr;
+        totalIn++;
+        ret = (uchar)chr;
         inflatePrime( &strm, here.bits, ret >> ( 8 - here.bits ) );
     }
-    inflateSetDictionary( &strm, ( const Bytef* )here.window.data(), GZipIndex::WINSIZE );
+    inflateSetDictionary( &strm, ( const Bytef* )window.constData(), GZipIndex::WINSIZE );
 
     /* skip uncompressed bytes until offset reached, then satisfy request */
     offset -= here.out;
@@ -243,16 +383,20 @@ bool GzipUtil::skip( const GZipIndexAccessPoint& here, qint64 offset ) {
             howMany = offset;
         }
         offset -= howMany;
-        qint64 uncompressed = uncompress( discard, howMany );
-        if( uncompressed != howMany ) {
-            return false; /* error or eof - cannot skip to desired position */
+        /* the output stops at the end of each gzip member, the next member is continued */
+        while ( howMany > 0 ) {
+            qint64 uncompressed = uncompress( discard, howMany );
+            if ( uncompressed < 0 || ( 0 == uncompressed && eof ) ) {
+                return false; /* error or eof - cannot skip to desired position */
+            }
+            howMany -= uncompressed;
         }
     } while ( 1 );
     return true;
 }
 
 ZlibAdapter::ZlibAdapter(IOAdapter* io)
-: IOAdapter(io->getFactory()), io(io), z(NULL), buf(NULL), rewinded(0) {}
+: IOAdapter(io->getFactory()), io(io), z(NULL), buf(NULL), rewinded(0), index(NULL) {}
 
 ZlibAdapter::~ZlibAdapter() {
     close();
@@ -262,6 +406,9 @@ ZlibAdapter::~ZlibAdapter() {
 void ZlibAdapter::close() {
     delete z;
     z = NULL;
+    delete index;
+    index = NULL;
+    rewinded = 0;
     if (buf) {
         delete[] buf->rawData();
         delete buf;
@@ -280,11 +427,33 @@ bool ZlibAdapter::open(const GUrl& url, IOAdapterMode m ) {
         if (m == IOAdapterMode_Read) {
             buf = new RingBuffer(new char[BUFLEN], BUFLEN);
             assert(buf);
+            initIndex();
         }
     }
     return res;
 }
 
+void ZlibAdapter::initIndex() {
+    if (NULL == qobject_cast<LocalFileAdapter*>(io)) {
+        return;
+    }
+    const QString filePath = io->getURL().getURLString();
+    GZipIndex loaded;
+    if (GZipIndex::load(filePath, loaded)) {
+        index = new GZipIndex(loaded);
+    } else {
+        z->startIndexing();
+    }
+}
+
+void ZlibAdapter::storeBuiltIndex() {
+    index = z->takeIndex();
+    // there is nothing to speed up for small files
+    if (index->points.size() > 1) {
+        index->store(io->getURL().getURLString());
+    }
+}
+
 qint64 ZlibAdapter::readBlock(char* data, qint64 size)
 {
     if (!isOpen() || z->isCompressing()) {
@@ -308,6 +477,9 @@ qint64 ZlibAdapter::readBlock(char* data, qint64 size)
         return -1;
     }
     buf->append(data + cached, size);
+    if (z->isIndexComplete()) {
+        storeBuiltIndex();
+    }
 
     return size + cached;
 }
@@ -333,11 +505,26 @@ bool ZlibAdapter::skip(qint64 nBytes) {
             rewinded = -nBytes;
             return true;
         }
-        return false;
+        return seek(z->getPos() + nBytes);
+    }
+    if (NULL != index) {
+        // it is faster to start from an access point than to inflate everything before the target
+        const GZipIndexAccessPoint* point = index->findPoint(z->getPos() + nBytes);
+        if (NULL != point && point->out > z->getPos()) {
+            return seek(z->getPos() + nBytes);
+        }
     }
     rewinded = 0;
     char* tmp = new char[nBytes];
-    qint64 skipped = readBlock(tmp, nBytes);
+    // a read stops at the end of a gzip member, so read until the next members give enough data
+    qint64 skipped = 0;
+    while (skipped < nBytes) {
+        qint64 len = readBlock(tmp, nBytes - skipped);
+        if (len < 0 || (0 == len && z->isEof())) {
+            break;
+        }
+        skipped += len;
+    }
     delete[] tmp;
 
     return skipped == nBytes;
@@ -353,6 +540,19 @@ bool ZlibAdapter::skip( const GZipIndexAccessPoint& point, qint64 offset ) {
     return z->skip( point, offset );
 }
 
+bool ZlibAdapter::seek( qint64 offset ) {
+    if (!isOpen() || z->isCompressing() || NULL == index) {
+        return false;
+    }
+    const GZipIndexAccessPoint* point = index->findPoint(offset);
+    if (NULL == point || !z->skip(*point, offset)) {
+        return false;
+    }
+    buf->clear();
+    rewinded = 0;
+    return true;
+}
+
 qint64 ZlibAdapter::bytesRead() const {
     return z->getPos() - rewinded;
 }
@@ -457,6 +657,96 @@ qint64 ZlibAdapter::getUncompressedFileSizeInBytes(const GUrl &url) {
     return result;
 }
 
+const GZipIndexAccessPoint* GZipIndex::findPoint( qint64 offset ) const {
+    int left = 0;
+    int right = points.size() - 1;
+    const GZipIndexAccessPoint* result = NULL;
+    while (left <= right) {
+        int mid = (left + right) / 2;
+        if (points[mid].out <= offset) {
+            result = &points[mid];
+            left = mid + 1;
+        } else {
+            right = mid - 1;
+        }
+    }
+    return result;
+}
+
+QString GZipIndex::getIndexFilePath( const QString& gzFilePath ) {
+    QString dirPath = QDir::tempPath();
+    AppSettings* appSettings = AppContext::getAppSettings();
+    if (NULL != appSettings && NULL != appSettings->getUserAppsSettings()) {
+        dirPath = appSettings->getUserAppsSettings()->getUserTemporaryDirPath();
+    }
+    const QString absolutePath = QFileInfo(gzFilePath).absoluteFilePath();
+    const QString fileName = QString::fromLatin1(QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Md5).toHex());
+    return dirPath + "/ugene_tmp/gzip_index/" + fileName + ".ugzi";
+}
+
+bool GZipIndex::store( const QString& gzFilePath ) const {
+    QFileInfo gzInfo(gzFilePath);
+    QFile file(getIndexFilePath(gzFilePath));
+    QDir().mkpath(QFileInfo(file).absolutePath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        ioLog.trace(QString("Can't create gzip index file: %1").arg(file.fileName()));
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << INDEX_FILE_MAGIC << INDEX_FILE_VERSION << gzInfo.absoluteFilePath() << qint64(gzInfo.size()) << qint64(gzInfo.lastModified().toMSecsSinceEpoch());
+    out << qint32(points.size());
+    foreach (const GZipIndexAccessPoint& point, points) {
+        out << point.out << point.in << qint32(point.bits) << point.window;
+    }
+    if (out.status() != QDataStream::Ok) {
+        file.close();
+        file.remove();
+        return false;
+    }
+    return true;
+}
+
+bool GZipIndex::load( const QString& gzFilePath, GZipIndex& index ) {
+    QFile file(getIndexFilePath(gzFilePath));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString path;
+    qint64 size = 0;
+    qint64 modified = 0;
+    qint32 count = 0;
+    in >> magic >> version;
+    if (in.status() == QDataStream::Ok && magic == INDEX_FILE_MAGIC && version == INDEX_FILE_VERSION) {
+        in >> path >> size >> modified >> count;
+    }
+
+    QFileInfo gzInfo(gzFilePath);
+    if (in.status() != QDataStream::Ok || magic != INDEX_FILE_MAGIC || version != INDEX_FILE_VERSION
+        || path != gzInfo.absoluteFilePath() || size != gzInfo.size() || modified != gzInfo.lastModified().toMSecsSinceEpoch() || count <= 0)
+    {
+        ioLog.trace(QString("Gzip index file is outdated: %1").arg(file.fileName()));
+        return false;
+    }
+    index.points.clear();
+    for (int i = 0; i < count; i++) {
+        GZipIndexAccessPoint point;
+        qint32 bits = 0;
+        in >> point.out >> point.in >> bits >> point.window;
+        point.bits = bits;
+        index.points << point;
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+QByteArray GZipIndex::unpackWindow( const QByteArray& window ) {
+    return qUncompress(window);
+}
+
 GUrl ZlibAdapter::getURL() const {
     return io->getURL();
 }
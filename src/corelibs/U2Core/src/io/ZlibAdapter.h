@@ -62,6 +62,14 @@ public:
      */
     bool skip( const GZipIndexAccessPoint& point, qint64 offset );
 
+    /**
+     * Moves to the @offset of the uncompressed data using the access points index.
+     * Returns false if there is no index for the file.
+     */
+    bool seek( qint64 offset );
+
+    bool hasIndex() const {return NULL != index;}
+
     /**
      * on error *ok set to false and GZipIndex() is returned
      * io - opened ioadapter, on the beginning of the file
@@ -76,18 +84,22 @@ public:
     virtual QString errorString() const;
 
 private:
+    void initIndex();
+    void storeBuiltIndex();
+
     static const int BUFLEN = 32768;
     IOAdapter* io;
     GzipUtil* z;
     RingBuffer* buf; // seek buffer
     int rewinded; // how much should read from seek buffer
+    GZipIndex* index; // access points of the file: loaded from the index file or built during the first full read
 };
 
 struct GZipIndexAccessPoint {
     qint64     out;    // corresponding offset in uncompressed data
     qint64     in;     // offset in input file of first full byte
     int        bits;   // number of bits (1-7) from byte at in - 1, or 0
-    QByteArray window; //preceding WINSIZE of uncompressed data
+    QByteArray window; //preceding WINSIZE of uncompressed data, compressed with qCompress
 };
 
 struct U2CORE_EXPORT GZipIndex {
@@ -96,6 +108,22 @@ struct U2CORE_EXPORT GZipIndex {
     static const int    CHUNK   = 16384;
 
     QList< GZipIndexAccessPoint > points;
+
+    /** Returns the last access point that is not after @offset, NULL if there is no such point */
+    const GZipIndexAccessPoint* findPoint( qint64 offset ) const;
+
+    /**
+     * The index is stored in the user temporary directory, not next to the user data.
+     * The file name is made of the hash of the compressed file path.
+     */
+    static QString getIndexFilePath( const QString& gzFilePath );
+
+    bool store( const QString& gzFilePath ) const;
+
+    /** Returns false if there is no index file or it was created for another version of the compressed file */
+    static bool load( const QString& gzFilePath, GZipIndex& index );
+
+    static QByteArray unpackWindow( const QByteArray& window );
 }; // GZipIndex
 
 };//namespace
@@ -89,6 +89,21 @@ void AssemblyImporter::addReads(U2DbiIterator<U2AssemblyRead> *readsIterator) {
     assemblyDbi->addReads(assembly.id, readsIterator, os);
 }
 
+void AssemblyImporter::addPackedReads(U2DbiIterator<U2AssemblyRead> *readsIterator) {
+    CHECK(objectExists, );
+    SAFE_POINT(dbiRef.isValid(), "Database reference is invalid", );
+    SAFE_POINT(assembly.hasValidId(), "Assembly ID is invalid", );
+
+    DbiConnection connection(dbiRef, os);
+    SAFE_POINT_OP(os, );
+    CHECK(!os.isCanceled(), );
+    SAFE_POINT(connection.isOpen(), "Connection is closed", );
+    U2AssemblyDbi *assemblyDbi = connection.dbi->getAssemblyDbi();
+    SAFE_POINT(NULL != assemblyDbi, L10N::nullPointerError("assembly dbi"), );
+
+    assemblyDbi->addPackedReads(assembly.id, readsIterator, os);
+}
+
 void AssemblyImporter::packReads(U2AssemblyReadsImportInfo &importInfo) {
     CHECK(!importInfo.packed, );
     CHECK(objectExists, );
@@ -40,6 +40,8 @@ public:
     void createAssembly(const U2DbiRef &dbiRef, const QString &folder, U2DbiIterator<U2AssemblyRead> *readsIterator, U2AssemblyReadsImportInfo &importInfo, U2Assembly &assembly);
 
     void addReads(U2DbiIterator<U2AssemblyRead> *readsIterator);
+    /** Adds reads that have their packed rows assigned already */
+    void addPackedReads(U2DbiIterator<U2AssemblyRead> *readsIterator);
     void packReads(U2AssemblyReadsImportInfo &importInfo);
 
     bool isObjectExist() const;
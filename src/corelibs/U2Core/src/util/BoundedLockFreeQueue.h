@@ -0,0 +1,143 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_BOUNDED_LOCK_FREE_QUEUE_H_
+#define _U2_BOUNDED_LOCK_FREE_QUEUE_H_
+
+#include <QAtomicInt>
+
+#include <U2Core/global.h>
+
+namespace U2 {
+
+/**
+ * Fixed-capacity multi-producer/multi-consumer FIFO queue that never takes a lock.
+ * Every cell carries a sequence number that tells producers and consumers whose turn it is,
+ * so a push or a pop costs a single CAS on the queue head or tail in the uncontended case.
+ * The capacity is rounded up to a power of two. tryPush() returns false when the queue is full
+ * and tryPop() returns false when it is empty: the caller decides how to back off.
+ */
+template <class T>
+class BoundedLockFreeQueue {
+public:
+    explicit BoundedLockFreeQueue(int minCapacity)
+        : cells(NULL), mask(0)
+    {
+        int capacity = 2;
+        while (capacity < minCapacity) {
+            capacity <<= 1;
+        }
+        mask = capacity - 1;
+        cells = new Cell[capacity];
+        for (int i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i);
+        }
+        enqueuePos.store(0);
+        dequeuePos.store(0);
+    }
+
+    ~BoundedLockFreeQueue() {
+        delete[] cells;
+    }
+
+    int getCapacity() const {
+        return mask + 1;
+    }
+
+    bool tryPush(const T &value) {
+        Cell *cell = NULL;
+        int pos = enqueuePos.load();
+        forever {
+            cell = &cells[pos & mask];
+            const int diff = distance(cell->sequence.loadAcquire(), pos);
+            if (0 == diff) {
+                if (enqueuePos.testAndSetRelaxed(pos, advance(pos, 1))) {
+                    break;
+                }
+                pos = enqueuePos.load();
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load();
+            }
+        }
+        cell->value = value;
+        cell->sequence.storeRelease(advance(pos, 1));
+        return true;
+    }
+
+    bool tryPop(T &value) {
+        Cell *cell = NULL;
+        int pos = dequeuePos.load();
+        forever {
+            cell = &cells[pos & mask];
+            const int diff = distance(cell->sequence.loadAcquire(), advance(pos, 1));
+            if (0 == diff) {
+                if (dequeuePos.testAndSetRelaxed(pos, advance(pos, 1))) {
+                    break;
+                }
+                pos = dequeuePos.load();
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load();
+            }
+        }
+        value = cell->value;
+        cell->value = T();
+        cell->sequence.storeRelease(advance(pos, mask + 1));
+        return true;
+    }
+
+    /** Approximate: other threads may change the queue while the value is being returned. */
+    bool isEmpty() const {
+        return enqueuePos.load() == dequeuePos.load();
+    }
+
+private:
+    Q_DISABLE_COPY(BoundedLockFreeQueue)
+
+    struct Cell {
+        QAtomicInt sequence;
+        T value;
+    };
+
+    // positions wrap around, so the arithmetic is done on unsigned values to keep it well defined
+    static int advance(int pos, int delta) {
+        return int(quint32(pos) + quint32(delta));
+    }
+
+    static int distance(int sequence, int pos) {
+        return int(quint32(sequence) - quint32(pos));
+    }
+
+    Cell *cells;
+    int mask;
+    // producers and consumers work on different cache lines
+    char padding0[64];
+    QAtomicInt enqueuePos;
+    char padding1[64];
+    QAtomicInt dequeuePos;
+};
+
+}   // namespace U2
+
+#endif // _U2_BOUNDED_LOCK_FREE_QUEUE_H_
@@ -171,6 +171,18 @@ void MsaDbiUtils::calculateGapModelAfterInsert(QList<U2MsaGap>& gapModel, qint64
     }
 }
 
+void MsaDbiUtils::removeTrailingGap(QList<U2MsaGap>& gapModel, qint64 seqLength) {
+    qint64 gapsLength = 0;
+    for (int i = 0, n = gapModel.count(); i < n; ++i) {
+        const U2MsaGap& gap = gapModel[i];
+        if ((i == n - 1) && (gap.offset >= seqLength + gapsLength)) {
+            gapModel.removeAt(i);
+            break;
+        }
+        gapsLength += gap.gap;
+    }
+}
+
 QList<U2MsaRow> MsaDbiUtils::cutOffLeadingGaps(QList<U2MsaRow>& rows) {
     qint64 leadingGapsToRemove = LLONG_MAX;
     for (qint64 i = 0; i < rows.length(); ++i) {
@@ -776,6 +788,18 @@ void MsaDbiUtils::updateRowGapModel(const U2EntityRef& msaRef, qint64 rowId, con
     msaDbi->updateGapModel(msaRef.entityId, rowId, gaps, os);
 }
 
+void MsaDbiUtils::updateRowsGapModel(const U2EntityRef& msaRef, const QMap<qint64, QList<U2MsaGap> >& rowsGapModel, U2OpStatus& os) {
+    // Prepare the connection
+    DbiConnection con(msaRef.dbiRef, os);
+    CHECK_OP(os, );
+
+    U2MsaDbi* msaDbi = con.dbi->getMsaDbi();
+    SAFE_POINT(NULL != msaDbi, "NULL Msa Dbi!", );
+
+    // Update the data
+    msaDbi->updateGapModels(msaRef.entityId, rowsGapModel, os);
+}
+
 void MsaDbiUtils::updateRowsOrder(const U2EntityRef& msaRef, const QList<qint64>& rowsOrder, U2OpStatus& os) {
     // Prepare the connection
     DbiConnection con(msaRef.dbiRef, os);
@@ -916,16 +940,7 @@ void MsaDbiUtils::insertGaps(const U2EntityRef& msaRef, const QList<qint64>& row
         calculateGapModelAfterInsert(row.gaps, pos, count);
 
         // Trim trailing gap (if any)
-        qint64 seqLength = row.gend - row.gstart;
-        qint64 gapsLength = 0;
-        for (int i = 0, n = row.gaps.count(); i < n; ++i) {
-            const U2MsaGap& gap = row.gaps[i];
-            if ((i == n - 1) && (gap.offset >= seqLength + gapsLength)) {
-                row.gaps.removeAt(i);
-                break;
-            }
-            gapsLength += gap.gap;
-        }
+        removeTrailingGap(row.gaps, row.gend - row.gstart);
 
         // Put the new gap model into the database
         msaDbi->updateGapModel(msaRef.entityId, row.rowId, row.gaps, os);
@@ -142,6 +142,12 @@ public:
      */
     static void updateRowGapModel(const U2EntityRef& msaRef, qint64 rowId, const QList<U2MsaGap>& gaps, U2OpStatus& os);
 
+    /**
+     * Updates gap models of several rows in the database at once.
+     * Keys of the map must be valid row IDs in the database.
+     */
+    static void updateRowsGapModel(const U2EntityRef& msaRef, const QMap<qint64, QList<U2MsaGap> >& rowsGapModel, U2OpStatus& os);
+
     /**
      * Updates positions of the rows in the database according to the order in the list.
      * All IDs must exactly match IDs of the MSA!
@@ -172,6 +178,9 @@ public:
     /** Calculates a new gap model when 'count' gaps are inserted to 'pos' position */
     static void calculateGapModelAfterInsert(QList<U2MsaGap>& gapModel, qint64 pos, qint64 count);
 
+    /** Removes the last gap of the model if it is located after the sequence of 'seqLength' characters */
+    static void removeTrailingGap(QList<U2MsaGap>& gapModel, qint64 seqLength);
+
 private:
     /**
      * Verifies if the alignment contains columns of gaps at the beginning.
@@ -13,6 +13,11 @@ UGENE_RELATIVE_DESTDIR = ''
 
 DEFINES += QT_FATAL_ASSERT BUILDING_U2FORMATS_DLL
 
+use_sse2() {
+    #the packed sequence decoding is compiled per function and is enabled at runtime by CPUID
+    DEFINES += U2FORMATS_BUILD_WITH_SSE2
+}
+
 LIBS += -L../../_release -lU2Core -lU2Algorithm
 LIBS += -lugenedb -lsamtools
 
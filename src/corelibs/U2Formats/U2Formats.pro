@@ -17,6 +17,7 @@ HEADERS += src/ABIFormat.h \
            src/EMBLPlainTextFormat.h \
            src/FastaFormat.h \
            src/FastqFormat.h \
+           src/FastqParallelReader.h \
            src/FpkmTrackingFormat.h \
            src/GenbankLocationParser.h \
            src/GenbankPlainTextFormat.h \
@@ -89,11 +90,14 @@ HEADERS += src/ABIFormat.h \
            src/sqlite_dbi/SQLiteSequenceDbi.h \
            src/sqlite_dbi/SQLiteUdrDbi.h \
            src/sqlite_dbi/SQLiteVariantDbi.h \
+           src/sqlite_dbi/assembly/AssemblyCoverageTable.h \
            src/sqlite_dbi/assembly/MultiTableAssemblyAdapter.h \
            src/sqlite_dbi/assembly/RTreeAssemblyAdapter.h \
            src/sqlite_dbi/assembly/SingleTableAssemblyAdapter.h \
+           src/sqlite_dbi/util/SQLiteReadConnectionPool.h \
            src/sqlite_dbi/util/SqliteUpgrader.h \
            src/sqlite_dbi/util/SqliteUpgraderFrom_0_To_1_13.cpp \
+           src/sqlite_dbi/util/SqliteUpgraderFrom_1_13_To_1_25.h \
            src/tasks/BgzipTask.h \
            src/tasks/ConvertAssemblyToSamTask.h \
            src/tasks/ConvertFileTask.h \
@@ -120,6 +124,7 @@ SOURCES += src/ABIFormat.cpp \
            src/EMBLPlainTextFormat.cpp \
            src/FastaFormat.cpp \
            src/FastqFormat.cpp \
+           src/FastqParallelReader.cpp \
            src/FpkmTrackingFormat.cpp \
            src/GenbankLocationParser.cpp \
            src/GenbankPlainTextFormat.cpp \
@@ -190,11 +195,14 @@ SOURCES += src/ABIFormat.cpp \
            src/sqlite_dbi/SQLiteSequenceDbi.cpp \
            src/sqlite_dbi/SQLiteUdrDbi.cpp \
            src/sqlite_dbi/SQLiteVariantDbi.cpp \
+           src/sqlite_dbi/assembly/AssemblyCoverageTable.cpp \
            src/sqlite_dbi/assembly/MultiTableAssemblyAdapter.cpp \
            src/sqlite_dbi/assembly/RTreeAssemblyAdapter.cpp \
            src/sqlite_dbi/assembly/SingleTableAssemblyAdapter.cpp \
+           src/sqlite_dbi/util/SQLiteReadConnectionPool.cpp \
            src/sqlite_dbi/util/SqliteUpgrader.cpp \
            src/sqlite_dbi/util/SqliteUpgraderFrom_0_To_1_13.cpp \
+           src/sqlite_dbi/util/SqliteUpgraderFrom_1_13_To_1_25.cpp \
            src/tasks/BgzipTask.cpp \
            src/tasks/ConvertAssemblyToSamTask.cpp \
            src/tasks/ConvertFileTask.cpp \
@@ -0,0 +1,323 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/AppContext.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/DNASequence.h>
+#include <U2Core/IOAdapter.h>
+#include <U2Core/MemoryMappedFileAdapter.h>
+#include <U2Core/TextUtils.h>
+#include <U2Core/U2AlphabetUtils.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "FastqFormat.h"
+#include "FastqParallelReader.h"
+
+namespace U2 {
+
+const qint64 FastqParallelReader::DEFAULT_CHUNK_SIZE = 8 * 1024 * 1024;
+
+namespace {
+
+const qint64 LAYOUT_CHECK_SIZE = 1024 * 1024;
+const unsigned long CANCEL_CHECK_INTERVAL = 100;
+const int MAX_RESYNC_LINES = 8;
+
+struct FastqLine {
+    FastqLine() : start(0), length(0) {}
+    const char* start;
+    int length;
+};
+
+/** Reads the line that starts at @pos without the terminator and surrounding whitespace, @pos is moved to the next line */
+inline bool readLine(const char* data, qint64 size, qint64& pos, FastqLine& line) {
+    CHECK(pos < size, false);
+    const char* begin = data + pos;
+    const char* eol = static_cast<const char*>(memchr(begin, '\n', size - pos));
+    const char* end = (NULL == eol) ? data + size : eol;
+    pos = (NULL == eol) ? size : (eol - data) + 1;
+
+    while (begin < end && TextUtils::WHITES[(uchar)*begin]) {
+        begin++;
+    }
+    while (end > begin && TextUtils::WHITES[(uchar)*(end - 1)]) {
+        end--;
+    }
+    line.start = begin;
+    line.length = end - begin;
+    return true;
+}
+
+struct FastqRecord {
+    FastqLine header;
+    FastqLine sequence;
+    FastqLine plus;
+    FastqLine quality;
+};
+
+/** Moves @pos to the beginning of the first non-empty line */
+inline void skipEmptyLines(const char* data, qint64 size, qint64& pos) {
+    FastqLine line;
+    qint64 lineStart = pos;
+    while (readLine(data, size, pos, line) && 0 == line.length) {
+        lineStart = pos;
+    }
+    pos = lineStart;
+}
+
+/** Parses a 4-line record that starts at @pos. Returns false at the end of the data or on error */
+inline bool readRecord(const char* data, qint64 size, qint64& pos, FastqRecord& record, QString& error) {
+    CHECK(readLine(data, size, pos, record.header), false);
+    if (0 == record.header.length || '@' != record.header.start[0]
+        || !readLine(data, size, pos, record.sequence)
+        || !readLine(data, size, pos, record.plus) || 0 == record.plus.length || '+' != record.plus.start[0]
+        || !readLine(data, size, pos, record.quality))
+    {
+        error = FastqFormat::tr("Error while trying to find sequence name start");
+        return false;
+    }
+    if (record.sequence.length != record.quality.length) {
+        error = FastqFormat::tr("Bad quality scores: inconsistent size.");
+        return false;
+    }
+    if (record.plus.length > 1 && (record.plus.length != record.header.length
+        || 0 != memcmp(record.plus.start + 1, record.header.start + 1, record.header.length - 1)))
+    {
+        error = FastqFormat::tr("Sequence name differs from quality scores name: %1 and %2")
+            .arg(QString::fromLatin1(record.header.start + 1, record.header.length - 1))
+            .arg(QString::fromLatin1(record.plus.start + 1, record.plus.length - 1));
+        return false;
+    }
+    return true;
+}
+
+/** Checks that a record starts at @pos (that is a line start) */
+inline bool isRecordStart(const char* data, qint64 size, qint64 pos) {
+    CHECK(pos < size && '@' == data[pos], false);
+    FastqRecord record;
+    QString error;
+    return readRecord(data, size, pos, record, error);
+}
+
+/** Returns the position of the first record that starts at @from or after it */
+qint64 findRecordStart(const char* data, qint64 size, qint64 from) {
+    CHECK(from > 0, 0);
+    qint64 pos = from;
+    if ('\n' != data[pos - 1]) {
+        const char* eol = static_cast<const char*>(memchr(data + pos, '\n', size - pos));
+        CHECK(NULL != eol, size);
+        pos = (eol - data) + 1;
+    }
+    FastqLine line;
+    for (int i = 0; i < MAX_RESYNC_LINES && pos < size; i++) {
+        if (isRecordStart(data, size, pos)) {
+            return pos;
+        }
+        readLine(data, size, pos, line);
+    }
+    return pos < size ? -1 : size;
+}
+
+DNASequence* createSequence(const FastqRecord& record, const DNAAlphabet* alphabet) {
+    QByteArray seq(record.sequence.start, record.sequence.length);
+    if (!alphabet->isCaseSensitive()) {
+        TextUtils::translate(TextUtils::UPPER_CASE_MAP, seq.data(), seq.length());
+    }
+    QString name = QString::fromLatin1(record.header.start + 1, record.header.length - 1);
+    DNASequence* result = new DNASequence(name, seq, alphabet);
+    result->quality = DNAQuality(QByteArray(record.quality.start, record.quality.length));
+    return result;
+}
+
+}
+
+/************************************************************************/
+/* FastqParseChunksTask */
+/************************************************************************/
+FastqParseChunksTask::FastqParseChunksTask(FastqParallelReader* reader)
+    : Task(tr("Parse FASTQ chunks"), TaskFlag_None), reader(reader)
+{
+}
+
+void FastqParseChunksTask::run() {
+    reader->parseChunks(stateInfo);
+}
+
+/************************************************************************/
+/* FastqParallelReader */
+/************************************************************************/
+FastqParallelReader::FastqParallelReader(qint64 chunkSize)
+    : chunkSize(qMax(qint64(1), chunkSize)), io(NULL), data(NULL), size(0),
+      chunksCount(0), parseTasksCount(0), nextChunk(0), consumedChunks(0), stopped(false)
+{
+}
+
+FastqParallelReader::~FastqParallelReader() {
+    stop();
+    foreach (Batch* batch, readyBatches) {
+        qDeleteAll(batch->sequences);
+        delete batch;
+    }
+    delete io;
+}
+
+bool FastqParallelReader::open(const GUrl& url) {
+    SAFE_POINT(NULL == io, "The reader is already opened", false);
+    IOAdapterFactory* factory = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::MEMORY_MAPPED_LOCAL_FILE);
+    SAFE_POINT(NULL != factory, "Memory mapped IO adapter factory is NULL", false);
+    io = qobject_cast<MemoryMappedFileAdapter*>(factory->createIOAdapter());
+    SAFE_POINT(NULL != io, "Memory mapped IO adapter is NULL", false);
+    CHECK_EXT(io->open(url, IOAdapterMode_Read), delete io; io = NULL, false);
+
+    data = io->getMappedData();
+    size = io->getMappedSize();
+
+    // multi-line records can't be resynchronized: check the layout of the beginning of the file
+    qint64 pos = 0;
+    qint64 checkSize = qMin(size, LAYOUT_CHECK_SIZE);
+    FastqRecord record;
+    QString error;
+    int recordsCount = 0;
+    skipEmptyLines(data, size, pos);
+    while (pos < checkSize && readRecord(data, size, pos, record, error)) {
+        recordsCount++;
+        skipEmptyLines(data, size, pos);
+    }
+    CHECK_EXT(error.isEmpty() && recordsCount > 0, delete io; io = NULL, false);
+
+    chunksCount = int((size + chunkSize - 1) / chunkSize);
+    return true;
+}
+
+QList<Task*> FastqParallelReader::createParseTasks(int tasksCount) {
+    QList<Task*> tasks;
+    QMutexLocker locker(&lock);
+    CHECK(NULL != io && !stopped, tasks);
+    for (int i = 0; i < tasksCount; i++) {
+        tasks << new FastqParseChunksTask(this);
+    }
+    parseTasksCount += tasks.size();
+    return tasks;
+}
+
+void FastqParallelReader::stop() {
+    QMutexLocker locker(&lock);
+    stopped = true;
+    canProduce.wakeAll();
+}
+
+QList<DNASequence*> FastqParallelReader::takeNextBatch(U2OpStatus& os) {
+    QMutexLocker locker(&lock);
+    CHECK(consumedChunks < chunksCount, QList<DNASequence*>());
+    const int chunkIndex = consumedChunks;
+    Batch* batch = NULL;
+    if (!readyBatches.contains(chunkIndex) && nextChunk == chunkIndex) {
+        // no task has taken the chunk yet, e.g. all threads are busy
+        nextChunk++;
+        locker.unlock();
+        batch = parseChunk(chunkIndex);
+        locker.relock();
+    } else {
+        while (!readyBatches.contains(chunkIndex)) {
+            batchReady.wait(&lock);
+        }
+        batch = readyBatches.take(chunkIndex);
+    }
+    consumedChunks++;
+    canProduce.wakeAll();
+    locker.unlock();
+
+    // the chunk is not needed anymore: records start in their own chunks
+    io->releasePages(qint64(chunkIndex) * chunkSize, chunkSize);
+
+    QList<DNASequence*> result = batch->sequences;
+    if (!batch->error.isEmpty()) {
+        os.setError(batch->error);
+    }
+    delete batch;
+    return result;
+}
+
+bool FastqParallelReader::isEnd() const {
+    QMutexLocker locker(&lock);
+    return consumedChunks >= chunksCount;
+}
+
+int FastqParallelReader::getProgress() const {
+    QMutexLocker locker(&lock);
+    CHECK(chunksCount > 0, 100);
+    return 100 * consumedChunks / chunksCount;
+}
+
+void FastqParallelReader::parseChunks(TaskStateInfo& ti) {
+    forever {
+        int chunkIndex = acquireChunk(ti);
+        if (chunkIndex < 0) {
+            break;
+        }
+        putBatch(chunkIndex, parseChunk(chunkIndex));
+    }
+}
+
+int FastqParallelReader::acquireChunk(TaskStateInfo& ti) {
+    QMutexLocker locker(&lock);
+    // at most two chunks per task are kept in memory
+    while (!stopped && !ti.cancelFlag && nextChunk < chunksCount && nextChunk - consumedChunks >= 2 * parseTasksCount) {
+        // the task cancelation is not signaled: check it from time to time
+        canProduce.wait(&lock, CANCEL_CHECK_INTERVAL);
+    }
+    CHECK(!stopped && !ti.cancelFlag && nextChunk < chunksCount, -1);
+    return nextChunk++;
+}
+
+void FastqParallelReader::putBatch(int chunkIndex, Batch* batch) {
+    QMutexLocker locker(&lock);
+    readyBatches.insert(chunkIndex, batch);
+    batchReady.wakeAll();
+}
+
+FastqParallelReader::Batch* FastqParallelReader::parseChunk(int chunkIndex) const {
+    Batch* batch = new Batch();
+    const qint64 chunkStart = chunkIndex * chunkSize;
+    const qint64 chunkEnd = qMin(size, chunkStart + chunkSize);
+
+    qint64 pos = findRecordStart(data, size, chunkStart);
+    if (pos < 0) {
+        batch->error = FastqFormat::tr("Error while trying to find sequence name start");
+        return batch;
+    }
+
+    const DNAAlphabet* alphabet = U2AlphabetUtils::getById(BaseDNAAlphabetIds::NUCL_DNA_EXTENDED());
+    SAFE_POINT_EXT(NULL != alphabet, batch->error = "FastqParallelReader: alphabet is NULL", batch);
+
+    FastqRecord record;
+    skipEmptyLines(data, size, pos);
+    while (pos < chunkEnd) {
+        if (!readRecord(data, size, pos, record, batch->error)) {
+            break;
+        }
+        batch->sequences << createSequence(record, alphabet);
+        skipEmptyLines(data, size, pos);
+    }
+    return batch;
+}
+
+}//namespace
@@ -0,0 +1,117 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_FASTQ_PARALLEL_READER_H_
+#define _U2_FASTQ_PARALLEL_READER_H_
+
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
+
+#include <U2Core/GUrl.h>
+#include <U2Core/Task.h>
+#include <U2Core/U2OpStatus.h>
+
+namespace U2 {
+
+class DNASequence;
+class FastqParallelReader;
+class MemoryMappedFileAdapter;
+
+/** Parses the chunks of the reader until there are no more chunks or the reader is stopped */
+class U2FORMATS_EXPORT FastqParseChunksTask : public Task {
+    Q_OBJECT
+public:
+    FastqParseChunksTask(FastqParallelReader* reader);
+    void run();
+
+private:
+    FastqParallelReader* reader;
+};
+
+/**
+ * Reads a FASTQ file with one line per sequence and one line per quality string by large chunks.
+ * The file is memory mapped and split into chunks. Each chunk is parsed from the first record that starts inside it:
+ * a record is started by a '@' line that is followed by a sequence line, a '+' line and a quality line of the same length.
+ * Records crossing the end of a chunk are parsed by the chunk they start in. The parsed batches are returned in the file order.
+ * The chunks are parsed in advance by the tasks from createParseTasks(), that are run by the task scheduler.
+ * If the next chunk is not taken by a task, it is parsed by the caller of takeNextBatch().
+ */
+class U2FORMATS_EXPORT FastqParallelReader {
+    friend class FastqParseChunksTask;
+public:
+    FastqParallelReader(qint64 chunkSize = DEFAULT_CHUNK_SIZE);
+    /** The parse tasks must be finished before the reader is deleted */
+    ~FastqParallelReader();
+
+    /**
+     * Maps the file.
+     * Returns false if the file can't be mapped or its beginning doesn't look like a 4-line FASTQ file:
+     * such files should be read with FastqFormat::loadSequence.
+     */
+    bool open(const GUrl& url);
+
+    /** Creates the tasks to parse the chunks in advance, the caller takes the ownership */
+    QList<Task*> createParseTasks(int tasksCount);
+
+    /** Stops the parse tasks, the rest chunks are parsed by takeNextBatch() */
+    void stop();
+
+    /** Returns the sequences of the next chunk, the caller takes the ownership. An empty list means the end of the file. */
+    QList<DNASequence*> takeNextBatch(U2OpStatus& os);
+
+    bool isEnd() const;
+
+    int getProgress() const;
+
+    static const qint64 DEFAULT_CHUNK_SIZE;
+
+private:
+    struct Batch {
+        QList<DNASequence*> sequences;
+        QString error;
+    };
+
+    void parseChunks(TaskStateInfo& ti);
+    int acquireChunk(TaskStateInfo& ti);
+    void putBatch(int chunkIndex, Batch* batch);
+    Batch* parseChunk(int chunkIndex) const;
+
+    const qint64                chunkSize;
+    MemoryMappedFileAdapter*    io;
+    const char*                 data;
+    qint64                      size;
+    int                         chunksCount;
+
+    int                         parseTasksCount;
+    QMap<int, Batch*>           readyBatches;
+    int                         nextChunk;
+    int                         consumedChunks;
+    bool                        stopped;
+
+    mutable QMutex              lock;
+    QWaitCondition              batchReady;
+    QWaitCondition              canProduce;
+};
+
+}//namespace
+
+#endif
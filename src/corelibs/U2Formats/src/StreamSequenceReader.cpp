@@ -22,9 +22,12 @@
 #include <U2Core/AppContext.h>
 #include <U2Core/DocumentModel.h>
 #include <U2Core/DocumentUtils.h>
+#include <U2Core/BaseDocumentFormats.h>
 #include <U2Core/IOAdapter.h>
+#include <U2Core/IOAdapterUtils.h>
 #include <U2Core/Timer.h>
 
+#include "FastqParallelReader.h"
 #include "StreamSequenceReader.h"
 
 namespace U2 {
@@ -56,7 +59,7 @@ bool StreamSequenceReader::hasNext() {
 
         while (currentReaderIndex < readers.count()) {
             ReaderContext ctx = readers.at(currentReaderIndex);
-            DNASequence *newSeq = ctx.format->loadSequence(ctx.io, taskInfo);
+            DNASequence *newSeq = (NULL != ctx.parallelReader) ? takeNextParallelSequence(ctx) : ctx.format->loadSequence(ctx.io, taskInfo);
             currentSeq.reset(newSeq);
             if (NULL == newSeq) {
                 ++currentReaderIndex;
@@ -75,7 +78,15 @@ bool StreamSequenceReader::hasNext() {
     return true;
 }
 
-bool StreamSequenceReader::init( const QList<GUrl>& urls ) {
+DNASequence* StreamSequenceReader::takeNextParallelSequence(const ReaderContext& ctx) {
+    // a chunk can contain no record starts, e.g. when it is covered by a long record
+    while (currentBatch.isEmpty() && !ctx.parallelReader->isEnd() && !taskInfo.hasError()) {
+        currentBatch = ctx.parallelReader->takeNextBatch(taskInfo);
+    }
+    return currentBatch.isEmpty() ? NULL : currentBatch.takeFirst();
+}
+
+bool StreamSequenceReader::init(const QList<GUrl>& urls, bool parallelFastqReading) {
     foreach (const GUrl& url, urls) {
         QList<FormatDetectionResult> detectedFormats = DocumentUtils::detectFormat(url);
         if (detectedFormats.isEmpty()) {
@@ -87,6 +98,17 @@ bool StreamSequenceReader::init( const QList<GUrl>& urls ) {
         if ( ctx.format->getFlags().testFlag(DocumentFormatFlag_SupportStreaming) == false  ) {
             break;
         }
+        if (parallelFastqReading && ctx.format->getFormatId() == BaseDocumentFormats::FASTQ
+            && IOAdapterUtils::url2io(url) == BaseIOAdapters::LOCAL_FILE)
+        {
+            FastqParallelReader* parallelReader = new FastqParallelReader();
+            if (parallelReader->open(url)) {
+                ctx.parallelReader = parallelReader;
+                readers.append(ctx);
+                continue;
+            }
+            delete parallelReader;
+        }
         IOAdapterFactory* factory = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::LOCAL_FILE);
         IOAdapter* io = factory->createIOAdapter();
         if (!io->open(url, IOAdapterMode_Read)) {
@@ -107,6 +129,24 @@ bool StreamSequenceReader::init( const QList<GUrl>& urls ) {
 
 }
 
+QList<Task*> StreamSequenceReader::createParallelReadingTasks(int tasksCount) {
+    QList<Task*> tasks;
+    foreach (const ReaderContext& ctx, readers) {
+        if (NULL != ctx.parallelReader) {
+            tasks << ctx.parallelReader->createParseTasks(tasksCount);
+        }
+    }
+    return tasks;
+}
+
+void StreamSequenceReader::stopParallelReading() {
+    foreach (const ReaderContext& ctx, readers) {
+        if (NULL != ctx.parallelReader) {
+            ctx.parallelReader->stop();
+        }
+    }
+}
+
 QString StreamSequenceReader::getErrorMessage() {
     return taskInfo.getError();
 }
@@ -119,16 +159,20 @@ int StreamSequenceReader::getProgress() {
     float factor = 1/readers.count();
     int progress = 0;
     for (int i = 0; i < readers.count(); ++i) {
-        progress += (int)(factor * readers[i].io->getProgress());
+        const ReaderContext& ctx = readers[i];
+        progress += (int)(factor * (NULL != ctx.parallelReader ? ctx.parallelReader->getProgress() : ctx.io->getProgress()));
     }
 
     return progress;
 }
 
 StreamSequenceReader::~StreamSequenceReader() {
+    qDeleteAll(currentBatch);
     for(int i =0; i < readers.size(); ++i) {
         delete readers[i].io;
         readers[i].io = NULL;
+        delete readers[i].parallelReader;
+        readers[i].parallelReader = NULL;
     }
 }
 
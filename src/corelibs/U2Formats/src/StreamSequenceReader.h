@@ -34,6 +34,7 @@ namespace U2 {
 
 class Document;
 class DocumentFormat;
+class FastqParallelReader;
 class IOAdapter;
 
 /**
@@ -44,18 +45,23 @@ class IOAdapter;
 * Note, that document format has to support DocumentReadMode_SingleObject
 * to be read by StreamSequenceReader.
 * In case of multiple files, they will be read subsequently.
+* Plain FASTQ files can be parsed in several threads, see FastqParallelReader.
 *
 */
 
 class U2FORMATS_EXPORT StreamSequenceReader {
     struct ReaderContext {
-        ReaderContext() : io(NULL), format(NULL) {}
+        ReaderContext() : io(NULL), format(NULL), parallelReader(NULL) {}
         IOAdapter* io;
         DocumentFormat* format;
+        FastqParallelReader* parallelReader;
     };
+    DNASequence* takeNextParallelSequence(const ReaderContext& ctx);
+
     QList<ReaderContext> readers;
     int currentReaderIndex;
     QScopedPointer<DNASequence> currentSeq;
+    QList<DNASequence*> currentBatch;
     bool errorOccured;
     bool lookupPerformed;
     QString errorMessage;
@@ -64,7 +70,12 @@ class U2FORMATS_EXPORT StreamSequenceReader {
 public:
     StreamSequenceReader();
     ~StreamSequenceReader();
-    bool init(const QList<GUrl>& urls);
+    /** If @parallelFastqReading is set, FASTQ files can be parsed in advance by the tasks from createParallelReadingTasks() */
+    bool init(const QList<GUrl>& urls, bool parallelFastqReading = false);
+    /** Creates @tasksCount tasks per FASTQ file, the caller runs them as subtasks and must not delete the reader before they are finished */
+    QList<Task*> createParallelReadingTasks(int tasksCount);
+    /** Stops the parallel reading tasks, the rest of the files is read by hasNext() */
+    void stopParallelReading();
     bool hasNext();
     bool hasError() { return errorOccured; }
     int getProgress();
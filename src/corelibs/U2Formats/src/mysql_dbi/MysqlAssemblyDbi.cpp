@@ -345,6 +345,15 @@ void MysqlAssemblyDbi::addReads(const U2DataId& assemblyId, U2DbiIterator<U2Asse
     }
 }
 
+void MysqlAssemblyDbi::addPackedReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os) {
+    MysqlAssemblyAdapter* a = getAdapter(assemblyId, os);
+    if ( a != NULL ) {
+        U2AssemblyReadsImportInfo ii;
+        ii.prepacked = true;
+        addReads(a, it, ii, os);
+    }
+}
+
 
 /**  Packs assembly rows: assigns packedViewRow value for every read in assembly */
 void MysqlAssemblyDbi::pack(const U2DataId& assemblyId, U2AssemblyPackStat& stat, U2OpStatus& os) {
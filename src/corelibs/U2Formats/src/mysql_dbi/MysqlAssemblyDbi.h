@@ -115,6 +115,12 @@ public:
     */
     virtual void addReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os);
 
+    /**
+        Adds reads with the packed rows already assigned, the rows are stored as is
+        Reads got their ids assigned.
+    */
+    virtual void addPackedReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os);
+
     /**  Packs assembly rows: assigns packedViewRow value for every read in assembly */
     virtual void pack(const U2DataId& assemblyId, U2AssemblyPackStat& stat, U2OpStatus& os);
 
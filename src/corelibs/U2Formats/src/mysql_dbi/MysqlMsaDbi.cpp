@@ -512,6 +512,23 @@ void MysqlMsaDbi::updateGapModel(const U2DataId& msaId, qint64 msaRowId, const Q
     updateAction.complete(os);
 }
 
+void MysqlMsaDbi::updateGapModels(const U2DataId& msaId, const QMap<qint64, QList<U2MsaGap> >& rowsGapModel, U2OpStatus& os) {
+    MysqlTransaction t(db, os);
+    Q_UNUSED(t);
+
+    MysqlModificationAction updateAction(dbi, msaId);
+    updateAction.prepare(os);
+    CHECK_OP(os, );
+
+    QMap<qint64, QList<U2MsaGap> >::const_iterator it = rowsGapModel.constBegin();
+    for (; it != rowsGapModel.constEnd(); ++it) {
+        updateGapModel(updateAction, msaId, it.key(), it.value(), os);
+        CHECK_OP(os, );
+    }
+
+    updateAction.complete(os);
+}
+
 void MysqlMsaDbi::updateMsaLength(const U2DataId& msaId, qint64 length, U2OpStatus& os) {
     MysqlTransaction t(db, os);
     Q_UNUSED(t);
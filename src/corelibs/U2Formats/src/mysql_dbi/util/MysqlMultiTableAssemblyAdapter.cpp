@@ -215,7 +215,7 @@ void MysqlMultiTableAssemblyAdapter::addReads(U2DbiIterator<U2AssemblyRead>* it,
         CHECK_OP(os, );
     }
 
-    bool packIsOn = empty;
+    bool packIsOn = empty && !ii.prepacked;
     qint64 prevLeftmostPos = -1;
     PackAlgorithmContext packContext;
 
@@ -232,8 +232,10 @@ void MysqlMultiTableAssemblyAdapter::addReads(U2DbiIterator<U2AssemblyRead>* it,
             read->effectiveLen = readLen + U2AssemblyUtils::getCigarExtraLength(read->cigar);
             int elenPos = getElenRangePosByLength(read->effectiveLen);
 
-            packIsOn = packIsOn && (read->leftmostPos >= prevLeftmostPos);
-            read->packedViewRow = packIsOn ? AssemblyPackAlgorithm::packRead(U2Region(read->leftmostPos, read->effectiveLen), packContext, os) : 0;
+            if (!ii.prepacked) {
+                packIsOn = packIsOn && (read->leftmostPos >= prevLeftmostPos);
+                read->packedViewRow = packIsOn ? AssemblyPackAlgorithm::packRead(U2Region(read->leftmostPos, read->effectiveLen), packContext, os) : 0;
+            }
             int rowPos = getRowRangePosByRow(read->packedViewRow);
             ensureGridSize(readsGrid, rowPos, nElens);
             readsGrid[rowPos][elenPos] << read;
@@ -276,6 +278,9 @@ void MysqlMultiTableAssemblyAdapter::addReads(U2DbiIterator<U2AssemblyRead>* it,
         ii.packStat.maxProw = packContext.maxProw;
         ii.packed = true;
         flushTables(os);
+    } else if (ii.prepacked && !os.hasError()) {
+        // the row ranges could be added
+        flushTables(os);
     }
 }
 
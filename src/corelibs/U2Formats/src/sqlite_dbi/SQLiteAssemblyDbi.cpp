@@ -60,6 +60,7 @@ void SQLiteAssemblyDbi::initSqlSchema(U2OpStatus& os) {
 }
 
 void SQLiteAssemblyDbi::shutdown(U2OpStatus& os) {
+    QMutexLocker locker(&adaptersLock);
     foreach(AssemblyAdapter* a, adaptersById.values()) {
         a->shutdown(os);
         delete a;
@@ -69,12 +70,16 @@ void SQLiteAssemblyDbi::shutdown(U2OpStatus& os) {
 
 AssemblyAdapter* SQLiteAssemblyDbi::getAdapter(const U2DataId& assemblyId, U2OpStatus& os) {
     qint64 sqliteId = U2DbiUtils::toDbiId(assemblyId);
-    AssemblyAdapter* res = adaptersById.value(sqliteId);
+    AssemblyAdapter* res = NULL;
+    {
+        QMutexLocker locker(&adaptersLock);
+        res = adaptersById.value(sqliteId);
+    }
     if (res != NULL) {
         return res;
     }
 
-    SQLiteQuery q("SELECT imethod, cmethod FROM Assembly WHERE object = ?1", db, os);
+    SQLiteQuery q("SELECT imethod, cmethod FROM Assembly WHERE object = ?1", dbi->getReadDbRef(), os);
     q.bindDataId(1, assemblyId);
     if (!q.step()) {
         os.setError(U2DbiL10n::tr("There is no assembly object with the specified id."));
@@ -87,7 +92,9 @@ AssemblyAdapter* SQLiteAssemblyDbi::getAdapter(const U2DataId& assemblyId, U2OpS
 
 
     if (indexMethod == SQLITE_DBI_ASSEMBLY_READ_ELEN_METHOD_SINGLE_TABLE) {
-        res = new SingleTableAssemblyAdapter(dbi, assemblyId, 'S', "", NULL, db, os);
+        SingleTableAssemblyAdapter* sa = new SingleTableAssemblyAdapter(dbi, assemblyId, 'S', "", NULL, db, os);
+        sa->setCoverageTable(QSharedPointer<AssemblyCoverageTable>(new AssemblyCoverageTable(dbi, assemblyId)));
+        res = sa;
     } else if (indexMethod == SQLITE_DBI_ASSEMBLY_READ_ELEN_METHOD_MULTITABLE_V1) {
         res = new MultiTableAssemblyAdapter(dbi, assemblyId, NULL, db, os);
     } else if (indexMethod == SQLITE_DBI_ASSEMBLY_READ_ELEN_METHOD_RTREE) {
@@ -96,6 +103,14 @@ AssemblyAdapter* SQLiteAssemblyDbi::getAdapter(const U2DataId& assemblyId, U2OpS
         os.setError(U2DbiL10n::tr("Unsupported reads storage type: %1").arg(indexMethod));
         return NULL;
     }
+
+    // the adapter is created without the lock: its constructor can wait for the main connection
+    QMutexLocker locker(&adaptersLock);
+    AssemblyAdapter* created = adaptersById.value(sqliteId);
+    if (created != NULL) {
+        delete res;
+        return created;
+    }
     adaptersById[sqliteId] = res;
     return res;
 }
@@ -110,7 +125,7 @@ U2Assembly SQLiteAssemblyDbi::getAssemblyObject(const U2DataId& assemblyId, U2Op
     CHECK_OP(os, res);
 
     SQLiteQuery q("SELECT Assembly.reference, Object.type, '' FROM Assembly, Object "
-                  " WHERE Assembly.object = ?1 AND Object.id = Assembly.reference", db, os);
+                  " WHERE Assembly.object = ?1 AND Object.id = Assembly.reference", dbi->getReadDbRef(), os);
 
     q.bindDataId(1, assemblyId);
     if (q.step())  {
@@ -318,6 +333,15 @@ void SQLiteAssemblyDbi::addReads(const U2DataId& assemblyId, U2DbiIterator<U2Ass
     }
 }
 
+void SQLiteAssemblyDbi::addPackedReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os) {
+    AssemblyAdapter* a = getAdapter(assemblyId, os);
+    if ( a != NULL ) {
+        U2AssemblyReadsImportInfo ii;
+        ii.prepacked = true;
+        addReads(a, it, ii, os);
+    }
+}
+
 
 /**  Packs assembly rows: assigns packedViewRow value for every read in assembly */
 void SQLiteAssemblyDbi::pack(const U2DataId& assemblyId, U2AssemblyPackStat& stat, U2OpStatus& os) {
@@ -358,8 +382,231 @@ static QByteArray getQuality(const U2AssemblyRead &read) {
     return QByteArray(read->readSequence.length(), char(0xFF));
 }
 
+#define BINARY_SEQ_2BIT        0
+#define BINARY_SEQ_4BIT        1
+#define BINARY_SEQ_RAW         2
+#define BINARY_SEQ_MASK        3
+#define BINARY_HAS_QUALITY     (1 << 2)
+#define BINARY_HAS_MATE_INFO   (1 << 3)
+
+/** BAM 4-bit nucleotide codes, the index of a char is its code */
+static const char NT16_CHARS[] = "=ACMGRSVTWYHKDBN";
+static const char NT4_CHARS[] = "ACGT";
+
+static void appendVarint(QByteArray& res, quint64 value) {
+    while (value >= 0x80) {
+        res.append(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    res.append(char(value));
+}
+
+static quint64 readVarint(const QByteArray& data, int& pos, U2OpStatus& os) {
+    quint64 res = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= data.length()) {
+            os.setError(U2DbiL10n::tr("Data is corrupted, unexpected end of the packed read"));
+            return 0;
+        }
+        quint8 c = quint8(data.at(pos++));
+        res |= quint64(c & 0x7F) << shift;
+        if ((c & 0x80) == 0) {
+            return res;
+        }
+    }
+    os.setError(U2DbiL10n::tr("Data is corrupted, invalid number in the packed read"));
+    return 0;
+}
+
+static void appendBytes(QByteArray& res, const QByteArray& bytes) {
+    appendVarint(res, bytes.length());
+    res.append(bytes);
+}
+
+static QByteArray readBytes(const QByteArray& data, int& pos, U2OpStatus& os) {
+    qint64 len = (qint64)readVarint(data, pos, os);
+    CHECK_OP(os, QByteArray());
+    if (len > data.length() - pos) {
+        os.setError(U2DbiL10n::tr("Data is corrupted, unexpected end of the packed read"));
+        return QByteArray();
+    }
+    QByteArray res(data.constData() + pos, (int)len);
+    pos += (int)len;
+    return res;
+}
+
+static QVector<qint8> createCharCodes(const char* chars) {
+    QVector<qint8> res(256, -1);
+    for (int i = 0; chars[i] != 0; i++) {
+        res[quint8(chars[i])] = qint8(i);
+    }
+    return res;
+}
+
+static int getSequenceEncoding(const QByteArray& seq) {
+    static const QVector<qint8> nt4Codes = createCharCodes(NT4_CHARS);
+    static const QVector<qint8> nt16Codes = createCharCodes(NT16_CHARS);
+    int res = BINARY_SEQ_2BIT;
+    const char* data = seq.constData();
+    for (int i = 0, n = seq.length(); i < n; i++) {
+        quint8 c = quint8(data[i]);
+        if (nt4Codes[c] >= 0) {
+            continue;
+        }
+        if (nt16Codes[c] < 0) {
+            return BINARY_SEQ_RAW;
+        }
+        res = BINARY_SEQ_4BIT;
+    }
+    return res;
+}
+
+static void appendSequence(QByteArray& res, const QByteArray& seq, int encoding) {
+    static const QVector<qint8> nt4Codes = createCharCodes(NT4_CHARS);
+    static const QVector<qint8> nt16Codes = createCharCodes(NT16_CHARS);
+    if (encoding == BINARY_SEQ_RAW) {
+        res.append(seq);
+        return;
+    }
+    const QVector<qint8>& codes = encoding == BINARY_SEQ_2BIT ? nt4Codes : nt16Codes;
+    const int bitsPerChar = encoding == BINARY_SEQ_2BIT ? 2 : 4;
+    const int charsPerByte = 8 / bitsPerChar;
+    const char* data = seq.constData();
+    int len = seq.length();
+    for (int i = 0; i < len; i += charsPerByte) {
+        quint8 byte = 0;
+        for (int j = 0; j < charsPerByte && i + j < len; j++) {
+            byte |= quint8(codes[quint8(data[i + j])]) << (j * bitsPerChar);
+        }
+        res.append(char(byte));
+    }
+}
+
+static QByteArray readSequence(const QByteArray& data, int& pos, int len, int encoding, U2OpStatus& os) {
+    int bitsPerChar = 8;
+    const char* chars = NULL;
+    if (encoding == BINARY_SEQ_2BIT) {
+        bitsPerChar = 2;
+        chars = NT4_CHARS;
+    } else if (encoding == BINARY_SEQ_4BIT) {
+        bitsPerChar = 4;
+        chars = NT16_CHARS;
+    } else if (encoding != BINARY_SEQ_RAW) {
+        os.setError(U2DbiL10n::tr("Data is corrupted, unknown sequence encoding: %1").arg(encoding));
+        return QByteArray();
+    }
+    const int charsPerByte = 8 / bitsPerChar;
+    int nBytes = (len + charsPerByte - 1) / charsPerByte;
+    if (len < 0 || nBytes > data.length() - pos) {
+        os.setError(U2DbiL10n::tr("Data is corrupted, unexpected end of the packed read"));
+        return QByteArray();
+    }
+    if (encoding == BINARY_SEQ_RAW) {
+        QByteArray res(data.constData() + pos, len);
+        pos += len;
+        return res;
+    }
+    QByteArray res(len, Qt::Uninitialized);
+    char* resData = res.data();
+    const quint8* bytes = (const quint8*)data.constData() + pos;
+    const quint8 mask = quint8((1 << bitsPerChar) - 1);
+    for (int i = 0; i < len; i++) {
+        quint8 byte = bytes[i / charsPerByte];
+        resData[i] = chars[(byte >> ((i % charsPerByte) * bitsPerChar)) & mask];
+    }
+    pos += nBytes;
+    return res;
+}
+
+static QByteArray packBinary(const U2AssemblyRead &read) {
+    const QByteArray &seq = read->readSequence;
+    bool hasQuality = seq.length() == read->quality.length() && SamtoolsAdapter::hasQuality(read->quality);
+    bool hasMateInfo = read->rnext != "*" || read->pnext != 0 || !read->aux.isEmpty();
+    int encoding = getSequenceEncoding(seq);
+
+    QByteArray res;
+    res.reserve(16 + read->name.length() + seq.length() / 2 + 2 * read->cigar.size() + (hasQuality ? seq.length() : 0));
+    res.append('1');
+    res.append(char(encoding | (hasQuality ? BINARY_HAS_QUALITY : 0) | (hasMateInfo ? BINARY_HAS_MATE_INFO : 0)));
+    appendBytes(res, read->name);
+    appendVarint(res, seq.length());
+    appendSequence(res, seq, encoding);
+    appendVarint(res, read->cigar.size());
+    foreach (const U2CigarToken& t, read->cigar) {
+        appendVarint(res, (quint64(t.count) << 4) | quint64(t.op));
+    }
+    if (hasQuality) {
+        res.append(read->quality);
+    }
+    if (hasMateInfo) {
+        appendBytes(res, read->rnext);
+        // zig-zag encoding keeps small negative positions short
+        appendVarint(res, (quint64(read->pnext) << 1) ^ quint64(read->pnext >> 63));
+        appendBytes(res, SamtoolsAdapter::aux2string(read->aux));
+    }
+    return res;
+}
+
+static void unpackBinary(const QByteArray& packedData, U2AssemblyRead &read, U2OpStatus& os) {
+    if (packedData.length() < 2) {
+        os.setError(U2DbiL10n::tr("Data is corrupted, unexpected end of the packed read"));
+        return;
+    }
+    quint8 flags = quint8(packedData.at(1));
+    int pos = 2;
+
+    read->name = readBytes(packedData, pos, os);
+    CHECK_OP(os, );
+
+    int seqLen = (int)readVarint(packedData, pos, os);
+    CHECK_OP(os, );
+    read->readSequence = readSequence(packedData, pos, seqLen, flags & BINARY_SEQ_MASK, os);
+    CHECK_OP(os, );
+
+    int nTokens = (int)readVarint(packedData, pos, os);
+    CHECK_OP(os, );
+    QList<U2CigarToken> cigar;
+    for (int i = 0; i < nTokens; i++) {
+        quint64 token = readVarint(packedData, pos, os);
+        CHECK_OP(os, );
+        int op = int(token & 0xF);
+        if (op <= U2CigarOp_Invalid || op > U2CigarOp_X) {
+            os.setError(U2DbiL10n::tr("Data is corrupted, unknown CIGAR operation: %1").arg(op));
+            return;
+        }
+        cigar << U2CigarToken(U2CigarOp(op), int(token >> 4));
+    }
+    read->cigar = cigar;
+
+    if (flags & BINARY_HAS_QUALITY) {
+        if (seqLen > packedData.length() - pos) {
+            os.setError(U2DbiL10n::tr("Data is corrupted, unexpected end of the packed read"));
+            return;
+        }
+        read->quality = QByteArray(packedData.constData() + pos, seqLen);
+        pos += seqLen;
+    } else {
+        read->quality = QByteArray(seqLen, char(0xFF));
+    }
+
+    if (flags & BINARY_HAS_MATE_INFO) {
+        read->rnext = readBytes(packedData, pos, os);
+        CHECK_OP(os, );
+        quint64 pnext = readVarint(packedData, pos, os);
+        CHECK_OP(os, );
+        read->pnext = qint64(pnext >> 1) ^ -qint64(pnext & 1);
+        QByteArray aux = readBytes(packedData, pos, os);
+        CHECK_OP(os, );
+        read->aux = SamtoolsAdapter::string2aux(aux);
+    }
+}
+
 QByteArray SQLiteAssemblyUtils::packData(SQLiteAssemblyDataMethod method, const U2AssemblyRead &read, U2OpStatus& os)
 {
+    if (method == SQLiteAssemblyDataMethod_Binary) {
+        return packBinary(read);
+    }
+
     const QByteArray &name = read->name;
     const QByteArray &seq = read->readSequence;
     QByteArray cigarText = U2AssemblyUtils::cigar2String(read->cigar);
@@ -464,6 +711,10 @@ void SQLiteAssemblyUtils::unpackData(const QByteArray& packedData, U2AssemblyRea
     const char* data = packedData.constData();
 
     // packing type
+    if (data[0] == '1') {
+        unpackBinary(packedData, read, os);
+        return;
+    }
     if (data[0] != '0') {
         os.setError(U2DbiL10n::tr("Packing method prefix is not supported: %1").arg(data));
         return;
@@ -113,6 +113,12 @@ public:
     */
     virtual void addReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os);
 
+    /**
+        Adds reads with the packed rows already assigned, the rows are stored as is
+        Reads got their ids assigned.
+    */
+    virtual void addPackedReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os);
+
     /**  Packs assembly rows: assigns packedViewRow value for every read in assembly */
     virtual void pack(const U2DataId& assemblyId, U2AssemblyPackStat& stat, U2OpStatus& os);
 
@@ -138,6 +144,8 @@ private:
 
     /** Adapters by database assembly id */
     QHash<qint64, AssemblyAdapter*> adaptersById;
+    /** Guards adaptersById: in the WAL mode adapters are requested by readers without the main connection lock */
+    QMutex                          adaptersLock;
 };
 
 
@@ -154,13 +162,19 @@ protected:
 /** Compression method for assembly data */
 enum SQLiteAssemblyDataMethod {
     /** Merges Name, Sequence, Cigar and Quality values into single byte array separated by '\n' character. Merge prefix is '0'*/
-    SQLiteAssemblyDataMethod_NSCQ = 1
+    SQLiteAssemblyDataMethod_NSCQ = 1,
+    /**
+        Binary encoding with prefix '1': 2-bit (ACGT) or 4-bit (IUPAC) sequence, varint-coded CIGAR operations,
+        quality is stored only if it is present, mate info and aux are stored only if they differ from defaults
+    */
+    SQLiteAssemblyDataMethod_Binary = 2
 };
 
 class SQLiteAssemblyUtils {
 public:
     static QByteArray packData(SQLiteAssemblyDataMethod method, const U2AssemblyRead &read, U2OpStatus& os);
 
+    /** Detects the packing method by the prefix of the packed data */
     static void unpackData(const QByteArray& packed, U2AssemblyRead &read, U2OpStatus& os);
 
     static void calculateCoverage(SQLiteQuery& q, const U2Region& r, U2AssemblyCoverageStat& c, U2OpStatus& os);
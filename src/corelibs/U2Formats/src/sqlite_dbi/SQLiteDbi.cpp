@@ -31,7 +31,10 @@
 #include "SQLiteModDbi.h"
 #include "SQLiteUdrDbi.h"
 #include "util/SqliteUpgraderFrom_0_To_1_13.h"
+#include "util/SqliteUpgraderFrom_1_13_To_1_25.h"
+#include "util/SQLiteReadConnectionPool.h"
 
+#include <U2Core/U2OpStatusUtils.h>
 #include <U2Core/U2SafePoints.h>
 #include <U2Core/U2SqlHelpers.h>
 #include <U2Core/Log.h>
@@ -50,6 +53,8 @@ SQLiteDbi::SQLiteDbi()
     : U2AbstractDbi (SQLiteDbiFactory::ID)
 {
     db = new DbRef();
+    readConnections = NULL;
+    sequencePacking = false;
     objectDbi = new SQLiteObjectDbi(this);
     objectRelationsDbi = new SQLiteObjectRelationsDbi(this);
     sequenceDbi = new SQLiteSequenceDbi(this);
@@ -63,10 +68,12 @@ SQLiteDbi::SQLiteDbi()
     udrDbi = new SQLiteUdrDbi(this);
 
     upgraders << new SqliteUpgraderFrom_0_To_1_13(this);
+    upgraders << new SqliteUpgraderFrom_1_13_To_1_25(this);
 }
 
 SQLiteDbi::~SQLiteDbi() {
     SAFE_POINT( NULL == db->handle, "Invalid DB handle detected!", );
+    SAFE_POINT(NULL == readConnections, "Read-only connections are not closed!", );
 
     delete udrDbi;
     delete objectDbi;
@@ -195,10 +202,35 @@ void SQLiteDbi::stopOperationBlock(U2OpStatus& os) {
     }
 }
 
+DbRef* SQLiteDbi::getReadDbRef() const {
+    CHECK(NULL != readConnections, db);
+    if (db->lock.tryLock()) {
+        // a transaction keeps the lock of the main connection: its uncommitted changes are visible on that connection only
+        const bool ownTransaction = !db->transactionStack.isEmpty();
+        db->lock.unlock();
+        CHECK(!ownTransaction, db);
+    }
+    U2OpStatusImpl os;
+    DbRef* ref = readConnections->getDbRef(os);
+    CHECK_EXT(!os.hasError(), ioLog.error(os.getError()), db);
+    return ref;
+}
+
 QMutex * SQLiteDbi::getDbMutex( ) const {
     return &db->lock;
 }
 
+bool SQLiteDbi::isSequencePackingEnabled() const {
+    return sequencePacking;
+}
+
+void SQLiteDbi::raiseMinCompatibleVersion(const Version &version, U2OpStatus &os) {
+    const QString dbVersionText = getProperty(U2DbiOptions::APP_MIN_COMPATIBLE_VERSION, "0.0.0", os);
+    CHECK_OP(os, );
+    CHECK(Version::parseVersion(dbVersionText) < version, );
+    setProperty(U2DbiOptions::APP_MIN_COMPATIBLE_VERSION, version.text, os);
+}
+
 bool SQLiteDbi::isReadOnly() const {
     return SQLiteUtils::isDatabaseReadOnly(db, "main") == 1;
 }
@@ -351,13 +383,29 @@ void SQLiteDbi::init(const QHash<QString, QString>& props, const QVariantMap&, U
 
         SQLiteQuery("PRAGMA synchronous = OFF", db, os).execute();
         QString lockingMode = props.value(U2DbiOptions::U2_DBI_LOCKING_MODE, "exclusive");
-        if (lockingMode == "normal") {
+        // the WAL journal of an in-memory database can't be shared with other connections
+        bool walMode = lockingMode == "wal" && url != SQLITE_DBI_VALUE_MEMORY_DB_URL;
+        if (lockingMode == "normal" || walMode) {
             SQLiteQuery("PRAGMA main.locking_mode = NORMAL", db, os).execute();
         } else {
             SQLiteQuery("PRAGMA main.locking_mode = EXCLUSIVE", db, os).execute();
         }
         SQLiteQuery("PRAGMA temp_store = MEMORY", db, os).execute();
-        SQLiteQuery("PRAGMA journal_mode = MEMORY", db, os).execute();
+        sequencePacking = props.value(U2DbiOptions::U2_DBI_SEQUENCE_PACKING) == U2DbiOptions::U2_DBI_VALUE_ON;
+        if (walMode) {
+            // a read-only file can't be switched to WAL: it is opened as before
+            {
+                U2OpStatusImpl walOs;
+                SQLiteQuery journalModeQuery("PRAGMA journal_mode = WAL", db, walOs);
+                walMode = journalModeQuery.step() && !walOs.hasError() && journalModeQuery.getString(0).toLower() == "wal";
+            }
+            if (!walMode) {
+                coreLog.info(U2DbiL10n::tr("WAL journal mode is not supported for the database, the rollback journal is used: %1").arg(url));
+                SQLiteQuery("PRAGMA journal_mode = MEMORY", db, os).execute();
+            }
+        } else {
+            SQLiteQuery("PRAGMA journal_mode = MEMORY", db, os).execute();
+        }
         SQLiteQuery("PRAGMA cache_size = 50000", db, os).execute();
         SQLiteQuery("PRAGMA recursive_triggers = ON", db, os).execute();
         SQLiteQuery("PRAGMA foreign_keys = ON", db, os).execute();
@@ -380,6 +428,9 @@ void SQLiteDbi::init(const QHash<QString, QString>& props, const QVariantMap&, U
 
         dbiId = url;
         internalInit(props, os);
+        if (walMode && !os.hasError()) {
+            readConnections = new SQLiteReadConnectionPool(url);
+        }
         // OK, initialization complete
         if (!os.hasError()) {
             ioLog.trace(QString("SQLite: initialized: %1\n").arg(url));
@@ -423,6 +474,11 @@ QVariantMap SQLiteDbi::shutdown(U2OpStatus& os) {
     modDbi->shutdown(os);
 
     setState(U2DbiState_Stopping);
+    if (NULL != readConnections) {
+        readConnections->close();
+        delete readConnections;
+        readConnections = NULL;
+    }
     int rc = sqlite3_close(db->handle);
 
     if (rc != SQLITE_OK) {
@@ -43,6 +43,7 @@ class SQLiteVariantDbi;
 class SQLiteFeatureDbi;
 class SQLiteModDbi;
 class SQLiteUdrDbi;
+class SQLiteReadConnectionPool;
 class DbRef;
 
 /** Name of the init property used to indicate assembly reads storage method for all new assemblies */
@@ -124,6 +125,14 @@ public:
 
     DbRef*    getDbRef() const {return db;}
 
+    /**
+        Returns a connection for read-only queries.
+        In the WAL mode it is a read-only connection of the current thread,
+        unless the thread has an active transaction on the main connection.
+        Otherwise it is the main connection.
+    */
+    DbRef*    getReadDbRef() const;
+
     SQLiteObjectDbi* getSQLiteObjectDbi() const;
 
     SQLiteObjectRelationsDbi *getSQLiteObjectRelationsDbi() const;
@@ -155,6 +164,13 @@ public:
 
     bool isTransactionActive() const;
 
+    /** Returns true if the U2_DBI_SEQUENCE_PACKING option is on */
+    bool isSequencePackingEnabled() const;
+
+    /** Raises APP_MIN_COMPATIBLE_VERSION of the database up to @version if it is lower.
+        Must be called when the data that is unknown to the older versions is written */
+    void raiseMinCompatibleVersion(const Version &version, U2OpStatus &os);
+
     static const int BIND_PARAMETERS_LIMIT;
 
 private:
@@ -166,6 +182,8 @@ private:
 
     QString                             url;
     DbRef*                              db;
+    SQLiteReadConnectionPool*           readConnections;
+    bool                                sequencePacking;
 
     SQLiteObjectDbi*                    objectDbi;
     SQLiteObjectRelationsDbi *          objectRelationsDbi;
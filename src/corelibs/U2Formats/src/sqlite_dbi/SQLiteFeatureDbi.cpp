@@ -134,7 +134,7 @@ U2AnnotationTable SQLiteFeatureDbi::getAnnotationTableObject(const U2DataId &tab
 
     DBI_TYPE_CHECK(tableId, U2Type::AnnotationTable, os, result);
 
-    SQLiteQuery q("SELECT rootId, name FROM AnnotationTable, Object WHERE object = ?1 AND id = ?1", db, os);
+    SQLiteQuery q("SELECT rootId, name FROM AnnotationTable, Object WHERE object = ?1 AND id = ?1", dbi->getReadDbRef(), os);
     q.bindDataId(1, tableId);
     if (q.step()) {
         result.rootFeature = q.getDataId(0, U2Type::Feature);
@@ -162,7 +162,7 @@ U2Feature SQLiteFeatureDbi::getFeature(const U2DataId& featureId, U2OpStatus& os
     DBI_TYPE_CHECK(featureId, U2Type::Feature, os, res);
 
     const QString queryString("SELECT " + FDBI_FIELDS + " FROM Feature AS f WHERE id = ?1");
-    SQLiteQuery q(queryString, db, os);
+    SQLiteQuery q(queryString, dbi->getReadDbRef(), os);
     q.bindDataId(1, featureId);
     q.execute();
     CHECK_OP(os, res);
@@ -351,7 +351,7 @@ QSharedPointer<SQLiteQuery> SQLiteFeatureDbi::createFeatureQuery(const QString &
 
     QSharedPointer<SQLiteQuery> q;
     if (NULL == trans) {
-        q = QSharedPointer<SQLiteQuery>(new SQLiteQuery(fullQuery, db, os));
+        q = QSharedPointer<SQLiteQuery>(new SQLiteQuery(fullQuery, dbi->getReadDbRef(), os));
     } else {
         q = QSharedPointer<SQLiteQuery>(trans->getPreparedQuery(fullQuery, db, os));
         CHECK_OP(os, QSharedPointer<SQLiteQuery>());
@@ -419,9 +419,10 @@ U2DbiIterator<U2Feature>* SQLiteFeatureDbi::getFeatures(const FeatureQuery& fq,
 }
 
 QList<U2FeatureKey> SQLiteFeatureDbi::getFeatureKeys(const U2DataId& featureId, U2OpStatus& os) {
-    SQLiteTransaction t(db, os);
+    DbRef* readDb = dbi->getReadDbRef();
+    SQLiteTransaction t(readDb, os);
     static const QString queryString("SELECT name, value FROM FeatureKey WHERE feature = ?1");
-    SQLiteQuery q(queryString, db, os);
+    SQLiteQuery q(queryString, readDb, os);
 
     q.bindDataId(1, featureId);
     CHECK_OP(os, QList<U2FeatureKey>());
@@ -609,7 +610,7 @@ bool SQLiteFeatureDbi::getKeyValue(const U2DataId &featureId, U2FeatureKey &key,
     DBI_TYPE_CHECK(featureId, U2Type::Feature, os, false);
 
     static const QString queryString("SELECT value FROM FeatureKey WHERE feature = ?1 AND name = ?2");
-    SQLiteQuery q(queryString, db, os);
+    SQLiteQuery q(queryString, dbi->getReadDbRef(), os);
     CHECK_OP(os, false);
 
     q.bindDataId(1, featureId);
@@ -742,7 +743,8 @@ void SQLiteFeatureDbi::removeFeaturesByRoot(const U2DataId &rootId, U2OpStatus &
 U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByRegion(const U2Region& reg, const U2DataId& rootId, const QString& featureName,
     const U2DataId& seqId, U2OpStatus& os, bool contains)
 {
-    SQLiteTransaction t(db, os);
+    DbRef* readDb = dbi->getReadDbRef();
+    SQLiteTransaction t(readDb, os);
 
     const bool selectByRoot = !rootId.isEmpty();
     const QString queryByRegion = "SELECT " + FDBI_FIELDS + " FROM Feature AS f "
@@ -750,7 +752,7 @@ U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByRegion(const U2Region&
         + (selectByRoot ? QString("f.root = ?3 AND ") : QString())
         + (contains ? "fr.start >= ?1 AND fr.end <= ?2" : "fr.start <= ?2 AND fr.end >= ?1");
 
-    QSharedPointer<SQLiteQuery> q = t.getPreparedQuery(queryByRegion, db, os);
+    QSharedPointer<SQLiteQuery> q = t.getPreparedQuery(queryByRegion, readDb, os);
 
     q->bindInt64(1, reg.startPos);
     q->bindInt64(2, reg.endPos() - 1);
@@ -764,10 +766,11 @@ U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByRegion(const U2Region&
 }
 
 U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesBySequence(const QString &featureName, const U2DataId &seqId, U2OpStatus &os) {
-    SQLiteTransaction t(db, os);
+    DbRef* readDb = dbi->getReadDbRef();
+    SQLiteTransaction t(readDb, os);
     static const QString queryStringk("SELECT " + FDBI_FIELDS + " FROM Feature AS f "
         "WHERE f.sequence = ?1 and f.name = ?2 ORDER BY f.start");
-    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, db, os);
+    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, readDb, os);
 
     q->bindDataId(1, seqId);
     q->bindString(2, featureName);
@@ -778,11 +781,12 @@ U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesBySequence(const QString
 U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByParent(const U2DataId &parentId, const QString &featureName, const U2DataId &seqId,
     U2OpStatus &os, SubfeatureSelectionMode mode)
 {
-    SQLiteTransaction t(db, os);
+    DbRef* readDb = dbi->getReadDbRef();
+    SQLiteTransaction t(readDb, os);
     const bool includeParent = SelectParentFeature == mode;
     const QString queryStringk("SELECT " + FDBI_FIELDS + " FROM Feature AS f "
         "WHERE f.parent = ?1" + (includeParent ? " OR f.id = ?2" : "") + " ORDER BY f.start");
-    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, db, os);
+    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, readDb, os);
 
     q->bindDataId(1, parentId);
     if (includeParent) {
@@ -794,10 +798,11 @@ U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByParent(const U2DataId
 }
 
 U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByRoot(const U2DataId &rootId, const FeatureFlags &types, U2OpStatus &os) {
-    SQLiteTransaction t(db, os);
+    DbRef* readDb = dbi->getReadDbRef();
+    SQLiteTransaction t(readDb, os);
     const QString queryStringk("SELECT " + FDBI_FIELDS + " FROM Feature AS f "
         "WHERE f.root = ?1" + getWhereQueryPartFromType("f", types) +  "ORDER BY f.start");
-    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, db, os);
+    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, readDb, os);
 
     q->bindDataId(1, rootId);
     CHECK_OP(os, NULL);
@@ -806,10 +811,11 @@ U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByRoot(const U2DataId &r
 }
 
 U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByName(const U2DataId &rootId, const QString &name, const FeatureFlags &types, U2OpStatus &os) {
-    SQLiteTransaction t(db, os);
+    DbRef* readDb = dbi->getReadDbRef();
+    SQLiteTransaction t(readDb, os);
     const QString queryStringk("SELECT " + FDBI_FIELDS + " FROM Feature AS f "
         "WHERE f.root = ?1" + getWhereQueryPartFromType("f", types) +  " AND nameHash = ?2 ORDER BY f.start");
-    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, db, os);
+    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, readDb, os);
 
     q->bindDataId(1, rootId);
     q->bindInt32(2, qHash(name));
@@ -818,10 +824,11 @@ U2DbiIterator<U2Feature> * SQLiteFeatureDbi::getFeaturesByName(const U2DataId &r
 }
 
 QList<FeatureAndKey> SQLiteFeatureDbi::getFeatureTable(const U2DataId &rootFeatureId, U2OpStatus &os) {
-    SQLiteTransaction t(db, os);
+    DbRef* readDb = dbi->getReadDbRef();
+    SQLiteTransaction t(readDb, os);
     static const QString queryStringk("SELECT " + FDBI_FIELDS + ", fk.name, fk.value FROM Feature AS f "
         "LEFT OUTER JOIN FeatureKey AS fk ON f.id = fk.feature WHERE f.root = ?1 ORDER BY f.class DESC, f.start, f.len");
-    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, db, os);
+    QSharedPointer<SQLiteQuery> q =  t.getPreparedQuery(queryStringk, readDb, os);
 
     q->bindDataId(1, rootFeatureId);
     QList<FeatureAndKey> result;
@@ -838,7 +845,8 @@ QList<FeatureAndKey> SQLiteFeatureDbi::getFeatureTable(const U2DataId &rootFeatu
 }
 
 QMap<U2DataId, QStringList> SQLiteFeatureDbi::getAnnotationTablesByFeatureKey(const QStringList &values, U2OpStatus &os) {
-    SQLiteTransaction t(db, os);
+    DbRef* readDb = dbi->getReadDbRef();
+    SQLiteTransaction t(readDb, os);
     QMap<U2DataId, QStringList> result;
     CHECK(!values.isEmpty(), result);
     // Pay attention here if there is the need of processing more search terms
@@ -853,7 +861,7 @@ QMap<U2DataId, QStringList> SQLiteFeatureDbi::getAnnotationTablesByFeatureKey(co
 
     queryStringk.append("COLLATE NOCASE");
 
-    QSharedPointer<SQLiteQuery> q = t.getPreparedQuery(queryStringk, db, os);
+    QSharedPointer<SQLiteQuery> q = t.getPreparedQuery(queryStringk, readDb, os);
 
     for (int i = 1, n = values.size(); i <= n; ++i) {
         q->bindString(i, QString("%%1%").arg(values[i - 1]));
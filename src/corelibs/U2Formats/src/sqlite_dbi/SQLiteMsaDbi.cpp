@@ -657,6 +657,25 @@ void SQLiteMsaDbi::updateGapModel(const U2DataId& msaId, qint64 msaRowId, const
     SAFE_POINT_OP(os, );
 }
 
+void SQLiteMsaDbi::updateGapModels(const U2DataId& msaId, const QMap<qint64, QList<U2MsaGap> >& rowsGapModel, U2OpStatus& os) {
+    SQLiteTransaction t(db, os);
+    Q_UNUSED(t);
+
+    ModificationAction updateAction(dbi, msaId);
+    updateAction.prepare(os);
+    SAFE_POINT_OP(os, );
+
+    // All rows share the action: their tracks are saved as a single multiple modification step
+    QMap<qint64, QList<U2MsaGap> >::const_iterator it = rowsGapModel.constBegin();
+    for (; it != rowsGapModel.constEnd(); ++it) {
+        updateGapModel(updateAction, msaId, it.key(), it.value(), os);
+        SAFE_POINT_OP(os, );
+    }
+
+    updateAction.complete(os);
+    SAFE_POINT_OP(os, );
+}
+
 void SQLiteMsaDbi::updateGapModel(ModificationAction &updateAction, const U2DataId& msaId, qint64 msaRowId, const QList<U2MsaGap>& gapModel, U2OpStatus& os) {
     QByteArray gapsDetails;
     if (TrackOnUpdate == updateAction.getTrackModType()) {
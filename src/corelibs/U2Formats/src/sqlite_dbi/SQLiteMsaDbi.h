@@ -158,6 +158,13 @@ public:
      */
     virtual void updateGapModel(const U2DataId& msaId, qint64 msaRowId, const QList<U2MsaGap>& gapModel, U2OpStatus& os);
 
+    /**
+     * Sets new gap models for several rows in a single transaction.
+     * Updates the alignment length.
+     * Increments the alignment version once.
+     */
+    virtual void updateGapModels(const U2DataId& msaId, const QMap<qint64, QList<U2MsaGap> >& rowsGapModel, U2OpStatus& os);
+
 
     /** Updates a part of the Msa object info - the length */
     virtual void updateMsaLength(const U2DataId& msaId, qint64 length, U2OpStatus& os);
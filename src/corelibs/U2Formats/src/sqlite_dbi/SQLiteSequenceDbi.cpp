@@ -19,16 +19,213 @@
  * MA 02110-1301, USA.
  */
 
+#include <QtCore/QtEndian>
+
+#ifdef U2FORMATS_BUILD_WITH_SSE2
+#include <emmintrin.h>
+#endif
+
 #include "SQLiteSequenceDbi.h"
 #include "SQLiteObjectDbi.h"
 
+#include <U2Core/AppResources.h>
 #include <U2Core/U2DbiPackUtils.h>
 #include <U2Core/U2SafePoints.h>
 #include <U2Core/U2SequenceUtils.h>
 #include <U2Core/U2SqlHelpers.h>
+#include <U2Core/Version.h>
 
 namespace U2 {
 
+/************************************************************************/
+/* Packed sequence data */
+/************************************************************************/
+namespace {
+
+/** The values of the 'encoding' column of the SequenceData table */
+enum SequenceDataEncoding {
+    SequenceDataEncoding_Raw = 0,
+    SequenceDataEncoding_Packed2Bit = 1
+};
+
+/**
+ * Packed chunk layout:
+ *   quint32 exceptions count;
+ *   the exceptions: quint32 start, quint32 length, char symbol. These are the runs of the non-ACGT symbols;
+ *   2-bit codes of the bases, 4 bases per byte, the first base is in the lowest bits. The exception bases have the code 0.
+ * All numbers are little-endian.
+ */
+const int PACKED_HEADER_SIZE = 4;
+const int PACKED_EXCEPTION_SIZE = 9;
+
+class PackedBasesTable {
+public:
+    PackedBasesTable() {
+        memset(codes, -1, sizeof(codes));
+        for (int i = 0; i < 4; i++) {
+            codes[uchar(BASES[i])] = static_cast<qint8>(i);
+        }
+        for (int byte = 0; byte < 256; byte++) {
+            for (int i = 0; i < 4; i++) {
+                quads[byte][i] = BASES[(byte >> (2 * i)) & 3];
+            }
+        }
+    }
+
+    static const char BASES[4];
+    qint8 codes[256];
+    // 4 decoded bases for each packed byte
+    char quads[256][4];
+};
+
+const char PackedBasesTable::BASES[4] = {'A', 'C', 'G', 'T'};
+const PackedBasesTable PACKED_BASES;
+
+inline uchar getCode(char c) {
+    const qint8 code = PACKED_BASES.codes[uchar(c)];
+    return code < 0 ? 0 : static_cast<uchar>(code);
+}
+
+/** Returns false if the packed data would take more than a half of the raw data size */
+bool packSequenceData(const QByteArray &data, QByteArray &packed) {
+    const int length = data.length();
+    const char *seq = data.constData();
+    const int exceptionsSizeLimit = length / 2 - PACKED_HEADER_SIZE - (length + 3) / 4;
+    CHECK(exceptionsSizeLimit >= 0, false);
+    const int maxExceptionsCount = exceptionsSizeLimit / PACKED_EXCEPTION_SIZE;
+
+    QList<int> exceptionStarts;
+    for (int i = 0; i < length; ) {
+        if (PACKED_BASES.codes[uchar(seq[i])] >= 0) {
+            i++;
+            continue;
+        }
+        CHECK(exceptionStarts.size() < maxExceptionsCount, false);
+        exceptionStarts << i;
+        const char symbol = seq[i];
+        while (i < length && seq[i] == symbol) {
+            i++;
+        }
+    }
+
+    const int exceptionsSize = PACKED_EXCEPTION_SIZE * exceptionStarts.size();
+    packed.resize(PACKED_HEADER_SIZE + exceptionsSize + (length + 3) / 4);
+    uchar *out = reinterpret_cast<uchar *>(packed.data());
+    qToLittleEndian<quint32>(exceptionStarts.size(), out);
+    out += PACKED_HEADER_SIZE;
+    foreach (int start, exceptionStarts) {
+        int end = start;
+        while (end < length && seq[end] == seq[start]) {
+            end++;
+        }
+        qToLittleEndian<quint32>(start, out);
+        qToLittleEndian<quint32>(end - start, out + 4);
+        out[8] = static_cast<uchar>(seq[start]);
+        out += PACKED_EXCEPTION_SIZE;
+    }
+
+    const int wholeBytesLength = length & ~3;
+    for (int i = 0; i < wholeBytesLength; i += 4) {
+        *out++ = getCode(seq[i]) | (getCode(seq[i + 1]) << 2) | (getCode(seq[i + 2]) << 4) | (getCode(seq[i + 3]) << 6);
+    }
+    if (wholeBytesLength < length) {
+        uchar byte = 0;
+        for (int i = wholeBytesLength; i < length; i++) {
+            byte |= getCode(seq[i]) << (2 * (i - wholeBytesLength));
+        }
+        *out = byte;
+    }
+    return true;
+}
+
+#ifdef U2FORMATS_BUILD_WITH_SSE2
+
+#if defined(__GNUC__) && !defined(__SSE2__)
+#define PACKED_SSE2_TARGET __attribute__((target("sse2")))
+#else
+#define PACKED_SSE2_TARGET
+#endif
+
+const bool USE_SSE2_UNPACKING = AppResourcePool::isSSE2Enabled();
+
+/**
+ * Decodes 16 bases of every 4 packed bytes at once, @count must be a multiple of 16.
+ * Every packed byte is repeated 4 times, the byte lanes are masked with the 2-bit field of their base
+ * and compared with the C, G and T codes shifted into the field.
+ */
+PACKED_SSE2_TARGET void unpackBasesSSE2(const uchar *codes, int count, char *out) {
+    const __m128i fieldMasks = _mm_set1_epi32(static_cast<int>(0xC0300C03));
+    const __m128i cCodes = _mm_set1_epi32(static_cast<int>(0x40100401));
+    const __m128i gCodes = _mm_set1_epi32(static_cast<int>(0x80200802));
+    const __m128i tCodes = fieldMasks;
+    const __m128i aBases = _mm_set1_epi8('A');
+    const __m128i cDeltas = _mm_set1_epi8('C' - 'A');
+    const __m128i gDeltas = _mm_set1_epi8('G' - 'A');
+    const __m128i tDeltas = _mm_set1_epi8('T' - 'A');
+    for (int i = 0; i < count; i += 16, codes += 4, out += 16) {
+        int fourBytes;
+        memcpy(&fourBytes, codes, 4);
+        __m128i bytes = _mm_cvtsi32_si128(fourBytes);
+        bytes = _mm_unpacklo_epi8(bytes, bytes);
+        bytes = _mm_unpacklo_epi16(bytes, bytes);
+        const __m128i fields = _mm_and_si128(bytes, fieldMasks);
+
+        __m128i bases = aBases;
+        bases = _mm_add_epi8(bases, _mm_and_si128(_mm_cmpeq_epi8(fields, cCodes), cDeltas));
+        bases = _mm_add_epi8(bases, _mm_and_si128(_mm_cmpeq_epi8(fields, gCodes), gDeltas));
+        bases = _mm_add_epi8(bases, _mm_and_si128(_mm_cmpeq_epi8(fields, tCodes), tDeltas));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), bases);
+    }
+}
+
+#endif // U2FORMATS_BUILD_WITH_SSE2
+
+/** Decodes @count bases starting from @from of the packed chunk of @chunkLength bases into @out */
+bool unpackSequenceData(const QByteArray &packed, qint64 chunkLength, int from, int count, char *out) {
+    CHECK(packed.size() >= PACKED_HEADER_SIZE, false);
+    const uchar *data = reinterpret_cast<const uchar *>(packed.constData());
+    const qint64 exceptionsCount = qFromLittleEndian<quint32>(data);
+    const uchar *exceptions = data + PACKED_HEADER_SIZE;
+    const uchar *codes = exceptions + PACKED_EXCEPTION_SIZE * exceptionsCount;
+    CHECK(PACKED_HEADER_SIZE + PACKED_EXCEPTION_SIZE * exceptionsCount + (chunkLength + 3) / 4 == packed.size(), false);
+    CHECK(from >= 0 && count >= 0 && from + count <= chunkLength, false);
+
+    const int end = from + count;
+    int i = from;
+    char *o = out;
+    for (; i < end && 0 != (i & 3); i++) {
+        *o++ = PackedBasesTable::BASES[(codes[i >> 2] >> (2 * (i & 3))) & 3];
+    }
+#ifdef U2FORMATS_BUILD_WITH_SSE2
+    if (USE_SSE2_UNPACKING) {
+        const int sse2Count = (end - i) & ~15;
+        unpackBasesSSE2(codes + (i >> 2), sse2Count, o);
+        i += sse2Count;
+        o += sse2Count;
+    }
+#endif
+    for (; i + 4 <= end; i += 4, o += 4) {
+        memcpy(o, PACKED_BASES.quads[codes[i >> 2]], 4);
+    }
+    for (; i < end; i++) {
+        *o++ = PackedBasesTable::BASES[(codes[i >> 2] >> (2 * (i & 3))) & 3];
+    }
+
+    for (qint64 e = 0; e < exceptionsCount; e++, exceptions += PACKED_EXCEPTION_SIZE) {
+        const int start = qFromLittleEndian<quint32>(exceptions);
+        CHECK(start < end, true);
+        const int exceptionEnd = start + qFromLittleEndian<quint32>(exceptions + 4);
+        const int fillStart = qMax(start, from);
+        const int fillEnd = qMin(exceptionEnd, end);
+        if (fillStart < fillEnd) {
+            memset(out + fillStart - from, exceptions[8], fillEnd - fillStart);
+        }
+    }
+    return true;
+}
+
+}
+
 SQLiteSequenceDbi::SQLiteSequenceDbi(SQLiteDbi* dbi) : U2SequenceDbi(dbi), SQLiteChildDBICommon(dbi) {
 }
 
@@ -38,7 +235,9 @@ void SQLiteSequenceDbi::initSqlSchema(U2OpStatus& os) {
                 "FOREIGN KEY(object) REFERENCES Object(id) ON DELETE CASCADE)", db, os).execute();
 
     // part of the sequence, starting with 'sstart'(inclusive) and ending at 'send'(not inclusive)
+    // 'encoding' is a SequenceDataEncoding value
     SQLiteQuery("CREATE TABLE SequenceData (sequence INTEGER, sstart INTEGER NOT NULL, send INTEGER NOT NULL, data BLOB NOT NULL, "
+                "encoding INTEGER NOT NULL DEFAULT 0, "
                 "PRIMARY KEY (sequence, sstart, send), "
                 "FOREIGN KEY(sequence) REFERENCES Sequence(object) ON DELETE CASCADE)", db, os).execute();
 
@@ -54,7 +253,7 @@ U2Sequence SQLiteSequenceDbi::getSequenceObject(const U2DataId& sequenceId, U2Op
     CHECK_OP(os, res);
 
     static const QString queryString("SELECT Sequence.length, Sequence.alphabet, Sequence.circular FROM Sequence WHERE Sequence.object = ?1");
-    SQLiteQuery q(queryString, db, os);
+    SQLiteQuery q(queryString, dbi->getReadDbRef(), os);
     q.bindDataId(1, sequenceId);
     if (q.step()) {
         res.length = q.getInt64(0);
@@ -76,8 +275,8 @@ QByteArray SQLiteSequenceDbi::getSequenceData(const U2DataId& sequenceId, const
             res.reserve(region.length);
         }
         // Get all chunks that intersect the region
-        SQLiteQuery q("SELECT sstart, send, data FROM SequenceData WHERE sequence = ?1 "
-            "AND  (send >= ?2 AND sstart < ?3) ORDER BY sstart", db, os);
+        SQLiteQuery q("SELECT sstart, send, data, encoding FROM SequenceData WHERE sequence = ?1 "
+            "AND  (send >= ?2 AND sstart < ?3) ORDER BY sstart", dbi->getReadDbRef(), os);
 
         q.bindDataId(1, sequenceId);
         q.bindInt64(2, region.startPos);
@@ -89,10 +288,20 @@ QByteArray SQLiteSequenceDbi::getSequenceData(const U2DataId& sequenceId, const
             qint64 send = q.getInt64(1);
             qint64 length = send - sstart;
             QByteArray data = q.getBlob(2);
+            const int encoding = q.getInt32(3);
 
             int copyStart = pos - sstart;
             int copyLength = static_cast<int>(qMin(regionLengthToRead, length - copyStart));
-            res.append(data.constData() + copyStart, copyLength);
+            if (SequenceDataEncoding_Packed2Bit == encoding) {
+                const int oldSize = res.size();
+                res.resize(oldSize + copyLength);
+                const bool unpacked = unpackSequenceData(data, length, copyStart, copyLength, res.data() + oldSize);
+                SAFE_POINT_EXT(unpacked,
+                    os.setError("An error occurred during unpacking sequence data from dbi."),
+                    QByteArray());
+            } else {
+                res.append(data.constData() + copyStart, copyLength);
+            }
             pos += copyLength;
             regionLengthToRead -= copyLength;
 
@@ -318,16 +527,26 @@ void SQLiteSequenceDbi::updateSequenceDataCore(const U2DataId& sequenceId, const
     }
     // insert new regions
     QList<QByteArray> newDataToInsert = quantify(QList<QByteArray>() << leftCrop << dataToInsert << rightCrop);
-    static const QString insertString("INSERT INTO SequenceData(sequence, sstart, send, data) VALUES(?1, ?2, ?3, ?4)");
+    static const QString insertString("INSERT INTO SequenceData(sequence, sstart, send, data, encoding) VALUES(?1, ?2, ?3, ?4, ?5)");
     QSharedPointer<SQLiteQuery> insertQ = t.getPreparedQuery(insertString, db, os);
     CHECK_OP(os, );
     qint64 startPos = cropLeftPos;
+    QByteArray packed;
+    const bool packingEnabled = dbi->isSequencePackingEnabled();
     foreach(const QByteArray& d, newDataToInsert) {
+        const bool isPacked = packingEnabled && packSequenceData(d, packed);
+        if (isPacked) {
+            // the packed chunks are unknown to the older versions
+            static const Version packedDataVersion = Version::parseVersion("1.25.0");
+            dbi->raiseMinCompatibleVersion(packedDataVersion, os);
+            CHECK_OP(os, );
+        }
         insertQ->reset();
         insertQ->bindDataId(1, sequenceId);
         insertQ->bindInt64(2, startPos);
         insertQ->bindInt64(3, startPos + d.length());
-        insertQ->bindBlob(4, d);
+        insertQ->bindBlob(4, isPacked ? packed : d);
+        insertQ->bindInt32(5, isPacked ? SequenceDataEncoding_Packed2Bit : SequenceDataEncoding_Raw);
         insertQ->execute();
         if (os.hasError()) {
             return;
@@ -0,0 +1,172 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "AssemblyCoverageTable.h"
+#include "../SQLiteDbi.h"
+
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+namespace U2 {
+
+const qint64 AssemblyCoverageTable::BIN_SIZE = 512;
+const qint64 AssemblyCoverageTable::MIN_BINS_PER_WINDOW = 8;
+
+AssemblyCoverageTable::AssemblyCoverageTable(SQLiteDbi* dbi, const U2DataId& assemblyId)
+    : dbi(dbi), db(dbi->getDbRef()), tableState(-1)
+{
+    tableName = QString("AssemblyCoverage_%1").arg(U2DbiUtils::toDbiId(assemblyId));
+}
+
+void AssemblyCoverageTable::createTable(U2OpStatus& os) {
+    // bin - bin number, the bin covers [bin * BIN_SIZE, (bin + 1) * BIN_SIZE) region
+    // starts - number of reads with the leftmost base in the bin
+    // ends - number of reads with the rightmost base in the bin
+    static QString q = "CREATE TABLE IF NOT EXISTS %1 (bin INTEGER PRIMARY KEY, starts INTEGER NOT NULL, ends INTEGER NOT NULL)";
+    SQLiteQuery(q.arg(tableName), db, os).execute();
+    CHECK_OP(os, );
+    tableState = 1;
+}
+
+void AssemblyCoverageTable::dropTable(U2OpStatus& os) {
+    pendingDeltas.clear();
+    SQLiteQuery(QString("DROP TABLE IF EXISTS %1").arg(tableName), db, os).execute();
+    CHECK_OP(os, );
+    tableState = 0;
+}
+
+bool AssemblyCoverageTable::isAvailable(U2OpStatus& os) {
+    if (tableState == -1) {
+        bool exists = SQLiteUtils::isTableExists(tableName, db, os);
+        CHECK_OP(os, false);
+        tableState = exists ? 1 : 0;
+    }
+    return tableState == 1;
+}
+
+void AssemblyCoverageTable::addRead(qint64 leftmostPos, qint64 effectiveLen) {
+    addDelta(leftmostPos, effectiveLen, 1);
+}
+
+void AssemblyCoverageTable::removeRead(qint64 leftmostPos, qint64 effectiveLen) {
+    addDelta(leftmostPos, effectiveLen, -1);
+}
+
+void AssemblyCoverageTable::addDelta(qint64 leftmostPos, qint64 effectiveLen, int delta) {
+    CHECK(effectiveLen > 0, );
+    qint64 startPos = qMax(qint64(0), leftmostPos);
+    qint64 endPos = qMax(startPos, leftmostPos + effectiveLen - 1);
+    pendingDeltas[startPos / BIN_SIZE].starts += delta;
+    pendingDeltas[endPos / BIN_SIZE].ends += delta;
+}
+
+void AssemblyCoverageTable::flush(U2OpStatus& os) {
+    CHECK(!pendingDeltas.isEmpty(), );
+    SAFE_POINT_EXT(tableState == 1, os.setError("Assembly coverage table doesn't exist"), );
+
+    SQLiteTransaction t(db, os);
+    Q_UNUSED(t);
+    SQLiteQuery insertQ(QString("INSERT OR IGNORE INTO %1(bin, starts, ends) VALUES(?1, 0, 0)").arg(tableName), db, os);
+    SQLiteQuery updateQ(QString("UPDATE %1 SET starts = starts + ?2, ends = ends + ?3 WHERE bin = ?1").arg(tableName), db, os);
+    CHECK_OP(os, );
+    QHash<qint64, BinDelta>::ConstIterator it = pendingDeltas.constBegin();
+    for (; it != pendingDeltas.constEnd() && !os.hasError(); ++it) {
+        insertQ.reset();
+        insertQ.bindInt64(1, it.key());
+        insertQ.execute();
+
+        updateQ.reset();
+        updateQ.bindInt64(1, it.key());
+        updateQ.bindInt64(2, it.value().starts);
+        updateQ.bindInt64(3, it.value().ends);
+        updateQ.execute();
+    }
+    pendingDeltas.clear();
+}
+
+bool AssemblyCoverageTable::canCalculateCoverage(const U2Region& r, const U2AssemblyCoverageStat& c, U2OpStatus& os) {
+    int csize = c.coverage->size();
+    CHECK(csize > 0 && r.startPos >= 0 && r.length > 0, false);
+    CHECK(r != U2_REGION_MAX && double(r.length) / csize >= BIN_SIZE * MIN_BINS_PER_WINDOW, false);
+    return isAvailable(os) && pendingDeltas.isEmpty();
+}
+
+void AssemblyCoverageTable::calculateCoverage(const U2Region& r, U2AssemblyCoverageStat& c, U2OpStatus& os) {
+    int csize = c.coverage->size();
+    SAFE_POINT(csize > 0, "illegal coverage vector size!", );
+
+    const qint64 firstBin = r.startPos / BIN_SIZE;
+    const qint64 lastBin = (r.endPos() - 1) / BIN_SIZE;
+
+    DbRef* readDb = dbi->getReadDbRef();
+
+    // reads started before the region: they intersect the region unless they are ended before it as well
+    SQLiteQuery prefixQ(QString("SELECT SUM(starts), SUM(ends) FROM %1 WHERE bin < ?1").arg(tableName), readDb, os);
+    prefixQ.bindInt64(1, firstBin);
+    CHECK_OP(os, );
+    qint64 startsBefore = 0;
+    qint64 endsBefore = 0;
+    if (prefixQ.step()) {
+        startsBefore = prefixQ.getInt64(0);
+        endsBefore = prefixQ.getInt64(1);
+    }
+    CHECK_OP(os, );
+
+    // window i covers bins [windowBins[i], windowBins[i + 1])
+    double basesPerRange = double(r.length) / csize;
+    QVector<qint64> windowBins(csize + 1);
+    windowBins[0] = firstBin;
+    for (int i = 1; i < csize; i++) {
+        windowBins[i] = qint64((r.startPos + i * basesPerRange) / BIN_SIZE);
+    }
+    windowBins[csize] = lastBin + 1;
+
+    QVector<qint64> windowStarts(csize, 0);
+    QVector<qint64> windowEnds(csize, 0);
+    SQLiteQuery q(QString("SELECT bin, starts, ends FROM %1 WHERE bin >= ?1 AND bin <= ?2 ORDER BY bin").arg(tableName), readDb, os);
+    q.bindInt64(1, firstBin);
+    q.bindInt64(2, lastBin);
+    int window = 0;
+    while (q.step() && !os.isCoR()) {
+        qint64 bin = q.getInt64(0);
+        while (bin >= windowBins[window + 1]) {
+            window++;
+        }
+        windowStarts[window] += q.getInt64(1);
+        windowEnds[window] += q.getInt64(2);
+    }
+    CHECK_OP(os, );
+
+    // the number of reads intersecting a window is the number of reads started before the window end
+    // minus the number of reads ended before the window start
+    U2Range<int>* cdata = c.coverage->data();
+    qint64 startsBeforeWindowEnd = startsBefore;
+    qint64 endsBeforeWindowStart = endsBefore;
+    for (int i = 0; i < csize; i++) {
+        startsBeforeWindowEnd += windowStarts[i];
+        int windowCoverage = int(startsBeforeWindowEnd - endsBeforeWindowStart);
+        cdata[i].minValue += windowCoverage;
+        cdata[i].maxValue += windowCoverage;
+        endsBeforeWindowStart += windowEnds[i];
+    }
+}
+
+} //namespace
@@ -0,0 +1,91 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_SQLITE_ASSEMBLY_COVERAGE_TABLE_H_
+#define _U2_SQLITE_ASSEMBLY_COVERAGE_TABLE_H_
+
+#include <QtCore/QHash>
+
+#include <U2Core/U2Assembly.h>
+
+namespace U2 {
+
+class DbRef;
+class SQLiteDbi;
+class U2OpStatus;
+
+/**
+    Per-bin read counters of the assembly: for every bin of BIN_SIZE bases
+    the number of reads started in the bin and the number of reads ended in the bin are stored.
+    The counters are maintained while reads are added or removed and allow
+    to calculate coverage of large regions without scanning the reads tables.
+*/
+class AssemblyCoverageTable {
+public:
+    AssemblyCoverageTable(SQLiteDbi* dbi, const U2DataId& assemblyId);
+
+    void createTable(U2OpStatus& os);
+    void dropTable(U2OpStatus& os);
+
+    /** Returns false for assemblies created before the table was introduced */
+    bool isAvailable(U2OpStatus& os);
+
+    /** Counters are accumulated in memory until 'flush' is called */
+    void addRead(qint64 leftmostPos, qint64 effectiveLen);
+    void removeRead(qint64 leftmostPos, qint64 effectiveLen);
+    void flush(U2OpStatus& os);
+
+    /** Checks that every coverage window of the region spans enough bins to be computed from the table */
+    bool canCalculateCoverage(const U2Region& r, const U2AssemblyCoverageStat& c, U2OpStatus& os);
+
+    /**
+        Adds coverage of the region to 'c.coverage'.
+        Window bounds are aligned to the bins, so a read is counted in a window
+        if it intersects the bins the window is aligned to.
+    */
+    void calculateCoverage(const U2Region& r, U2AssemblyCoverageStat& c, U2OpStatus& os);
+
+    static const qint64 BIN_SIZE;
+
+    /** Minimal number of bins in a coverage window to calculate coverage using the table */
+    static const qint64 MIN_BINS_PER_WINDOW;
+
+private:
+    class BinDelta {
+    public:
+        BinDelta() : starts(0), ends(0) {}
+        qint64 starts;
+        qint64 ends;
+    };
+
+    void addDelta(qint64 leftmostPos, qint64 effectiveLen, int delta);
+
+    SQLiteDbi*                  dbi;
+    DbRef*                      db;
+    QString                     tableName;
+    /** -1: unknown, 0: no table, 1: the table exists */
+    int                         tableState;
+    QHash<qint64, BinDelta>     pendingDeltas;
+};
+
+} //namespace
+
+#endif
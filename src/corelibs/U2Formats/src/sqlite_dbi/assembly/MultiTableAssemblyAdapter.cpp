@@ -41,6 +41,7 @@ MultiTableAssemblyAdapter::MultiTableAssemblyAdapter(SQLiteDbi* _dbi, const U2Da
 {
     dbi = _dbi;
     version = -1;
+    coverageTable = QSharedPointer<AssemblyCoverageTable>(new AssemblyCoverageTable(dbi, assemblyId));
     syncTables(os);
     rowsPerRange = DEFAULT_ROWS_PER_TABLE;
 }
@@ -226,12 +227,19 @@ MTASingleTableAdapter* MultiTableAssemblyAdapter::createAdapter(int rowPos, int
     QByteArray idExtra = getIdExtra(rowPos, elenPos);
     MTASingleTableAdapter * ma = new MTASingleTableAdapter(sa, rowPos, elenPos, idExtra);
     ma->singleTableAdapter->createReadsTables(os);
+    // the coverage table is set after the reads table is created: it must be created only with a new assembly
+    sa->setCoverageTable(coverageTable);
     adapters << ma;
     idExtras << idExtra;
     adaptersGrid[rowPos][elenPos] =  ma;
     return ma;
 }
 
+void MultiTableAssemblyAdapter::createReadsTables(U2OpStatus& os) {
+    // reads tables are created on demand, see 'createAdapter'
+    coverageTable->createTable(os);
+}
+
 void MultiTableAssemblyAdapter::createReadsIndexes(U2OpStatus& os) {
     SQLiteQuery("PRAGMA temp_store = FILE", db, os).execute();
     CHECK_OP(os, );
@@ -422,7 +430,7 @@ void MultiTableAssemblyAdapter::addReads(U2DbiIterator<U2AssemblyRead>* it, U2As
         }
     }
 
-    bool packIsOn = empty;
+    bool packIsOn = empty && !ii.prepacked;
     qint64 prevLeftmostPos = -1;
     PackAlgorithmContext packContext;
 
@@ -440,8 +448,10 @@ void MultiTableAssemblyAdapter::addReads(U2DbiIterator<U2AssemblyRead>* it, U2As
             read->effectiveLen = readLen + U2AssemblyUtils::getCigarExtraLength(read->cigar);
             int elenPos = getElenRangePosByLength(read->effectiveLen);
 
-            packIsOn = packIsOn && read->leftmostPos >= prevLeftmostPos;
-            read->packedViewRow = packIsOn ?  AssemblyPackAlgorithm::packRead(U2Region(read->leftmostPos, read->effectiveLen), packContext, os): 0;
+            if (!ii.prepacked) {
+                packIsOn = packIsOn && read->leftmostPos >= prevLeftmostPos;
+                read->packedViewRow = packIsOn ?  AssemblyPackAlgorithm::packRead(U2Region(read->leftmostPos, read->effectiveLen), packContext, os): 0;
+            }
             int rowPos = getRowRangePosByRow(read->packedViewRow);
             ensureGridSize(readsGrid, rowPos, nElens);
             readsGrid[rowPos][elenPos] << read;
@@ -482,6 +492,9 @@ void MultiTableAssemblyAdapter::addReads(U2DbiIterator<U2AssemblyRead>* it, U2As
         ii.packStat.maxProw = packContext.maxProw;
         ii.packed = true;
         flushTables(os);
+    } else if (ii.prepacked && !os.hasError()) {
+        // the row ranges could be added
+        flushTables(os);
     }
 }
 
@@ -544,6 +557,7 @@ void MultiTableAssemblyAdapter::dropReadsTables(U2OpStatus &os) {
             }
         }
     }
+    coverageTable->dropTable(os);
 }
 
 void MultiTableAssemblyAdapter::pack(U2AssemblyPackStat& stat, U2OpStatus& os) {
@@ -560,9 +574,13 @@ void MultiTableAssemblyAdapter::pack(U2AssemblyPackStat& stat, U2OpStatus& os) {
 }
 
 void MultiTableAssemblyAdapter::calculateCoverage(const U2Region& region, U2AssemblyCoverageStat& c, U2OpStatus& os) {
+    if (coverageTable->canCalculateCoverage(region, c, os)) {
+        coverageTable->calculateCoverage(region, c, os);
+        return;
+    }
     for(int i = 0; i < adapters.size(); ++i) {
         MTASingleTableAdapter * a = adapters.at(i);
-        a->singleTableAdapter->calculateCoverage(region, c, os);
+        a->singleTableAdapter->calculateCoverageByReads(region, c, os);
         if (os.isCoR()) {
             break;
         }
@@ -65,6 +65,7 @@ public:
     virtual void pack(U2AssemblyPackStat& stat, U2OpStatus& os);
     virtual void calculateCoverage(const U2Region& region, U2AssemblyCoverageStat& c, U2OpStatus& os);
 
+    virtual void createReadsTables(U2OpStatus& os);
     virtual void createReadsIndexes(U2OpStatus& os);
 
     int getElenRangePosByLength(qint64 readLength) const;
@@ -127,6 +128,9 @@ protected:
     /** prow range per table */
     qint32                                      rowsPerRange;
 
+    /** Coverage counters of the assembly shared by all table adapters */
+    QSharedPointer<AssemblyCoverageTable>       coverageTable;
+
     //TODO: add read-locks into all methods
     QReadWriteLock                              tablesSyncLock;
 };
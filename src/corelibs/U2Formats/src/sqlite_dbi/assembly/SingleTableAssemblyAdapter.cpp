@@ -26,6 +26,7 @@
 #include <U2Core/U2AssemblyUtils.h>
 #include <U2Core/U2SafePoints.h>
 #include <U2Core/U2SqlHelpers.h>
+#include <U2Core/Version.h>
 
 namespace U2 {
 
@@ -79,6 +80,11 @@ void SingleTableAssemblyAdapter::createReadsTables(U2OpStatus& os) {
         "gstart INTEGER NOT NULL, elen INTEGER NOT NULL, flags INTEGER NOT NULL, mq INTEGER NOT NULL, data BLOB NOT NULL)";
 
     SQLiteQuery(q.arg(readsTable), db, os).execute();
+    CHECK_OP(os, );
+
+    if (!coverageTable.isNull()) {
+        coverageTable->createTable(os);
+    }
 }
 
 void SingleTableAssemblyAdapter::createReadsIndexes(U2OpStatus& os) {
@@ -114,10 +120,10 @@ void SingleTableAssemblyAdapter::bindRegion(SQLiteQuery& q, const U2Region& r, b
 
 qint64 SingleTableAssemblyAdapter::countReads(const U2Region& r, U2OpStatus& os) {
     if (r == U2_REGION_MAX) {
-        return SQLiteQuery(QString("SELECT COUNT(*) FROM %1").arg(readsTable), db, os).selectInt64();
+        return SQLiteQuery(QString("SELECT COUNT(*) FROM %1").arg(readsTable), dbi->getReadDbRef(), os).selectInt64();
     }
     QString qStr = QString("SELECT COUNT(*) FROM %1 WHERE " + rangeConditionCheckForCount).arg(readsTable);
-    SQLiteQuery q(qStr, db, os);
+    SQLiteQuery q(qStr, dbi->getReadDbRef(), os);
     bindRegion(q, r, true);
     return q.selectInt64();
 }
@@ -128,19 +134,19 @@ qint64 SingleTableAssemblyAdapter::countReadsPrecise(const U2Region& r, U2OpStat
     }
     //here we use not-optimized rangeConditionCheck but not rangeConditionCheckForCount
     QString qStr = QString("SELECT COUNT(*) FROM %1 WHERE " + rangeConditionCheck).arg(readsTable);
-    SQLiteQuery q(qStr, db, os);
+    SQLiteQuery q(qStr, dbi->getReadDbRef(), os);
     bindRegion(q, r, false);
     return q.selectInt64();
 }
 
 qint64 SingleTableAssemblyAdapter::getMaxPackedRow(const U2Region& r, U2OpStatus& os) {
-    SQLiteQuery q(QString("SELECT MAX(prow) FROM %1 WHERE " + rangeConditionCheck).arg(readsTable), db, os);
+    SQLiteQuery q(QString("SELECT MAX(prow) FROM %1 WHERE " + rangeConditionCheck).arg(readsTable), dbi->getReadDbRef(), os);
     bindRegion(q, r);
     return q.selectInt64();
 }
 
 qint64 SingleTableAssemblyAdapter::getMaxEndPos(U2OpStatus& os) {
-    return SQLiteQuery(QString("SELECT MAX(gstart + elen) FROM %1").arg(readsTable), db, os).selectInt64();
+    return SQLiteQuery(QString("SELECT MAX(gstart + elen) FROM %1").arg(readsTable), dbi->getReadDbRef(), os).selectInt64();
 }
 
 U2DbiIterator<U2AssemblyRead>* SingleTableAssemblyAdapter::getReads(const U2Region& r, U2OpStatus& os, bool sortedHint) {
@@ -149,7 +155,7 @@ U2DbiIterator<U2AssemblyRead>* SingleTableAssemblyAdapter::getReads(const U2Regi
         qStr += SORTED_READS;
     }
 
-    QSharedPointer<SQLiteQuery> q (new SQLiteQuery(qStr, db, os));
+    QSharedPointer<SQLiteQuery> q (new SQLiteQuery(qStr, dbi->getReadDbRef(), os));
     bindRegion(*q, r);
     return new SqlRSIterator<U2AssemblyRead>(q, new SimpleAssemblyReadLoader(), NULL, U2AssemblyRead(), os);
 }
@@ -158,7 +164,7 @@ U2DbiIterator<U2AssemblyRead>* SingleTableAssemblyAdapter::getReadsByRow(const U
     int rowFieldPos = rangeMode ? 4 : 3;
     QString qStr = QString("SELECT " + ALL_READ_FIELDS + " FROM %1 WHERE " + rangeConditionCheck
         + " AND (prow >= ?%2 AND prow < ?%3)").arg(readsTable).arg(rowFieldPos).arg(rowFieldPos + 1);
-    QSharedPointer<SQLiteQuery> q ( new SQLiteQuery(qStr, db, os) );
+    QSharedPointer<SQLiteQuery> q ( new SQLiteQuery(qStr, dbi->getReadDbRef(), os) );
     bindRegion(*q, r);
     q->bindInt64(rowFieldPos, minRow);
     q->bindInt64(rowFieldPos + 1, maxRow);
@@ -167,7 +173,7 @@ U2DbiIterator<U2AssemblyRead>* SingleTableAssemblyAdapter::getReadsByRow(const U
 
 U2DbiIterator<U2AssemblyRead>* SingleTableAssemblyAdapter::getReadsByName(const QByteArray& name, U2OpStatus& os) {
     QString qStr = QString("SELECT " + ALL_READ_FIELDS + " FROM %1 WHERE name = ?1").arg(readsTable);
-    QSharedPointer<SQLiteQuery> q (new SQLiteQuery(qStr, db, os));
+    QSharedPointer<SQLiteQuery> q (new SQLiteQuery(qStr, dbi->getReadDbRef(), os));
     int hash = qHash(name);
     q->bindInt64(1, hash);
     return new SqlRSIterator<U2AssemblyRead>(q, new SimpleAssemblyReadLoader(),
@@ -176,8 +182,15 @@ U2DbiIterator<U2AssemblyRead>* SingleTableAssemblyAdapter::getReadsByName(const
 
 void SingleTableAssemblyAdapter::addReads(U2DbiIterator<U2AssemblyRead>* it, U2AssemblyReadsImportInfo& ii, U2OpStatus& os) {
     SQLiteTransaction t(db, os);
+    if (it->hasNext()) {
+        // the binary packing of the reads is unknown to the older versions
+        static const Version binaryReadsVersion = Version::parseVersion("1.25.0");
+        dbi->raiseMinCompatibleVersion(binaryReadsVersion, os);
+        CHECK_OP(os, );
+    }
     QString q = "INSERT INTO %1(name, prow, flags, gstart, elen, mq, data) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)";
     SQLiteQuery insertQ(q.arg(readsTable), db, os);
+    bool updateCoverageTable = !coverageTable.isNull() && coverageTable->isAvailable(os);
     while (it->hasNext() && !os.isCoR()) {
         U2AssemblyRead read = it->next();
         bool dnaExt = false; //TODO:
@@ -200,27 +213,47 @@ void SingleTableAssemblyAdapter::addReads(U2DbiIterator<U2AssemblyRead>* it, U2A
         insertQ.bindInt64(4, read->leftmostPos);
         insertQ.bindInt64(5, read->effectiveLen);
         insertQ.bindInt32(6, read->mappingQuality);
-        QByteArray packedData = SQLiteAssemblyUtils::packData(SQLiteAssemblyDataMethod_NSCQ, read, os);
+        QByteArray packedData = SQLiteAssemblyUtils::packData(SQLiteAssemblyDataMethod_Binary, read, os);
         insertQ.bindBlob(7, packedData, false);
 
         insertQ.insert();
 
         SQLiteAssemblyUtils::addToCoverage(ii.coverageInfo, read);
+        if (updateCoverageTable) {
+            coverageTable->addRead(read->leftmostPos, read->effectiveLen);
+        }
 
         ii.nReads++;
     }
+    if (updateCoverageTable && !os.isCoR()) {
+        coverageTable->flush(os);
+    }
 }
 
 void SingleTableAssemblyAdapter::removeReads(const QList<U2DataId>& readIds, U2OpStatus& os) {
     //TODO: add transaction per pack or reads
     //TODO: remove multiple reads in 1 SQL at once
     //SQLiteObjectDbi* objDbi = dbi->getSQLiteObjectDbi();
+    QScopedPointer<SQLiteQuery> regionQ;
+    if (!coverageTable.isNull() && coverageTable->isAvailable(os)) {
+        regionQ.reset(new SQLiteQuery(QString("SELECT gstart, elen FROM %1 WHERE id = ?1").arg(readsTable), db, os));
+    }
     foreach(U2DataId readId, readIds) {
+        if (!regionQ.isNull()) {
+            regionQ->reset();
+            regionQ->bindDataId(1, readId);
+            if (regionQ->step()) {
+                coverageTable->removeRead(regionQ->getInt64(0), regionQ->getInt64(1));
+            }
+        }
         SQLiteUtils::remove(readsTable, "id", readId, 1, db, os);
         if (os.hasError()) {
             break;
         }
     }
+    if (!regionQ.isNull() && !os.hasError()) {
+        coverageTable->flush(os);
+    }
     SQLiteObjectDbi::incrementVersion(assemblyId, db, os);
 }
 
@@ -228,6 +261,10 @@ void SingleTableAssemblyAdapter::dropReadsTables(U2OpStatus &os) {
     QString queryString = "DROP TABLE IF EXISTS %1";
     SQLiteQuery(queryString.arg(readsTable), db, os).execute();
     CHECK_OP(os, );
+    if (!coverageTable.isNull()) {
+        coverageTable->dropTable(os);
+        CHECK_OP(os, );
+    }
     SQLiteObjectDbi::incrementVersion(assemblyId, db, os);
 }
 
@@ -237,13 +274,21 @@ void SingleTableAssemblyAdapter::pack(U2AssemblyPackStat& stat, U2OpStatus& os)
 }
 
 void SingleTableAssemblyAdapter::calculateCoverage(const U2Region& r, U2AssemblyCoverageStat& c, U2OpStatus& os) {
+    if (!coverageTable.isNull() && coverageTable->canCalculateCoverage(r, c, os)) {
+        coverageTable->calculateCoverage(r, c, os);
+        return;
+    }
+    calculateCoverageByReads(r, c, os);
+}
+
+void SingleTableAssemblyAdapter::calculateCoverageByReads(const U2Region& r, U2AssemblyCoverageStat& c, U2OpStatus& os) {
     QString queryString = "SELECT gstart, elen FROM " + readsTable;
     bool rangeArgs = r != U2_REGION_MAX;
 
     if (rangeArgs) {
         queryString+=" WHERE " + rangeConditionCheck;
     }
-    SQLiteQuery q(queryString, db, os);
+    SQLiteQuery q(queryString, dbi->getReadDbRef(), os);
     if (rangeArgs) {
         bindRegion(q, r, false);
     }
@@ -23,8 +23,11 @@
 #define _U2_SQLITE_ASSEMBLY_SINGLE_TABLE_DBI_H_
 
 #include "../SQLiteAssemblyDbi.h"
+#include "AssemblyCoverageTable.h"
 #include "util/AssemblyPackAlgorithm.h"
 
+#include <QtCore/QSharedPointer>
+
 #include <U2Core/U2SqlHelpers.h>
 
 namespace U2 {
@@ -56,6 +59,15 @@ public:
 
     virtual void calculateCoverage(const U2Region& region, U2AssemblyCoverageStat& c, U2OpStatus& os);
 
+    /** Calculates coverage by scanning reads, the coverage table is not used */
+    void calculateCoverageByReads(const U2Region& region, U2AssemblyCoverageStat& c, U2OpStatus& os);
+
+    /**
+        Sets the coverage table updated when reads are added or removed.
+        The table can be shared between adapters of the same assembly
+    */
+    void setCoverageTable(const QSharedPointer<AssemblyCoverageTable>& table) {coverageTable = table;}
+
     const QString& getReadsTableName() const {return readsTable;}
 
     void enableRangeTableMode(int minLength, int maxLength);
@@ -77,6 +89,7 @@ protected:
     int         minReadLength; // used in range mode
     int         maxReadLength; // used in range mode
     bool        rangeMode;     // flag to show that range mode is in use
+    QSharedPointer<AssemblyCoverageTable> coverageTable;
 };
 
 class SingleTablePackAlgorithmAdapter : public PackAlgorithmAdapter {
@@ -0,0 +1,140 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QThread>
+
+#include <3rdparty/sqlite3/sqlite3.h>
+
+#include <U2Core/Log.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "SQLiteReadConnectionPool.h"
+
+namespace U2 {
+
+SQLiteReadConnectionPool::SQLiteReadConnectionPool(const QString &url)
+    : url(url)
+{
+}
+
+SQLiteReadConnectionPool::~SQLiteReadConnectionPool() {
+    close();
+}
+
+DbRef * SQLiteReadConnectionPool::getDbRef(U2OpStatus &os) {
+    QThread *thread = QThread::currentThread();
+    SAFE_POINT_EXT(NULL != thread, os.setError("Unknown thread"), NULL);
+
+    QMutexLocker locker(&mutex);
+    closePendingConnections();
+    DbRef *ref = connections.value(thread, NULL);
+    CHECK(NULL == ref, ref);
+
+    ref = openConnection(os);
+    CHECK_OP(os, NULL);
+    connections.insert(thread, ref);
+    connect(thread, SIGNAL(finished()), SLOT(sl_threadFinished()), Qt::DirectConnection);
+    return ref;
+}
+
+void SQLiteReadConnectionPool::close() {
+    QMutexLocker locker(&mutex);
+    foreach (QThread *thread, connections.keys()) {
+        disconnect(thread, SIGNAL(finished()), this, SLOT(sl_threadFinished()));
+        closeOrKeepConnection(connections[thread]);
+    }
+    connections.clear();
+    closePendingConnections();
+    CHECK(!pendingConnections.isEmpty(), );
+    // the unfinished queries still use the connections, so they can be neither closed nor deleted
+    ioLog.error(QString("SQLite: %1 read-only connection(s) are left opened by unfinished queries: %2").arg(pendingConnections.size()).arg(url));
+    pendingConnections.clear();
+}
+
+void SQLiteReadConnectionPool::sl_threadFinished() {
+    // the slot is called directly in the finished thread
+    QMutexLocker locker(&mutex);
+    DbRef *ref = connections.take(QThread::currentThread());
+    CHECK(NULL != ref, );
+    disconnect(QThread::currentThread(), SIGNAL(finished()), this, SLOT(sl_threadFinished()));
+    closeOrKeepConnection(ref);
+}
+
+DbRef * SQLiteReadConnectionPool::openConnection(U2OpStatus &os) const {
+    QScopedPointer<DbRef> ref(new DbRef());
+    ref->useCache = false;
+    const QByteArray file = url.toUtf8();
+    const int rc = sqlite3_open_v2(file.constData(), &ref->handle, SQLITE_OPEN_READONLY, NULL);
+    if (SQLITE_OK != rc) {
+        const QString err = NULL == ref->handle ? QString(" error-code: %1").arg(rc) : QString(sqlite3_errmsg(ref->handle));
+        os.setError(U2DbiL10n::tr("Error opening SQLite database: %1!").arg(err));
+        sqlite3_close(ref->handle);
+        return NULL;
+    }
+
+    // a reader waits for a checkpoint or a recovery of the WAL file only, it is never blocked by writers
+    sqlite3_busy_timeout(ref->handle, 1000);
+    SQLiteQuery("PRAGMA temp_store = MEMORY", ref.data(), os).execute();
+    SQLiteQuery("PRAGMA cache_size = 10000", ref.data(), os).execute();
+    if (os.hasError()) {
+        sqlite3_close(ref->handle);
+        return NULL;
+    }
+    ioLog.trace(QString("SQLite: read-only connection is opened: %1\n").arg(url));
+    return ref.take();
+}
+
+bool SQLiteReadConnectionPool::closeConnection(DbRef *ref) const {
+    CHECK(NULL != ref, true);
+    // a query keeps the connection locked until it is finished, the lock can be held by a query of the current thread only
+    CHECK(ref->lock.tryLock(), false);
+    ref->preparedQueries.clear();
+    // the statements of the unfinished queries are finalized by the queries themselves
+    if (NULL != sqlite3_next_stmt(ref->handle, NULL)) {
+        ref->lock.unlock();
+        return false;
+    }
+    const int rc = sqlite3_close(ref->handle);
+    ref->lock.unlock();
+    CHECK_EXT(SQLITE_OK == rc, ioLog.error(U2DbiL10n::tr("Failed to close database: %1, err: %2").arg(url).arg(sqlite3_errmsg(ref->handle))), false);
+    delete ref;
+    ioLog.trace(QString("SQLite: read-only connection is closed: %1\n").arg(url));
+    return true;
+}
+
+void SQLiteReadConnectionPool::closeOrKeepConnection(DbRef *ref) {
+    CHECK(!closeConnection(ref), );
+    ioLog.trace(QString("SQLite: read-only connection is used by an unfinished query, it will be closed later: %1\n").arg(url));
+    pendingConnections << ref;
+}
+
+void SQLiteReadConnectionPool::closePendingConnections() {
+    QList<DbRef *> stillUsed;
+    foreach (DbRef *ref, pendingConnections) {
+        if (!closeConnection(ref)) {
+            stillUsed << ref;
+        }
+    }
+    pendingConnections = stillUsed;
+}
+
+}   // namespace U2
@@ -0,0 +1,76 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_SQLITE_READ_CONNECTION_POOL_H_
+#define _U2_SQLITE_READ_CONNECTION_POOL_H_
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+
+#include <U2Core/U2OpStatus.h>
+
+class QThread;
+
+namespace U2 {
+
+class DbRef;
+
+/**
+    Read-only connections to an SQLite database in the WAL journal mode.
+    Every thread gets its own connection, so the readers neither wait for each other
+    nor for the main connection of the dbi, while it is busy with a write transaction.
+    A connection is closed when its thread is finished or when the pool is closed.
+    A connection that is still used by an unfinished query, e.g. by an iterator passed to another thread,
+    is kept and closed on the next request of a connection or when the pool is closed.
+*/
+class SQLiteReadConnectionPool : public QObject {
+    Q_OBJECT
+public:
+    SQLiteReadConnectionPool(const QString &url);
+    ~SQLiteReadConnectionPool();
+
+    /** Returns the connection of the current thread, the connection is opened on the first request */
+    DbRef * getDbRef(U2OpStatus &os);
+
+    /** Closes all connections, the queries of the connections must be finished, otherwise the connections are left opened */
+    void close();
+
+private slots:
+    void sl_threadFinished();
+
+private:
+    DbRef * openConnection(U2OpStatus &os) const;
+    /** Returns false if the connection is used by an unfinished query: it is not closed then */
+    bool closeConnection(DbRef *ref) const;
+    /** Keeps the connection if it can not be closed now */
+    void closeOrKeepConnection(DbRef *ref);
+    void closePendingConnections();
+
+    const QString url;
+    QMutex mutex;
+    QHash<QThread *, DbRef *> connections;
+    QList<DbRef *> pendingConnections;
+};
+
+}   // namespace U2
+
+#endif // _U2_SQLITE_READ_CONNECTION_POOL_H_
@@ -0,0 +1,63 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2Dbi.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "SqliteUpgraderFrom_1_13_To_1_25.h"
+#include "../SQLiteDbi.h"
+
+namespace U2 {
+
+SqliteUpgraderFrom_1_13_To_1_25::SqliteUpgraderFrom_1_13_To_1_25(SQLiteDbi *dbi) :
+    SqliteUpgrader(Version::parseVersion("1.13.0"), Version::parseVersion("1.25.0"), dbi)
+{
+}
+
+void SqliteUpgraderFrom_1_13_To_1_25::upgrade(U2OpStatus &os) const {
+    SQLiteTransaction t(dbi->getDbRef(), os);
+    Q_UNUSED(t);
+
+    // the new column is ignored by the older versions, so the minimum compatible version is kept:
+    // it is raised only when the data that is unknown to the older versions is written
+    upgradeSequenceDbi(os);
+}
+
+void SqliteUpgraderFrom_1_13_To_1_25::upgradeSequenceDbi(U2OpStatus &os) const {
+    SQLiteQuery q("PRAGMA table_info(SequenceData)", dbi->getDbRef(), os);
+    CHECK_OP(os, );
+
+    bool hasEncoding = false;
+    while (q.step()) {
+        QString colName = q.getString(1);
+        if ("encoding" == colName) {
+            hasEncoding = true;
+            break;
+        }
+    }
+    CHECK(!hasEncoding, );
+
+    // the existing chunks are raw, the packed ones are written only by the newer versions
+    SQLiteQuery("ALTER TABLE SequenceData ADD encoding INTEGER NOT NULL DEFAULT 0", dbi->getDbRef(), os).execute();
+}
+
+}   // namespace U2
@@ -47,7 +47,7 @@ public:
 
 #define PACK_TAIL_SIZE 50000
 
-class PackAlgorithmContext {
+class U2FORMATS_EXPORT PackAlgorithmContext {
 public:
     PackAlgorithmContext();
 
@@ -60,7 +60,7 @@ public:
     QVector<qint64> tails;
 };
 
-class AssemblyPackAlgorithm {
+class U2FORMATS_EXPORT AssemblyPackAlgorithm {
 public:
     static void pack(PackAlgorithmAdapter& adapter, U2AssemblyPackStat& stat, U2OpStatus& os);
     static int packRead(const U2Region& reg, PackAlgorithmContext& ctx, U2OpStatus& os);
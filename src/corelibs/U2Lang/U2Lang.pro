@@ -11,6 +11,7 @@ HEADERS += src/library/BaseActorCategories.h \
            src/library/BaseTypes.h \
            src/library/LastReadyScheduler.h \
            src/library/LocalDomain.h \
+           src/library/ParallelScheduler.h \
            src/model/ActorPrototypeRegistry.h \
            src/model/Aliasing.h \
            src/model/Attribute.h \
@@ -32,6 +33,7 @@ HEADERS += src/library/BaseActorCategories.h \
            src/model/IntegralBusType.h \
            src/model/Marker.h \
            src/model/MarkerAttribute.h \
+           src/model/MemoryDataStorage.h \
            src/model/MessageMetadata.h \
            src/model/Peer.h \
            src/model/Port.h \
@@ -128,6 +130,7 @@ SOURCES += src/library/BaseActorCategories.cpp \
            src/library/BaseTypes.cpp \
            src/library/LastReadyScheduler.cpp \
            src/library/LocalDomain.cpp \
+           src/library/ParallelScheduler.cpp \
            src/model/ActorPrototypeRegistry.cpp \
            src/model/Aliasing.cpp \
            src/model/Attribute.cpp \
@@ -147,6 +150,7 @@ SOURCES += src/library/BaseActorCategories.cpp \
            src/model/IntegralBusType.cpp \
            src/model/Marker.cpp \
            src/model/MarkerAttribute.cpp \
+           src/model/MemoryDataStorage.cpp \
            src/model/MessageMetadata.cpp \
            src/model/Port.cpp \
            src/model/QDConstraint.cpp \
@@ -22,6 +22,7 @@
 #include "LocalDomain.h"
 
 #include <U2Lang/LastReadyScheduler.h>
+#include <U2Lang/ParallelScheduler.h>
 #include <U2Lang/Schema.h>
 #include <U2Lang/IntegralBusType.h>
 #include <U2Lang/WorkflowMonitor.h>
@@ -257,17 +258,20 @@ SimpleQueue::SimpleQueue() : ended(false), takenMsgs(0) {
 }
 
 Message SimpleQueue::get() {
-    assert(hasMessage());
+    QMutexLocker locker(&mutex);
+    assert(!que.isEmpty());
     takenMsgs++;
     return que.dequeue();
 }
 
 Message SimpleQueue::look() const {
-    assert(hasMessage());
+    QMutexLocker locker(&mutex);
+    assert(!que.isEmpty());
     return que.head();
 }
 
 void SimpleQueue::put(const Message& m, bool isMessageRestored) {
+    QMutexLocker locker(&mutex);
     que.enqueue(m);
     if(isMessageRestored) {
         --takenMsgs;
@@ -275,10 +279,12 @@ void SimpleQueue::put(const Message& m, bool isMessageRestored) {
 }
 
 int SimpleQueue::hasMessage() const {
+    QMutexLocker locker(&mutex);
     return que.size();
 }
 
 int SimpleQueue::takenMessages() const {
+    QMutexLocker locker(&mutex);
     return takenMsgs;
 }
 
@@ -287,10 +293,12 @@ int SimpleQueue::hasRoom(const DataType* ) const {
 }
 
 bool SimpleQueue::isEnded() const {
+    QMutexLocker locker(&mutex);
     return ended && que.isEmpty();
 }
 
 void SimpleQueue::setEnded() {
+    QMutexLocker locker(&mutex);
     ended = true;
 }
 
@@ -302,8 +310,9 @@ void SimpleQueue::setCapacity(int) {
 }
 
 QQueue<Message> SimpleQueue::getMessages(int startIndex, int endIndex) const {
+    QMutexLocker locker(&mutex);
     if(-1 == endIndex) {
-        endIndex = hasMessage() - 1;
+        endIndex = que.size() - 1;
     }
     Q_ASSERT(0 <= startIndex && que.size() >= startIndex
         && 0 <= endIndex && que.size() >= endIndex);
@@ -419,7 +428,12 @@ CommunicationChannel* LocalDomainFactory::createConnection(Link* l) {
 }
 
 Scheduler* LocalDomainFactory::createScheduler(Schema* sh) {
-    Scheduler *sc = new LastReadyScheduler(sh);
+    Scheduler *sc = NULL;
+    if (WorkflowSettings::isParallelRunEnabled()) {
+        sc = new ParallelScheduler(sh);
+    } else {
+        sc = new LastReadyScheduler(sh);
+    }
     return sc;
 }
 
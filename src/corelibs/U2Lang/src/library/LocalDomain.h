@@ -28,6 +28,7 @@
 #include <U2Lang/WorkflowTransport.h>
 #include <U2Lang/WorkflowManager.h>
 
+#include <QtCore/QMutex>
 #include <QtCore/QQueue>
 #include <limits.h>
 
@@ -120,6 +121,7 @@ protected:
 
 /**
  * simple realization of Communnication channel
+ * the queue is guarded by a mutex: the workers that are ticked in parallel can put messages from their tasks
  */
 class U2LANG_EXPORT SimpleQueue : public CommunicationChannel {
 public:
@@ -142,6 +144,7 @@ public:
     virtual QQueue<Message> getMessages(int startIndex = 0, int endIndex = -1) const;
 
 protected:
+    mutable QMutex mutex;
     // first in, first out
     QQueue<Message> que;
     // 'end' flag
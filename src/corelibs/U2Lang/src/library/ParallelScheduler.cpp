@@ -0,0 +1,172 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/AppContext.h>
+#include <U2Core/AppResources.h>
+#include <U2Core/AppSettings.h>
+#include <U2Core/U2SafePoints.h>
+
+#include <U2Lang/ElapsedTimeUpdater.h>
+#include <U2Lang/Schema.h>
+#include <U2Lang/WorkflowDebugStatus.h>
+#include <U2Lang/WorkflowMonitor.h>
+
+#include "ParallelScheduler.h"
+
+namespace U2 {
+
+namespace LocalWorkflow {
+
+ParallelScheduler::ParallelScheduler(Schema *sh)
+    : LastReadyScheduler(sh), maxRunningTicks(AppContext::getAppSettings()->getAppResourcePool()->getMaxThreadCount())
+{
+    maxRunningTicks = qMax(1, maxRunningTicks);
+}
+
+ParallelScheduler::~ParallelScheduler() {
+    qDeleteAll(timeUpdaters);
+}
+
+void ParallelScheduler::init() {
+    LastReadyScheduler::init();
+
+    QMap<const Actor *, QList<const Actor *> > successors;
+    foreach (Link *l, schema->getFlows()) {
+        successors[l->source()->owner()] << l->destination()->owner();
+    }
+    dependentActors.clear();
+    foreach (Actor *a, schema->getProcesses()) {
+        QList<const Actor *> stack = successors.value(a);
+        QSet<const Actor *> &downstream = dependentActors[a];
+        while (!stack.isEmpty()) {
+            const Actor *next = stack.takeLast();
+            if (!downstream.contains(next)) {
+                downstream << next;
+                stack << successors.value(next);
+            }
+        }
+    }
+    foreach (Actor *a, schema->getProcesses()) {
+        foreach (const Actor *next, dependentActors.value(a)) {
+            dependentActors[next] << a;
+        }
+    }
+}
+
+bool ParallelScheduler::isBusy(BaseWorker *w) const {
+    Task *t = tickTasks.value(w, NULL);
+    return (NULL != t) && !t->isFinished();
+}
+
+int ParallelScheduler::runningTicksCount() const {
+    int result = 0;
+    foreach (const QPointer<Task> &t, tickTasks) {
+        if (!t.isNull() && !t->isFinished()) {
+            result++;
+        }
+    }
+    return result;
+}
+
+bool ParallelScheduler::dependsOnRunningTicks(const Actor *a) const {
+    const QSet<const Actor *> dependent = dependentActors.value(a);
+    QMap<BaseWorker *, QPointer<Task> >::ConstIterator i = tickTasks.constBegin();
+    for (; i != tickTasks.constEnd(); i++) {
+        if (isBusy(i.key()) && dependent.contains(i.key()->getActor())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Actor * ParallelScheduler::findReadyActor() const {
+    for (int vertexLabel = 0; vertexLabel < topologicSortedGraph.size(); vertexLabel++) {
+        foreach (Actor *a, topologicSortedGraph.value(vertexLabel)) {
+            BaseWorker *w = a->castPeer<BaseWorker>();
+            if (!w->isReady() || isBusy(w) || dependsOnRunningTicks(a)) {
+                continue;
+            }
+            if (requestedActorForNextTick.isEmpty() || a->getId() == requestedActorForNextTick) {
+                return a;
+            }
+        }
+    }
+    return NULL;
+}
+
+bool ParallelScheduler::isReady() const {
+    CHECK(runningTicksCount() < maxRunningTicks, false);
+    return NULL != findReadyActor();
+}
+
+Task * ParallelScheduler::tick() {
+    Actor *a = findReadyActor();
+    SAFE_POINT(NULL != a, "No ready actors to tick", NULL);
+
+    BaseWorker *w = a->castPeer<BaseWorker>();
+    w->deleteBackupMessagesFromPreviousTick();
+    Task *t = w->tick(canLastTaskBeCanceled);
+
+    delete timeUpdaters.take(w);
+    tickTasks.remove(w);
+    if (NULL != t) {
+        ElapsedTimeUpdater *updater = new ElapsedTimeUpdater(a->getId(), context->getMonitor(), t);
+        updater->start(1000);
+        timeUpdaters[w] = updater;
+        tickTasks[w] = t;
+
+        context->getMonitor()->registerTask(t, a->getId());
+    }
+
+    lastWorker = w;
+    lastTask = t;
+    debugInfo->checkActorForBreakpoint(a);
+    if (!requestedActorForNextTick.isEmpty()) {
+        requestedActorForNextTick = ActorId();
+    }
+    return t;
+}
+
+bool ParallelScheduler::cancelCurrentTaskIfAllowed() {
+    // the other ticks can use the messages of the canceled one, so the tick can not be replayed
+    return false;
+}
+
+bool ParallelScheduler::isParallel() const {
+    return true;
+}
+
+WorkerState ParallelScheduler::getWorkerState(const Actor *a) {
+    BaseWorker *w = a->castPeer<BaseWorker>();
+    if (isBusy(w)) {
+        return WorkerRunning;
+    }
+    if (w->isDone()) {
+        return WorkerDone;
+    } else if (w->isReady()) {
+        return WorkerReady;
+    }
+    return WorkerWaiting;
+}
+
+} // LocalWorkflow
+
+} // U2
@@ -0,0 +1,77 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _WORKFLOW_PARALLEL_SCHEDULER_H_
+#define _WORKFLOW_PARALLEL_SCHEDULER_H_
+
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
+
+#include "LastReadyScheduler.h"
+
+namespace U2 {
+
+namespace LocalWorkflow {
+
+/**
+ * ticks all ready workers that do not have running tasks
+ * the workers are visited in the same order as LastReadyScheduler does,
+ * every worker has not more than one running tick task, so the order of messages of one actor is preserved
+ * the workers are ticked in the main thread, so the channels and the monitor are not shared between threads,
+ * only the tick tasks run in parallel. The tasks run at the same time only if their actors are independent:
+ * there is no data path between them. The data storage, the message metadata and the used files
+ * of the workflow process are shared by all tasks and are guarded by their own mutexes
+ * the debugger pauses the workflow after the running tasks: no new ticks are started while it is paused
+ */
+class ParallelScheduler : public LastReadyScheduler {
+public:
+    ParallelScheduler(Schema *sh);
+    virtual ~ParallelScheduler();
+
+    // reimplemented from Worker
+    virtual void init();
+    virtual bool isReady() const;
+    virtual Task *tick();
+
+    virtual bool cancelCurrentTaskIfAllowed();
+    virtual bool isParallel() const;
+
+protected:
+    virtual WorkerState getWorkerState(const Actor *a);
+
+private:
+    bool isBusy(BaseWorker *w) const;
+    int runningTicksCount() const;
+    bool dependsOnRunningTicks(const Actor *a) const;
+    Actor * findReadyActor() const;
+
+    QMap<BaseWorker *, QPointer<Task> > tickTasks;
+    // the actors that are upstream or downstream of the key actor
+    QMap<const Actor *, QSet<const Actor *> > dependentActors;
+    QMap<BaseWorker *, ElapsedTimeUpdater *> timeUpdaters;
+    int maxRunningTicks;
+};
+
+} // LocalWorkflow
+
+} // U2
+
+#endif // _WORKFLOW_PARALLEL_SCHEDULER_H_
@@ -23,6 +23,7 @@
 #include <U2Core/U2OpStatusUtils.h>
 
 #include <U2Lang/DbiDataStorage.h>
+#include <U2Lang/MemoryDataStorage.h>
 
 #include "DbiDataHandler.h"
 
@@ -30,12 +31,21 @@ namespace U2 {
 namespace Workflow {
 
 DbiDataHandler::DbiDataHandler(const U2EntityRef &entRef, U2ObjectDbi *dbi, bool useGC)
-: entRef(entRef), dbi(dbi), useGC(useGC)
+: entRef(entRef), dbi(dbi), useGC(useGC), memorySequence(NULL), memoryOrder(-1), memoryImporting(false)
+{
+
+}
+
+DbiDataHandler::DbiDataHandler(const U2DbiRef &dbiRef, U2ObjectDbi *dbi, const QSharedPointer<MemoryDataPool> &pool)
+: entRef(dbiRef, U2DataId()), dbi(dbi), useGC(true), memoryPool(pool), memorySequence(NULL), memoryOrder(-1), memoryImporting(false)
 {
 
 }
 
 DbiDataHandler::~DbiDataHandler() {
+    if (!memoryPool.isNull()) {
+        memoryPool->remove(this);
+    }
     if (useGC) {
         U2OpStatusImpl os;
         // TODO: removing is forbidden because of performance problems
@@ -45,7 +55,7 @@ DbiDataHandler::~DbiDataHandler() {
 }
 
 DbiDataHandler::DbiDataHandler(const DbiDataHandler & /*other*/)
-: QSharedData()
+: QSharedData(), memorySequence(NULL), memoryOrder(-1), memoryImporting(false)
 {
 }
 
@@ -57,6 +67,10 @@ bool DbiDataHandler::equals(const DbiDataHandler *other) const {
     if (NULL == other) {
         return false;
     }
+    if (!memoryPool.isNull() || !other->memoryPool.isNull()) {
+        // the copies of the in-memory objects share the handler
+        return this == other;
+    }
 
     return (other->entRef == entRef) && (other->dbi == dbi);
 }
@@ -73,7 +87,17 @@ U2DbiRef DbiDataHandler::getDbiRef() const {
     return entRef.dbiRef;
 }
 
+U2EntityRef DbiDataHandler::getEntityRef() const {
+    if (!memoryPool.isNull()) {
+        return memoryPool->getEntityRef(this);
+    }
+    return entRef;
+}
+
 bool DbiDataHandler::isValid() const {
+    if (!memoryPool.isNull()) {
+        return entRef.dbiRef.isValid();
+    }
     return entRef.isValid();
 }
 
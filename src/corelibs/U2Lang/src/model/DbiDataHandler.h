@@ -22,35 +22,53 @@
 #ifndef _WORKFLOW_DBI_DATA_HANDLER_H_
 #define _WORKFLOW_DBI_DATA_HANDLER_H_
 
+#include <QtCore/QSharedPointer>
+
 #include <U2Core/U2ObjectDbi.h>
 #include <U2Core/U2Type.h>
 
 namespace U2 {
+
+class DNASequence;
+
 namespace Workflow {
 
 class DbiDataStorage;
 class DbiDataHandler;
+class MemoryDataPool;
 
 typedef QSharedDataPointer<DbiDataHandler> SharedDbiDataHandler;
 
 class U2LANG_EXPORT DbiDataHandler : public QSharedData {
     friend class DbiDataStorage;
+    friend class MemoryDataPool;
 public:
     DbiDataHandler(const U2EntityRef &entRef, U2ObjectDbi *dbi, bool useGC);
+    /* The handler of the object that is not imported into the dbi yet. The entity id is set by @pool on import */
+    DbiDataHandler(const U2DbiRef &dbiRef, U2ObjectDbi *dbi, const QSharedPointer<MemoryDataPool> &pool);
     virtual ~DbiDataHandler();
 
     int getReferenceCount() const;
     U2DbiRef getDbiRef() const;
+    /* The entity id of the in-memory object is published by the memory pool, so it is read under the pool mutex */
+    U2EntityRef getEntityRef() const;
 
     bool equals(const DbiDataHandler *other) const;
 
     bool isValid() const;
 
 private:
-    const U2EntityRef entRef;
+    // the entity id is empty while the object is kept in the memory pool, it is published under the mutex of @memoryPool
+    U2EntityRef entRef;
     U2ObjectDbi *dbi;
     bool useGC;
 
+    QSharedPointer<MemoryDataPool> memoryPool;
+    // these fields are guarded by the mutex of @memoryPool
+    DNASequence *memorySequence;
+    qint64 memoryOrder;
+    bool memoryImporting;
+
     DbiDataHandler(const DbiDataHandler &);
     DbiDataHandler &operator=(const DbiDataHandler &);
 };
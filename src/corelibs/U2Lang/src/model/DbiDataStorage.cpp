@@ -92,8 +92,9 @@ U2DbiRef DbiDataStorage::getDbiRef() {
 U2Object *DbiDataStorage::getObject(const SharedDbiDataHandler &handler, const U2DataType &type) {
     assert(NULL != dbiHandle);
     U2OpStatusImpl os;
-    const U2DataId &objectId = handler->entRef.entityId;
-    DbiConnection *connection = this->getConnection(handler->getDbiRef(), os);
+    const U2EntityRef entityRef = handler->getEntityRef();
+    const U2DataId &objectId = entityRef.entityId;
+    DbiConnection *connection = this->getConnection(entityRef.dbiRef, os);
     CHECK_OP(os, NULL);
 
     if (U2Type::Sequence == type) {
@@ -127,7 +128,7 @@ U2Object *DbiDataStorage::getObject(const SharedDbiDataHandler &handler, const U
 
         return new U2AnnotationTable(annTable);
     } else if (U2Type::Text == type) {
-        U2RawData rawData = RawDataUdrSchema::getObject(handler->entRef, os);
+        U2RawData rawData = RawDataUdrSchema::getObject(entityRef, os);
         SAFE_POINT_OP(os, NULL);
 
         return new U2RawData(rawData);
@@ -152,6 +153,12 @@ SharedDbiDataHandler DbiDataStorage::putSequence(const DNASequence &dnaSeq) {
     return handler;
 }
 
+DNASequence DbiDataStorage::getSequence(const SharedDbiDataHandler &handler, U2OpStatus &os) {
+    QScopedPointer<U2SequenceObject> seqObj(StorageUtils::getSequenceObject(this, handler));
+    CHECK_EXT(NULL != seqObj.data(), os.setError(L10N::nullPointerError("sequence object")), DNASequence());
+    return seqObj->getWholeSequence(os);
+}
+
 SharedDbiDataHandler DbiDataStorage::putAlignment(const MAlignment &al) {
     assert(NULL != dbiHandle);
 
@@ -229,7 +236,7 @@ SharedDbiDataHandler DbiDataStorage::getDataHandler(const U2EntityRef &entRef, b
 }
 
 DbiConnection *DbiDataStorage::getConnection(const U2DbiRef &dbiRef, U2OpStatus &os) {
-    // TODO: mutex
+    QMutexLocker locker(&connectionsMutex);
     if (connections.contains(dbiRef.dbiId)) {
         return connections[dbiRef.dbiId];
     } else {
@@ -242,7 +249,7 @@ DbiConnection *DbiDataStorage::getConnection(const U2DbiRef &dbiRef, U2OpStatus
 }
 
 U2DbiRef DbiDataStorage::createTmpDbi(U2OpStatus &os) {
-    // TODO: mutex
+    QMutexLocker locker(&connectionsMutex);
     QString tmpDirPath = AppContext::getAppSettings()->getUserAppsSettings()->getCurrentProcessTemporaryDirPath();
 
     U2DbiRef dbiRef;
@@ -266,6 +273,7 @@ void DbiDataStorage::openDbi(const U2DbiRef &dbiRef, U2OpStatus &os) {
     QScopedPointer<DbiConnection> con(new DbiConnection(dbiRef, false, os));
     CHECK_OP(os,);
 
+    QMutexLocker locker(&connectionsMutex);
     dbiList[dbiRef.dbiId] = false;
     connections[dbiRef.dbiId] = con.take();
 }
@@ -283,6 +291,11 @@ U2SequenceObject *StorageUtils::getSequenceObject(DbiDataStorage *storage, const
     return new U2SequenceObject(seqDbi->visualName, ent);
 }
 
+DNASequence StorageUtils::getSequence(DbiDataStorage *storage, const SharedDbiDataHandler &handler, U2OpStatus &os) {
+    CHECK_EXT(NULL != handler.constData(), os.setError(L10N::nullPointerError("sequence handler")), DNASequence());
+    return storage->getSequence(handler, os);
+}
+
 VariantTrackObject *StorageUtils::getVariantTrackObject(DbiDataStorage *storage, const SharedDbiDataHandler &handler) {
     CHECK(NULL != handler.constData(), NULL);
     //QScopedPointer<U2VariantTrack> track(dynamic_cast<U2VariantTrack*>(storage->getObject(handler, U2Type::VariantTrack)));
@@ -22,6 +22,8 @@
 #ifndef _WORKFLOW_DBI_DATA_STORAGE_H_
 #define _WORKFLOW_DBI_DATA_STORAGE_H_
 
+#include <QtCore/QMutex>
+
 #include <U2Core/AnnotationData.h>
 #include <U2Core/AssemblyObject.h>
 #include <U2Core/DNASequence.h>
@@ -43,12 +45,14 @@ public:
     DbiDataStorage();
     virtual ~DbiDataStorage();
 
-    bool init();
+    virtual bool init();
     U2DbiRef getDbiRef();
 
     /* NOTE: deallocate memory! */
     virtual U2Object *getObject(const SharedDbiDataHandler &handler, const U2DataType &type);
     virtual SharedDbiDataHandler putSequence(const DNASequence &sequence);
+    /* Returns the whole sequence without creating the sequence object */
+    virtual DNASequence getSequence(const SharedDbiDataHandler &handler, U2OpStatus &os);
     virtual SharedDbiDataHandler putAlignment(const MAlignment &al);
     virtual SharedDbiDataHandler putAnnotationTable(const QList<SharedAnnotationData> &anns, const QString annTableName = "Annotations");
     virtual SharedDbiDataHandler putAnnotationTable(AnnotationTableObject *annTable);
@@ -70,7 +74,10 @@ private:
     QMap<U2DbiId, DbiConnection*> connections;
     /* DbiRef <-> temporary */
     QMap<U2DbiId, bool> dbiList;
+    /* Guards the connections and the dbi list: the workers can be ticked in parallel */
+    QMutex connectionsMutex;
 
+protected:
     DbiConnection *getConnection(const U2DbiRef &dbiRef, U2OpStatus &os);
 };
 
@@ -81,6 +88,8 @@ public:
      * Do not forget to move the object to thread you need
      **/
     static U2SequenceObject *getSequenceObject(DbiDataStorage *storage, const SharedDbiDataHandler &handler);
+    /* Use it if the sequence object itself is not needed: the in-memory storage does not import the sequence then */
+    static DNASequence getSequence(DbiDataStorage *storage, const SharedDbiDataHandler &handler, U2OpStatus &os);
     static VariantTrackObject *getVariantTrackObject(DbiDataStorage *storage, const SharedDbiDataHandler &handler);
     static AssemblyObject *getAssemblyObject(DbiDataStorage *storage, const SharedDbiDataHandler &handler);
     static MAlignmentObject *getMsaObject(DbiDataStorage *storage, const SharedDbiDataHandler &handler);
@@ -0,0 +1,197 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SequenceUtils.h>
+
+#include "MemoryDataStorage.h"
+
+namespace U2 {
+namespace Workflow {
+
+/************************************************************************/
+/* MemoryDataPool */
+/************************************************************************/
+MemoryDataPool::MemoryDataPool(const U2DbiRef &dbiRef, qint64 memoryLimit)
+: dbiRef(dbiRef), memoryLimit(memoryLimit), usedMemory(0), importingMemory(0), nextOrder(0)
+{
+
+}
+
+void MemoryDataPool::addSequence(DbiDataHandler *handler, const DNASequence &sequence, U2OpStatus &os) {
+    QList<DbiDataHandler *> taken;
+    {
+        QMutexLocker locker(&mutex);
+        SAFE_POINT_EXT(NULL == handler->memorySequence, os.setError("The handler already has a sequence"), );
+
+        handler->memorySequence = new DNASequence(sequence);
+        handler->memoryOrder = nextOrder++;
+        handlers[handler->memoryOrder] = handler;
+        usedMemory += getSize(sequence);
+
+        while (usedMemory - importingMemory > memoryLimit && !handlers.isEmpty()) {
+            DbiDataHandler *oldest = handlers.begin().value();
+            takeLocked(oldest);
+            taken << oldest;
+        }
+    }
+    importTaken(taken, os);
+}
+
+bool MemoryDataPool::getSequence(const DbiDataHandler *handler, DNASequence &sequence) const {
+    QMutexLocker locker(&mutex);
+    CHECK(NULL != handler->memorySequence, false);
+    sequence = *handler->memorySequence;
+    return true;
+}
+
+void MemoryDataPool::importSequence(const DbiDataHandler *constHandler, U2OpStatus &os) {
+    DbiDataHandler *handler = const_cast<DbiDataHandler *>(constHandler);
+    {
+        QMutexLocker locker(&mutex);
+        waitImportLocked(handler);
+        CHECK(NULL != handler->memorySequence, );
+        takeLocked(handler);
+    }
+    importTaken(QList<DbiDataHandler *>() << handler, os);
+}
+
+void MemoryDataPool::remove(DbiDataHandler *handler) {
+    QMutexLocker locker(&mutex);
+    waitImportLocked(handler);
+    releaseLocked(handler);
+}
+
+U2EntityRef MemoryDataPool::getEntityRef(const DbiDataHandler *handler) const {
+    QMutexLocker locker(&mutex);
+    return handler->entRef;
+}
+
+qint64 MemoryDataPool::getUsedMemory() const {
+    QMutexLocker locker(&mutex);
+    return usedMemory;
+}
+
+qint64 MemoryDataPool::getSize(const DNASequence &sequence) {
+    return sequence.seq.size() + sequence.quality.qualCodes.size() + sizeof(QChar) * sequence.getName().size();
+}
+
+void MemoryDataPool::waitImportLocked(const DbiDataHandler *handler) const {
+    while (handler->memoryImporting) {
+        importFinished.wait(&mutex);
+    }
+}
+
+void MemoryDataPool::takeLocked(DbiDataHandler *handler) {
+    handlers.remove(handler->memoryOrder);
+    handler->memoryImporting = true;
+    importingMemory += getSize(*handler->memorySequence);
+}
+
+void MemoryDataPool::importTaken(const QList<DbiDataHandler *> &taken, U2OpStatus &os) {
+    foreach (DbiDataHandler *handler, taken) {
+        U2EntityRef entityRef;
+        if (!os.hasError()) {
+            // the sequence is neither changed nor released while the handler is being imported
+            entityRef = U2SequenceUtils::import(dbiRef, *handler->memorySequence, os);
+        }
+        QMutexLocker locker(&mutex);
+        finishImportLocked(handler, entityRef, os);
+    }
+}
+
+void MemoryDataPool::finishImportLocked(DbiDataHandler *handler, const U2EntityRef &entityRef, const U2OpStatus &os) {
+    handler->memoryImporting = false;
+    importingMemory -= getSize(*handler->memorySequence);
+    if (os.hasError()) {
+        // the sequence stays in memory and can be imported later
+        handlers[handler->memoryOrder] = handler;
+    } else {
+        handler->entRef.entityId = entityRef.entityId;
+        releaseLocked(handler);
+    }
+    importFinished.wakeAll();
+}
+
+void MemoryDataPool::releaseLocked(DbiDataHandler *handler) {
+    CHECK(NULL != handler->memorySequence, );
+
+    usedMemory -= getSize(*handler->memorySequence);
+    delete handler->memorySequence;
+    handler->memorySequence = NULL;
+    handlers.remove(handler->memoryOrder);
+    handler->memoryOrder = -1;
+}
+
+/************************************************************************/
+/* MemoryDataStorage */
+/************************************************************************/
+MemoryDataStorage::MemoryDataStorage(qint64 memoryLimit)
+: DbiDataStorage(), memoryLimit(memoryLimit)
+{
+
+}
+
+bool MemoryDataStorage::init() {
+    CHECK(DbiDataStorage::init(), false);
+    pool = QSharedPointer<MemoryDataPool>(new MemoryDataPool(getDbiRef(), memoryLimit));
+    return true;
+}
+
+U2Object *MemoryDataStorage::getObject(const SharedDbiDataHandler &handler, const U2DataType &type) {
+    if (U2Type::Sequence == type) {
+        U2OpStatusImpl os;
+        pool->importSequence(handler.constData(), os);
+        SAFE_POINT_OP(os, NULL);
+    }
+    return DbiDataStorage::getObject(handler, type);
+}
+
+SharedDbiDataHandler MemoryDataStorage::putSequence(const DNASequence &sequence) {
+    SAFE_POINT(!pool.isNull(), "Memory data storage is not initialized", SharedDbiDataHandler());
+
+    U2OpStatusImpl os;
+    DbiConnection *connection = getConnection(getDbiRef(), os);
+    CHECK_OP(os, SharedDbiDataHandler());
+
+    DbiDataHandler *handler = new DbiDataHandler(getDbiRef(), connection->dbi->getObjectDbi(), pool);
+    SharedDbiDataHandler result(handler);
+    pool->addSequence(handler, sequence, os);
+    CHECK_OP(os, SharedDbiDataHandler());
+
+    return result;
+}
+
+DNASequence MemoryDataStorage::getSequence(const SharedDbiDataHandler &handler, U2OpStatus &os) {
+    DNASequence sequence;
+    if (pool->getSequence(handler.constData(), sequence)) {
+        return sequence;
+    }
+    return DbiDataStorage::getSequence(handler, os);
+}
+
+qint64 MemoryDataStorage::getUsedMemory() const {
+    return pool.isNull() ? 0 : pool->getUsedMemory();
+}
+
+} // Workflow
+} // U2
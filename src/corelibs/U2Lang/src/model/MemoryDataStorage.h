@@ -0,0 +1,101 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _WORKFLOW_MEMORY_DATA_STORAGE_H_
+#define _WORKFLOW_MEMORY_DATA_STORAGE_H_
+
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
+
+#include <U2Lang/DbiDataStorage.h>
+
+namespace U2 {
+namespace Workflow {
+
+/**
+ * Keeps the objects of the in-memory handlers.
+ * When the memory limit is exceeded the oldest objects are imported into the dbi.
+ * The pool is shared by the storage and the handlers, so it is alive while any handler is alive.
+ * The dbi import runs without the pool mutex: the handler is marked as being imported,
+ * and its entity id is published under the mutex when the import is finished.
+ */
+class MemoryDataPool {
+public:
+    MemoryDataPool(const U2DbiRef &dbiRef, qint64 memoryLimit);
+
+    void addSequence(DbiDataHandler *handler, const DNASequence &sequence, U2OpStatus &os);
+    /* Returns false if the sequence of @handler is not in memory */
+    bool getSequence(const DbiDataHandler *handler, DNASequence &sequence) const;
+    /* Imports the sequence of @handler into the dbi if it is still in memory */
+    void importSequence(const DbiDataHandler *handler, U2OpStatus &os);
+    void remove(DbiDataHandler *handler);
+    /* Returns the entity reference of @handler. The entity id is empty if the sequence is not imported yet */
+    U2EntityRef getEntityRef(const DbiDataHandler *handler) const;
+
+    qint64 getUsedMemory() const;
+
+private:
+    static qint64 getSize(const DNASequence &sequence);
+
+    void waitImportLocked(const DbiDataHandler *handler) const;
+    void takeLocked(DbiDataHandler *handler);
+    void importTaken(const QList<DbiDataHandler *> &taken, U2OpStatus &os);
+    void finishImportLocked(DbiDataHandler *handler, const U2EntityRef &entityRef, const U2OpStatus &os);
+    void releaseLocked(DbiDataHandler *handler);
+
+    mutable QMutex mutex;
+    mutable QWaitCondition importFinished;
+    const U2DbiRef dbiRef;
+    const qint64 memoryLimit;
+    qint64 usedMemory;
+    // the memory of the objects that are being imported now
+    qint64 importingMemory;
+    qint64 nextOrder;
+    // the in-memory objects in the order of adding, except the ones that are being imported
+    QMap<qint64, DbiDataHandler *> handlers;
+};
+
+/**
+ * Passes the sequences between workflow elements without importing them into the session dbi.
+ * The sequence is imported only if its dbi object is requested or if it is pushed out of the memory limit.
+ * The other data types are stored as usual.
+ */
+class U2LANG_EXPORT MemoryDataStorage : public DbiDataStorage {
+public:
+    MemoryDataStorage(qint64 memoryLimit);
+
+    virtual bool init();
+
+    virtual U2Object *getObject(const SharedDbiDataHandler &handler, const U2DataType &type);
+    virtual SharedDbiDataHandler putSequence(const DNASequence &sequence);
+    virtual DNASequence getSequence(const SharedDbiDataHandler &handler, U2OpStatus &os);
+
+    qint64 getUsedMemory() const;
+
+private:
+    const qint64 memoryLimit;
+    QSharedPointer<MemoryDataPool> pool;
+};
+
+} // Workflow
+} // U2
+
+#endif // _WORKFLOW_MEMORY_DATA_STORAGE_H_
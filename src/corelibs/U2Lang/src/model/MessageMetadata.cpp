@@ -76,10 +76,12 @@ int MessageMetadata::nextId() {
 /* MessageMetadataStorage */
 /************************************************************************/
 void MessageMetadataStorage::put(const MessageMetadata &value) {
+    QMutexLocker locker(&mutex);
     data[value.getId()] = value;
 }
 
 MessageMetadata MessageMetadataStorage::get(int metadataId) const {
+    QMutexLocker locker(&mutex);
     return data.value(metadataId, MessageMetadata());
 }
 
@@ -23,6 +23,7 @@
 #define _U2_MESSAGE_METADATA_H_
 
 #include <QMap>
+#include <QMutex>
 
 #include <U2Core/global.h>
 
@@ -59,6 +60,8 @@ public:
 
 private:
     QMap<int, MessageMetadata> data;
+    // the parallel ticks put the metadata concurrently
+    mutable QMutex mutex;
 };
 
 } // U2
@@ -37,6 +37,7 @@
 #include <U2Lang/Datatype.h>
 #include <U2Lang/GrouperOutSlot.h>
 #include <U2Lang/IntegralBus.h>
+#include <U2Lang/MemoryDataStorage.h>
 #include <U2Lang/WorkflowMonitor.h>
 #include <U2Lang/WorkflowSettings.h>
 
@@ -87,7 +88,11 @@ WorkflowContext::~WorkflowContext() {
 }
 
 bool WorkflowContext::init() {
-    storage = new DbiDataStorage();
+    if (WorkflowSettings::isInMemoryDataStorageEnabled()) {
+        storage = new MemoryDataStorage(qint64(WorkflowSettings::getInMemoryDataStorageLimit()) * 1024 * 1024);
+    } else {
+        storage = new DbiDataStorage();
+    }
     CHECK(initWorkingDir(), false);
     return storage->init();
 }
@@ -97,6 +97,8 @@ public:
     // returning value indicates if current task was canceled
     virtual bool cancelCurrentTaskIfAllowed() = 0;
     virtual void makeOneTick(const ActorId &) = 0;
+    // returns true if the scheduler can tick the next worker while the tasks of the previous ticks are running
+    virtual bool isParallel() const { return false; }
     virtual void setDebugInfo(WorkflowDebugStatus *newDebugInfo) {
         Q_ASSERT(NULL != newDebugInfo);
         debugInfo = newDebugInfo;
@@ -242,12 +242,18 @@ void WorkflowIterationRunTask::prepare() {
     scheduler->setContext(context);
     scheduler->init();
     scheduler->setDebugInfo(debugInfo);
+    if (scheduler->isParallel()) {
+        setMaxParallelSubtasks(MAX_PARALLEL_SUBTASKS_AUTO);
+    }
     context->getMonitor()->start();
     while(scheduler->isReady() && !isCanceled()) {
         Task* t = scheduler->tick();
         if (t) {
             addSubTask(t);
-            break;
+            // a breakpoint pauses the workflow after the ticks that are already started
+            if (!scheduler->isParallel() || debugInfo->isPaused()) {
+                break;
+            }
         }
     }
 }
@@ -278,7 +284,9 @@ QList<Task*> WorkflowIterationRunTask::onSubTaskFinished(Task* subTask) {
         Task* t = scheduler->tick();
         if (t) {
             tasks << t;
-            break;
+            if (!scheduler->isParallel() || debugInfo->isPaused()) {
+                break;
+            }
         }
     }
     emit si_ticked();
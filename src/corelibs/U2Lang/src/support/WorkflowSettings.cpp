@@ -47,6 +47,9 @@ namespace U2 {
 #define SNAP_STATE                  SETTINGS + "snap2rid"
 #define LOCK_STATE                  SETTINGS + "monitorRun"
 #define DEBUGGER_STATE              SETTINGS + "enableDebugger"
+#define PARALLEL_RUN                SETTINGS + "parallelRun"
+#define IN_MEMORY_STORAGE           SETTINGS + "inMemoryStorage"
+#define IN_MEMORY_STORAGE_LIMIT     SETTINGS + "inMemoryStorageLimit"
 #define STYLE                       SETTINGS + "style"
 #define FONT                        SETTINGS + "font"
 #define DIR                         "workflow_settings/path"
@@ -95,6 +98,30 @@ void WorkflowSettings::setDebuggerEnabled(bool v) {
     AppContext::getSettings()->setValue(DEBUGGER_STATE, v);
 }
 
+bool WorkflowSettings::isParallelRunEnabled() {
+    return AppContext::getSettings()->getValue(PARALLEL_RUN, false).toBool();
+}
+
+void WorkflowSettings::setParallelRunEnabled(bool v) {
+    AppContext::getSettings()->setValue(PARALLEL_RUN, v);
+}
+
+bool WorkflowSettings::isInMemoryDataStorageEnabled() {
+    return AppContext::getSettings()->getValue(IN_MEMORY_STORAGE, false).toBool();
+}
+
+void WorkflowSettings::setInMemoryDataStorageEnabled(bool v) {
+    AppContext::getSettings()->setValue(IN_MEMORY_STORAGE, v);
+}
+
+int WorkflowSettings::getInMemoryDataStorageLimit() {
+    return AppContext::getSettings()->getValue(IN_MEMORY_STORAGE_LIMIT, 512).toInt();
+}
+
+void WorkflowSettings::setInMemoryDataStorageLimit(int v) {
+    AppContext::getSettings()->setValue(IN_MEMORY_STORAGE_LIMIT, v);
+}
+
 QString WorkflowSettings::defaultStyle()
 {
     return AppContext::getSettings()->getValue(STYLE, "ext").toString();
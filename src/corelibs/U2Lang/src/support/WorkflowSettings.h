@@ -54,6 +54,15 @@ public:
     static bool isDebuggerEnabled();
     static void setDebuggerEnabled(bool v);
 
+    static bool isParallelRunEnabled();
+    static void setParallelRunEnabled(bool v);
+
+    static bool isInMemoryDataStorageEnabled();
+    static void setInMemoryDataStorageEnabled(bool v);
+    // in megabytes
+    static int getInMemoryDataStorageLimit();
+    static void setInMemoryDataStorageLimit(int v);
+
     static QString defaultStyle();
     static void setDefaultStyle(const QString&);
 
@@ -22,6 +22,7 @@
 #include "IOAdapterRegistryImpl.h"
 
 #include <U2Core/LocalFileAdapter.h>
+#include <U2Core/MemoryMappedFileAdapter.h>
 #include <U2Core/HttpFileAdapter.h>
 #include <U2Core/VFSAdapter.h>
 #include <U2Core/StringAdapter.h>
@@ -56,6 +57,7 @@ IOAdapterFactory* IOAdapterRegistryImpl::getIOAdapterFactoryById(IOAdapterId id)
 void IOAdapterRegistryImpl::init() {
     registerIOAdapter(new LocalFileAdapterFactory(this));
     registerIOAdapter(new GzippedLocalFileAdapterFactory(this));
+    registerIOAdapter(new MemoryMappedFileAdapterFactory(this));
     registerIOAdapter( new HttpFileAdapterFactory(this) );
     registerIOAdapter( new GzippedHttpFileAdapterFactory(this) );
     registerIOAdapter( new VFSAdapterFactory(this) );
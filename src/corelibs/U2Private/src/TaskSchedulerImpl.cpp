@@ -30,10 +30,13 @@
 #include <U2Core/AppContext.h>
 #include <U2Core/U2SafePoints.h>
 #include <U2Core/L10n.h>
+#include <U2Core/Settings.h>
 
 #include <QtCore/QVector>
 #include <QtCore/QCoreApplication>
 
+#include <climits>
+
 /* TRANSLATOR U2::TaskSchedulerImpl */
 
 #ifdef Q_CC_MSVC_NET
@@ -75,9 +78,11 @@ const int PAUSE_THREAD_EVENT_TYPE = 10003;
 namespace U2 {
 
 #define UPDATE_TIMEOUT 100
+#define SETTINGS_THREAD_POOL QString("task_scheduler/thread_pool")
 
 TaskSchedulerImpl::TaskSchedulerImpl(AppResourcePool* rp) {
     resourcePool = rp;
+    threadPool = NULL;
 
     stateNames << tr("New") <<  tr("Prepared") <<  tr("Running") << tr("Finished");
     connect(&timer, SIGNAL(timeout()), this, SLOT(update()));
@@ -87,11 +92,13 @@ TaskSchedulerImpl::TaskSchedulerImpl(AppResourcePool* rp) {
     threadsResource = resourcePool->getResource(RESOURCE_THREAD);
 
     createSleepPreventer();
+    createThreadPool();
 }
 
 TaskSchedulerImpl::~TaskSchedulerImpl() {
     assert(topLevelTasks.empty());
     assert(priorityQueue.isEmpty());
+    delete threadPool;
     delete sleepPreventer;
 }
 
@@ -218,6 +225,9 @@ bool TaskSchedulerImpl::processFinishedTasks() {
 
         Task* task = ti->task;
         priorityQueue.removeAt(i);
+        if (NULL != threadPool) {
+            threadPool->setPaused(task, false);
+        }
         if(task->hasFlags(TaskFlag_RunMessageLoopOnly)) {
             QCoreApplication::postEvent (ti->thread,
                 new QEvent(static_cast<QEvent::Type>(TERMINATE_MESSAGE_LOOP_EVENT_TYPE)));
@@ -314,12 +324,14 @@ void TaskSchedulerImpl::runReady() {
             if (state == Task::State_Prepared) {
                 promoteTask(ti, Task::State_Running);
             }
-            if (ti->thread == NULL) {
+            if (!ti->isRunStarted()) {
                 ti->selfRunFinished = true;
+            } else if (ti->runInPool && !ti->selfRunFinished && threadPool->cancelPending(ti)) {
+                ti->selfRunFinished = true; //the task was not taken by a worker yet
             }
             continue;
         }
-        if (ti->thread!=NULL) { //task is already running in a separate thread
+        if (ti->isRunStarted()) { //task is already running in a separate thread
             assert(state == Task::State_Running);
             continue;
         }
@@ -360,6 +372,11 @@ void TaskSchedulerImpl::runThread(TaskInfo* ti) {
     assert(!ti->task->hasError());
     assert(!ti->selfRunFinished);
 #endif
+    if (threadPool != NULL && !ti->task->hasFlags(TaskFlag_RunMessageLoopOnly)) {
+        ti->runInPool = true;
+        threadPool->submit(ti);
+        return;
+    }
     ti->thread = new TaskThread(ti);
     connect(ti->thread, SIGNAL(finished()), SLOT(sl_threadFinished()));
     ti->thread->start();
@@ -445,6 +462,7 @@ void TaskSchedulerImpl::releaseResources(TaskInfo* ti, bool prepareStage) {
     if (!prepareStage) {
         threadsResource->release();
     }
+    stateChangesObserved = true; //tasks waiting for the resources can be started right now
     TaskResources& tres = getTaskResources(ti->task);
     for (int i=0, n = tres.size(); i<n; i++) {
         TaskResourceUsage& taskRes = tres[i];
@@ -545,6 +563,7 @@ void TaskSchedulerImpl::registerTopLevelTask(Task* task) {
     newTasks.append(task);
 
     sleepPreventer->capture();
+    wakeUp();
 }
 
 bool TaskSchedulerImpl::addToPriorityQueue(Task* task, TaskInfo* pti) {
@@ -624,6 +643,8 @@ void TaskSchedulerImpl::stopTask(Task* task) {
             cancelTask(task);
             if (ti->thread!=NULL && !ti->thread->isFinished()) {
                 ti->thread->wait();//TODO: try avoid blocking here
+            } else if (ti->runInPool) {
+                threadPool->waitForTask(ti);
             }
             assert(readyToFinish(ti));
             break;
@@ -732,6 +753,22 @@ void TaskSchedulerImpl::createSleepPreventer() {
 #endif
 }
 
+void TaskSchedulerImpl::createThreadPool() {
+    Settings* s = AppContext::getSettings();
+    CHECK(NULL != s && s->getValue(SETTINGS_THREAD_POOL, false).toBool(), );
+
+    // the run stage of every task acquires the thread resource, so no more workers than its limit are ever needed
+    threadPool = new TaskThreadPool(qMax(1, resourcePool->getIdealThreadCount()), threadsResource->maxUse());
+    connect(threadPool, SIGNAL(si_taskRunFinished()), SLOT(sl_threadFinished()));
+    taskLog.details(tr("Tasks are run in the thread pool, workers: %1").arg(threadPool->getWorkersCount()));
+}
+
+void TaskSchedulerImpl::wakeUp() {
+    if (timer.interval() != 0) {
+        timer.setInterval(0);
+    }
+}
+
 static void checkFinishedState(TaskInfo* ti) {
 #ifdef _DEBUG
     foreach(Task* sub, ti->task->getSubtasks()) {
@@ -951,6 +988,10 @@ void TaskSchedulerImpl::updateOldTasksPriority() {
     n = UPDATE_GRAN;
 
     foreach(TaskInfo* ti, priorityQueue) {
+        if (ti->task->isRunning() && ti->runInPool && !ti->selfRunFinished) {
+            threadPool->setTaskPriority(ti, getThreadPriority(ti->task->getTopLevelParentTask()));
+            continue;
+        }
         if (!ti->task->isRunning() || ti->thread == NULL || !ti->thread->isRunning()) {
             continue;
         }
@@ -959,7 +1000,7 @@ void TaskSchedulerImpl::updateOldTasksPriority() {
 }
 
 void TaskSchedulerImpl::sl_threadFinished() {
-    timer.setInterval(0);
+    wakeUp();
 }
 
 Task * TaskSchedulerImpl::getTopLevelTaskById( qint64 id ) const {
@@ -975,8 +1016,11 @@ Task * TaskSchedulerImpl::getTopLevelTaskById( qint64 id ) const {
 }
 
 void TaskSchedulerImpl::pauseThreadWithTask(const Task *task) {
+    if (NULL != threadPool) {
+        threadPool->setPaused(task, true);
+    }
     foreach(TaskInfo *ti, priorityQueue) {
-        if(task == ti->task) {
+        if(task == ti->task && NULL != ti->thread) {
             QCoreApplication::postEvent(ti->thread,
                 new QEvent(static_cast<QEvent::Type>(PAUSE_THREAD_EVENT_TYPE)));
         }
@@ -984,6 +1028,9 @@ void TaskSchedulerImpl::pauseThreadWithTask(const Task *task) {
 }
 
 void TaskSchedulerImpl::resumeThreadWithTask(const Task *task) {
+    if (NULL != threadPool) {
+        threadPool->setPaused(task, false);
+    }
     foreach(TaskInfo *ti, priorityQueue) {
         if(task == ti->task && NULL != ti->thread && ti->thread->isPaused) {
             ti->thread->resume();
@@ -1123,6 +1170,7 @@ void TaskThread::resume() {
 }
 
 TaskInfo::~TaskInfo() {
+    assert(!runInPool || selfRunFinished);
     if (thread!=NULL) {
         if (!thread->isFinished()) {
             taskLog.trace("TaskScheduler: Waiting for the thread before delete");
@@ -1136,4 +1184,247 @@ TaskInfo::~TaskInfo() {
     }
 }
 
+/************************************************************************/
+/* TaskPoolWorker */
+/************************************************************************/
+#define EXTRA_WORKER_IDLE_TIMEOUT 30000
+
+TaskPoolWorker::TaskPoolWorker(TaskThreadPool* pool, int index, bool core)
+    : pool(pool), index(index), core(core)
+{
+}
+
+void TaskPoolWorker::run() {
+    setPriority(QThread::LowPriority);
+    forever {
+        int version = 0;
+        {
+            QMutexLocker locker(&pool->idleLock);
+            if (pool->stopped) {
+                break;
+            }
+            version = pool->workVersion;
+        }
+        TaskInfo* ti = pool->takeTask(index);
+        if (NULL != ti) {
+            runTask(ti);
+            continue;
+        }
+
+        QMutexLocker locker(&pool->idleLock);
+        if (pool->stopped) {
+            break;
+        }
+        if (version != pool->workVersion) {
+            continue;
+        }
+        const bool woken = pool->hasWork.wait(&pool->idleLock, core ? ULONG_MAX : EXTRA_WORKER_IDLE_TIMEOUT);
+        if (!woken && !core && version == pool->workVersion) {
+            pool->liveWorkersCount--;
+            break;
+        }
+    }
+}
+
+void TaskPoolWorker::runTask(TaskInfo* ti) {
+    assert(!ti->selfRunFinished);
+    assert(ti->task->getState() == Task::State_Running);
+
+    Qt::HANDLE handle = QThread::currentThreadId();
+    lock.lock();
+    AppContext::getTaskScheduler()->addThreadId(ti->task->getTaskId(), handle);
+    lock.unlock();
+
+    pool->onTaskRunStarted(ti, this);
+    try {
+        ti->task->run();
+        assert(ti->task->getState() == Task::State_Running);
+    } catch (const std::bad_alloc &) {
+        onBadAlloc(ti->task);
+    }
+
+    lock.lock();
+    AppContext::getTaskScheduler()->removeThreadId(ti->task->getTaskId());
+    lock.unlock();
+
+    pool->onTaskRunFinished(ti);
+}
+
+/************************************************************************/
+/* TaskThreadPool */
+/************************************************************************/
+TaskThreadPool::TaskThreadPool(int coreWorkersCount, int maxWorkersCount)
+    : nextDeque(0), maxWorkersCount(qMax(coreWorkersCount, maxWorkersCount)), liveWorkersCount(coreWorkersCount),
+      pendingCount(0), busyCount(0), stopped(false), workVersion(0)
+{
+    for (int i = 0; i < coreWorkersCount; i++) {
+        deques << new WorkerDeque();
+        workers << new TaskPoolWorker(this, i, true);
+    }
+    foreach (TaskPoolWorker* worker, workers) {
+        worker->start();
+    }
+}
+
+TaskThreadPool::~TaskThreadPool() {
+    idleLock.lock();
+    stopped = true;
+    hasWork.wakeAll();
+    idleLock.unlock();
+
+    foreach (TaskPoolWorker* worker, workers) {
+        worker->wait();
+    }
+    qDeleteAll(workers);
+    qDeleteAll(deques);
+}
+
+void TaskThreadPool::submit(TaskInfo* ti) {
+    WorkerDeque* deque = deques[nextDeque];
+    nextDeque = (nextDeque + 1) % deques.size();
+
+    deque->lock.lock();
+    deque->tasks.append(ti);
+    deque->lock.unlock();
+    pendingCount.ref();
+
+    QMutexLocker locker(&idleLock);
+    workVersion++;
+    startWorkerIfNeeded();
+    hasWork.wakeOne();
+}
+
+void TaskThreadPool::startWorkerIfNeeded() {
+    // a worker is counted as busy before its task stops being pending, so the demand is never underestimated
+    const int demand = busyCount.load() + pendingCount.load();
+    CHECK(demand > liveWorkersCount && liveWorkersCount < maxWorkersCount, );
+
+    deleteFinishedWorkers();
+    TaskPoolWorker* worker = new TaskPoolWorker(this, -1, false);
+    workers << worker;
+    liveWorkersCount++;
+    worker->start();
+}
+
+void TaskThreadPool::deleteFinishedWorkers() {
+    for (int i = workers.size() - 1; i >= deques.size(); i--) {
+        if (workers[i]->isFinished()) {
+            delete workers.takeAt(i);
+        }
+    }
+}
+
+TaskInfo* TaskThreadPool::takeTask(int workerIndex) {
+    CHECK(pendingCount.load() > 0, NULL);
+
+    // the most recently submitted task of the own deque first: its data is likely still in cache
+    if (workerIndex >= 0) {
+        TaskInfo* ti = takeNotPaused(deques[workerIndex], true);
+        CHECK(NULL == ti, ti);
+    }
+
+    // steal the oldest task of another worker
+    const int n = deques.size();
+    const int first = workerIndex >= 0 ? workerIndex + 1 : 0;
+    for (int i = 0; i < n; i++) {
+        const int victimIndex = (first + i) % n;
+        if (victimIndex == workerIndex) {
+            continue;
+        }
+        TaskInfo* ti = takeNotPaused(deques[victimIndex], false);
+        CHECK(NULL == ti, ti);
+    }
+    return NULL;
+}
+
+TaskInfo* TaskThreadPool::takeNotPaused(WorkerDeque* deque, bool newest) {
+    QMutexLocker locker(&deque->lock);
+    const int size = deque->tasks.size();
+    for (int i = 0; i < size; i++) {
+        const int index = newest ? size - 1 - i : i;
+        TaskInfo* ti = deque->tasks[index];
+        if (isPaused(ti)) {
+            continue;
+        }
+        busyCount.ref();
+        pendingCount.deref();
+        return deque->tasks.takeAt(index);
+    }
+    return NULL;
+}
+
+bool TaskThreadPool::isPaused(TaskInfo* ti) {
+    QMutexLocker locker(&pauseLock);
+    CHECK(!pausedTasks.isEmpty(), false);
+    for (const Task* task = ti->task; NULL != task; task = task->getParentTask()) {
+        CHECK(!pausedTasks.contains(task), true);
+    }
+    return false;
+}
+
+void TaskThreadPool::setPaused(const Task* task, bool paused) {
+    pauseLock.lock();
+    bool resumed = false;
+    if (paused) {
+        pausedTasks.insert(task);
+    } else {
+        resumed = pausedTasks.remove(task);
+    }
+    pauseLock.unlock();
+    CHECK(resumed, );
+
+    QMutexLocker locker(&idleLock);
+    workVersion++;
+    startWorkerIfNeeded();
+    hasWork.wakeAll();
+}
+
+void TaskThreadPool::setTaskPriority(TaskInfo* ti, QThread::Priority priority) {
+    QMutexLocker locker(&finishLock);
+    TaskPoolWorker* worker = runningTasks.value(ti, NULL);
+    if (NULL != worker && worker->priority() != priority) {
+        worker->setPriority(priority);
+    }
+}
+
+bool TaskThreadPool::cancelPending(TaskInfo* ti) {
+    foreach (WorkerDeque* deque, deques) {
+        QMutexLocker locker(&deque->lock);
+        if (deque->tasks.removeOne(ti)) {
+            pendingCount.deref();
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskThreadPool::waitForTask(TaskInfo* ti) {
+    if (cancelPending(ti)) {
+        ti->selfRunFinished = true;
+        return;
+    }
+    QMutexLocker locker(&finishLock);
+    while (!ti->selfRunFinished) {
+        runFinished.wait(&finishLock);
+    }
+}
+
+void TaskThreadPool::onTaskRunStarted(TaskInfo* ti, TaskPoolWorker* worker) {
+    QMutexLocker locker(&finishLock);
+    runningTasks.insert(ti, worker);
+    worker->setPriority(getThreadPriority(ti->task->getTopLevelParentTask()));
+}
+
+void TaskThreadPool::onTaskRunFinished(TaskInfo* ti) {
+    finishLock.lock();
+    runningTasks.remove(ti);
+    ti->selfRunFinished = true;
+    runFinished.wakeAll();
+    finishLock.unlock();
+    busyCount.deref();
+
+    // 'ti' can be deleted by the scheduler since this moment
+    emit si_taskRunFinished();
+}
+
 }//namespace
@@ -29,6 +29,9 @@
 #include <QtCore/QTimer>
 #include <QtCore/QMutex>
 #include <QtCore/QWaitCondition>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
 
 namespace U2 {
 
@@ -75,11 +78,101 @@ private:
 };
 
 
+class TaskThreadPool;
+
+/**
+ * A worker of the TaskThreadPool.
+ * Takes tasks from its own deque (LIFO) and steals from other workers (FIFO) when the own deque is empty.
+ * The extra workers have no deques, they only steal and exit after some idle time.
+ */
+class TaskPoolWorker : public QThread {
+public:
+    TaskPoolWorker(TaskThreadPool* pool, int index, bool core);
+    void run();
+
+private:
+    void runTask(TaskInfo* ti);
+
+    TaskThreadPool* pool;
+    int             index;      // -1 for the extra workers
+    bool            core;
+};
+
+/**
+ * Set of worker threads used by the TaskSchedulerImpl instead of creating a new TaskThread per task.
+ * It keeps the ideal count of workers and starts extra ones when all workers are busy,
+ * up to the thread resource limit: a task that blocks a worker waiting for another task can't starve it.
+ * The pending tasks of paused tasks are not taken until they are resumed.
+ * All methods except the worker callbacks must be called from the scheduler (main) thread.
+ */
+class TaskThreadPool : public QObject {
+    Q_OBJECT
+    friend class TaskPoolWorker;
+public:
+    TaskThreadPool(int coreWorkersCount, int maxWorkersCount);
+    ~TaskThreadPool();
+
+    int getWorkersCount() const { return liveWorkersCount; }
+
+    void submit(TaskInfo* ti);
+
+    // removes the task from the deques if it was not taken by a worker yet, returns true on success
+    bool cancelPending(TaskInfo* ti);
+
+    // blocks until the 'run' method of the task is finished (or the task is removed from the deques)
+    void waitForTask(TaskInfo* ti);
+
+    // the pending subtasks of the paused task are not run until it is resumed
+    void setPaused(const Task* task, bool paused);
+
+    // sets the priority of the worker that runs the task if it is running
+    void setTaskPriority(TaskInfo* ti, QThread::Priority priority);
+
+signals:
+    // emitted from a worker thread each time a task 'run' is finished
+    void si_taskRunFinished();
+
+private:
+    struct WorkerDeque {
+        QMutex          lock;
+        QList<TaskInfo*> tasks;
+    };
+
+    TaskInfo* takeTask(int workerIndex);
+    TaskInfo* takeNotPaused(WorkerDeque* deque, bool newest);
+    bool isPaused(TaskInfo* ti);
+    void onTaskRunStarted(TaskInfo* ti, TaskPoolWorker* worker);
+    void onTaskRunFinished(TaskInfo* ti);
+    // starts an extra worker if the pending and running tasks are more than the workers, must be called under 'idleLock'
+    void startWorkerIfNeeded();
+    void deleteFinishedWorkers();
+
+    QList<TaskPoolWorker*>  workers;
+    QList<WorkerDeque*>     deques;
+    int                     nextDeque;
+    int                     maxWorkersCount;
+    int                     liveWorkersCount;   // guarded by 'idleLock'
+    QAtomicInt              pendingCount;
+    QAtomicInt              busyCount;
+    volatile bool           stopped;
+
+    QMutex                  idleLock;
+    QWaitCondition          hasWork;
+    int                     workVersion;        // is changed when new work can appear, guarded by 'idleLock'
+
+    QMutex                  pauseLock;
+    QSet<const Task*>       pausedTasks;
+
+    QMutex                  finishLock;
+    QWaitCondition          runFinished;
+    QHash<TaskInfo*, TaskPoolWorker*> runningTasks;     // guarded by 'finishLock'
+};
+
 class TaskInfo {
 public:
     TaskInfo(Task* t, TaskInfo* p)
         : task(t), parentTaskInfo(p), wasPrepared(false), subtasksWereCanceled(false), selfRunFinished(false),
-        hasLockedPrepareResources(false), hasLockedRunResources(false),
+        hasLockedPrepareResources(false), hasLockedRunResources(false), runInPool(false),
         prevProgress(0), numPreparedSubtasks(0), numRunningSubtasks(0), numFinishedSubtasks(0),  thread(NULL) {}
 
     virtual ~TaskInfo();
@@ -95,6 +188,7 @@ public:
     bool            selfRunFinished;        // indicates that the 'run' method of this task was finished
     bool            hasLockedPrepareResources;  //true if there were resource locks for 'prepare' stage
     bool            hasLockedRunResources;      //true if there were resource locks for 'run' stage
+    bool            runInPool;              // 'true' if the 'run' method was submitted to the TaskThreadPool
 
 
     int             prevProgress;   //used for TaskProgress_Manual
@@ -110,6 +204,10 @@ public:
         return numPreparedSubtasks+numRunningSubtasks;
     }
 
+    inline bool isRunStarted() const {
+        return thread != NULL || runInPool;
+    }
+
 
 };
 
@@ -144,6 +242,8 @@ public:
     void resumeThreadWithTask(const Task *task);
     void onSubTaskFinished(TaskThread *thread, Task *subtask);
 
+    bool isThreadPoolMode() const { return threadPool != NULL; }
+
 private slots:
     void update();
     void sl_threadFinished();
@@ -171,6 +271,8 @@ private:
     void updateOldTasksPriority();
     void checkSerialPromotion(TaskInfo* pti, Task* subtask);
     void createSleepPreventer();
+    void createThreadPool();
+    void wakeUp();
 
 private:
     QTimer                  timer;
@@ -185,6 +287,7 @@ private:
     AppResource*            threadsResource;
     bool                    stateChangesObserved;
     SleepPreventer*         sleepPreventer;
+    TaskThreadPool*         threadPool;     // NULL if every task is run in a new TaskThread
 };
 
 } //namespace
@@ -79,6 +79,13 @@ void XMLTestUtils::replacePrefix(const GTestEnvironment *env, QString &path){
     path = result.mid(0, result.size() - 1); // without the last ';'
 }
 
+quint64 XMLTestUtils::nextRandom(quint64 &state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * Q_UINT64_C(2685821657736338717);
+}
+
 void XMLMultiTest::init(XMLTestFormat *tf, const QDomElement& el) {
 
     // This attribute is used to avoid mixing log messages between different tests
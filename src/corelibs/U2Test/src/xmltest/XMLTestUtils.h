@@ -65,6 +65,8 @@ class U2TEST_EXPORT XMLTestUtils {
 public:
     static QList<XMLTestFactory*> createTestFactories();
     static void replacePrefix(const GTestEnvironment* env, QString &path);
+    /** Returns the next pseudo-random value of the xorshift64* generator: the same data on all platforms for the same non-zero seed */
+    static quint64 nextRandom(quint64 &state);
 };
 
 
@@ -109,7 +109,10 @@ exportToSamAction(NULL), setReferenceAction(NULL), extractAssemblyRegionAction(N
         objects.append(o);
         requiredObjects.append(o);
         const U2EntityRef& ref= gobject->getEntityRef();
-        model = QSharedPointer<AssemblyModel>(new AssemblyModel(DbiConnection(ref.dbiRef, dbiOpStatus)));
+        // the reads, the coverage and the consensus are fetched by several threads at once
+        QHash<QString, QString> properties;
+        properties[U2DbiOptions::U2_DBI_LOCKING_MODE] = "wal";
+        model = QSharedPointer<AssemblyModel>(new AssemblyModel(DbiConnection(ref.dbiRef, false, dbiOpStatus, properties)));
         connect(model.data(), SIGNAL(si_referenceChanged()), SLOT(sl_referenceChanged()));
         assemblyLoaded();
         CHECK_OP(dbiOpStatus, );
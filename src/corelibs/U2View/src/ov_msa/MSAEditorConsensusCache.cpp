@@ -27,40 +27,157 @@
 
 namespace U2 {
 
+//////////////////////////////////////////////////////////////////////////
+// MSAConsensusCacheChunkTask
+
+MSAConsensusCacheChunkTask::MSAConsensusCacheChunkTask(const MSAConsensusCacheColumns& columns, const MSAConsensusAlgorithm* algorithm, const U2Region& region)
+: Task(tr("Calculate consensus chunk"), TaskFlag_None), columns(columns), algorithm(algorithm), chunk(region)
+{
+    tpm = Progress_Manual;
+}
+
+void MSAConsensusCacheChunkTask::run() {
+    const int nSeq = columns.ma.getNumRows();
+    CHECK_EXT(0 != nSeq, setError(tr("The alignment is empty")), );
+    SAFE_POINT_EXT(columns.region.contains(chunk.region), setError(tr("Consensus chunk is out of the copied columns")), );
+
+    const int startColumn = chunk.region.startPos - columns.region.startPos;
+    chunk.chars.resize(chunk.region.length);
+    chunk.percents.resize(chunk.region.length);
+    for (int i = 0; i < chunk.region.length; i++) {
+        CHECK(!isCanceled(), );
+        int count = 0;
+        chunk.chars[i] = algorithm->getConsensusCharAndScore(columns.ma, startColumn + i, count);
+        chunk.percents[i] = (char)qRound(count * 100. / nSeq);
+        stateInfo.setProgress(100 * i / chunk.region.length);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// MSAConsensusCacheUpdateTask
+
+const int MSAConsensusCacheUpdateTask::CHUNK_SIZE = 1024;
+
+MSAConsensusCacheUpdateTask::MSAConsensusCacheUpdateTask(const MAlignment& ma, const QSharedPointer<MSAConsensusAlgorithm>& algorithm, const QVector<U2Region>& regions)
+: BackgroundTask<QList<MSAConsensusCacheChunk> >(tr("Calculate consensus"), TaskFlags_NR_FOSE_COSC), algorithm(algorithm)
+{
+    SAFE_POINT_EXT(!algorithm.isNull(), setError(tr("Consensus algorithm is NULL")), );
+    const U2Region alignmentRegion(0, ma.getLength());
+    foreach (const U2Region& region, regions) {
+        SAFE_POINT_EXT(alignmentRegion.contains(region), setError(tr("Consensus region is out of the alignment")), );
+        // the rows of a copied alignment share the data with the original rows, the columns are copied only for a part of the alignment
+        columns << MSAConsensusCacheColumns(region, region == alignmentRegion ? ma : ma.mid(region.startPos, region.length));
+    }
+    setMaxParallelSubtasks(MAX_PARALLEL_SUBTASKS_AUTO);
+}
+
+void MSAConsensusCacheUpdateTask::prepare() {
+    CHECK_OP(stateInfo, );
+    foreach (const MSAConsensusCacheColumns& regionColumns, columns) {
+        const U2Region& region = regionColumns.region;
+        for (qint64 start = region.startPos; start < region.endPos(); start += CHUNK_SIZE) {
+            const U2Region chunkRegion(start, qMin<qint64>(CHUNK_SIZE, region.endPos() - start));
+            MSAConsensusCacheChunkTask* chunkTask = new MSAConsensusCacheChunkTask(regionColumns, algorithm.data(), chunkRegion);
+            chunkTasks << chunkTask;
+            addSubTask(chunkTask);
+        }
+    }
+}
+
+Task::ReportResult MSAConsensusCacheUpdateTask::report() {
+    CHECK_OP(stateInfo, ReportResult_Finished);
+    foreach (MSAConsensusCacheChunkTask* chunkTask, chunkTasks) {
+        result << chunkTask->getChunk();
+    }
+    return ReportResult_Finished;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// MSAEditorConsensusCache
+
 MSAEditorConsensusCache::MSAEditorConsensusCache(QObject* p, MAlignmentObject* o, MSAConsensusAlgorithmFactory* factory)
-: QObject(p), curCacheSize(0), aliObj(o), algorithm(NULL)
+: QObject(p), curCacheSize(0), aliObj(o)
 {
     setConsensusAlgorithm(factory);
 
     connect(aliObj, SIGNAL(si_alignmentChanged(const MAlignment&, const MAlignmentModInfo&)),
         SLOT(sl_alignmentChanged(const MAlignment&, const MAlignmentModInfo&)));
     connect(aliObj, SIGNAL(si_invalidateAlignmentObject()), SLOT(sl_invalidateAlignmentObject()));
+    connect(&updateTaskRunner, SIGNAL(si_finished()), SLOT(sl_updateTaskFinished()));
 
     curCacheSize = aliObj->getLength();
     updateMap.resize(curCacheSize);
     cache.resize(curCacheSize);
-}
-
-MSAEditorConsensusCache::~MSAEditorConsensusCache() {
-    delete algorithm;
-    algorithm = NULL;
+    startUpdateTask();
 }
 
 void MSAEditorConsensusCache::setConsensusAlgorithm(MSAConsensusAlgorithmFactory* factory) {
-    delete algorithm;
-    algorithm = NULL;
-    algorithm = factory->createAlgorithm(aliObj->getMAlignment());
-    connect(algorithm, SIGNAL(si_thresholdChanged(int)), SLOT(sl_thresholdChanged(int)));
-    updateMap.fill(false);
+    if (!algorithm.isNull()) {
+        // a canceled update task may still hold the previous algorithm
+        algorithm->disconnect(this);
+    }
+    algorithm = QSharedPointer<MSAConsensusAlgorithm>(factory->createAlgorithm(aliObj->getMAlignment()));
+    connect(algorithm.data(), SIGNAL(si_thresholdChanged(int)), SLOT(sl_thresholdChanged(int)));
+    invalidate(U2Region());
 }
 
-void MSAEditorConsensusCache::sl_alignmentChanged(const MAlignment&, const MAlignmentModInfo&) {
+void MSAEditorConsensusCache::sl_alignmentChanged(const MAlignment&, const MAlignmentModInfo& modInfo) {
     if(curCacheSize != aliObj->getLength()) {
         curCacheSize = aliObj->getLength();
         updateMap.resize(curCacheSize);
         cache.resize(aliObj->getLength());
     }
-    updateMap.fill(false);
+    invalidate(modInfo.modifiedColumns);
+}
+
+void MSAEditorConsensusCache::invalidate(const U2Region& columns) {
+    const U2Region cacheRegion(0, curCacheSize);
+    const U2Region invalidRegion = columns.isEmpty() ? cacheRegion : cacheRegion.intersect(columns);
+    if (!invalidRegion.isEmpty()) {
+        updateMap.fill(false, invalidRegion.startPos, invalidRegion.endPos());
+    }
+    startUpdateTask();
+}
+
+void MSAEditorConsensusCache::startUpdateTask() {
+    updateTaskRunner.cancel();
+    CHECK(NULL != aliObj && !algorithm.isNull(), );
+
+    const MAlignment& ma = aliObj->getMAlignment();
+    CHECK(0 != ma.getNumRows() && curCacheSize == ma.getLength(), );
+
+    QVector<U2Region> regions;
+    for (int pos = 0; pos < curCacheSize; pos++) {
+        if (updateMap.testBit(pos)) {
+            continue;
+        }
+        int end = pos + 1;
+        while (end < curCacheSize && !updateMap.testBit(end)) {
+            end++;
+        }
+        regions << U2Region(pos, end - pos);
+        pos = end;
+    }
+    CHECK(!regions.isEmpty(), );
+
+    // a threshold change cancels the task, so it never finishes with results for the previous threshold
+    updateTaskRunner.run(new MSAConsensusCacheUpdateTask(ma, algorithm, regions));
+}
+
+void MSAEditorConsensusCache::sl_updateTaskFinished() {
+    CHECK(updateTaskRunner.isSuccessful() && NULL != aliObj, );
+
+    // the task is canceled on every modification, so the results correspond to the current alignment
+    foreach (const MSAConsensusCacheChunk& chunk, updateTaskRunner.getResult()) {
+        SAFE_POINT(chunk.region.endPos() <= curCacheSize, "Consensus chunk is out of the alignment", );
+        for (int i = 0; i < chunk.region.length; i++) {
+            const int pos = chunk.region.startPos + i;
+            if (!updateMap.testBit(pos)) {
+                cache[pos] = CacheItem(chunk.chars[i], chunk.percents[i]);
+                updateMap.setBit(pos, true);
+            }
+        }
+    }
 }
 
 void MSAEditorConsensusCache::updateCacheItem(int pos) {
@@ -108,10 +225,11 @@ QByteArray MSAEditorConsensusCache::getConsensusLine(bool withGaps) {
 
 void MSAEditorConsensusCache::sl_thresholdChanged(int newValue) {
     Q_UNUSED(newValue);
-    updateMap.fill(false);
+    invalidate(U2Region());
 }
 
 void MSAEditorConsensusCache::sl_invalidateAlignmentObject() {
+    updateTaskRunner.cancel();
     aliObj = NULL;
 }
 
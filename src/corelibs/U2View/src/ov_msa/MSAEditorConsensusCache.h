@@ -23,24 +23,83 @@
 #define _U2_MSA_EDITOR_CONSENSUS_CACHE_H_
 
 #include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
 #include <QtCore/QVector>
 #include <QtCore/QBitArray>
 
+#include <U2Core/BackgroundTaskRunner.h>
+#include <U2Core/MAlignment.h>
+#include <U2Core/U2Region.h>
+
 namespace U2 {
 
 class MAlignmentObject;
-class MAlignment;
 class MAlignmentModInfo;
 class MSAConsensusAlgorithm;
 class MSAConsensusAlgorithmFactory;
 class U2OpStatus;
 
+/** Consensus chars and percents of a region of columns */
+class MSAConsensusCacheChunk {
+public:
+    MSAConsensusCacheChunk(const U2Region& region = U2Region()) : region(region) {}
+
+    U2Region    region;
+    QByteArray  chars;
+    QByteArray  percents;
+};
+
+/** A copy of the alignment columns in the region */
+class MSAConsensusCacheColumns {
+public:
+    MSAConsensusCacheColumns(const U2Region& region = U2Region(), const MAlignment& ma = MAlignment()) : region(region), ma(ma) {}
+
+    U2Region    region;
+    MAlignment  ma;
+};
+
+class MSAConsensusCacheChunkTask : public Task {
+    Q_OBJECT
+public:
+    MSAConsensusCacheChunkTask(const MSAConsensusCacheColumns& columns, const MSAConsensusAlgorithm* algorithm, const U2Region& region);
+
+    void run();
+
+    const MSAConsensusCacheChunk& getChunk() const { return chunk; }
+
+private:
+    const MSAConsensusCacheColumns& columns;
+    const MSAConsensusAlgorithm*    algorithm;
+    MSAConsensusCacheChunk          chunk;
+};
+
+/**
+ * Calculates the consensus of the specified columns in background.
+ * Only these columns are copied from the alignment, the whole alignment is shared if all columns are requested.
+ * The task uses the algorithm of the cache: the consensus of some algorithms depends on the alignment they were created for.
+ * The columns are split into chunks, the chunks are calculated in parallel subtasks.
+ */
+class U2VIEW_EXPORT MSAConsensusCacheUpdateTask : public BackgroundTask<QList<MSAConsensusCacheChunk> > {
+    Q_OBJECT
+public:
+    MSAConsensusCacheUpdateTask(const MAlignment& ma, const QSharedPointer<MSAConsensusAlgorithm>& algorithm, const QVector<U2Region>& regions);
+
+    void prepare();
+    ReportResult report();
+
+    static const int CHUNK_SIZE;
+
+private:
+    QSharedPointer<MSAConsensusAlgorithm>   algorithm;
+    QList<MSAConsensusCacheColumns>         columns;
+    QList<MSAConsensusCacheChunkTask*>      chunkTasks;
+};
+
 class MSAEditorConsensusCache : public QObject {
     Q_OBJECT
     Q_DISABLE_COPY(MSAEditorConsensusCache)
 public:
     MSAEditorConsensusCache(QObject* p, MAlignmentObject* aliObj, MSAConsensusAlgorithmFactory* algo);
-    ~MSAEditorConsensusCache();
 
     char getConsensusChar(int pos);
 
@@ -50,13 +109,14 @@ public:
 
     void setConsensusAlgorithm(MSAConsensusAlgorithmFactory* algo);
 
-    MSAConsensusAlgorithm* getConsensusAlgorithm() const {return algorithm;}
+    MSAConsensusAlgorithm* getConsensusAlgorithm() const {return algorithm.data();}
 
     QByteArray getConsensusLine(bool withGaps);
 private slots:
     void sl_alignmentChanged(const MAlignment&, const MAlignmentModInfo&);
     void sl_thresholdChanged(int newValue);
     void sl_invalidateAlignmentObject();
+    void sl_updateTaskFinished();
 
 private:
     struct CacheItem {
@@ -68,11 +128,20 @@ private:
 
     void updateCacheItem(int pos);
 
+    /** Marks the columns as not calculated. If the region is empty, marks all columns */
+    void invalidate(const U2Region& columns);
+
+    /** Starts the background calculation of all not calculated columns */
+    void startUpdateTask();
+
     int                     curCacheSize;
     QVector<CacheItem>      cache;
     QBitArray               updateMap;
     MAlignmentObject*       aliObj;
-    MSAConsensusAlgorithm*  algorithm;
+    // shared with the running update task
+    QSharedPointer<MSAConsensusAlgorithm> algorithm;
+
+    BackgroundTaskRunner<QList<MSAConsensusCacheChunk> > updateTaskRunner;
 };
 
 }//namespace;
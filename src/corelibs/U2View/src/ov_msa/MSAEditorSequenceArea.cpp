@@ -1234,8 +1234,10 @@ void MSAEditorSequenceArea::mouseMoveEvent(QMouseEvent* e) {
 void MSAEditorSequenceArea::mouseReleaseEvent(QMouseEvent *e) {
     rubberBand->hide();
     if (shifting) {
+        // the deferred edits are written on the state release, they must get into the tracked user step
+        U2OpStatus2Log os;
+        editor->getMSAObject()->releaseState(os);
         changeTracker.finishTracking();
-        editor->getMSAObject()->releaseState();
     }
 
     QPoint newCurPos = coordToAbsolutePos(e->pos());
@@ -3019,8 +3021,9 @@ bool MSAEditorSequenceArea::getUseDotsCheckedState() const {
 void MSAEditorSequenceArea::cancelShiftTracking() {
     shifting = false;
     selecting = false;
+    U2OpStatus2Log os;
+    editor->getMSAObject()->releaseState(os);
     changeTracker.finishTracking();
-    editor->getMSAObject()->releaseState();
 }
 
 ExportHighligtningTask::ExportHighligtningTask(ExportHighligtingDialogController *dialog, MSAEditorSequenceArea *msaese_)
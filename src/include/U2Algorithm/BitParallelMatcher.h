@@ -0,0 +1 @@
+#include "../../corelibs/U2Algorithm/src/misc/BitParallelMatcher.h"
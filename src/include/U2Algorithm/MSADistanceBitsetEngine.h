@@ -0,0 +1 @@
+#include "../../corelibs/U2Algorithm/src/util_msa_distance/MSADistanceBitsetEngine.h"
@@ -0,0 +1 @@
+#include "../../corelibs/U2Lang/src/model/MemoryDataStorage.h"
@@ -5,6 +5,7 @@ HEADERS += src/AnnotationTableObjectTest.h \
            src/AsnParserTests.h \
            src/BinaryFindOpenCLTests.h \
            src/BioStruct3DObjectTests.h \
+           src/BitMaskLookupTableTests.h \
            src/CMDLineTests.h \
            src/CoreTests.h \
            src/DnaAssemblyTests.h \
@@ -17,6 +18,8 @@ HEADERS += src/AnnotationTableObjectTest.h \
            src/FormatDetectionTests.h \
            src/GUrlTests.h \
            src/LoadRemoteDocumentTests.h \
+           src/MSAConsensusCacheTests.h \
+           src/MSADistanceBitsetEngineTests.h \
            src/PWMatrixTests.h \
            src/PhyTreeObjectTests.h \
            src/SMatrixTests.h \
@@ -24,11 +27,13 @@ HEADERS += src/AnnotationTableObjectTest.h \
            src/SequenceWalkerTests.h \
            src/TaskTests.h \
            src/TextObjectTests.h \
-           src/UtilTestActions.h
+           src/UtilTestActions.h \
+           src/WorkflowSchedulerTests.h
 SOURCES += src/AnnotationTableObjectTest.cpp \
            src/AsnParserTests.cpp \
            src/BinaryFindOpenCLTests.cpp \
            src/BioStruct3DObjectTests.cpp \
+           src/BitMaskLookupTableTests.cpp \
            src/CMDLineTests.cpp \
            src/CoreTests.cpp \
            src/DNASequenceObjectTests.cpp \
@@ -41,6 +46,8 @@ SOURCES += src/AnnotationTableObjectTest.cpp \
            src/FormatDetectionTests.cpp \
            src/GUrlTests.cpp \
            src/LoadRemoteDocumentTests.cpp \
+           src/MSAConsensusCacheTests.cpp \
+           src/MSADistanceBitsetEngineTests.cpp \
            src/PWMatrixTests.cpp \
            src/PhyTreeObjectTests.cpp \
            src/SMatrixTests.cpp \
@@ -48,4 +55,5 @@ SOURCES += src/AnnotationTableObjectTest.cpp \
            src/SequenceWalkerTests.cpp \
            src/TaskTests.cpp \
            src/TextObjectTests.cpp \
-           src/UtilTestActions.cpp
+           src/UtilTestActions.cpp \
+           src/WorkflowSchedulerTests.cpp
@@ -0,0 +1,167 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <algorithm>
+
+#include <QDomElement>
+
+#include <U2Algorithm/BitMaskLookupTable.h>
+
+#include <U2Core/Log.h>
+#include <U2Core/Timer.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "BitMaskLookupTableTests.h"
+
+namespace U2 {
+
+/* attributes */
+static const QString VALUES_COUNT("values-count");      // count of sorted bit masks
+static const QString LOOKUPS_COUNT("lookups-count");    // count of searched windows
+static const QString SEED("seed");                      // random generator seed, optional
+
+// the genome aligner bit masks: 31 nucleotides, 2 bits per nucleotide
+static const int VALUE_BITS = 62;
+static const int MAX_WINDOW_SIZE = VALUE_BITS / 2;
+static const int MIN_WINDOW_SIZE = 5;
+
+QList<XMLTestFactory *> BitMaskLookupTableTests::createTestFactories() {
+    QList<XMLTestFactory *> res;
+    res.append(GTest_BitMaskLookupTable::createFactory());
+    res.append(GTest_BitMaskLookupTablePerf::createFactory());
+    return res;
+}
+
+BitMaskLookupTableTestData::BitMaskLookupTableTestData()
+    : valuesCount(0), lookupsCount(0), seed(1)
+{
+
+}
+
+QString BitMaskLookupTableTestData::init(const QDomElement &el) {
+    bool ok = false;
+    valuesCount = el.attribute(VALUES_COUNT).toInt(&ok);
+    if (!ok || valuesCount < 0) {
+        return QString("Invalid value of the attribute: %1").arg(VALUES_COUNT);
+    }
+    lookupsCount = el.attribute(LOOKUPS_COUNT).toInt(&ok);
+    if (!ok || lookupsCount <= 0) {
+        return QString("Invalid value of the attribute: %1").arg(LOOKUPS_COUNT);
+    }
+    if (el.hasAttribute(SEED)) {
+        seed = el.attribute(SEED).toULongLong(&ok);
+        if (!ok || 0 == seed) {
+            return QString("Invalid value of the attribute: %1").arg(SEED);
+        }
+    }
+    return QString();
+}
+
+void BitMaskLookupTableTestData::generate() {
+    quint64 state = seed;
+    values.resize(valuesCount);
+    for (int i = 0; i < valuesCount; i++) {
+        values[i] = XMLTestUtils::nextRandom(state) >> (64 - VALUE_BITS);
+        // a part of the values share long prefixes, like repeats in a reference sequence
+        if (0 == XMLTestUtils::nextRandom(state) % 4) {
+            values[i] &= ~((Q_UINT64_C(1) << (VALUE_BITS / 2)) - 1);
+        }
+    }
+    std::sort(values.begin(), values.end());
+
+    lookupValues.resize(lookupsCount);
+    lookupFilters.resize(lookupsCount);
+    for (int i = 0; i < lookupsCount; i++) {
+        const int windowSize = MIN_WINDOW_SIZE + int(XMLTestUtils::nextRandom(state) % (MAX_WINDOW_SIZE - MIN_WINDOW_SIZE + 1));
+        lookupFilters[i] = ~Q_UINT64_C(0) << (VALUE_BITS - windowSize * 2);
+        // a half of the windows are taken from the array to have found results
+        const bool existing = valuesCount > 0 && 0 == XMLTestUtils::nextRandom(state) % 2;
+        lookupValues[i] = existing ? values[int(XMLTestUtils::nextRandom(state) % valuesCount)] : XMLTestUtils::nextRandom(state) >> (64 - VALUE_BITS);
+    }
+}
+
+/* class GTest_BitMaskLookupTable : public GTest */
+
+void GTest_BitMaskLookupTable::init(XMLTestFormat *, const QDomElement &el) {
+    const QString error = data.init(el);
+    if (!error.isEmpty()) {
+        stateInfo.setError(error);
+    }
+}
+
+void GTest_BitMaskLookupTable::run() {
+    data.generate();
+    BitMaskLookupTable table;
+    table.build(data.values.constData(), data.values.size(), VALUE_BITS);
+
+    for (int i = 0; i < data.lookupsCount; i++) {
+        const qint64 expected = BitMaskLookupTable::binarySearch(data.values.constData(), data.values.size(), data.lookupValues[i], data.lookupFilters[i]);
+        const qint64 actual = table.find(data.lookupValues[i], data.lookupFilters[i]);
+        if (expected != actual) {
+            stateInfo.setError(QString("Lookup %1: expected position %2, got %3").arg(i).arg(expected).arg(actual));
+            return;
+        }
+    }
+}
+
+/* class GTest_BitMaskLookupTablePerf : public GTest */
+
+void GTest_BitMaskLookupTablePerf::init(XMLTestFormat *, const QDomElement &el) {
+    const QString error = data.init(el);
+    if (!error.isEmpty()) {
+        stateInfo.setError(error);
+    }
+}
+
+void GTest_BitMaskLookupTablePerf::run() {
+    data.generate();
+
+    qint64 t0 = GTimer::currentTimeMicros();
+    BitMaskLookupTable table;
+    table.build(data.values.constData(), data.values.size(), VALUE_BITS);
+    const qint64 buildTime = GTimer::currentTimeMicros() - t0;
+
+    // the sums keep the compiler from dropping the searches
+    qint64 binarySearchSum = 0;
+    t0 = GTimer::currentTimeMicros();
+    for (int i = 0; i < data.lookupsCount; i++) {
+        binarySearchSum += BitMaskLookupTable::binarySearch(data.values.constData(), data.values.size(), data.lookupValues[i], data.lookupFilters[i]);
+    }
+    const qint64 binarySearchTime = qMax(GTimer::currentTimeMicros() - t0, qint64(1));
+
+    qint64 tableSum = 0;
+    t0 = GTimer::currentTimeMicros();
+    for (int i = 0; i < data.lookupsCount; i++) {
+        tableSum += table.find(data.lookupValues[i], data.lookupFilters[i]);
+    }
+    const qint64 tableTime = qMax(GTimer::currentTimeMicros() - t0, qint64(1));
+
+    CHECK_EXT(binarySearchSum == tableSum, stateInfo.setError("The lookup table results differ from the binary search results"), );
+
+    const double binarySearchRate = data.lookupsCount / (binarySearchTime / 1000000.0);
+    const double tableRate = data.lookupsCount / (tableTime / 1000000.0);
+    algoLog.info(QString("Bit mask search in %1 values: binary search %2 lookups/s, lookup table (%3 bits, %4 Kb, built in %5 ms) %6 lookups/s, speedup %7")
+        .arg(data.valuesCount).arg(binarySearchRate, 0, 'f', 0).arg(table.getPrefixBits()).arg(table.getMemoryUsage() / 1024)
+        .arg(buildTime / 1000.0, 0, 'f', 3).arg(tableRate, 0, 'f', 0).arg(tableRate / binarySearchRate, 0, 'f', 2));
+}
+
+}   // namespace U2
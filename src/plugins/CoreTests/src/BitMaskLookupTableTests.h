@@ -0,0 +1,86 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_BIT_MASK_LOOKUP_TABLE_TESTS_H_
+#define _U2_BIT_MASK_LOOKUP_TABLE_TESTS_H_
+
+#include <QtCore/QVector>
+
+#include <U2Test/XMLTestUtils.h>
+
+namespace U2 {
+
+/** Random sorted bit masks and random windows to search in them */
+class BitMaskLookupTableTestData {
+public:
+    BitMaskLookupTableTestData();
+
+    /** Returns an error message if the attributes are invalid */
+    QString init(const QDomElement &el);
+    void generate();
+
+    int valuesCount;
+    int lookupsCount;
+    quint64 seed;
+
+    QVector<quint64> values;
+    QVector<quint64> lookupValues;
+    QVector<quint64> lookupFilters;
+};
+
+/**
+ * The results of BitMaskLookupTable::find() must be equal to the results of the plain binary search.
+ */
+class GTest_BitMaskLookupTable : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_BitMaskLookupTable, "check-bit-mask-lookup-table", TaskFlags_FOSCOE);
+
+    void run();
+
+private:
+    BitMaskLookupTableTestData data;
+};
+
+/**
+ * Benchmark: reports the lookups per second of BitMaskLookupTable::find() and of the plain binary search
+ * that the genome aligner used before the table. Only the results are checked, the rates are just logged.
+ */
+class GTest_BitMaskLookupTablePerf : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_BitMaskLookupTablePerf, "bit-mask-lookup-table-performance", TaskFlags_FOSCOE);
+
+    void run();
+
+private:
+    BitMaskLookupTableTestData data;
+};
+
+class BitMaskLookupTableTests {
+public:
+    static QList<XMLTestFactory *> createTestFactories();
+};
+
+}   // namespace U2
+
+#endif // _U2_BIT_MASK_LOOKUP_TABLE_TESTS_H_
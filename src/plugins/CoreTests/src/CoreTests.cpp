@@ -32,6 +32,7 @@
 #include "AsnParserTests.h"
 #include "BinaryFindOpenCLTests.h"
 #include "BioStruct3DObjectTests.h"
+#include "BitMaskLookupTableTests.h"
 #include "CMDLineTests.h"
 #include "DNASequenceObjectTests.h"
 #include "DNATranslationImplTests.h"
@@ -43,6 +44,8 @@
 #include "FormatDetectionTests.h"
 #include "GUrlTests.h"
 #include "LoadRemoteDocumentTests.h"
+#include "MSAConsensusCacheTests.h"
+#include "MSADistanceBitsetEngineTests.h"
 #include "PWMatrixTests.h"
 #include "PhyTreeObjectTests.h"
 #include "SMatrixTests.h"
@@ -51,6 +54,7 @@
 #include "TaskTests.h"
 #include "TextObjectTests.h"
 #include "UtilTestActions.h"
+#include "WorkflowSchedulerTests.h"
 
 namespace U2 {
 
@@ -142,6 +146,15 @@ void CoreTests::registerFactories() {
     registerFactory<BinaryFindOpenCLTests>(xmlTestFormat);
 #endif
 
+    // BitMaskLookupTable tests
+    registerFactory<BitMaskLookupTableTests>(xmlTestFormat);
+
+    // MSADistanceBitsetEngine tests
+    registerFactory<MSADistanceBitsetEngineTests>(xmlTestFormat);
+
+    // MSA editor consensus cache tests
+    registerFactory<MSAConsensusCacheTests>(xmlTestFormat);
+
     // FindAlforithm tests
     registerFactory<FindAlgorithmTests>(xmlTestFormat);
 
@@ -150,6 +163,9 @@ void CoreTests::registerFactories() {
 
     registerFactory<TextObjectTests>(xmlTestFormat);
 
+    // Workflow scheduler tests
+    registerFactory<WorkflowSchedulerTests>(xmlTestFormat);
+
     // Some utility actions to use them in tests
     registerFactory<UtilTestActions>(xmlTestFormat);
 }
@@ -23,6 +23,7 @@
 #include <U2Core/GUrlUtils.h>
 #include <U2Core/DocumentUtils.h>
 #include <U2Core/IOAdapter.h>
+#include <U2Core/U2SafePoints.h>
 
 #include <U2Formats/SAMFormat.h>
 #include <U2Formats/BAMUtils.h>
@@ -203,6 +204,192 @@ Task::ReportResult GTest_AssemblycompareTwoSAMbyLength::report() {
     return ReportResult_Finished;
 }
 
+//----------------------------------------------------------
+#define COMPARED_ATTR "compared-options"
+#define REF_LENGTH_ATTR "ref-length"
+#define READS_COUNT_ATTR "reads-count"
+#define READ_LENGTH_ATTR "read-length"
+#define SEED_ATTR "seed"
+
+namespace {
+
+const QString COMPARE_FILES_PREFIX("compare_dna_assembly_options_");
+
+QMap<QString, QString> parseOptions(const QString &options) {
+    QMap<QString, QString> result;
+    foreach (const QString &option, options.split(",", QString::SkipEmptyParts)) {
+        const QStringList keyValPair = option.split('=');
+        if (keyValPair.size() == 2) {
+            result.insert(keyValPair[0], keyValPair[1]);
+        }
+    }
+    return result;
+}
+
+QByteArray reverseComplement(const QByteArray &seq) {
+    QByteArray result(seq.length(), 'N');
+    for (int i = 0; i < seq.length(); i++) {
+        const char c = seq[seq.length() - 1 - i];
+        result[i] = 'A' == c ? 'T' : 'C' == c ? 'G' : 'G' == c ? 'C' : 'A';
+    }
+    return result;
+}
+
+void writeFile(const QString &url, const QByteArray &data, U2OpStatus &os) {
+    QFile file(url);
+    if (!file.open(QIODevice::WriteOnly) || data.size() != file.write(data)) {
+        os.setError(QString("Can't write the file: %1").arg(url));
+    }
+}
+
+}
+
+void GTest_CompareDnaAssemblyOptions::init(XMLTestFormat *, const QDomElement &el) {
+    firstTask = NULL;
+    secondTask = NULL;
+    seed = 1;
+
+    algName = el.attribute(METHOD_NAME_ATTR);
+    if (algName.isEmpty()) {
+        failMissingValue(METHOD_NAME_ATTR);
+        return;
+    }
+    customOptions = parseOptions(el.attribute(CUSTOM_ATTR));
+    comparedOptions = parseOptions(el.attribute(COMPARED_ATTR));
+    if (comparedOptions.isEmpty()) {
+        failMissingValue(COMPARED_ATTR);
+        return;
+    }
+
+    bool ok = false;
+    refLength = el.attribute(REF_LENGTH_ATTR).toInt(&ok);
+    if (!ok || refLength <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(REF_LENGTH_ATTR));
+        return;
+    }
+    readsCount = el.attribute(READS_COUNT_ATTR).toInt(&ok);
+    if (!ok || readsCount <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(READS_COUNT_ATTR));
+        return;
+    }
+    readLength = el.attribute(READ_LENGTH_ATTR).toInt(&ok);
+    if (!ok || readLength <= 0 || readLength > refLength) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(READ_LENGTH_ATTR));
+        return;
+    }
+    if (el.hasAttribute(SEED_ATTR)) {
+        seed = el.attribute(SEED_ATTR).toULongLong(&ok);
+        if (!ok || 0 == seed) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEED_ATTR));
+            return;
+        }
+    }
+}
+
+void GTest_CompareDnaAssemblyOptions::prepare() {
+    dir = env->getVar("TEMP_DATA_DIR");
+    CHECK_EXT(QDir::root().mkpath(dir), stateInfo.setError(QString("Can't create the directory: %1").arg(dir)), );
+
+    static const char CHARS[] = "ACGT";
+    quint64 state = seed;
+    QByteArray ref(refLength, 'A');
+    for (int i = 0; i < refLength; i++) {
+        ref[i] = CHARS[XMLTestUtils::nextRandom(state) % 4];
+    }
+
+    // every second read is reverse complemented, every third one has a mismatch
+    QByteArray reads;
+    for (int i = 0; i < readsCount; i++) {
+        QByteArray read = ref.mid(int(XMLTestUtils::nextRandom(state) % (refLength - readLength + 1)), readLength);
+        if (0 == i % 3) {
+            const int pos = int(XMLTestUtils::nextRandom(state) % readLength);
+            read[pos] = 'A' == read[pos] ? 'C' : 'A';
+        }
+        if (0 == i % 2) {
+            read = reverseComplement(read);
+        }
+        reads += ">read_" + QByteArray::number(i) + "\n" + read + "\n";
+    }
+
+    refSeqUrl = dir + "/" + COMPARE_FILES_PREFIX + "ref.fa";
+    readsUrl = dir + "/" + COMPARE_FILES_PREFIX + "reads.fa";
+    writeFile(refSeqUrl, ">ref\n" + ref + "\n", stateInfo);
+    CHECK_OP(stateInfo, );
+    writeFile(readsUrl, reads, stateInfo);
+    CHECK_OP(stateInfo, );
+
+    // the runs are sequential: they must not compete for the resources
+    firstTask = createAssemblyTask(customOptions, "first");
+    addSubTask(firstTask);
+}
+
+QList<Task *> GTest_CompareDnaAssemblyOptions::onSubTaskFinished(Task *subTask) {
+    QList<Task *> res;
+    CHECK(subTask == firstTask && !hasError() && !isCanceled(), res);
+
+    QMap<QString, QString> options = customOptions;
+    foreach (const QString &name, comparedOptions.keys()) {
+        options.insert(name, comparedOptions.value(name));
+    }
+    secondTask = createAssemblyTask(options, "second");
+    res << secondTask;
+    return res;
+}
+
+DnaAssemblyMultiTask * GTest_CompareDnaAssemblyOptions::createAssemblyTask(const QMap<QString, QString> &options, const QString &name) {
+    DnaAssemblyToRefTaskSettings settings;
+    settings.openView = false;
+    settings.prebuiltIndex = false;
+    settings.algName = algName;
+    settings.refSeqUrl = refSeqUrl;
+    settings.indexFileName = dir + "/" + COMPARE_FILES_PREFIX + name + "_index";
+    settings.resultFileName = dir + "/" + COMPARE_FILES_PREFIX + name + ".sam";
+    settings.shortReadSets.append(GUrl(readsUrl));
+    foreach (const QString &optionName, options.keys()) {
+        settings.setCustomValue(optionName, options.value(optionName));
+    }
+    return new DnaAssemblyMultiTask(settings, false);
+}
+
+QStringList GTest_CompareDnaAssemblyOptions::readRecords(const QString &url) {
+    QStringList records;
+    QFile file(url);
+    CHECK_EXT(file.open(QIODevice::ReadOnly), stateInfo.setError(QString("Can't read the file: %1").arg(url)), records);
+    while (!file.atEnd()) {
+        const QString line = QString::fromLatin1(file.readLine()).trimmed();
+        if (!line.isEmpty() && !line.startsWith('@')) {
+            records << line;
+        }
+    }
+    records.sort();
+    return records;
+}
+
+Task::ReportResult GTest_CompareDnaAssemblyOptions::report() {
+    CHECK(!hasError() && !isCanceled(), ReportResult_Finished);
+    CHECK_EXT(NULL != secondTask, stateInfo.setError("The assembly with the compared options was not run"), ReportResult_Finished);
+
+    const QStringList firstRecords = readRecords(firstTask->getSettings().resultFileName.getURLString());
+    CHECK_OP(stateInfo, ReportResult_Finished);
+    const QStringList secondRecords = readRecords(secondTask->getSettings().resultFileName.getURLString());
+    CHECK_OP(stateInfo, ReportResult_Finished);
+
+    CHECK_EXT(!firstRecords.isEmpty(), stateInfo.setError("No reads are aligned"), ReportResult_Finished);
+    CHECK_EXT(firstRecords.size() == secondRecords.size(),
+        stateInfo.setError(QString("Records count: expected %1, got %2").arg(firstRecords.size()).arg(secondRecords.size())), ReportResult_Finished);
+    for (int i = 0; i < firstRecords.size(); i++) {
+        CHECK_EXT(firstRecords[i] == secondRecords[i],
+            stateInfo.setError(QString("Records are different: expected '%1', got '%2'").arg(firstRecords[i]).arg(secondRecords[i])), ReportResult_Finished);
+    }
+    return ReportResult_Finished;
+}
+
+void GTest_CompareDnaAssemblyOptions::cleanup() {
+    QDir tempDir(dir);
+    foreach (const QString &f, tempDir.entryList(QStringList() << COMPARE_FILES_PREFIX + "*", QDir::Files)) {
+        QFile::remove(tempDir.absoluteFilePath(f));
+    }
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 
@@ -211,6 +398,7 @@ QList<XMLTestFactory*> DnaAssemblyTests::createTestFactories()
     QList<XMLTestFactory*> res;
     res.append(GTest_DnaAssemblyToReferenceTask::createFactory());
     res.append(GTest_AssemblycompareTwoSAMbyLength::createFactory());
+    res.append(GTest_CompareDnaAssemblyOptions::createFactory());
 
     return res;
 }
@@ -63,6 +63,39 @@ class GTest_AssemblycompareTwoSAMbyLength : public GTest {
     bool isBam;
 };
 
+/**
+ * Aligns random reads to a random reference twice: with the custom options
+ * and with the compared options added to them, then checks that the SAM records are the same.
+ * The records are compared regardless of their order, parallel aligners write them in any order.
+ */
+class GTest_CompareDnaAssemblyOptions : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_CompareDnaAssemblyOptions, "compare-dna-assembly-options", TaskFlags_NR_FOSCOE);
+
+    void prepare();
+    QList<Task *> onSubTaskFinished(Task *subTask);
+    ReportResult report();
+    void cleanup();
+
+private:
+    DnaAssemblyMultiTask *createAssemblyTask(const QMap<QString, QString> &options, const QString &name);
+    QStringList readRecords(const QString &url);
+
+    QString algName;
+    QMap<QString, QString> customOptions;
+    QMap<QString, QString> comparedOptions;
+    int refLength;
+    int readsCount;
+    int readLength;
+    quint64 seed;
+
+    QString dir;
+    QString refSeqUrl;
+    QString readsUrl;
+    DnaAssemblyMultiTask *firstTask;
+    DnaAssemblyMultiTask *secondTask;
+};
 
 class DnaAssemblyTests {
 public:
@@ -19,11 +19,18 @@
 * MA 02110-1301, USA.
 */
 
+#include <QtCore/QRegExp>
+
 #include "FindAlgorithmTests.h"
 
+#include <U2Algorithm/BitParallelMatcher.h>
+#include <U2Algorithm/DynTable.h>
+#include <U2Algorithm/SequenceRegExp.h>
+
 #include <U2Core/DocumentModel.h>
 #include <U2Core/GObjectUtils.h>
 #include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/U2SafePoints.h>
 
 namespace U2 {
 
@@ -249,10 +256,243 @@ Task::ReportResult GTest_FindAlgorithmTest::report(){
     return ReportResult_Finished;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////
+// bit-parallel matcher attributes
+#define PATTERN_LENGTH_ATTR         "pattern-length"
+#define MAX_ERROR_ATTR              "max-error"
+#define SEQUENCE_LENGTH_ATTR        "sequence-length"
+#define SEED_ATTR                   "seed"
+#define MAX_RESULTS_ATTR            "max-results"
+
+namespace {
+
+QByteArray generateNucleotides(int length, quint64 &state) {
+    static const char NUCLEOTIDES[] = "ACGT";
+    QByteArray res(length, 'A');
+    for (int i = 0; i < length; i++) {
+        res[i] = NUCLEOTIDES[XMLTestUtils::nextRandom(state) % 4];
+    }
+    return res;
+}
+
+// every eighth character is an ambiguous base
+QByteArray generateAmbiguousNucleotides(int length, quint64 &state) {
+    static const char AMBIGUOUS_BASES[] = "NRYKMSWBDHV";
+    QByteArray res = generateNucleotides(length, state);
+    for (int i = 0; i < length; i++) {
+        if (0 == XMLTestUtils::nextRandom(state) % 8) {
+            res[i] = AMBIGUOUS_BASES[XMLTestUtils::nextRandom(state) % 11];
+        }
+    }
+    return res;
+}
+
+bool lessByRegion(const FindAlgorithmResult &r1, const FindAlgorithmResult &r2) {
+    if (r1.region.startPos != r2.region.startPos) {
+        return r1.region.startPos < r2.region.startPos;
+    }
+    if (r1.region.length != r2.region.length) {
+        return r1.region.length < r2.region.length;
+    }
+    return r1.strand.getDirectionValue() < r2.strand.getDirectionValue();
+}
+
+class FindResultsCollector : public FindAlgorithmResultsListener {
+public:
+    void onResult(const FindAlgorithmResult &r) {
+        results << r;
+    }
+
+    QList<FindAlgorithmResult> results;
+};
+
+class RegExpMatchesCollector : public SequenceRegExpListener {
+public:
+    void onMatch(int startPos, int length) {
+        matches << U2Region(startPos, length);
+    }
+
+    QList<U2Region> matches;
+};
+
+void matchColumn(DynTable &dt, const QByteArray &pattern, char c, bool useAmbiguousBases) {
+    for (int j = 0; j < pattern.length(); j++) {
+        dt.match(j, useAmbiguousBases ? FindAlgorithm::cmpAmbiguous(c, pattern[j]) : c == pattern[j]);
+    }
+}
+
+}
+
+void GTest_BitParallelMatcher::init(XMLTestFormat *, const QDomElement& el) {
+    seed = 1;
+    useAmbiguousBases = el.attribute(AMBIG_ATTR) == "true";
+
+    bool ok = false;
+    patternLength = el.attribute(PATTERN_LENGTH_ATTR).toInt(&ok);
+    CHECK_EXT(ok && patternLength > 0, stateInfo.setError(GTest::tr("value incorrect for %1").arg(PATTERN_LENGTH_ATTR)), );
+    maxErr = el.attribute(MAX_ERROR_ATTR).toInt(&ok);
+    CHECK_EXT(ok && maxErr >= 0 && maxErr < patternLength, stateInfo.setError(GTest::tr("value incorrect for %1").arg(MAX_ERROR_ATTR)), );
+    sequenceLength = el.attribute(SEQUENCE_LENGTH_ATTR).toInt(&ok);
+    CHECK_EXT(ok && sequenceLength > 0, stateInfo.setError(GTest::tr("value incorrect for %1").arg(SEQUENCE_LENGTH_ATTR)), );
+
+    const QString algorithm = el.attribute(ALGORITHM_ATTR);
+    CHECK_EXT(algorithm == "insdel" || algorithm == "subst", stateInfo.setError(GTest::tr("value for %1 incorrect").arg(ALGORITHM_ATTR)), );
+    insDel = algorithm == "insdel";
+
+    if (el.hasAttribute(SEED_ATTR)) {
+        seed = el.attribute(SEED_ATTR).toULongLong(&ok);
+        CHECK_EXT(ok && 0 != seed, stateInfo.setError(GTest::tr("value incorrect for %1").arg(SEED_ATTR)), );
+    }
+}
+
+void GTest_BitParallelMatcher::run() {
+    quint64 state = seed;
+    const QByteArray sequence = useAmbiguousBases ? generateAmbiguousNucleotides(sequenceLength, state) : generateNucleotides(sequenceLength, state);
+    const QByteArray pattern = useAmbiguousBases ? generateAmbiguousNucleotides(patternLength, state) : generateNucleotides(patternLength, state);
+    const int width = patternLength + maxErr;
+
+    DynTable dt(width, patternLength, insDel);
+    BitParallelMatcher matcher(pattern.constData(), patternLength, maxErr, insDel, useAmbiguousBases);
+    for (int i = 0; i < sequenceLength; i++) {
+        matchColumn(dt, pattern, sequence[i], useAmbiguousBases);
+        matcher.addChar(sequence[i]);
+
+        const int expectedErr = insDel ? dt.getLast() : qMin(dt.getLast(), maxErr + 1);
+        CHECK_EXT(expectedErr == matcher.getLast(),
+            stateInfo.setError(GTest::tr("Position %1: expected distance %2, got %3").arg(i).arg(expectedErr).arg(matcher.getLast())), );
+        if (expectedErr <= maxErr) {
+            CHECK_EXT(dt.getLastLen() == matcher.getLastLen(),
+                stateInfo.setError(GTest::tr("Position %1: expected length %2, got %3").arg(i).arg(dt.getLastLen()).arg(matcher.getLastLen())), );
+        }
+        dt.shiftColumn();
+    }
+}
+
+void GTest_FindAlgorithmChunks::init(XMLTestFormat *, const QDomElement& el) {
+    seed = 1;
+    maxResults = FindAlgorithmSettings::MAX_RESULT_TO_FIND_UNLIMITED;
+    findTask = NULL;
+
+    bool ok = false;
+    const int patternLength = el.attribute(PATTERN_LENGTH_ATTR).toInt(&ok);
+    CHECK_EXT(ok && patternLength > 0, stateInfo.setError(GTest::tr("value incorrect for %1").arg(PATTERN_LENGTH_ATTR)), );
+    settings.maxErr = el.attribute(MAX_ERROR_ATTR).toInt(&ok);
+    CHECK_EXT(ok && settings.maxErr >= 0 && settings.maxErr < patternLength, stateInfo.setError(GTest::tr("value incorrect for %1").arg(MAX_ERROR_ATTR)), );
+    const int sequenceLength = el.attribute(SEQUENCE_LENGTH_ATTR).toInt(&ok);
+    CHECK_EXT(ok && sequenceLength > patternLength, stateInfo.setError(GTest::tr("value incorrect for %1").arg(SEQUENCE_LENGTH_ATTR)), );
+
+    const QString algorithm = el.attribute(ALGORITHM_ATTR);
+    CHECK_EXT(algorithm == "insdel" || algorithm == "subst", stateInfo.setError(GTest::tr("value for %1 incorrect").arg(ALGORITHM_ATTR)), );
+    settings.patternSettings = algorithm == "insdel" ? FindAlgorithmPatternSettings_InsDel : FindAlgorithmPatternSettings_Subst;
+    settings.useAmbiguousBases = el.attribute(AMBIG_ATTR) == "true";
+
+    if (el.hasAttribute(SEED_ATTR)) {
+        seed = el.attribute(SEED_ATTR).toULongLong(&ok);
+        CHECK_EXT(ok && 0 != seed, stateInfo.setError(GTest::tr("value incorrect for %1").arg(SEED_ATTR)), );
+    }
+    if (el.hasAttribute(MAX_RESULTS_ATTR)) {
+        maxResults = el.attribute(MAX_RESULTS_ATTR).toInt(&ok);
+        CHECK_EXT(ok && maxResults > 0, stateInfo.setError(GTest::tr("value incorrect for %1").arg(MAX_RESULTS_ATTR)), );
+    }
+
+    quint64 state = seed;
+    settings.sequence = generateNucleotides(sequenceLength, state);
+    settings.pattern = generateNucleotides(patternLength, state);
+    // the pattern copies, every second one with an 'N', are planted often enough to hit the chunk borders
+    for (int pos = int(XMLTestUtils::nextRandom(state) % 1000); pos + patternLength <= sequenceLength; pos += 997 + int(XMLTestUtils::nextRandom(state) % 1000)) {
+        memcpy(settings.sequence.data() + pos, settings.pattern.constData(), patternLength);
+        if (0 == XMLTestUtils::nextRandom(state) % 2) {
+            settings.sequence[pos + int(XMLTestUtils::nextRandom(state) % patternLength)] = 'N';
+        }
+    }
+    settings.searchRegion = U2Region(0, sequenceLength);
+    settings.strand = FindAlgorithmStrand_Direct;
+    settings.maxResult2Find = maxResults;
+    settings.countTask = false;
+}
+
+void GTest_FindAlgorithmChunks::prepare() {
+    findTask = new FindAlgorithmTask(settings);
+    addSubTask(findTask);
+}
+
+void GTest_FindAlgorithmChunks::run() {
+    FindResultsCollector collector;
+    int stopFlag = 0;
+    int progress = 0;
+    FindAlgorithm::find(&collector, settings, settings.sequence.constData(), settings.sequence.size(), false, stopFlag, progress);
+    QList<FindAlgorithmResult> expected = collector.results;
+    qStableSort(expected.begin(), expected.end(), lessByRegion);
+    if (FindAlgorithmSettings::MAX_RESULT_TO_FIND_UNLIMITED != maxResults) {
+        expected = expected.mid(0, maxResults);
+    }
+
+    QList<FindAlgorithmResult> actual = findTask->popResults();
+    CHECK_EXT(!actual.isEmpty(), stateInfo.setError(GTest::tr("No results are found")), );
+    for (int i = 1; i < actual.size(); i++) {
+        CHECK_EXT(actual[i - 1].region.startPos <= actual[i].region.startPos,
+            stateInfo.setError(GTest::tr("The results are not sorted by position: %1 , %2").arg(actual[i - 1].region.toString()).arg(actual[i].region.toString())), );
+    }
+    qStableSort(actual.begin(), actual.end(), lessByRegion);
+
+    CHECK_EXT(expected.size() == actual.size(),
+        stateInfo.setError(GTest::tr("Expected and actual result sizes are different: %1 , %2").arg(expected.size()).arg(actual.size())), );
+    for (int i = 0; i < expected.size(); i++) {
+        CHECK_EXT(expected[i] == actual[i],
+            stateInfo.setError(GTest::tr("Expected and actual regions are different: %1 , %2").arg(expected[i].region.toString()).arg(actual[i].region.toString())), );
+    }
+}
+
+void GTest_SequenceRegExp::init(XMLTestFormat *, const QDomElement& el) {
+    seed = 1;
+    pattern = el.attribute(PATTERN_ATTR).toLatin1();
+
+    bool ok = false;
+    sequenceLength = el.attribute(SEQUENCE_LENGTH_ATTR).toInt(&ok);
+    CHECK_EXT(ok && sequenceLength > 0, stateInfo.setError(GTest::tr("value incorrect for %1").arg(SEQUENCE_LENGTH_ATTR)), );
+    maxLength = el.attribute(MAXLEN_ATTR).toInt(&ok);
+    CHECK_EXT(ok && maxLength > 0, stateInfo.setError(GTest::tr("value incorrect for %1").arg(MAXLEN_ATTR)), );
+    if (el.hasAttribute(SEED_ATTR)) {
+        seed = el.attribute(SEED_ATTR).toULongLong(&ok);
+        CHECK_EXT(ok && 0 != seed, stateInfo.setError(GTest::tr("value incorrect for %1").arg(SEED_ATTR)), );
+    }
+}
+
+void GTest_SequenceRegExp::run() {
+    quint64 state = seed;
+    const QByteArray sequence = generateNucleotides(sequenceLength, state);
+
+    SequenceRegExp regExp(pattern);
+    CHECK_EXT(regExp.isValid(), stateInfo.setError(regExp.getError()), );
+    RegExpMatchesCollector collector;
+    regExp.findAll(sequence.constData(), sequence.length(), maxLength, &collector, stateInfo.cancelFlag);
+
+    QList<U2Region> expected;
+    const QRegExp qRegExp(pattern);
+    const QString sequenceString(sequence);
+    for (int start = 0; start < sequenceLength; start++) {
+        for (int length = qMin(maxLength, sequenceLength - start); length > 0; length--) {
+            if (qRegExp.exactMatch(sequenceString.mid(start, length))) {
+                expected << U2Region(start, length);
+            }
+        }
+    }
+
+    CHECK_EXT(expected.size() == collector.matches.size(),
+        stateInfo.setError(GTest::tr("Expected and actual result sizes are different: %1 , %2").arg(expected.size()).arg(collector.matches.size())), );
+    for (int i = 0; i < expected.size(); i++) {
+        CHECK_EXT(expected[i] == collector.matches[i],
+            stateInfo.setError(GTest::tr("Expected and actual regions are different: %1 , %2").arg(expected[i].toString()).arg(collector.matches[i].toString())), );
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 QList<XMLTestFactory*> FindAlgorithmTests::createTestFactories(){
     QList<XMLTestFactory*> res;
     res.append(GTest_FindAlgorithmTest::createFactory());
+    res.append(GTest_BitParallelMatcher::createFactory());
+    res.append(GTest_FindAlgorithmChunks::createFactory());
+    res.append(GTest_SequenceRegExp::createFactory());
 
     return res;
 }
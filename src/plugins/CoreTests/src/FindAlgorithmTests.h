@@ -45,6 +45,65 @@ private:
     FindAlgorithmTask *t;
 };
 
+/**
+ * Matches random patterns against a random sequence with BitParallelMatcher and DynTable,
+ * checks that the distances and the alignment lengths are equal.
+ */
+class GTest_BitParallelMatcher : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_BitParallelMatcher, "bit-parallel-matcher", TaskFlags_FOSCOE);
+
+    void run();
+
+private:
+    int patternLength;
+    int maxErr;
+    bool insDel;
+    int sequenceLength;
+    bool useAmbiguousBases;
+    quint64 seed;
+};
+
+/**
+ * Searches a pattern planted into a random sequence with FindAlgorithmTask, that splits long sequences into parallel chunks,
+ * and checks the results against the search in the whole sequence at once: they are the same, the first ones by position if their count is limited.
+ * The sequence should be at least two chunks long (2 Mb) to be searched in parallel.
+ */
+class GTest_FindAlgorithmChunks : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_FindAlgorithmChunks, "find-algorithm-chunks", TaskFlags_FOSCOE);
+
+    void prepare();
+    void run();
+
+private:
+    FindAlgorithmTaskSettings settings;
+    int maxResults;
+    quint64 seed;
+    FindAlgorithmTask *findTask;
+};
+
+/**
+ * Searches a regular expression in a random sequence with SequenceRegExp
+ * and checks the matches against QRegExp::exactMatch() for all sequence parts.
+ * The pattern should not contain the '^' and '$' anchors: QRegExp matches them at the part boundaries.
+ */
+class GTest_SequenceRegExp : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_SequenceRegExp, "sequence-regexp", TaskFlags_FOSCOE);
+
+    void run();
+
+private:
+    QByteArray pattern;
+    int sequenceLength;
+    int maxLength;
+    quint64 seed;
+};
+
 class FindAlgorithmTests {
 public:
     static QList<XMLTestFactory*> createTestFactories();
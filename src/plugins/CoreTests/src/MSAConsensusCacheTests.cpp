@@ -0,0 +1,176 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QDomElement>
+
+#include <U2Algorithm/MSAConsensusAlgorithm.h>
+#include <U2Algorithm/MSAConsensusAlgorithmRegistry.h>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/U2SafePoints.h>
+
+#include <U2View/MSAEditorConsensusCache.h>
+
+#include "MSAConsensusCacheTests.h"
+
+namespace U2 {
+
+/* attributes */
+static const QString ALGORITHM("algorithm");    // consensus algorithm id
+static const QString THRESHOLD("threshold");    // algorithm threshold, optional
+static const QString ROWS_COUNT("rows-count");  // count of random rows
+static const QString LENGTH("length");          // length of the rows
+static const QString CHANGED("changed");        // changed columns: "start..end", 1-based
+static const QString SEED("seed");              // random generator seed, optional
+
+QList<XMLTestFactory *> MSAConsensusCacheTests::createTestFactories() {
+    QList<XMLTestFactory *> res;
+    res.append(GTest_MSAConsensusCacheUpdate::createFactory());
+    return res;
+}
+
+namespace {
+
+const QByteArray CHARS("ACGT-");
+
+void fillRandomly(QByteArray &row, const U2Region &region, quint64 &state) {
+    for (qint64 pos = region.startPos; pos < region.endPos(); pos++) {
+        row[int(pos)] = CHARS[int(XMLTestUtils::nextRandom(state) % CHARS.length())];
+    }
+}
+
+}
+
+void GTest_MSAConsensusCacheUpdate::init(XMLTestFormat *, const QDomElement &el) {
+    updateTask = NULL;
+    threshold = -1;
+    seed = 1;
+
+    algorithmId = el.attribute(ALGORITHM);
+    if (algorithmId.isEmpty()) {
+        failMissingValue(ALGORITHM);
+        return;
+    }
+    bool ok = false;
+    if (el.hasAttribute(THRESHOLD)) {
+        threshold = el.attribute(THRESHOLD).toInt(&ok);
+        if (!ok) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(THRESHOLD));
+            return;
+        }
+    }
+    rowsCount = el.attribute(ROWS_COUNT).toInt(&ok);
+    if (!ok || rowsCount <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(ROWS_COUNT));
+        return;
+    }
+    length = el.attribute(LENGTH).toInt(&ok);
+    if (!ok || length <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(LENGTH));
+        return;
+    }
+    const QStringList changed = el.attribute(CHANGED).split("..");
+    if (2 != changed.size()) {
+        failMissingValue(CHANGED);
+        return;
+    }
+    bool startOk = false;
+    bool endOk = false;
+    const int start = changed[0].toInt(&startOk);
+    const int end = changed[1].toInt(&endOk);
+    changedColumns = U2Region(start - 1, end - start + 1);
+    if (!startOk || !endOk || changedColumns.isEmpty() || !U2Region(0, length).contains(changedColumns)) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(CHANGED));
+        return;
+    }
+    if (el.hasAttribute(SEED)) {
+        seed = el.attribute(SEED).toULongLong(&ok);
+        if (!ok || 0 == seed) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEED));
+            return;
+        }
+    }
+}
+
+void GTest_MSAConsensusCacheUpdate::prepare() {
+    MSAConsensusAlgorithmFactory *factory = AppContext::getMSAConsensusAlgorithmRegistry()->getAlgorithmFactory(algorithmId);
+    CHECK_EXT(NULL != factory, stateInfo.setError(QString("Unknown consensus algorithm: %1").arg(algorithmId)), );
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    CHECK_EXT(NULL != alphabet, stateInfo.setError("No DNA alphabet"), );
+
+    quint64 state = seed;
+    QList<QByteArray> rows;
+    for (int i = 0; i < rowsCount; i++) {
+        QByteArray row(length, MAlignment_GapChar);
+        fillRandomly(row, U2Region(0, length), state);
+        rows << row;
+    }
+
+    MAlignment original("original", alphabet);
+    for (int i = 0; i < rowsCount; i++) {
+        original.addRow(QString("row %1").arg(i), rows[i], stateInfo);
+        CHECK_OP(stateInfo, );
+    }
+    // the algorithm is created for the alignment before the change, as the consensus editor creates it
+    algorithm = QSharedPointer<MSAConsensusAlgorithm>(factory->createAlgorithm(original));
+    if (threshold >= 0) {
+        algorithm->setThreshold(threshold);
+    }
+
+    ma = MAlignment("changed", alphabet);
+    for (int i = 0; i < rowsCount; i++) {
+        fillRandomly(rows[i], changedColumns, state);
+        ma.addRow(QString("row %1").arg(i), rows[i], stateInfo);
+        CHECK_OP(stateInfo, );
+    }
+
+    updateTask = new MSAConsensusCacheUpdateTask(ma, algorithm, QVector<U2Region>() << changedColumns << U2Region(0, length));
+    addSubTask(updateTask);
+}
+
+Task::ReportResult GTest_MSAConsensusCacheUpdate::report() {
+    CHECK_OP(stateInfo, ReportResult_Finished);
+    CHECK_EXT(NULL != updateTask && !updateTask->hasError(), stateInfo.setError("The update task failed"), ReportResult_Finished);
+
+    qint64 columnsCount = 0;
+    foreach (const MSAConsensusCacheChunk &chunk, updateTask->getResult()) {
+        for (int i = 0; i < chunk.region.length; i++) {
+            const int column = chunk.region.startPos + i;
+            int count = 0;
+            const char expectedChar = algorithm->getConsensusCharAndScore(ma, column, count);
+            const char expectedPercent = (char)qRound(count * 100. / rowsCount);
+            if (chunk.chars[i] != expectedChar || chunk.percents[i] != expectedPercent) {
+                stateInfo.setError(QString("Column %1: expected '%2' %3%, got '%4' %5%")
+                    .arg(column + 1).arg(expectedChar).arg(int(expectedPercent)).arg(chunk.chars[i]).arg(int(chunk.percents[i])));
+                return ReportResult_Finished;
+            }
+        }
+        columnsCount += chunk.region.length;
+    }
+    CHECK_EXT(columnsCount == changedColumns.length + length,
+        stateInfo.setError(QString("Expected %1 calculated columns, got %2").arg(changedColumns.length + length).arg(columnsCount)), ReportResult_Finished);
+    return ReportResult_Finished;
+}
+
+}   // namespace U2
@@ -0,0 +1,72 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_MSA_CONSENSUS_CACHE_TESTS_H_
+#define _U2_MSA_CONSENSUS_CACHE_TESTS_H_
+
+#include <QtCore/QSharedPointer>
+
+#include <U2Core/MAlignment.h>
+#include <U2Core/U2Region.h>
+
+#include <U2Test/XMLTestUtils.h>
+
+namespace U2 {
+
+class MSAConsensusAlgorithm;
+class MSAConsensusCacheUpdateTask;
+
+/**
+ * Creates a consensus algorithm for a random alignment, changes the columns of the alignment
+ * and calculates the consensus of the changed alignment with MSAConsensusCacheUpdateTask:
+ * for the changed columns only and for the whole alignment.
+ * The results must be equal to the results of the algorithm for each column, as the consensus editor calculates them on demand.
+ */
+class GTest_MSAConsensusCacheUpdate : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_MSAConsensusCacheUpdate, "msa-consensus-cache-update", TaskFlags_NR_FOSCOE);
+
+    void prepare();
+    ReportResult report();
+
+private:
+    QString algorithmId;
+    int threshold;
+    int rowsCount;
+    int length;
+    U2Region changedColumns;
+    quint64 seed;
+
+    MAlignment ma;
+    QSharedPointer<MSAConsensusAlgorithm> algorithm;
+    MSAConsensusCacheUpdateTask *updateTask;
+};
+
+class MSAConsensusCacheTests {
+public:
+    static QList<XMLTestFactory *> createTestFactories();
+};
+
+}   // namespace U2
+
+#endif // _U2_MSA_CONSENSUS_CACHE_TESTS_H_
@@ -0,0 +1,137 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QDomElement>
+
+#include <U2Algorithm/MSADistanceBitsetEngine.h>
+
+#include <U2Core/MAlignment.h>
+
+#include "MSADistanceBitsetEngineTests.h"
+
+namespace U2 {
+
+/* attributes */
+static const QString ROWS_COUNT("rows-count");  // count of random rows
+static const QString LENGTH("length");          // length of the rows
+static const QString ALPHABET("alphabet");      // chars of the rows, '-' is a gap
+static const QString SEED("seed");              // random generator seed, optional
+
+QList<XMLTestFactory *> MSADistanceBitsetEngineTests::createTestFactories() {
+    QList<XMLTestFactory *> res;
+    res.append(GTest_MSADistanceBitsetEngine::createFactory());
+    return res;
+}
+
+namespace {
+
+QList<QByteArray> generateRows(int rowsCount, int length, const QByteArray &alphabet, quint64 &state) {
+    QList<QByteArray> rows;
+    for (int i = 0; i < rowsCount; i++) {
+        QByteArray row(length, MAlignment_GapChar);
+        for (int pos = 0; pos < length; pos++) {
+            row[pos] = alphabet[int(XMLTestUtils::nextRandom(state) % alphabet.length())];
+        }
+        rows << row;
+    }
+    return rows;
+}
+
+int compareChars(const QByteArray &row1, const QByteArray &row2, MSADistanceBitsetEngine::Measure measure) {
+    int result = 0;
+    for (int pos = 0; pos < row1.length(); pos++) {
+        const bool equal = row1[pos] == row2[pos];
+        const bool gap1 = MAlignment_GapChar == row1[pos];
+        const bool gap2 = MAlignment_GapChar == row2[pos];
+        switch (measure) {
+        case MSADistanceBitsetEngine::Measure_Mismatches:
+            result += equal ? 0 : 1;
+            break;
+        case MSADistanceBitsetEngine::Measure_MismatchesExcludeGaps:
+            result += (!equal && !gap1 && !gap2) ? 1 : 0;
+            break;
+        case MSADistanceBitsetEngine::Measure_Matches:
+            result += equal ? 1 : 0;
+            break;
+        case MSADistanceBitsetEngine::Measure_MatchesExcludeGaps:
+            result += (equal && !gap1) ? 1 : 0;
+            break;
+        }
+    }
+    return result;
+}
+
+}
+
+void GTest_MSADistanceBitsetEngine::init(XMLTestFormat *, const QDomElement &el) {
+    seed = 1;
+    bool ok = false;
+    rowsCount = el.attribute(ROWS_COUNT).toInt(&ok);
+    if (!ok || rowsCount <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(ROWS_COUNT));
+        return;
+    }
+    length = el.attribute(LENGTH).toInt(&ok);
+    if (!ok || length < 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(LENGTH));
+        return;
+    }
+    alphabet = el.attribute(ALPHABET).toLatin1();
+    if (alphabet.isEmpty()) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(ALPHABET));
+        return;
+    }
+    if (el.hasAttribute(SEED)) {
+        seed = el.attribute(SEED).toULongLong(&ok);
+        if (!ok || 0 == seed) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEED));
+            return;
+        }
+    }
+}
+
+void GTest_MSADistanceBitsetEngine::run() {
+    quint64 state = seed;
+    const QList<QByteArray> rows = generateRows(rowsCount, length, alphabet, state);
+    const QList<QByteArray> columnRows = generateRows(rowsCount, length, alphabet, state);
+
+    for (int withColumnRows = 0; withColumnRows < 2; withColumnRows++) {
+        const QList<QByteArray> &rows2 = withColumnRows ? columnRows : rows;
+        MSADistanceBitsetEngine engine(rows, withColumnRows ? columnRows : QList<QByteArray>(), length);
+        QVector<int> results(rowsCount);
+        for (int measure = MSADistanceBitsetEngine::Measure_Mismatches; measure <= MSADistanceBitsetEngine::Measure_MatchesExcludeGaps; measure++) {
+            for (int i = 0; i < rowsCount; i++) {
+                engine.compare(i, i, rowsCount - i, MSADistanceBitsetEngine::Measure(measure), results.data());
+                for (int j = i; j < rowsCount; j++) {
+                    const int expected = compareChars(rows[i], rows2[j], MSADistanceBitsetEngine::Measure(measure));
+                    if (results[j - i] != expected) {
+                        stateInfo.setError(QString("Measure %1, rows %2 and %3: expected %4, got %5")
+                            .arg(measure).arg(i).arg(j).arg(expected).arg(results[j - i]));
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+}   // namespace U2
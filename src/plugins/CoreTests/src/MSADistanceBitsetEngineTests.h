@@ -0,0 +1,55 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_MSA_DISTANCE_BITSET_ENGINE_TESTS_H_
+#define _U2_MSA_DISTANCE_BITSET_ENGINE_TESTS_H_
+
+#include <U2Test/XMLTestUtils.h>
+
+namespace U2 {
+
+/**
+ * The values of MSADistanceBitsetEngine must be equal to the values of the char by char comparison
+ * for random rows, with and without separate column rows.
+ */
+class GTest_MSADistanceBitsetEngine : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_MSADistanceBitsetEngine, "check-msa-distance-bitset-engine", TaskFlags_FOSCOE);
+
+    void run();
+
+private:
+    int rowsCount;
+    int length;
+    QByteArray alphabet;
+    quint64 seed;
+};
+
+class MSADistanceBitsetEngineTests {
+public:
+    static QList<XMLTestFactory *> createTestFactories();
+};
+
+}   // namespace U2
+
+#endif // _U2_MSA_DISTANCE_BITSET_ENGINE_TESTS_H_
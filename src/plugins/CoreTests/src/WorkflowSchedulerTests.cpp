@@ -0,0 +1,193 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QtCore/QFile>
+
+#include <U2Core/U2SafePoints.h>
+
+#include <U2Lang/BaseAttributes.h>
+#include <U2Lang/Schema.h>
+#include <U2Lang/WorkflowEnv.h>
+#include <U2Lang/WorkflowManager.h>
+#include <U2Lang/WorkflowRunTask.h>
+#include <U2Lang/WorkflowSettings.h>
+#include <U2Lang/WorkflowUtils.h>
+
+#include "WorkflowSchedulerTests.h"
+
+namespace U2 {
+
+using namespace Workflow;
+
+/************************************************************************/
+/* GTest_CompareWorkflowSchedulers */
+/************************************************************************/
+#define SCHEMA_ATTR "schema"
+#define IN_ATTR     "in"
+
+static const QString INPUT_ALIAS = "in";
+
+void GTest_CompareWorkflowSchedulers::init(XMLTestFormat *tf, const QDomElement &el) {
+    Q_UNUSED(tf);
+    initialParallelRun = false;
+    settingsChanged = false;
+    sequentialSchema = NULL;
+    parallelSchema = NULL;
+    sequentialTask = NULL;
+    parallelTask = NULL;
+
+    QString schemaAttr = el.attribute(SCHEMA_ATTR);
+    if (schemaAttr.isEmpty()) {
+        failMissingValue(SCHEMA_ATTR);
+        return;
+    }
+    schemaUrl = env->getVar("COMMON_DATA_DIR") + "/" + schemaAttr;
+
+    QString inAttr = el.attribute(IN_ATTR);
+    if (!inAttr.isEmpty()) {
+        inputUrl = env->getVar("COMMON_DATA_DIR") + "/" + inAttr;
+    }
+}
+
+GTest_CompareWorkflowSchedulers::~GTest_CompareWorkflowSchedulers() {
+    delete sequentialSchema;
+    delete parallelSchema;
+}
+
+static Schema * loadSchema(const QString &url, const QString &inputUrl, U2OpStatus &os) {
+    Schema *schema = new Schema();
+    schema->setDeepCopyFlag(true);
+    WorkflowUtils::schemaFromFile(url, schema, NULL, os);
+    CHECK_OP(os, schema);
+
+    if (schema->getDomain().isEmpty()) {
+        QList<QString> domainsId = WorkflowEnv::getDomainRegistry()->getAllIds();
+        SAFE_POINT_EXT(!domainsId.isEmpty(), os.setError("No workflow domains"), schema);
+        schema->setDomain(domainsId.first());
+    }
+    CHECK(!inputUrl.isEmpty(), schema);
+
+    QString attrName;
+    Actor *actor = WorkflowUtils::findActorByParamAlias(schema->getProcesses(), INPUT_ALIAS, attrName);
+    CHECK_EXT(NULL != actor, os.setError(QString("The workflow has no '%1' parameter alias").arg(INPUT_ALIAS)), schema);
+    Attribute *attr = actor->getParameter(attrName);
+    SAFE_POINT_EXT(NULL != attr, os.setError("NULL input attribute"), schema);
+    DataTypeValueFactory *valueFactory = WorkflowEnv::getDataTypeValueFactoryRegistry()->getById(attr->getAttributeType()->getId());
+    SAFE_POINT_EXT(NULL != valueFactory, os.setError("No value factory for the input attribute"), schema);
+
+    bool isOk = false;
+    QVariant value = valueFactory->getValueFromString(inputUrl, &isOk);
+    CHECK_EXT(isOk, os.setError(QString("Incorrect input value: %1").arg(inputUrl)), schema);
+    attr->setAttributeValue(value);
+    return schema;
+}
+
+Task * GTest_CompareWorkflowSchedulers::createRunTask(Schema *schema, const QString &outputPrefix, QStringList &outputUrls) {
+    foreach (Actor *actor, schema->getProcesses()) {
+        Attribute *attr = actor->getParameter(BaseAttributes::URL_OUT_ATTRIBUTE().getId());
+        if (NULL == attr) {
+            continue;
+        }
+        QString url = env->getVar("TEMP_DATA_DIR") + "/" + outputPrefix + "_" + actor->getId();
+        QFile::remove(url);
+        attr->setAttributeValue(url);
+        outputUrls << url;
+    }
+    return new WorkflowRunTask(*schema);
+}
+
+void GTest_CompareWorkflowSchedulers::prepare() {
+    sequentialSchema = loadSchema(schemaUrl, inputUrl, stateInfo);
+    CHECK_OP(stateInfo, );
+    parallelSchema = loadSchema(schemaUrl, inputUrl, stateInfo);
+    CHECK_OP(stateInfo, );
+
+    // the scheduler is chosen by the setting when the workflow iteration starts
+    initialParallelRun = WorkflowSettings::isParallelRunEnabled();
+    settingsChanged = true;
+    WorkflowSettings::setParallelRunEnabled(false);
+
+    sequentialTask = createRunTask(sequentialSchema, "sequential", sequentialOutputs);
+    addSubTask(sequentialTask);
+}
+
+QList<Task *> GTest_CompareWorkflowSchedulers::onSubTaskFinished(Task *subTask) {
+    QList<Task *> result;
+    CHECK(!hasError() && !isCanceled(), result);
+    CHECK(subTask == sequentialTask, result);
+
+    WorkflowSettings::setParallelRunEnabled(true);
+    parallelTask = createRunTask(parallelSchema, "parallel", parallelOutputs);
+    result << parallelTask;
+    return result;
+}
+
+static QByteArray readFile(const QString &url, U2OpStatus &os) {
+    QFile file(url);
+    if (!file.open(QIODevice::ReadOnly)) {
+        os.setError(QString("Can not open the output file: %1").arg(url));
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+Task::ReportResult GTest_CompareWorkflowSchedulers::report() {
+    restoreSettings();
+    CHECK_OP(stateInfo, ReportResult_Finished);
+    CHECK_EXT(!sequentialOutputs.isEmpty(), setError("The workflow has no output files"), ReportResult_Finished);
+    SAFE_POINT_EXT(sequentialOutputs.size() == parallelOutputs.size(), setError("Different output files count"), ReportResult_Finished);
+
+    for (int i = 0; i < sequentialOutputs.size(); i++) {
+        QByteArray expected = readFile(sequentialOutputs[i], stateInfo);
+        QByteArray actual = readFile(parallelOutputs[i], stateInfo);
+        CHECK_OP(stateInfo, ReportResult_Finished);
+        if (expected != actual) {
+            setError(QString("The parallel run output differs from the sequential one: %1, %2").arg(parallelOutputs[i]).arg(sequentialOutputs[i]));
+            return ReportResult_Finished;
+        }
+    }
+    return ReportResult_Finished;
+}
+
+void GTest_CompareWorkflowSchedulers::cleanup() {
+    restoreSettings();
+    foreach (const QString &url, sequentialOutputs + parallelOutputs) {
+        QFile::remove(url);
+    }
+}
+
+void GTest_CompareWorkflowSchedulers::restoreSettings() {
+    CHECK(settingsChanged, );
+    WorkflowSettings::setParallelRunEnabled(initialParallelRun);
+    settingsChanged = false;
+}
+
+/************************************************************************/
+/* WorkflowSchedulerTests */
+/************************************************************************/
+QList<XMLTestFactory *> WorkflowSchedulerTests::createTestFactories() {
+    QList<XMLTestFactory *> res;
+    res.append(GTest_CompareWorkflowSchedulers::createFactory());
+    return res;
+}
+
+}   // namespace U2
@@ -0,0 +1,73 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_WORKFLOW_SCHEDULER_TESTS_H_
+#define _U2_WORKFLOW_SCHEDULER_TESTS_H_
+
+#include <U2Test/XMLTestUtils.h>
+
+namespace U2 {
+
+namespace Workflow {
+class Schema;
+}
+
+/**
+ * Runs a workflow twice: with the sequential scheduler and with the parallel one,
+ * and checks that the files written by every element with the "url-out" attribute are equal.
+ * The input file is set to the parameter with the "in" alias, as the command line does.
+ */
+class GTest_CompareWorkflowSchedulers : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_CompareWorkflowSchedulers, "compare-workflow-schedulers", TaskFlags_NR_FOSCOE);
+    ~GTest_CompareWorkflowSchedulers();
+
+    void prepare();
+    QList<Task *> onSubTaskFinished(Task *subTask);
+    ReportResult report();
+    void cleanup();
+
+private:
+    Task * createRunTask(Workflow::Schema *schema, const QString &outputPrefix, QStringList &outputUrls);
+    void restoreSettings();
+
+    QString schemaUrl;
+    QString inputUrl;
+    bool initialParallelRun;
+    bool settingsChanged;
+    Workflow::Schema *sequentialSchema;
+    Workflow::Schema *parallelSchema;
+    Task *sequentialTask;
+    Task *parallelTask;
+    QStringList sequentialOutputs;
+    QStringList parallelOutputs;
+};
+
+class WorkflowSchedulerTests {
+public:
+    static QList<XMLTestFactory *> createTestFactories();
+};
+
+}   // namespace U2
+
+#endif // _U2_WORKFLOW_SCHEDULER_TESTS_H_
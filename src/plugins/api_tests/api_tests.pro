@@ -31,11 +31,15 @@ HEADERS += \
     src/core/gobjects/MAlignmentObjectUnitTests.h \
     src/core/gobjects/PhyTreeObjectUnitTests.h \
     src/core/gobjects/TextObjectUnitTests.h \
+    src/core/io/MemoryMappedFileAdapterUnitTests.h \
+    src/core/io/ZlibAdapterUnitTests.h \
     src/core/util/MAlignmentImporterExporterUnitTests.h \
     src/UnitTestSuite.h \  
+    src/core/util/BoundedLockFreeQueueUnitTests.h \
     src/core/util/DatatypeSerializeUtilsUnitTest.h \
     src/core/util/MsaDbiUtilsUnitTests.h \
     src/core/util/MsaUtilsUnitTests.h \
+    src/core/workflow/MemoryDataStorageUnitTests.h \
     src/core/format/sqlite_mod_dbi/ModDbiSQLiteSpecificUnitTests.h \
     src/core/format/sqlite_sequence_dbi/SequenceDbiSQLiteSpecificUnitTests.h
 SOURCES += \
@@ -67,10 +71,14 @@ SOURCES += \
     src/core/gobjects/MAlignmentObjectUnitTests.cpp \
     src/core/gobjects/PhyTreeObjectUnitTests.cpp \
     src/core/gobjects/TextObjectUnitTests.cpp \
+    src/core/io/MemoryMappedFileAdapterUnitTests.cpp \
+    src/core/io/ZlibAdapterUnitTests.cpp \
     src/core/util/MAlignmentImporterExporterUnitTests.cpp \
     src/UnitTestSuite.cpp \  
+    src/core/util/BoundedLockFreeQueueUnitTests.cpp \
     src/core/util/DatatypeSerializeUtilsUnitTest.cpp \
     src/core/util/MsaDbiUtilsUnitTests.cpp \
     src/core/util/MsaUtilsUnitTests.cpp \
+    src/core/workflow/MemoryDataStorageUnitTests.cpp \
     src/core/format/sqlite_mod_dbi/ModDbiSQLiteSpecificUnitTests.cpp \
     src/core/format/sqlite_sequence_dbi/SequenceDbiSQLiteSpecificUnitTests.cpp
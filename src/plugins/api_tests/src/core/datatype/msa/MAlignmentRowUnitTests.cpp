@@ -1075,6 +1075,50 @@ IMPLEMENT_TEST(MAlignmentRowUnitTests, charAt_onlyCharsInRow) {
     CHECK_EQUAL('-', ch, "char 3");
 }
 
+IMPLEMENT_TEST(MAlignmentRowUnitTests, charAt_afterEdit) {
+    MAlignment almnt;
+    MAlignmentRow row = MAlignmentRowTestUtils::initTestRowWithGapsInMiddle(almnt);
+    U2OpStatusImpl os;
+    row.insertGaps(0, 2, os);
+    CHECK_NO_ERROR(os);
+    row.insertGaps(5, 1, os);
+    CHECK_NO_ERROR(os);
+    row.removeChars(7, 2, os);
+    CHECK_NO_ERROR(os);
+
+    const QByteArray expected = "--GG--TAT";
+    for (int i = -1; i <= expected.size(); i++) {
+        const char expectedChar = (i >= 0 && i < expected.size()) ? expected[i] : '-';
+        CHECK_EQUAL(expectedChar, row.charAt(i), QString("char %1").arg(i));
+    }
+    CHECK_EQUAL(expected.size(), row.getRowLengthWithoutTrailing(), "row length");
+}
+
+/** Tests getChars */
+IMPLEMENT_TEST(MAlignmentRowUnitTests, getChars_insideRow) {
+    MAlignment almnt;
+    MAlignmentRow row = MAlignmentRowTestUtils::initTestRowWithGapsInMiddle(almnt);
+    QByteArray chars(5, 'X');
+    row.getChars(1, 5, chars.data());
+    CHECK_EQUAL("G-T--", QString(chars), "chars");
+
+    chars = QByteArray(8, 'X');
+    row.getChars(0, 8, chars.data());
+    CHECK_EQUAL("GG-T--AT", QString(chars), "whole row");
+}
+
+IMPLEMENT_TEST(MAlignmentRowUnitTests, getChars_outsideRow) {
+    MAlignment almnt;
+    MAlignmentRow row = MAlignmentRowTestUtils::initTestRowWithGapsInMiddle(almnt);
+    QByteArray chars(12, 'X');
+    row.getChars(-2, 12, chars.data());
+    CHECK_EQUAL("--GG-T--AT--", QString(chars), "chars");
+
+    chars = QByteArray(3, 'X');
+    row.getChars(10, 3, chars.data());
+    CHECK_EQUAL("---", QString(chars), "trailing chars");
+}
+
 
 /** Tests rowEqual */
 IMPLEMENT_TEST(MAlignmentRowUnitTests, rowsEqual_sameContent) {
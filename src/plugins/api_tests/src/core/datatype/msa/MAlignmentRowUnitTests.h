@@ -232,10 +232,20 @@ DECLARE_TEST(MAlignmentRowUnitTests, remove_oneCharInGaps);
  *   ^ allCharsNoOffset  - verify all indexes of a row without gap offset in the beginning
  *   ^ offsetAndTrailing - verify gaps at the beginning and end of a row
  *   ^ onlyCharsInRow    - there are no gaps in the row
+ *   ^ afterEdit         - verify all indexes of a row after gaps insertion and chars removal
  */
 DECLARE_TEST(MAlignmentRowUnitTests, charAt_allCharsNoOffset);
 DECLARE_TEST(MAlignmentRowUnitTests, charAt_offsetAndTrailing);
 DECLARE_TEST(MAlignmentRowUnitTests, charAt_onlyCharsInRow);
+DECLARE_TEST(MAlignmentRowUnitTests, charAt_afterEdit);
+
+/**
+ * Getting several chars starting from the specified position:
+ *   ^ insideRow  - the chars are inside the row, gaps and non-gap chars
+ *   ^ outsideRow - the chars before and after the row are gaps
+ */
+DECLARE_TEST(MAlignmentRowUnitTests, getChars_insideRow);
+DECLARE_TEST(MAlignmentRowUnitTests, getChars_outsideRow);
 
 /**
  * Checking if rows are equal (method "isRowContentEqual", "operator==", "operator!="):
@@ -418,6 +428,9 @@ DECLARE_METATYPE(MAlignmentRowUnitTests, remove_oneCharInGaps)
 DECLARE_METATYPE(MAlignmentRowUnitTests, charAt_allCharsNoOffset)
 DECLARE_METATYPE(MAlignmentRowUnitTests, charAt_offsetAndTrailing)
 DECLARE_METATYPE(MAlignmentRowUnitTests, charAt_onlyCharsInRow)
+DECLARE_METATYPE(MAlignmentRowUnitTests, charAt_afterEdit)
+DECLARE_METATYPE(MAlignmentRowUnitTests, getChars_insideRow)
+DECLARE_METATYPE(MAlignmentRowUnitTests, getChars_outsideRow)
 DECLARE_METATYPE(MAlignmentRowUnitTests, rowsEqual_sameContent)
 DECLARE_METATYPE(MAlignmentRowUnitTests, rowsEqual_noGaps)
 DECLARE_METATYPE(MAlignmentRowUnitTests, rowsEqual_trailingInFirst)
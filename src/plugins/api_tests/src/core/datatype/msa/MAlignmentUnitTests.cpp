@@ -493,6 +493,58 @@ IMPLEMENT_TEST(MAlignmentUnitTests, charAt_gap) {
     CHECK_EQUAL('-', result, "gap inside second row");
 }
 
+/** Tests getColumn and getRowSlice */
+IMPLEMENT_TEST(MAlignmentUnitTests, getColumn_allRows) {
+    MAlignment almnt = MAlignmentTestUtils::initTestAlignment();
+    QByteArray column(2, '\0');
+    int count = almnt.getColumn(3, column.data());
+    CHECK_EQUAL(2, count, "chars count");
+    CHECK_EQUAL("AC", QString(column), "column 3");
+
+    almnt.getColumn(2, column.data());
+    CHECK_EQUAL("--", QString(column), "column 2");
+
+    almnt.getColumn(8, column.data());
+    CHECK_EQUAL("-A", QString(column), "column 8");
+
+    almnt.getColumn(-1, column.data());
+    CHECK_EQUAL("--", QString(column), "column -1");
+}
+
+IMPLEMENT_TEST(MAlignmentUnitTests, getColumn_rowIndexes) {
+    MAlignment almnt = MAlignmentTestUtils::initTestAlignment();
+    QVector<qint64> rowIndexes;
+    rowIndexes << 1 << 0 << 1;
+    QByteArray column(3, '\0');
+    int count = almnt.getColumn(4, column.data(), rowIndexes);
+    CHECK_EQUAL(3, count, "chars count");
+    CHECK_EQUAL("TGT", QString(column), "column 4");
+}
+
+IMPLEMENT_TEST(MAlignmentUnitTests, getColumn_rowsWithoutGaps) {
+    MAlignment almnt = MAlignmentTestUtils::initTestAlignment();
+    U2OpStatusImpl os;
+    almnt.addRow("Third row", "ACGTA", os);
+    CHECK_NO_ERROR(os);
+
+    QByteArray column(3, '\0');
+    almnt.getColumn(4, column.data());
+    CHECK_EQUAL("GTA", QString(column), "column 4");
+
+    almnt.getColumn(5, column.data());
+    CHECK_EQUAL("---", QString(column), "column 5");
+}
+
+IMPLEMENT_TEST(MAlignmentUnitTests, getRowSlice_rowSlice) {
+    MAlignment almnt = MAlignmentTestUtils::initTestAlignment();
+    QByteArray slice;
+    almnt.getRowSlice(0, U2Region(2, 6), slice);
+    CHECK_EQUAL("-AG-T-", QString(slice), "first row slice");
+
+    almnt.getRowSlice(1, U2Region(0, 9), slice);
+    CHECK_EQUAL("AG-CT-TAA", QString(slice), "second row");
+}
+
 /** Tests insertGaps */
 IMPLEMENT_TEST(MAlignmentUnitTests, insertGaps_validParams) {
     MAlignment almnt = MAlignmentTestUtils::initTestAlignment();
@@ -146,6 +146,18 @@ DECLARE_TEST(MAlignmentUnitTests, getRows_rowNames);
 DECLARE_TEST(MAlignmentUnitTests, charAt_nonGapChar);
 DECLARE_TEST(MAlignmentUnitTests, charAt_gap);
 
+/**
+ * Getting chars of a column or of a row region:
+ *   ^ allRows    - the column of all rows
+ *   ^ rowIndexes - the column of the specified rows in the specified order
+ *   ^ rowsWithoutGaps - the column of rows with and without gaps
+ *   ^ rowSlice   - the region of a row, including positions after the row end
+ */
+DECLARE_TEST(MAlignmentUnitTests, getColumn_allRows);
+DECLARE_TEST(MAlignmentUnitTests, getColumn_rowIndexes);
+DECLARE_TEST(MAlignmentUnitTests, getColumn_rowsWithoutGaps);
+DECLARE_TEST(MAlignmentUnitTests, getRowSlice_rowSlice);
+
 /**
  * Inserting gaps into an alignment:
  *   ^ validParams       - gaps are inserted into a row
@@ -302,6 +314,10 @@ DECLARE_METATYPE(MAlignmentUnitTests, getRows_severalRows);
 DECLARE_METATYPE(MAlignmentUnitTests, getRows_rowNames);
 DECLARE_METATYPE(MAlignmentUnitTests, charAt_nonGapChar);
 DECLARE_METATYPE(MAlignmentUnitTests, charAt_gap);
+DECLARE_METATYPE(MAlignmentUnitTests, getColumn_allRows);
+DECLARE_METATYPE(MAlignmentUnitTests, getColumn_rowIndexes);
+DECLARE_METATYPE(MAlignmentUnitTests, getColumn_rowsWithoutGaps);
+DECLARE_METATYPE(MAlignmentUnitTests, getRowSlice_rowSlice);
 DECLARE_METATYPE(MAlignmentUnitTests, insertGaps_validParams);
 DECLARE_METATYPE(MAlignmentUnitTests, insertGaps_toBeginningLength);
 DECLARE_METATYPE(MAlignmentUnitTests, insertGaps_negativeRowIndex);
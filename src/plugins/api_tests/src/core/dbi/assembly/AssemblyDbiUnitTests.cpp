@@ -42,10 +42,12 @@ QList<U2DataId>* AssemblyTestData::assemblyIds = NULL;
 TestDbiProvider AssemblyTestData::dbiProvider = TestDbiProvider();
 
 static bool registerTests(){
+    qRegisterMetaType<U2::AssemblyDbiUnitTests_addPackedReads>("AssemblyDbiUnitTests_addPackedReads");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_addReads>("AssemblyDbiUnitTests_addReads");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_addReadsInvalid>("AssemblyDbiUnitTests_addReadsInvalid");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_calculateCoverage>("AssemblyDbiUnitTests_calculateCoverage");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_calculateCoverageInvalid>("AssemblyDbiUnitTests_calculateCoverageInvalid");
+    qRegisterMetaType<U2::AssemblyDbiUnitTests_calculateCoverageOfLargeRegion>("AssemblyDbiUnitTests_calculateCoverageOfLargeRegion");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_countReads>("AssemblyDbiUnitTests_countReads");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_countReadsInvalid>("AssemblyDbiUnitTests_countReadsInvalid");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_createAssemblyObject>("AssemblyDbiUnitTests_createAssemblyObject");
@@ -63,6 +65,7 @@ static bool registerTests(){
     qRegisterMetaType<U2::AssemblyDbiUnitTests_getReadsByRowInvalid>("AssemblyDbiUnitTests_getReadsByRowInvalid");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_pack>("AssemblyDbiUnitTests_pack");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_packInvalid>("AssemblyDbiUnitTests_packInvalid");
+    qRegisterMetaType<U2::AssemblyDbiUnitTests_readsDataPacking>("AssemblyDbiUnitTests_readsDataPacking");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_removeReads>("AssemblyDbiUnitTests_removeReads");
     qRegisterMetaType<U2::AssemblyDbiUnitTests_removeReadsInvalid>("AssemblyDbiUnitTests_removeReadsInvalid");
     return true;
@@ -575,4 +578,159 @@ void AssemblyDbiUnitTests_calculateCoverageInvalid::Test() {
     CHECK_TRUE(os.hasError(), "error should be thrown");
 }
 
+void AssemblyDbiUnitTests_calculateCoverageOfLargeRegion::Test() {
+    U2AssemblyDbi* assemblyDbi = AssemblyTestData::getAssemblyDbi();
+
+    // windows are aligned to the coverage bins, so the coverage must be exact
+    const int windowsCount = 64;
+    const qint64 windowLength = 8192;
+    const U2Region region(0, windowsCount * windowLength);
+
+    qsrand(42);
+    QList<U2AssemblyRead> reads;
+    for (int i = 0; i < 3000; i++) {
+        U2AssemblyRead read(new U2AssemblyReadData());
+        read->name = "read_" + QByteArray::number(i);
+        read->leftmostPos = qrand() % region.length;
+        read->readSequence = QByteArray(1 + qrand() % 3000, 'A');
+        read->cigar << U2CigarToken(U2CigarOp_M, read->readSequence.length());
+        read->effectiveLen = read->readSequence.length();
+        reads << read;
+    }
+
+    U2Assembly assembly;
+    U2AssemblyReadsImportInfo importInfo;
+    BufferedDbiIterator<U2AssemblyRead> it(reads);
+    U2OpStatusImpl os;
+    assemblyDbi->createAssemblyObject(assembly, "/", &it, importInfo, os);
+    CHECK_NO_ERROR(os);
+
+    U2AssemblyCoverageStat c;
+    c.coverage->resize(windowsCount);
+    assemblyDbi->calculateCoverage(assembly.id, region, c, os);
+    CHECK_NO_ERROR(os);
+
+    for (int i = 0; i < windowsCount; i++) {
+        U2Region window(i * windowLength, windowLength);
+        int expected = 0;
+        foreach (const U2AssemblyRead& read, reads) {
+            expected += window.intersects(U2Region(read->leftmostPos, read->effectiveLen)) ? 1 : 0;
+        }
+        CHECK_EQUAL(expected, c.coverage->at(i).maxValue, QString("coverage of window %1").arg(i));
+    }
+
+    // removed reads must not be counted
+    QList<U2DataId> readIds;
+    {
+        QScopedPointer< U2DbiIterator<U2AssemblyRead> > iter(assemblyDbi->getReads(assembly.id, U2Region(0, windowLength), os));
+        CHECK_NO_ERROR(os);
+        while (iter->hasNext()) {
+            readIds << iter->next()->id;
+        }
+    }
+    assemblyDbi->removeReads(assembly.id, readIds, os);
+    CHECK_NO_ERROR(os);
+
+    c.coverage->fill(U2Range<int>());
+    assemblyDbi->calculateCoverage(assembly.id, region, c, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(0, c.coverage->at(0).maxValue, "coverage of the first window after reads removing");
+}
+
+void AssemblyDbiUnitTests_readsDataPacking::Test() {
+    U2AssemblyDbi* assemblyDbi = AssemblyTestData::getAssemblyDbi();
+
+    // reads don't intersect: all of them are placed to the first packed row
+    QList<U2AssemblyRead> reads;
+    // 2-bit sequence without quality
+    U2AssemblyRead read1(new U2AssemblyReadData());
+    read1->name = "read1";
+    read1->leftmostPos = 10;
+    read1->readSequence = "ACGTTGCAACG";
+    read1->cigar << U2CigarToken(U2CigarOp_S, 2) << U2CigarToken(U2CigarOp_M, 5) << U2CigarToken(U2CigarOp_D, 3) << U2CigarToken(U2CigarOp_M, 4);
+    read1->effectiveLen = read1->readSequence.length() + 3 - 2;
+    reads << read1;
+
+    // 4-bit sequence with quality and mate info
+    U2AssemblyRead read2(new U2AssemblyReadData());
+    read2->name = "read2";
+    read2->leftmostPos = 40;
+    read2->readSequence = "NACGRYNNT";
+    read2->quality = "!!#$%&'()";
+    read2->cigar << U2CigarToken(U2CigarOp_M, 4) << U2CigarToken(U2CigarOp_I, 2) << U2CigarToken(U2CigarOp_M, 3);
+    read2->effectiveLen = read2->readSequence.length() - 2;
+    read2->rnext = "=";
+    read2->pnext = 120;
+    read2->flags = Fragmented | FirstInTemplate;
+    reads << read2;
+
+    // a sequence that can't be packed
+    U2AssemblyRead read3(new U2AssemblyReadData());
+    read3->name = "read3";
+    read3->leftmostPos = 80;
+    read3->readSequence = "acgt-ACGT";
+    read3->cigar << U2CigarToken(U2CigarOp_M, 9);
+    read3->effectiveLen = read3->readSequence.length();
+    reads << read3;
+
+    U2Assembly assembly;
+    U2AssemblyReadsImportInfo importInfo;
+    BufferedDbiIterator<U2AssemblyRead> it(reads);
+    U2OpStatusImpl os;
+    assemblyDbi->createAssemblyObject(assembly, "/", &it, importInfo, os);
+    CHECK_NO_ERROR(os);
+
+    QScopedPointer< U2DbiIterator<U2AssemblyRead> > iter(assemblyDbi->getReads(assembly.id, U2_REGION_MAX, os));
+    CHECK_NO_ERROR(os);
+    bool same = AssemblyDbiTestUtil::compareReadLists(iter.data(), reads);
+    CHECK_TRUE(same, "reads are changed after packing");
+
+    QScopedPointer< U2DbiIterator<U2AssemblyRead> > byName(assemblyDbi->getReadsByName(assembly.id, read2->name, os));
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(byName->hasNext(), "read2 is not found");
+    U2AssemblyRead unpacked = byName->next();
+    CHECK_EQUAL(QString(read2->rnext), QString(unpacked->rnext), "rnext");
+    CHECK_EQUAL(read2->pnext, unpacked->pnext, "pnext");
+}
+
+void AssemblyDbiUnitTests_addPackedReads::Test() {
+    U2AssemblyDbi* assemblyDbi = AssemblyTestData::getAssemblyDbi();
+
+    U2Assembly assembly;
+    U2OpStatusImpl os;
+    U2AssemblyReadsImportInfo importInfo;
+    assemblyDbi->createAssemblyObject(assembly, "/", NULL, importInfo, os);
+    CHECK_NO_ERROR(os);
+
+    // the rows are far from the auto-packed ones to get to the different row-range tables
+    QList<U2AssemblyRead> reads;
+    const qint64 rows[] = {0, 1, 1000, 5000};
+    for (int i = 0; i < 4; i++) {
+        U2AssemblyRead read(new U2AssemblyReadData());
+        read->name = "read_" + QByteArray::number(i);
+        read->leftmostPos = 100;
+        read->readSequence = "ACGTACGTAC";
+        read->cigar << U2CigarToken(U2CigarOp_M, read->readSequence.length());
+        read->effectiveLen = read->readSequence.length();
+        read->packedViewRow = rows[i];
+        reads << read;
+    }
+
+    BufferedDbiIterator<U2AssemblyRead> it(reads);
+    assemblyDbi->addPackedReads(assembly.id, &it, os);
+    CHECK_NO_ERROR(os);
+
+    const qint64 maxRow = assemblyDbi->getMaxPackedRow(assembly.id, U2_REGION_MAX, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(rows[3], maxRow, "max packed row");
+
+    for (int i = 0; i < 4; i++) {
+        QScopedPointer< U2DbiIterator<U2AssemblyRead> > iter(assemblyDbi->getReadsByRow(assembly.id, U2_REGION_MAX, rows[i], rows[i], os));
+        CHECK_NO_ERROR(os);
+        CHECK_TRUE(iter->hasNext(), QString("no reads in the row %1").arg(rows[i]));
+        CHECK_EQUAL(QString(reads[i]->name), QString(iter->next()->name), "read name");
+        CHECK_FALSE(iter->hasNext(), QString("too many reads in the row %1").arg(rows[i]));
+    }
+}
+
 } //namespace
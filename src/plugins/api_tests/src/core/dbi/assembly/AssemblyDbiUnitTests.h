@@ -145,12 +145,29 @@ public:
     void Test();
 };
 
+class AssemblyDbiUnitTests_calculateCoverageOfLargeRegion : public UnitTest {
+public:
+    void Test();
+};
+
+class AssemblyDbiUnitTests_readsDataPacking : public UnitTest {
+public:
+    void Test();
+};
+
+class AssemblyDbiUnitTests_addPackedReads : public UnitTest {
+public:
+    void Test();
+};
+
 }
 
+Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_addPackedReads);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_addReads);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_addReadsInvalid);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_calculateCoverage);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_calculateCoverageInvalid);
+Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_calculateCoverageOfLargeRegion);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_countReads);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_countReadsInvalid);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_createAssemblyObject);
@@ -168,6 +185,7 @@ Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_getReadsByRow);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_getReadsByRowInvalid);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_pack);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_packInvalid);
+Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_readsDataPacking);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_removeReads);
 Q_DECLARE_METATYPE(U2::AssemblyDbiUnitTests_removeReadsInvalid);
 
@@ -25,8 +25,10 @@
 #include <U2Core/AppSettings.h>
 #include <U2Core/U2ObjectDbi.h>
 #include <U2Core/U2SafePoints.h>
+#include <U2Core/Version.h>
 
 #include <QtCore/QDir>
+#include <QtCore/QThread>
 
 namespace U2 {
 
@@ -51,9 +53,11 @@ static bool registerTests(){
     qRegisterMetaType<U2::SequenceDbiUnitTests_getSequenceObject>("SequenceDbiUnitTests_getSequenceObject");
     qRegisterMetaType<U2::SequenceDbiUnitTests_getSequenceObjectInvalid>("SequenceDbiUnitTests_getSequenceObjectInvalid");
     qRegisterMetaType<U2::SequenceDbiUnitTests_updateHugeSequenceData>("SequenceDbiUnitTests_updateHugeSequenceData");
+    qRegisterMetaType<U2::SequenceDbiUnitTests_updatePackedSequenceData>("SequenceDbiUnitTests_updatePackedSequenceData");
     qRegisterMetaType<U2::SequenceDbiUnitTests_updateSequenceData>("SequenceDbiUnitTests_updateSequenceData");
     qRegisterMetaType<U2::SequenceDbiUnitTests_updateSequenceObject>("SequenceDbiUnitTests_updateSequenceObject");
     qRegisterMetaType<U2::SequenceDbiUnitTests_updateSequencesData>("SequenceDbiUnitTests_updateSequencesData");
+    qRegisterMetaType<U2::SequenceDbiUnitTests_walModeReads>("SequenceDbiUnitTests_walModeReads");
     return true;
 }
 
@@ -366,4 +370,176 @@ void SequenceDbiUnitTests_updateSequenceObject::Test() {
     CHECK_EXT(seq.circular == updated.circular, SetError("incorrect updated sequence circular"), );
 };
 
+namespace {
+
+class SequenceDataReader : public QThread {
+public:
+    SequenceDataReader(U2SequenceDbi* sequenceDbi, const U2DataId& sequenceId)
+        : sequenceDbi(sequenceDbi), sequenceId(sequenceId) {}
+
+    void run() {
+        data = sequenceDbi->getSequenceData(sequenceId, U2_REGION_MAX, os);
+    }
+
+    U2SequenceDbi* sequenceDbi;
+    U2DataId sequenceId;
+    QByteArray data;
+    U2OpStatusImpl os;
+};
+
+QByteArray readInThread(U2SequenceDbi* sequenceDbi, const U2DataId& sequenceId, U2OpStatus& os) {
+    SequenceDataReader reader(sequenceDbi, sequenceId);
+    reader.start();
+    reader.wait();
+    if (reader.os.hasError()) {
+        os.setError(reader.os.getError());
+    }
+    return reader.data;
+}
+
+/** Shuts down the database and removes its files with the WAL journal when the test finishes or fails. */
+class WalDbiCleaner {
+public:
+    WalDbiCleaner(const QString& url) : url(url) {
+        remove();
+    }
+    ~WalDbiCleaner() {
+        if (!dbi.isNull() && U2DbiState_Ready == dbi->getState()) {
+            U2OpStatus2Log os;
+            dbi->shutdown(os);
+        }
+        dbi.reset();
+        remove();
+    }
+
+    QScopedPointer<U2Dbi> dbi;
+
+private:
+    void remove() {
+        QFile::remove(url);
+        QFile::remove(url + "-wal");
+        QFile::remove(url + "-shm");
+    }
+
+    QString url;
+};
+
+}
+
+void SequenceDbiUnitTests_walModeReads::Test() {
+    const QString url = QDir::temp().absoluteFilePath("sequence-dbi-wal.ugenedb");
+    WalDbiCleaner cleaner(url);
+
+    U2DbiFactory* factory = AppContext::getDbiRegistry()->getDbiFactoryById(SQLITE_DBI_ID);
+    CHECK_TRUE(NULL != factory, "No dbi factory");
+    cleaner.dbi.reset(factory->createDbi());
+    U2Dbi* dbi = cleaner.dbi.data();
+    QHash<QString, QString> properties;
+    properties[U2DbiOptions::U2_DBI_OPTION_URL] = url;
+    properties[U2DbiOptions::U2_DBI_OPTION_CREATE] = U2DbiOptions::U2_DBI_VALUE_ON;
+    properties[U2DbiOptions::U2_DBI_LOCKING_MODE] = "wal";
+    U2OpStatusImpl os;
+    dbi->init(properties, QVariantMap(), os);
+    CHECK_NO_ERROR(os);
+
+    U2SequenceDbi* sequenceDbi = dbi->getSequenceDbi();
+    U2Sequence seq;
+    seq.alphabet = BaseDNAAlphabetIds::NUCL_DNA_DEFAULT();
+    sequenceDbi->createSequenceObject(seq, "/", os);
+    CHECK_NO_ERROR(os);
+    sequenceDbi->updateSequenceData(seq.id, U2Region(0, 0), "ACGTACGT", QVariantMap(), os);
+    CHECK_NO_ERROR(os);
+
+    // committed data is read by the read-only connections
+    CHECK_EQUAL(QString("ACGTACGT"), QString(sequenceDbi->getSequenceData(seq.id, U2_REGION_MAX, os)), "data in the main thread");
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(QString("ACGTACGT"), QString(readInThread(sequenceDbi, seq.id, os)), "data in other thread");
+    CHECK_NO_ERROR(os);
+
+    // uncommitted changes are visible for the writing thread only
+    dbi->startOperationsBlock(os);
+    CHECK_NO_ERROR(os);
+    sequenceDbi->updateSequenceData(seq.id, U2Region(0, 4), "TTTT", QVariantMap(), os);
+    CHECK_NO_ERROR(os);
+    const QByteArray ownData = sequenceDbi->getSequenceData(seq.id, U2_REGION_MAX, os);
+    CHECK_NO_ERROR(os);
+    const QByteArray otherData = readInThread(sequenceDbi, seq.id, os);
+    CHECK_NO_ERROR(os);
+    dbi->stopOperationBlock(os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(QString("TTTTACGT"), QString(ownData), "data in the writing thread");
+    CHECK_EQUAL(QString("ACGTACGT"), QString(otherData), "data in other thread during the transaction");
+
+    CHECK_EQUAL(QString("TTTTACGT"), QString(readInThread(sequenceDbi, seq.id, os)), "data in other thread after the transaction");
+    CHECK_NO_ERROR(os);
+
+    dbi->shutdown(os);
+    CHECK_NO_ERROR(os);
+}
+
+void SequenceDbiUnitTests_updatePackedSequenceData::Test() {
+    const QString url = QDir::temp().absoluteFilePath("sequence-dbi-packed.ugenedb");
+    WalDbiCleaner cleaner(url);
+
+    U2DbiFactory* factory = AppContext::getDbiRegistry()->getDbiFactoryById(SQLITE_DBI_ID);
+    CHECK_TRUE(NULL != factory, "No dbi factory");
+    cleaner.dbi.reset(factory->createDbi());
+    U2Dbi* dbi = cleaner.dbi.data();
+    QHash<QString, QString> properties;
+    properties[U2DbiOptions::U2_DBI_OPTION_URL] = url;
+    properties[U2DbiOptions::U2_DBI_OPTION_CREATE] = U2DbiOptions::U2_DBI_VALUE_ON;
+    properties[U2DbiOptions::U2_DBI_SEQUENCE_PACKING] = U2DbiOptions::U2_DBI_VALUE_ON;
+    U2OpStatusImpl os;
+    dbi->init(properties, QVariantMap(), os);
+    CHECK_NO_ERROR(os);
+
+    U2SequenceDbi* sequenceDbi = dbi->getSequenceDbi();
+    U2Sequence seq;
+    seq.alphabet = BaseDNAAlphabetIds::NUCL_DNA_DEFAULT();
+    sequenceDbi->createSequenceObject(seq, "/", os);
+    CHECK_NO_ERROR(os);
+
+    // short data is not packed, the database is still readable by the older versions
+    sequenceDbi->updateSequenceData(seq.id, U2Region(0, 0), "ACGT", QVariantMap(), os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(Version::minVersionForSQLite().text, dbi->getProperty(U2DbiOptions::APP_MIN_COMPATIBLE_VERSION, "", os), "version before packing");
+    CHECK_NO_ERROR(os);
+
+    // long nucleotide data with the non-ACGT runs is stored packed
+    QByteArray expected;
+    for (int i = 0; i < 1000; i++) {
+        expected += "ACGTTGCA";
+    }
+    expected.replace(101, 50, QByteArray(50, 'N'));
+    expected[2001] = 'R';
+    expected[7999] = 'N';
+    sequenceDbi->updateSequenceData(seq.id, U2Region(0, 4), expected, QVariantMap(), os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(QString("1.25.0"), dbi->getProperty(U2DbiOptions::APP_MIN_COMPATIBLE_VERSION, "", os), "version after packing");
+    CHECK_NO_ERROR(os);
+
+    sequenceDbi->updateSequenceData(seq.id, U2Region(99, 5), "TTTTTTT", QVariantMap(), os);
+    CHECK_NO_ERROR(os);
+    expected.replace(99, 5, "TTTTTTT");
+    sequenceDbi->updateSequenceData(seq.id, U2Region(2001, 2), "AAAAAA", QVariantMap(), os);
+    CHECK_NO_ERROR(os);
+    expected.replace(2001, 2, "AAAAAA");
+
+    const QByteArray wholeData = sequenceDbi->getSequenceData(seq.id, U2_REGION_MAX, os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(expected == wholeData, "incorrect sequence data");
+    // the regions are not aligned to the packed bytes and include the exceptions
+    const int regionStarts[] = {0, 1, 3, 98, 150, 2005, 7000};
+    foreach (int start, regionStarts) {
+        for (int length = 1; length < 100; length += 7) {
+            const QByteArray actual = sequenceDbi->getSequenceData(seq.id, U2Region(start, length), os);
+            CHECK_NO_ERROR(os);
+            CHECK_TRUE(expected.mid(start, length) == actual, QString("incorrect sequence data in region %1..%2").arg(start).arg(start + length));
+        }
+    }
+
+    dbi->shutdown(os);
+    CHECK_NO_ERROR(os);
+}
+
 } //namespace
@@ -99,11 +99,21 @@ public:
     void Test();
 };
 
+class SequenceDbiUnitTests_updatePackedSequenceData : public UnitTest {
+public:
+    void Test();
+};
+
 class SequenceDbiUnitTests_updateSequencesObject : public UnitTest {
 public:
     void Test();
 };
 
+class SequenceDbiUnitTests_walModeReads : public UnitTest {
+public:
+    void Test();
+};
+
 } // namespace U2
 
 Q_DECLARE_METATYPE(U2::U2Sequence);
@@ -117,8 +127,10 @@ Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceDataInvalid);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceObject);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceObjectInvalid);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateHugeSequenceData);
+Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updatePackedSequenceData);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateSequenceData);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateSequenceObject);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateSequencesData);
+Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_walModeReads);
 
 #endif //_U2_SEQUENCE_DBI_UNITTESTS_H_
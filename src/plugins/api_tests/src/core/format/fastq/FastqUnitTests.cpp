@@ -20,13 +20,16 @@
  */
 
 #include <QtCore/QDir>
+#include <QtCore/QThread>
 
 #include <U2Core/AnnotationData.h>
+#include <U2Core/DNASequence.h>
 #include <U2Core/U2SafePoints.h>
 #include <U2Core/U2Region.h>
 #include <U2Core/AppContext.h>
 #include <U2Core/IOAdapter.h>
 #include <U2Formats/FastqFormat.h>
+#include <U2Formats/FastqParallelReader.h>
 #include <U2Core/AppSettings.h>
 #include <U2Test/TestRunnerSettings.h>
 
@@ -101,4 +104,86 @@ IMPLEMENT_TEST(FasqUnitTests, checkRawDataInvalidQualityHeaderStartWith) {
     CHECK_EQUAL(FormatDetection_NotMatched, res.score, "format is not matched");
 }
 
+namespace {
+
+QString writeTmpFastq(const QString &fileName, const QByteArray &data) {
+    QString path = QDir::temp().absoluteFilePath(fileName);
+    QFile file(path);
+    file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    file.write(data);
+    file.close();
+    return path;
+}
+
+class ParseTaskRunner : public QThread {
+public:
+    ParseTaskRunner(Task *task)
+        : task(task) {}
+
+    void run() {
+        task->run();
+    }
+
+private:
+    Task *task;
+};
+
+}
+
+IMPLEMENT_TEST(FasqUnitTests, parallelReadingKeepsOrder) {
+    QByteArray data;
+    const int recordsCount = 200;
+    for (int i = 0; i < recordsCount; i++) {
+        // quality strings starting with '@' must not be taken for record starts
+        data += QString("@read_%1\nacgt%2\n+\n@III%3\n").arg(i).arg(QString(i % 7, 'T')).arg(QString(i % 7, 'I')).toLatin1();
+    }
+    QString path = writeTmpFastq("parallel_reading_order.fastq", data);
+
+    FastqParallelReader reader(97);
+    CHECK_TRUE(reader.open(path), "file is not opened");
+
+    // the tasks are run outside of the scheduler, the rest chunks are parsed by the test thread
+    QList<Task*> parseTasks = reader.createParseTasks(3);
+    QList<ParseTaskRunner*> runners;
+    foreach (Task *task, parseTasks) {
+        runners << new ParseTaskRunner(task);
+        runners.last()->start();
+    }
+
+    U2OpStatusImpl os;
+    QList<DNASequence*> sequences;
+    while (!reader.isEnd() && !os.hasError()) {
+        sequences << reader.takeNextBatch(os);
+    }
+
+    reader.stop();
+    foreach (ParseTaskRunner *runner, runners) {
+        runner->wait();
+    }
+    qDeleteAll(runners);
+    qDeleteAll(parseTasks);
+    QFile::remove(path);
+
+    QScopedPointer<DNASequence> seq;
+    int readCount = 0;
+    while (!sequences.isEmpty()) {
+        seq.reset(sequences.takeFirst());
+        CHECK_EQUAL(QString("read_%1").arg(readCount), seq->getName(), "sequence name");
+        CHECK_EQUAL(QString("ACGT") + QString(readCount % 7, 'T'), QString(seq->seq), "sequence data");
+        CHECK_EQUAL(seq->seq.length(), seq->quality.qualCodes.length(), "quality length");
+        readCount++;
+    }
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(recordsCount, readCount, "sequences count");
+}
+
+IMPLEMENT_TEST(FasqUnitTests, parallelReadingMultiLineRecords) {
+    QByteArray data = "@SEQ_ID\nGATTTGGGG\nTTCAAAGCA\n+\nIIIIIIIII\nIIIIIIIII\n";
+    QString path = writeTmpFastq("parallel_reading_multiline.fastq", data);
+
+    FastqParallelReader reader;
+    CHECK_FALSE(reader.open(path), "multi-line records are not supported by the parallel reader");
+    QFile::remove(path);
+}
+
 } //namespace
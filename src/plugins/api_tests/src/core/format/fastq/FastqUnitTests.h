@@ -21,6 +21,8 @@ DECLARE_TEST(FasqUnitTests, checkRawData);
 DECLARE_TEST(FasqUnitTests, checkRawDataInvalidHeaderStartWith);
 DECLARE_TEST(FasqUnitTests, checkRawDataInvalidQualityHeaderStartWith);
 DECLARE_TEST(FasqUnitTests, checkRawDataMultiple);
+DECLARE_TEST(FasqUnitTests, parallelReadingKeepsOrder);
+DECLARE_TEST(FasqUnitTests, parallelReadingMultiLineRecords);
 
 }
 
@@ -28,6 +30,8 @@ DECLARE_METATYPE(FasqUnitTests, checkRawData);
 DECLARE_METATYPE(FasqUnitTests, checkRawDataInvalidHeaderStartWith);
 DECLARE_METATYPE(FasqUnitTests, checkRawDataInvalidQualityHeaderStartWith);
 DECLARE_METATYPE(FasqUnitTests, checkRawDataMultiple);
+DECLARE_METATYPE(FasqUnitTests, parallelReadingKeepsOrder);
+DECLARE_METATYPE(FasqUnitTests, parallelReadingMultiLineRecords);
 
 #endif
 
@@ -786,6 +786,71 @@ IMPLEMENT_TEST(MsaDbiSQLiteSpecificUnitTests, updateGapModel_severalSteps) {
     CHECK_EQUAL(objVersion + expectedIndex, finalVersion, "final version");
 }
 
+IMPLEMENT_TEST(MsaDbiSQLiteSpecificUnitTests, updateGapModels_undo) {
+    U2OpStatusImpl os;
+    SQLiteDbi *sqliteDbi = MsaSQLiteSpecificTestData::getSQLiteDbi();
+    U2DataId msaId = MsaSQLiteSpecificTestData::createTestMsa(true, os);
+    CHECK_NO_ERROR(os);
+    QList<U2MsaRow> oldRows = sqliteDbi->getMsaDbi()->getRows(msaId, os);
+    CHECK_NO_ERROR(os);
+
+    // Get current version
+    int objVersion = sqliteDbi->getObjectDbi()->getObjectVersion(msaId, os);
+    CHECK_NO_ERROR(os);
+
+    // Update gaps of both rows
+    QMap<qint64, QList<U2MsaGap> > newGapModel;
+    newGapModel[oldRows[0].rowId] = QList<U2MsaGap>() << U2MsaGap(0, 2); // --TAAGACTTCTA
+    newGapModel[oldRows[1].rowId] = QList<U2MsaGap>() << U2MsaGap(1, 4) << U2MsaGap(14, 11); // T----AAGCTACTA-----------
+    sqliteDbi->getMsaDbi()->updateGapModels(msaId, newGapModel, os);
+    CHECK_NO_ERROR(os);
+
+    // Verify gaps
+    foreach (const U2MsaRow &oldRow, oldRows) {
+        U2MsaRow rowAfterUpdate = sqliteDbi->getMsaDbi()->getRow(msaId, oldRow.rowId, os);
+        CHECK_NO_ERROR(os);
+        CHECK_TRUE(newGapModel[oldRow.rowId] == rowAfterUpdate.gaps, "gaps");
+    }
+
+    // Verify msa length
+    U2Msa msaAfterUpdate = sqliteDbi->getMsaDbi()->getMsaObject(msaId, os);
+    CHECK_EQUAL(25, msaAfterUpdate.length, "length");
+
+    // Verify version: the object is modified once
+    int versionAfterUpdate = sqliteDbi->getObjectDbi()->getObjectVersion(msaId, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(objVersion + 1, versionAfterUpdate, "version");
+
+    // Verify the modification step: both rows and the length change are in a single step
+    QList< QList<U2SingleModStep> > modSteps = sqliteDbi->getSQLiteModDbi()->getModSteps(msaId, objVersion, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(1, modSteps.count(), "mod steps count");
+    CHECK_EQUAL(3, modSteps.first().size(), "mod single steps count");
+    CHECK_EQUAL(U2ModType::msaUpdatedGapModel, modSteps.first()[0].modType, "first mod step type");
+    CHECK_EQUAL(U2ModType::msaLengthChanged, modSteps.first()[1].modType, "second mod step type");
+    CHECK_EQUAL(U2ModType::msaUpdatedGapModel, modSteps.first()[2].modType, "third mod step type");
+
+    // Undo
+    sqliteDbi->getSQLiteObjectDbi()->undo(msaId, os);
+    CHECK_NO_ERROR(os);
+
+    // Verify gaps
+    foreach (const U2MsaRow &oldRow, oldRows) {
+        U2MsaRow rowAfterUndo = sqliteDbi->getMsaDbi()->getRow(msaId, oldRow.rowId, os);
+        CHECK_NO_ERROR(os);
+        CHECK_TRUE(oldRow.gaps == rowAfterUndo.gaps, "gaps after undo");
+    }
+
+    // Verify msa length
+    U2Msa msaAfterUndo = sqliteDbi->getMsaDbi()->getMsaObject(msaId, os);
+    CHECK_EQUAL(13, msaAfterUndo.length, "length after undo");
+
+    // Verify version
+    int versionAfterUndo = sqliteDbi->getObjectDbi()->getObjectVersion(msaId, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(objVersion, versionAfterUndo, "version after undo");
+}
+
 IMPLEMENT_TEST(MsaDbiSQLiteSpecificUnitTests, updateRowContent_noModTrack) {
     U2OpStatusImpl os;
     SQLiteDbi *sqliteDbi = MsaSQLiteSpecificTestData::getSQLiteDbi();
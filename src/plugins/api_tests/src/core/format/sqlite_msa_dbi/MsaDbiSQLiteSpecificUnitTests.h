@@ -88,6 +88,9 @@ DECLARE_TEST(MsaDbiSQLiteSpecificUnitTests, updateGapModel_undo);
 DECLARE_TEST(MsaDbiSQLiteSpecificUnitTests, updateGapModel_redo);
 DECLARE_TEST(MsaDbiSQLiteSpecificUnitTests, updateGapModel_severalSteps);
 
+/** Update gap models of several rows */
+DECLARE_TEST(MsaDbiSQLiteSpecificUnitTests, updateGapModels_undo);
+
 /** Update row content */
 DECLARE_TEST(MsaDbiSQLiteSpecificUnitTests, updateRowContent_noModTrack);
 DECLARE_TEST(MsaDbiSQLiteSpecificUnitTests, updateRowContent_undo);
@@ -174,6 +177,8 @@ DECLARE_METATYPE(MsaDbiSQLiteSpecificUnitTests, updateGapModel_undo);
 DECLARE_METATYPE(MsaDbiSQLiteSpecificUnitTests, updateGapModel_redo);
 DECLARE_METATYPE(MsaDbiSQLiteSpecificUnitTests, updateGapModel_severalSteps);
 
+DECLARE_METATYPE(MsaDbiSQLiteSpecificUnitTests, updateGapModels_undo);
+
 DECLARE_METATYPE(MsaDbiSQLiteSpecificUnitTests, updateRowContent_noModTrack);
 DECLARE_METATYPE(MsaDbiSQLiteSpecificUnitTests, updateRowContent_undo);
 DECLARE_METATYPE(MsaDbiSQLiteSpecificUnitTests, updateRowContent_redo);
@@ -211,4 +211,55 @@ IMPLEMENT_TEST( MAlignmentObjectUnitTests, deleteGap_gapRegion ) {
     CHECK_TRUE(resultAlignment.getRow(2).getData() == "-ACACA-G---", "Third row content is unexpected!");
 }
 
+IMPLEMENT_TEST(MAlignmentObjectUnitTests, releaseState_deferredEdits) {
+//  Test data:
+//  AC-GT--AAA
+//  -ACACA-GT
+
+//  Expected result, after two gaps are inserted to the first row and a gap is removed from the second one:
+//  A--C-GT--AAA
+//  ACACA-GT
+
+    const U2DbiRef dbiRef = MAlignmentObjectTestData::getDbiRef();
+    U2OpStatusImpl os;
+
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    MAlignment alignment("Alignment with deferred edits", alphabet);
+    alignment.addRow("First row", "AC-GT--AAA", os);
+    CHECK_NO_ERROR(os);
+    alignment.addRow("Second row", "-ACACA-GT", os);
+    CHECK_NO_ERROR(os);
+
+    QScopedPointer<MAlignmentObject> alnObj(MAlignmentImporter::createAlignment(dbiRef, alignment, os));
+    CHECK_NO_ERROR(os);
+    const U2EntityRef alnRef = alnObj->getEntityRef();
+    MAlignmentExporter exporter;
+
+    alnObj->saveState();
+    alnObj->insertGap(U2Region(0, 1), 1, 2);
+    const int countOfDeleted = alnObj->deleteGap(U2Region(1, 1), 0, 1, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(1, countOfDeleted, "count of removed gaps");
+
+    const MAlignment &cachedAlignment = alnObj->getMAlignment();
+    CHECK_TRUE(cachedAlignment.getRow(0).getData() == "A--C-GT--AAA", "First row content is unexpected!");
+    CHECK_TRUE(cachedAlignment.getRow(1).getData() == "ACACA-GT----", "Second row content is unexpected!");
+
+    // the edits are deferred while the state is saved
+    const MAlignment alignmentBeforeRelease = exporter.getAlignment(dbiRef, alnRef.entityId, os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(alignmentBeforeRelease.getRow(0).getData() == "AC-GT--AAA", "First row in the database is changed before the state release!");
+    CHECK_TRUE(alignmentBeforeRelease.getRow(1).getData() == "-ACACA-GT-", "Second row in the database is changed before the state release!");
+
+    alnObj->releaseState(os);
+    CHECK_NO_ERROR(os);
+
+    const MAlignment alignmentAfterRelease = exporter.getAlignment(dbiRef, alnRef.entityId, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(12, alignmentAfterRelease.getLength(), "alignment length in the database");
+    CHECK_TRUE(alignmentAfterRelease.getRow(0).getData() == "A--C-GT--AAA", "First row in the database is unexpected!");
+    CHECK_TRUE(alignmentAfterRelease.getRow(1).getData() == "ACACA-GT----", "Second row in the database is unexpected!");
+    CHECK_TRUE(alignmentAfterRelease == alnObj->getMAlignment(), "The database alignment doesn't equal to the cached one!");
+}
+
 } // namespace
@@ -56,6 +56,7 @@ DECLARE_TEST(MAlignmentObjectUnitTests, setMAlignment);
 DECLARE_TEST( MAlignmentObjectUnitTests, deleteGap_trailingGaps );
 DECLARE_TEST( MAlignmentObjectUnitTests, deleteGap_regionWithNonGapSymbols );
 DECLARE_TEST( MAlignmentObjectUnitTests, deleteGap_gapRegion );
+DECLARE_TEST(MAlignmentObjectUnitTests, releaseState_deferredEdits);
 
 } // namespace
 
@@ -64,5 +65,6 @@ DECLARE_METATYPE(MAlignmentObjectUnitTests, setMAlignment);
 DECLARE_METATYPE( MAlignmentObjectUnitTests, deleteGap_trailingGaps );
 DECLARE_METATYPE( MAlignmentObjectUnitTests, deleteGap_regionWithNonGapSymbols );
 DECLARE_METATYPE( MAlignmentObjectUnitTests, deleteGap_gapRegion );
+DECLARE_METATYPE(MAlignmentObjectUnitTests, releaseState_deferredEdits);
 
 #endif
@@ -0,0 +1,214 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QtCore/QBitArray>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QScopedPointer>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/MemoryMappedFileAdapter.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "MemoryMappedFileAdapterUnitTests.h"
+
+namespace U2 {
+
+namespace {
+
+// CRLF and LF line ends, the last line has no terminator
+const QByteArray LINES_DATA("first\nsecond\r\n\r\nlast");
+
+MemoryMappedFileAdapter* createMappedAdapter() {
+    IOAdapterFactory* factory = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::MEMORY_MAPPED_LOCAL_FILE);
+    return NULL == factory ? NULL : qobject_cast<MemoryMappedFileAdapter*>(factory->createIOAdapter());
+}
+
+/** Writes the test file and removes it when the test is finished, even if it fails */
+class TestFile {
+public:
+    TestFile(const QString& name, const QByteArray& data)
+        : url(QDir::temp().absoluteFilePath(name))
+    {
+        QFile file(url);
+        written = file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(data) == data.size();
+    }
+    ~TestFile() {
+        QFile::remove(url);
+    }
+
+    QString url;
+    bool written;
+};
+
+}
+
+IMPLEMENT_TEST(MemoryMappedFileAdapterUnitTests, readLineView) {
+    TestFile file("mmap-adapter-line-view.txt", LINES_DATA);
+    CHECK_TRUE(file.written, "can't write the test file");
+    QScopedPointer<MemoryMappedFileAdapter> io(createMappedAdapter());
+    CHECK_TRUE(!io.isNull() && io->open(file.url, IOAdapterMode_Read), "can't open the test file");
+    CHECK_EQUAL(LINES_DATA.size(), io->getMappedSize(), "mapped size");
+
+    const QList<QByteArray> expectedLines = QList<QByteArray>() << "first" << "second" << "" << "last";
+    for (int i = 0; i < expectedLines.size(); i++) {
+        const char* data = NULL;
+        bool terminatorFound = false;
+        const qint64 len = io->readLineView(data, &terminatorFound);
+        CHECK_EQUAL(expectedLines[i].size(), len, QString("length of the line %1").arg(i));
+        CHECK_TRUE(QByteArray(data, len) == expectedLines[i], QString("wrong line %1").arg(i));
+        CHECK_TRUE((i + 1 < expectedLines.size()) == terminatorFound, QString("wrong terminator of the line %1").arg(i));
+        // the view points directly into the mapping
+        CHECK_TRUE(data >= io->getMappedData() && data + len <= io->getMappedData() + io->getMappedSize(), "the view is out of the mapping");
+    }
+    const char* data = NULL;
+    CHECK_EQUAL(-1, io->readLineView(data), "result at the end of the file");
+    CHECK_EQUAL(0, io->left(), "bytes left");
+}
+
+IMPLEMENT_TEST(MemoryMappedFileAdapterUnitTests, readLine) {
+    TestFile file("mmap-adapter-line.txt", LINES_DATA);
+    CHECK_TRUE(file.written, "can't write the test file");
+    QScopedPointer<MemoryMappedFileAdapter> io(createMappedAdapter());
+    CHECK_TRUE(!io.isNull() && io->open(file.url, IOAdapterMode_Read), "can't open the test file");
+
+    QByteArray buffer(100, 0);
+    bool terminatorFound = false;
+    qint64 len = io->readLine(buffer.data(), buffer.size(), &terminatorFound);
+    CHECK_TRUE(buffer.left(len) == "first" && terminatorFound, "wrong LF line");
+    CHECK_EQUAL(6, io->bytesRead(), "position after the LF line");
+
+    len = io->readLine(buffer.data(), buffer.size(), &terminatorFound);
+    CHECK_TRUE(buffer.left(len) == "second" && terminatorFound, "wrong CRLF line");
+    CHECK_EQUAL(14, io->bytesRead(), "position after the CRLF line");
+
+    len = io->readLine(buffer.data(), buffer.size(), &terminatorFound);
+    CHECK_TRUE(0 == len && terminatorFound, "wrong empty line");
+
+    len = io->readLine(buffer.data(), buffer.size(), &terminatorFound);
+    CHECK_TRUE(buffer.left(len) == "last" && !terminatorFound, "wrong last line without the terminator");
+    CHECK_EQUAL(LINES_DATA.size(), io->bytesRead(), "position at the end of the file");
+
+    len = io->readLine(buffer.data(), buffer.size(), &terminatorFound);
+    CHECK_TRUE(0 == len && !terminatorFound, "a line is read after the end of the file");
+    CHECK_EQUAL(100, io->getProgress(), "progress at the end of the file");
+}
+
+IMPLEMENT_TEST(MemoryMappedFileAdapterUnitTests, readUntilAtEnd) {
+    const QByteArray data("ACGT;;TTT");
+    TestFile file("mmap-adapter-until.txt", data);
+    CHECK_TRUE(file.written, "can't write the test file");
+    QScopedPointer<MemoryMappedFileAdapter> io(createMappedAdapter());
+    CHECK_TRUE(!io.isNull() && io->open(file.url, IOAdapterMode_Read), "can't open the test file");
+
+    QBitArray terminators(256, false);
+    terminators[';'] = true;
+    QByteArray buffer(100, 0);
+    bool terminatorFound = false;
+    qint64 len = io->readUntil(buffer.data(), buffer.size(), terminators, IOAdapter::Term_Skip, &terminatorFound);
+    CHECK_TRUE(buffer.left(len) == "ACGT" && terminatorFound, "wrong data before the terminators");
+    CHECK_EQUAL(6, io->bytesRead(), "position after the skipped terminators");
+
+    // no terminator up to the end of the mapping
+    len = io->readUntil(buffer.data(), buffer.size(), terminators, IOAdapter::Term_Include, &terminatorFound);
+    CHECK_TRUE(buffer.left(len) == "TTT" && !terminatorFound, "wrong data at the end of the file");
+    CHECK_EQUAL(0, io->left(), "bytes left");
+
+    len = io->readUntil(buffer.data(), buffer.size(), terminators, IOAdapter::Term_Include, &terminatorFound);
+    CHECK_TRUE(0 == len && !terminatorFound, "data are read after the end of the file");
+    CHECK_EQUAL(data.size(), io->bytesRead(), "position after the end of the file");
+}
+
+IMPLEMENT_TEST(MemoryMappedFileAdapterUnitTests, skipAtEnd) {
+    const QByteArray data("0123456789");
+    TestFile file("mmap-adapter-skip.txt", data);
+    CHECK_TRUE(file.written, "can't write the test file");
+    QScopedPointer<MemoryMappedFileAdapter> io(createMappedAdapter());
+    CHECK_TRUE(!io.isNull() && io->open(file.url, IOAdapterMode_Read), "can't open the test file");
+
+    CHECK_TRUE(io->skip(4), "can't skip inside the file");
+    CHECK_FALSE(io->skip(data.size()), "skipped beyond the end of the file");
+    CHECK_EQUAL(4, io->bytesRead(), "position after the failed skip");
+    CHECK_FALSE(io->skip(-5), "skipped before the beginning of the file");
+    CHECK_TRUE(io->skip(-4), "can't skip back to the beginning");
+    CHECK_TRUE(io->skip(data.size()), "can't skip to the end of the file");
+    CHECK_EQUAL(0, io->left(), "bytes left");
+
+    char c = 0;
+    CHECK_EQUAL(0, io->readBlock(&c, 1), "data read at the end of the file");
+    const char* view = NULL;
+    CHECK_EQUAL(0, io->readBlockView(view, 10), "view length at the end of the file");
+}
+
+IMPLEMENT_TEST(MemoryMappedFileAdapterUnitTests, emptyFile) {
+    TestFile file("mmap-adapter-empty.txt", QByteArray());
+    CHECK_TRUE(file.written, "can't write the test file");
+    QScopedPointer<MemoryMappedFileAdapter> io(createMappedAdapter());
+    CHECK_TRUE(!io.isNull() && io->open(file.url, IOAdapterMode_Read), "can't open the empty file");
+
+    CHECK_TRUE(NULL == io->getMappedData(), "an empty file is mapped");
+    CHECK_EQUAL(0, io->getMappedSize(), "mapped size");
+    CHECK_EQUAL(0, io->left(), "bytes left");
+    CHECK_EQUAL(100, io->getProgress(), "progress");
+
+    const char* data = NULL;
+    CHECK_EQUAL(-1, io->readLineView(data), "line view length");
+    char buffer[10];
+    bool terminatorFound = true;
+    CHECK_EQUAL(0, io->readLine(buffer, sizeof(buffer), &terminatorFound), "line length");
+    CHECK_FALSE(terminatorFound, "a terminator is found in the empty file");
+    CHECK_EQUAL(0, io->readBlock(buffer, sizeof(buffer)), "block length");
+    CHECK_FALSE(io->skip(1), "skipped in the empty file");
+    io->close();
+    CHECK_FALSE(io->isOpen(), "the adapter is not closed");
+}
+
+IMPLEMENT_TEST(MemoryMappedFileAdapterUnitTests, mappingFailure) {
+    QScopedPointer<MemoryMappedFileAdapter> io(createMappedAdapter());
+    CHECK_TRUE(!io.isNull(), "can't create the adapter");
+    CHECK_FALSE(io->open(QDir::temp().absoluteFilePath("mmap-adapter-missing.txt"), IOAdapterMode_Read), "a missing file is opened");
+    CHECK_FALSE(io->isOpen(), "the adapter is open after the failure");
+
+#ifdef Q_OS_LINUX
+    // sysfs attributes have a size, but can't be mapped: the caller must be able to read them with the local file adapter
+    const QString unmappableUrl("/sys/devices/system/cpu/online");
+    if (QFileInfo(unmappableUrl).size() > 0) {
+        CHECK_FALSE(io->open(unmappableUrl, IOAdapterMode_Read), "a sysfs file is mapped");
+        CHECK_FALSE(io->isOpen(), "the adapter is open after the mapping failure");
+        CHECK_TRUE(NULL == io->getMappedData() && 0 == io->getMappedSize(), "the failed mapping is kept");
+
+        IOAdapterFactory* factory = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::LOCAL_FILE);
+        QScopedPointer<IOAdapter> localIo(factory->createIOAdapter());
+        CHECK_TRUE(localIo->open(unmappableUrl, IOAdapterMode_Read), "can't read the sysfs file with the local file adapter");
+        char buffer[100];
+        CHECK_TRUE(localIo->readBlock(buffer, sizeof(buffer)) > 0, "no data in the sysfs file");
+    }
+#endif
+
+    // the adapter is reusable after the failures
+    TestFile file("mmap-adapter-reuse.txt", LINES_DATA);
+    CHECK_TRUE(file.written, "can't write the test file");
+    CHECK_TRUE(io->open(file.url, IOAdapterMode_Read), "can't open the file after the failures");
+    CHECK_EQUAL(LINES_DATA.size(), io->left(), "bytes left");
+}
+
+} // namespace U2
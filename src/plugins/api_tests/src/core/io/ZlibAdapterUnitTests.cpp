@@ -0,0 +1,205 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QScopedPointer>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/IOAdapter.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/ZlibAdapter.h>
+
+#include "ZlibAdapterUnitTests.h"
+
+namespace U2 {
+
+namespace {
+
+// the data of each gzip member: several access point spans of random nucleotides
+const int MEMBER_SIZE = 3 * 1024 * 1024 + 123;
+
+QByteArray generateData(int length, quint32 seed) {
+    static const char NUCLEOTIDES[] = "ACGT";
+    QByteArray data(length, '\n');
+    for (int i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345;
+        if (0 != (i + 1) % 61) {
+            data[i] = NUCLEOTIDES[(seed >> 16) % 4];
+        }
+    }
+    return data;
+}
+
+IOAdapter* createGzipAdapter() {
+    IOAdapterFactory* factory = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::GZIPPED_LOCAL_FILE);
+    return NULL == factory ? NULL : factory->createIOAdapter();
+}
+
+bool writeMember(const QString& url, const QByteArray& data) {
+    QScopedPointer<IOAdapter> io(createGzipAdapter());
+    CHECK(!io.isNull() && io->open(url, IOAdapterMode_Write), false);
+    const bool written = io->writeBlock(data.constData(), data.size()) == data.size();
+    io->close();
+    return written;
+}
+
+/** Writes every part of the data as a separate gzip member */
+bool writeMultiMemberFile(const QString& url, const QList<QByteArray>& parts) {
+    QFile result(url);
+    CHECK(result.open(QIODevice::WriteOnly | QIODevice::Truncate), false);
+    const QString memberUrl = url + ".member";
+    foreach (const QByteArray& part, parts) {
+        CHECK(writeMember(memberUrl, part), false);
+        QFile member(memberUrl);
+        CHECK(member.open(QIODevice::ReadOnly), false);
+        result.write(member.readAll());
+    }
+    QFile::remove(memberUrl);
+    return true;
+}
+
+QByteArray readAll(IOAdapter* io) {
+    QByteArray result;
+    QByteArray buffer(65536, 0);
+    qint64 len = 0;
+    while ((len = io->readBlock(buffer.data(), buffer.size())) > 0) {
+        result.append(buffer.constData(), len);
+    }
+    return result;
+}
+
+/** Removes the test file and its index when the test is finished, even if it fails */
+class GzipFileCleaner {
+public:
+    GzipFileCleaner(const QString& url) : url(url) {
+        remove();
+    }
+    ~GzipFileCleaner() {
+        remove();
+    }
+
+private:
+    void remove() {
+        QFile::remove(url);
+        QFile::remove(GZipIndex::getIndexFilePath(url));
+    }
+
+    QString url;
+};
+
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, indexIsBuiltOnFullRead) {
+    const QString url = QDir::temp().absoluteFilePath("zlib-adapter-index.gz");
+    GzipFileCleaner cleaner(url);
+    const QByteArray data = generateData(MEMBER_SIZE, 1);
+    CHECK_TRUE(writeMultiMemberFile(url, QList<QByteArray>() << data), "can't write the gzip file");
+
+    QScopedPointer<IOAdapter> io(createGzipAdapter());
+    CHECK_TRUE(io->open(url, IOAdapterMode_Read), "can't open the gzip file");
+    CHECK_FALSE(qobject_cast<ZlibAdapter*>(io.data())->hasIndex(), "the index exists before the first read");
+    CHECK_TRUE(data == readAll(io.data()), "the read data differs from the written one");
+    CHECK_TRUE(qobject_cast<ZlibAdapter*>(io.data())->hasIndex(), "the index is not built");
+    io->close();
+
+    CHECK_FALSE(QFile::exists(url + ".ugzi"), "the index is stored next to the data");
+    GZipIndex index;
+    CHECK_TRUE(GZipIndex::load(url, index), "the index is not stored");
+    CHECK_TRUE(index.points.size() > 1, "the index has no access points inside the data");
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, seekByIndex) {
+    const QString url = QDir::temp().absoluteFilePath("zlib-adapter-seek.gz");
+    GzipFileCleaner cleaner(url);
+    const QByteArray data1 = generateData(MEMBER_SIZE, 2);
+    const QByteArray data2 = generateData(MEMBER_SIZE, 3);
+    const QByteArray data = data1 + data2;
+    CHECK_TRUE(writeMultiMemberFile(url, QList<QByteArray>() << data1 << data2), "can't write the gzip file");
+    {
+        QScopedPointer<IOAdapter> io(createGzipAdapter());
+        CHECK_TRUE(io->open(url, IOAdapterMode_Read), "can't open the gzip file");
+        CHECK_TRUE(data == readAll(io.data()), "the read data differs from the written one");
+    }
+
+    QScopedPointer<IOAdapter> io(createGzipAdapter());
+    CHECK_TRUE(io->open(url, IOAdapterMode_Read), "can't open the gzip file");
+    ZlibAdapter* zlibAdapter = qobject_cast<ZlibAdapter*>(io.data());
+    CHECK_TRUE(zlibAdapter->hasIndex(), "the index is not loaded");
+
+    // forward and backward, inside the first member, across the member border and inside the second member
+    const QList<qint64> offsets = QList<qint64>() << 2500000 << 100 << MEMBER_SIZE - 10 << MEMBER_SIZE + 1500000 << 1200000 << 2 * MEMBER_SIZE - 50;
+    QByteArray buffer(100, 0);
+    foreach (qint64 offset, offsets) {
+        CHECK_TRUE(zlibAdapter->seek(offset), QString("can't seek to %1").arg(offset));
+        CHECK_EQUAL(offset, io->bytesRead(), "position after seek");
+        const qint64 len = qMin(qint64(buffer.size()), data.size() - offset);
+        qint64 read = 0;
+        while (read < len) {
+            const qint64 n = io->readBlock(buffer.data() + read, len - read);
+            CHECK_TRUE(n > 0, QString("can't read at %1").arg(offset + read));
+            read += n;
+        }
+        CHECK_TRUE(data.mid(offset, len) == buffer.left(len), QString("wrong data at %1").arg(offset));
+    }
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, staleIndexIsNotLoaded) {
+    const QString url = QDir::temp().absoluteFilePath("zlib-adapter-stale.gz");
+    GzipFileCleaner cleaner(url);
+    CHECK_TRUE(writeMultiMemberFile(url, QList<QByteArray>() << generateData(MEMBER_SIZE, 4)), "can't write the gzip file");
+    {
+        QScopedPointer<IOAdapter> io(createGzipAdapter());
+        CHECK_TRUE(io->open(url, IOAdapterMode_Read), "can't open the gzip file");
+        readAll(io.data());
+    }
+    GZipIndex index;
+    CHECK_TRUE(GZipIndex::load(url, index), "the index is not stored");
+
+    // the file is replaced with other data, the old index must not be used for it
+    const QByteArray newData = generateData(MEMBER_SIZE + 1000, 5);
+    CHECK_TRUE(writeMultiMemberFile(url, QList<QByteArray>() << newData), "can't rewrite the gzip file");
+    CHECK_FALSE(GZipIndex::load(url, index), "the stale index is loaded");
+
+    QScopedPointer<IOAdapter> io(createGzipAdapter());
+    CHECK_TRUE(io->open(url, IOAdapterMode_Read), "can't open the gzip file");
+    CHECK_FALSE(qobject_cast<ZlibAdapter*>(io.data())->hasIndex(), "the stale index is used");
+    CHECK_TRUE(newData == readAll(io.data()), "the read data differs from the written one");
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, skipAcrossMembers) {
+    const QString url = QDir::temp().absoluteFilePath("zlib-adapter-skip.gz");
+    GzipFileCleaner cleaner(url);
+    const QByteArray data1 = generateData(1000, 6);
+    const QByteArray data2 = generateData(MEMBER_SIZE, 7);
+    const QByteArray data = data1 + data2;
+    CHECK_TRUE(writeMultiMemberFile(url, QList<QByteArray>() << data1 << data2), "can't write the gzip file");
+
+    QScopedPointer<IOAdapter> io(createGzipAdapter());
+    CHECK_TRUE(io->open(url, IOAdapterMode_Read), "can't open the gzip file");
+    CHECK_TRUE(io->skip(5000), "can't skip over the member end");
+    CHECK_EQUAL(5000, io->bytesRead(), "position after skip");
+    char c = 0;
+    CHECK_TRUE(io->getChar(&c), "can't read after skip");
+    CHECK_EQUAL(data[5000], c, "char after skip");
+}
+
+} // namespace U2
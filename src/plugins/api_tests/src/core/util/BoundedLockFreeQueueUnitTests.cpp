@@ -0,0 +1,142 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QThread>
+
+#include <U2Core/BoundedLockFreeQueue.h>
+
+#include "BoundedLockFreeQueueUnitTests.h"
+
+namespace U2 {
+
+namespace {
+
+class QueueProducer : public QThread {
+public:
+    QueueProducer(BoundedLockFreeQueue<int> &queue, int count)
+        : queue(queue), count(count) {}
+
+    void run() {
+        for (int i = 1; i <= count; i++) {
+            while (!queue.tryPush(i)) {
+                yieldCurrentThread();
+            }
+        }
+    }
+
+private:
+    BoundedLockFreeQueue<int> &queue;
+    int count;
+};
+
+class QueueConsumer : public QThread {
+public:
+    QueueConsumer(BoundedLockFreeQueue<int> &queue, QAtomicInt &leftToPop)
+        : queue(queue), leftToPop(leftToPop), sum(0) {}
+
+    void run() {
+        int value = 0;
+        while (leftToPop.load() > 0) {
+            if (queue.tryPop(value)) {
+                sum += value;
+                leftToPop.deref();
+            } else {
+                yieldCurrentThread();
+            }
+        }
+    }
+
+    qint64 getSum() const {
+        return sum;
+    }
+
+private:
+    BoundedLockFreeQueue<int> &queue;
+    QAtomicInt &leftToPop;
+    qint64 sum;
+};
+
+}
+
+IMPLEMENT_TEST(BoundedLockFreeQueueUnitTests, fifoOrder) {
+    BoundedLockFreeQueue<int> queue(8);
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 6; i++) {
+            CHECK_TRUE(queue.tryPush(round * 10 + i), "push failed");
+        }
+        int value = -1;
+        for (int i = 0; i < 6; i++) {
+            CHECK_TRUE(queue.tryPop(value), "pop failed");
+            CHECK_EQUAL(round * 10 + i, value, "popped value");
+        }
+    }
+    CHECK_TRUE(queue.isEmpty(), "queue is not empty");
+}
+
+IMPLEMENT_TEST(BoundedLockFreeQueueUnitTests, fullAndEmpty) {
+    BoundedLockFreeQueue<int> queue(5);
+    CHECK_EQUAL(8, queue.getCapacity(), "capacity");
+
+    int value = -1;
+    CHECK_FALSE(queue.tryPop(value), "popped from the empty queue");
+    for (int i = 0; i < queue.getCapacity(); i++) {
+        CHECK_TRUE(queue.tryPush(i), "push failed");
+    }
+    CHECK_FALSE(queue.tryPush(100), "pushed to the full queue");
+
+    CHECK_TRUE(queue.tryPop(value), "pop failed");
+    CHECK_EQUAL(0, value, "popped value");
+    CHECK_TRUE(queue.tryPush(100), "push after pop failed");
+}
+
+IMPLEMENT_TEST(BoundedLockFreeQueueUnitTests, concurrentProducersAndConsumers) {
+    const int threadsCount = 4;
+    const int valuesCount = 100000;
+    BoundedLockFreeQueue<int> queue(64);
+    QAtomicInt leftToPop(threadsCount * valuesCount);
+
+    QList<QueueProducer *> producers;
+    QList<QueueConsumer *> consumers;
+    for (int i = 0; i < threadsCount; i++) {
+        producers << new QueueProducer(queue, valuesCount);
+        consumers << new QueueConsumer(queue, leftToPop);
+    }
+    for (int i = 0; i < threadsCount; i++) {
+        consumers[i]->start();
+        producers[i]->start();
+    }
+
+    qint64 sum = 0;
+    for (int i = 0; i < threadsCount; i++) {
+        producers[i]->wait();
+        consumers[i]->wait();
+        sum += consumers[i]->getSum();
+    }
+    qDeleteAll(producers);
+    qDeleteAll(consumers);
+
+    const qint64 expectedSum = qint64(threadsCount) * valuesCount * (valuesCount + 1) / 2;
+    CHECK_EQUAL(expectedSum, sum, "sum of popped values");
+    CHECK_TRUE(queue.isEmpty(), "queue is not empty");
+}
+
+} // namespace U2
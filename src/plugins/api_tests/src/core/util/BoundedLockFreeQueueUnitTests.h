@@ -0,0 +1,40 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_BOUNDED_LOCK_FREE_QUEUE_UNIT_TESTS_H_
+#define _U2_BOUNDED_LOCK_FREE_QUEUE_UNIT_TESTS_H_
+
+#include <unittest.h>
+
+namespace U2 {
+
+DECLARE_TEST(BoundedLockFreeQueueUnitTests, fifoOrder);
+DECLARE_TEST(BoundedLockFreeQueueUnitTests, fullAndEmpty);
+DECLARE_TEST(BoundedLockFreeQueueUnitTests, concurrentProducersAndConsumers);
+
+} // namespace U2
+
+DECLARE_METATYPE(BoundedLockFreeQueueUnitTests, fifoOrder);
+DECLARE_METATYPE(BoundedLockFreeQueueUnitTests, fullAndEmpty);
+DECLARE_METATYPE(BoundedLockFreeQueueUnitTests, concurrentProducersAndConsumers);
+
+#endif // _U2_BOUNDED_LOCK_FREE_QUEUE_UNIT_TESTS_H_
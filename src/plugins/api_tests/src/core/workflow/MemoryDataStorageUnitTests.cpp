@@ -0,0 +1,133 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/AppContext.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/U2OpStatusUtils.h>
+
+#include <U2Lang/MemoryDataStorage.h>
+
+#include "MemoryDataStorageUnitTests.h"
+
+namespace U2 {
+
+using namespace Workflow;
+
+namespace {
+
+DNASequence createSequence(const QString &name, const QByteArray &data) {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    return DNASequence(name, data, alphabet);
+}
+
+}
+
+IMPLEMENT_TEST(MemoryDataStorageUnitTests, getSequence_inMemory) {
+    MemoryDataStorage storage(1024 * 1024);
+    CHECK_TRUE(storage.init(), "storage is not initialized");
+
+    SharedDbiDataHandler handler = storage.putSequence(createSequence("seq", "ACGTNACGT"));
+    CHECK_TRUE(NULL != handler.constData(), "NULL handler");
+    CHECK_TRUE(handler->isValid(), "invalid handler");
+    CHECK_TRUE(storage.getUsedMemory() > 0, "the sequence is not in memory");
+
+    U2OpStatusImpl os;
+    DNASequence sequence = StorageUtils::getSequence(&storage, handler, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL("seq", sequence.getName(), "sequence name");
+    CHECK_EQUAL("ACGTNACGT", QString(sequence.seq), "sequence data");
+    CHECK_TRUE(storage.getUsedMemory() > 0, "the sequence is imported");
+}
+
+IMPLEMENT_TEST(MemoryDataStorageUnitTests, getSequenceObject_imports) {
+    MemoryDataStorage storage(1024 * 1024);
+    CHECK_TRUE(storage.init(), "storage is not initialized");
+
+    SharedDbiDataHandler handler = storage.putSequence(createSequence("seq", "ACGTNACGT"));
+    QScopedPointer<U2SequenceObject> seqObj(StorageUtils::getSequenceObject(&storage, handler));
+    CHECK_TRUE(NULL != seqObj.data(), "NULL sequence object");
+    CHECK_EQUAL(0, storage.getUsedMemory(), "used memory");
+
+    U2OpStatusImpl os;
+    CHECK_EQUAL("ACGTNACGT", QString(seqObj->getWholeSequenceData(os)), "sequence object data");
+    CHECK_NO_ERROR(os);
+
+    DNASequence sequence = StorageUtils::getSequence(&storage, handler, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL("ACGTNACGT", QString(sequence.seq), "sequence data");
+}
+
+IMPLEMENT_TEST(MemoryDataStorageUnitTests, putSequence_overLimit) {
+    // every sequence takes 8 bytes of data and 2 bytes of the name
+    MemoryDataStorage storage(20);
+    CHECK_TRUE(storage.init(), "storage is not initialized");
+
+    QList<SharedDbiDataHandler> handlers;
+    handlers << storage.putSequence(createSequence("1", "AAAAAAAA"));
+    handlers << storage.putSequence(createSequence("2", "CCCCCCCC"));
+    CHECK_EQUAL(20, storage.getUsedMemory(), "used memory");
+
+    handlers << storage.putSequence(createSequence("3", "GGGGGGGG"));
+    CHECK_EQUAL(20, storage.getUsedMemory(), "used memory");
+
+    const QStringList expected = QStringList() << "AAAAAAAA" << "CCCCCCCC" << "GGGGGGGG";
+    for (int i = 0; i < handlers.size(); i++) {
+        U2OpStatusImpl os;
+        DNASequence sequence = StorageUtils::getSequence(&storage, handlers[i], os);
+        CHECK_NO_ERROR(os);
+        CHECK_EQUAL(expected[i], QString(sequence.seq), "sequence data");
+    }
+}
+
+IMPLEMENT_TEST(MemoryDataStorageUnitTests, handler_release) {
+    MemoryDataStorage storage(1024 * 1024);
+    CHECK_TRUE(storage.init(), "storage is not initialized");
+
+    SharedDbiDataHandler handler = storage.putSequence(createSequence("seq", "ACGT"));
+    SharedDbiDataHandler copy = handler;
+    CHECK_TRUE(handler->equals(copy.constData()), "copies are not equal");
+
+    handler = SharedDbiDataHandler();
+    CHECK_TRUE(storage.getUsedMemory() > 0, "the sequence is released while it has a reference");
+
+    copy = SharedDbiDataHandler();
+    CHECK_EQUAL(0, storage.getUsedMemory(), "used memory");
+}
+
+IMPLEMENT_TEST(MemoryDataStorageUnitTests, entityRef_published) {
+    MemoryDataStorage storage(1024 * 1024);
+    CHECK_TRUE(storage.init(), "storage is not initialized");
+
+    SharedDbiDataHandler handler = storage.putSequence(createSequence("seq", "ACGT"));
+    CHECK_TRUE(handler->getEntityRef().entityId.isEmpty(), "the sequence is imported on putting");
+
+    QScopedPointer<U2SequenceObject> seqObj(StorageUtils::getSequenceObject(&storage, handler));
+    CHECK_TRUE(NULL != seqObj.data(), "NULL sequence object");
+    const U2EntityRef entityRef = handler->getEntityRef();
+    CHECK_TRUE(entityRef.isValid(), "the entity id is not published");
+    CHECK_TRUE(entityRef == seqObj->getEntityRef(), "entity reference");
+
+    QScopedPointer<U2SequenceObject> seqObj2(StorageUtils::getSequenceObject(&storage, handler));
+    CHECK_TRUE(NULL != seqObj2.data(), "NULL sequence object");
+    CHECK_TRUE(entityRef == handler->getEntityRef(), "the sequence is imported twice");
+}
+
+} // namespace U2
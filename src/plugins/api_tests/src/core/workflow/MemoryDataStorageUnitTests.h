@@ -0,0 +1,43 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MEMORY_DATA_STORAGE_UNIT_TESTS_H_
+#define _U2_MEMORY_DATA_STORAGE_UNIT_TESTS_H_
+
+#include <unittest.h>
+
+namespace U2 {
+
+DECLARE_TEST(MemoryDataStorageUnitTests, getSequence_inMemory);
+DECLARE_TEST(MemoryDataStorageUnitTests, getSequenceObject_imports);
+DECLARE_TEST(MemoryDataStorageUnitTests, putSequence_overLimit);
+DECLARE_TEST(MemoryDataStorageUnitTests, handler_release);
+DECLARE_TEST(MemoryDataStorageUnitTests, entityRef_published);
+
+} // namespace U2
+
+DECLARE_METATYPE(MemoryDataStorageUnitTests, getSequence_inMemory);
+DECLARE_METATYPE(MemoryDataStorageUnitTests, getSequenceObject_imports);
+DECLARE_METATYPE(MemoryDataStorageUnitTests, putSequence_overLimit);
+DECLARE_METATYPE(MemoryDataStorageUnitTests, handler_release);
+DECLARE_METATYPE(MemoryDataStorageUnitTests, entityRef_published);
+
+#endif // _U2_MEMORY_DATA_STORAGE_UNIT_TESTS_H_
@@ -7,6 +7,7 @@ HEADERS += src/Alignment.h \
            src/BAMDbiPlugin.h \
            src/BAMFormat.h \
            src/BgzfReader.h \
+           src/BgzfTests.h \
            src/BgzfWriter.h \
            src/CancelledException.h \
            src/CigarValidator.h \
@@ -31,6 +32,7 @@ SOURCES += src/Alignment.cpp \
            src/BAMDbiPlugin.cpp \
            src/BAMFormat.cpp \
            src/BgzfReader.cpp \
+           src/BgzfTests.cpp \
            src/BgzfWriter.cpp \
            src/CancelledException.cpp \
            src/CigarValidator.cpp \
@@ -33,6 +33,7 @@
 #include <U2Core/CloneObjectTask.h>
 #include <U2Core/DbiDocumentFormat.h>
 #include <U2Core/DocumentUtils.h>
+#include <U2Core/GAutoDeleteList.h>
 #include <U2Core/GUrlUtils.h>
 #include <U2Core/IOAdapter.h>
 #include <U2Core/IOAdapterUtils.h>
@@ -53,8 +54,12 @@
 #include <U2Gui/OpenViewTask.h>
 #include <U2Core/QObjectScopedPointer.h>
 
+#include <U2Test/GTestFrameworkComponents.h>
+#include <U2Test/XMLTestFormat.h>
+
 #include "BAMDbiPlugin.h"
 #include "BAMFormat.h"
+#include "BgzfTests.h"
 #include "ConvertToSQLiteDialog.h"
 #include "ConvertToSQLiteTask.h"
 #include "Dbi.h"
@@ -77,6 +82,18 @@ BAMDbiPlugin::BAMDbiPlugin() : Plugin(tr("BAM format support"), tr("Interface fo
     AppContext::getDbiRegistry()->registerDbiFactory(new SamtoolsBasedDbiFactory());
 
     AppContext::getDocumentFormatRegistry()->getImportSupport()->addDocumentImporter(new BAMImporter());
+
+    // BGZF tests
+    GTestFormatRegistry *tfr = AppContext::getTestFramework()->getTestFormatRegistry();
+    XMLTestFormat *xmlTestFormat = qobject_cast<XMLTestFormat *>(tfr->findFormat("XML"));
+    SAFE_POINT(NULL != xmlTestFormat, "XML test format is not registered", );
+
+    GAutoDeleteList<XMLTestFactory> *l = new GAutoDeleteList<XMLTestFactory>(this);
+    l->qlist = BgzfTests::createTestFactories();
+    foreach (XMLTestFactory *f, l->qlist) {
+        bool res = xmlTestFormat->registerTestFactory(f);
+        SAFE_POINT(res, "Can't register the XML test factory", );
+    }
 }
 
 
@@ -19,6 +19,8 @@
  * MA 02110-1301, USA.
  */
 
+#include <QtCore/QtEndian>
+
 #include "BAMDbiPlugin.h"
 #include "IOException.h"
 #include "InvalidFormatException.h"
@@ -27,10 +29,174 @@
 namespace U2 {
 namespace BAM {
 
-BgzfReader::BgzfReader(IOAdapter &ioAdapter):
+namespace {
+
+// gzip header with the BGZF extra subfield
+const int BGZF_HEADER_SIZE = 18;
+// CRC32 and ISIZE
+const int BGZF_FOOTER_SIZE = 8;
+const int BGZF_MAX_BLOCK_SIZE = 65536;
+const unsigned long CANCEL_CHECK_INTERVAL = 100;
+
+bool isBgzfHeader(const char *header) {
+    const uchar *h = (const uchar *)header;
+    return 31 == h[0] && 139 == h[1] && 8 == h[2] && 0 != (h[3] & 4)
+            && 6 == qFromLittleEndian<quint16>(h + 10)
+            && 'B' == h[12] && 'C' == h[13] && 2 == qFromLittleEndian<quint16>(h + 14);
+}
+
+}
+
+/************************************************************************/
+/* BgzfInflateTask */
+/************************************************************************/
+BgzfInflateTask::BgzfInflateTask(BgzfInflater *inflater):
+    Task(BAMDbiPlugin::tr("Decompress BGZF blocks"), TaskFlag_None),
+    inflater(inflater)
+{
+}
+
+void BgzfInflateTask::run() {
+    inflater->inflateBlocks(stateInfo);
+}
+
+/************************************************************************/
+/* BgzfInflater */
+/************************************************************************/
+BgzfInflater::BgzfInflater():
+    tasksCount(0),
+    stopped(false)
+{
+}
+
+BgzfInflater::~BgzfInflater() {
+    stop();
+}
+
+QList<Task *> BgzfInflater::createInflateTasks(int tasksCount) {
+    QList<Task *> tasks;
+    QMutexLocker locker(&lock);
+    if(stopped) {
+        return tasks;
+    }
+    for(int i = 0; i < tasksCount; i++) {
+        tasks << new BgzfInflateTask(this);
+    }
+    this->tasksCount += tasks.size();
+    return tasks;
+}
+
+void BgzfInflater::stop() {
+    QMutexLocker locker(&lock);
+    stopped = true;
+    jobAdded.wakeAll();
+}
+
+void BgzfInflater::inflateBlocks(TaskStateInfo &ti) {
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = Z_NULL;
+    stream.avail_in = 0;
+    if(Z_OK != inflateInit2(&stream, 16 + 15)) {
+        ti.setError(BAMDbiPlugin::tr("Can't initialize zlib"));
+        return;
+    }
+    while(true) {
+        Block *block = acquireJob(ti);
+        if(NULL == block) {
+            break;
+        }
+        inflateBlock(block, stream);
+
+        QMutexLocker locker(&lock);
+        block->ready = true;
+        blockInflated.wakeAll();
+    }
+    inflateEnd(&stream);
+}
+
+BgzfInflater::Block *BgzfInflater::acquireJob(TaskStateInfo &ti) {
+    QMutexLocker locker(&lock);
+    while(jobs.isEmpty() && !stopped && !ti.cancelFlag) {
+        // the task cancelation is not signaled: check it from time to time
+        jobAdded.wait(&lock, CANCEL_CHECK_INTERVAL);
+    }
+    if(stopped || ti.cancelFlag) {
+        return NULL;
+    }
+    return jobs.dequeue();
+}
+
+void BgzfInflater::addJob(Block *block) {
+    QMutexLocker locker(&lock);
+    jobs.enqueue(block);
+    jobAdded.wakeOne();
+}
+
+void BgzfInflater::waitForBlock(Block *block, z_stream &stream) {
+    QMutexLocker locker(&lock);
+    if(jobs.removeOne(block)) {
+        locker.unlock();
+        inflateBlock(block, stream);
+        block->ready = true;
+        return;
+    }
+    while(!block->ready) {
+        blockInflated.wait(&lock);
+    }
+}
+
+void BgzfInflater::dropJob(Block *block) {
+    QMutexLocker locker(&lock);
+    if(!jobs.removeOne(block)) {
+        while(!block->ready) {
+            blockInflated.wait(&lock);
+        }
+    }
+}
+
+int BgzfInflater::getTasksCount() {
+    QMutexLocker locker(&lock);
+    return tasksCount;
+}
+
+void BgzfInflater::inflateBlock(Block *block, z_stream &stream) {
+    const uchar *footer = (const uchar *)block->compressed.constData() + block->compressed.size() - BGZF_FOOTER_SIZE;
+    const quint32 size = qFromLittleEndian<quint32>(footer + 4);
+    if(size > (quint32)BGZF_MAX_BLOCK_SIZE) {
+        block->error = QString("invalid uncompressed block size %1").arg(size);
+    } else {
+        inflateReset(&stream);
+        // one extra byte lets zlib finish the empty blocks too
+        block->data.resize(size + 1);
+        stream.next_in = (Bytef *)block->compressed.data();
+        stream.avail_in = block->compressed.size();
+        stream.next_out = (Bytef *)block->data.data();
+        stream.avail_out = size + 1;
+        if((Z_STREAM_END != inflate(&stream, Z_FINISH)) || (1 != stream.avail_out)) {
+            block->error = QString("failed to decompress %1 bytes").arg(block->compressed.size());
+        }
+        block->data.resize(size);
+    }
+    block->compressed = QByteArray();
+}
+
+/************************************************************************/
+/* BgzfReader */
+/************************************************************************/
+BgzfReader::BgzfReader(IOAdapter &ioAdapter, BgzfInflater *inflater):
     ioAdapter(ioAdapter),
     headerOffset(ioAdapter.bytesRead()),
-    endOfFile(false)
+    endOfFile(false),
+    inflater(inflater),
+    readAheadMode(false),
+    inputEnd(false),
+    maxScheduledBlocks(0),
+    readAheadWindow(1),
+    currentBlock(NULL),
+    currentPos(0)
 {
     stream.zalloc = Z_NULL;
     stream.zfree = Z_NULL;
@@ -42,9 +208,16 @@ BgzfReader::BgzfReader(IOAdapter &ioAdapter):
     if(Z_OK != inflateInit2(&stream, 16 + 15)) {
         throw Exception(BAMDbiPlugin::tr("Can't initialize zlib"));
     }
+    if(NULL != inflater) {
+        readAheadMode = startReadAhead();
+    }
 }
 
 BgzfReader::~BgzfReader() {
+    if(readAheadMode) {
+        dropScheduledBlocks();
+        delete currentBlock;
+    }
     inflateEnd(&stream);
 }
 
@@ -52,6 +225,9 @@ qint64 BgzfReader::read(char *buff, qint64 maxSize) {
     if(0 == maxSize) {
         return 0;
     }
+    if(readAheadMode) {
+        return readAhead(buff, maxSize);
+    }
     stream.next_out = (Bytef *)buff;
     stream.avail_out = maxSize;
     while(stream.avail_out > 0) {
@@ -107,10 +283,17 @@ bool BgzfReader::isEof()const {
 }
 
 VirtualOffset BgzfReader::getOffset()const {
+    if(readAheadMode) {
+        return VirtualOffset(headerOffset, currentPos);
+    }
     return VirtualOffset(headerOffset, stream.total_out);
 }
 
 void BgzfReader::seek(VirtualOffset offset) {
+    if(readAheadMode) {
+        seekAhead(offset);
+        return;
+    }
     if((offset.getCoffset() == headerOffset) && (offset.getUoffset() >= (int)stream.total_out)) {
         qint64 toSkip = offset.getUoffset() - stream.total_out;
         if(skip(toSkip) < toSkip) {
@@ -182,5 +365,200 @@ void BgzfReader::nextBlock() {
     stream.avail_out = oldAvailOut;
 }
 
+qint64 BgzfReader::readAhead(char *buff, qint64 maxSize) {
+    qint64 bytesRead = 0;
+    while(bytesRead < maxSize) {
+        if(!takeCurrentBlock()) {
+            endOfFile = true;
+            break;
+        }
+        qint64 toCopy = qMin(maxSize - bytesRead, (qint64)(currentBlock->data.size() - currentPos));
+        memcpy(buff + bytesRead, currentBlock->data.constData() + currentPos, toCopy);
+        currentPos += toCopy;
+        bytesRead += toCopy;
+        if(currentBlock->data.size() == currentPos) {
+            releaseCurrentBlock();
+        }
+    }
+    // the offset points to the next block and the end of file is detected as soon as possible, like in the sequential mode
+    if((NULL == currentBlock) && !takeCurrentBlock()) {
+        endOfFile = true;
+    }
+    return bytesRead;
+}
+
+void BgzfReader::seekAhead(VirtualOffset offset) {
+    if((NULL != currentBlock) && (currentBlock->coffset != offset.getCoffset())) {
+        releaseCurrentBlock();
+    }
+    if(NULL == currentBlock) {
+        bool scheduled = false;
+        foreach(Block *block, scheduledBlocks) {
+            if(block->coffset == offset.getCoffset()) {
+                scheduled = true;
+                break;
+            }
+        }
+        if(scheduled) {
+            while(scheduledBlocks.head()->coffset != offset.getCoffset()) {
+                dropScheduledBlock();
+            }
+        } else {
+            dropScheduledBlocks();
+            // a random seek should not inflate the blocks that may be never read
+            readAheadWindow = 1;
+            qint64 toSkipIo = offset.getCoffset() - ioAdapter.bytesRead();
+            if(!ioAdapter.skip(toSkipIo)) {
+                coreLog.error(QString("in BgzfReader::seekAhead, cannot seek to offset {coffset=%1,uoffset=%2}, ioAdapter failed to skip %3")
+                              .arg(offset.getCoffset())
+                              .arg(offset.getUoffset())
+                              .arg(toSkipIo));
+                throw IOException(BAMDbiPlugin::tr("Can't read input"));
+            }
+            inputEnd = false;
+        }
+        headerOffset = offset.getCoffset();
+        takeCurrentBlock();
+    }
+    int blockSize = (NULL == currentBlock) ? 0 : currentBlock->data.size();
+    if(offset.getUoffset() > blockSize) {
+        coreLog.error(QString("in BgzfReader::seekAhead, cannot seek to offset {coffset=%1,uoffset=%2}, the block size is %3")
+                      .arg(offset.getCoffset())
+                      .arg(offset.getUoffset())
+                      .arg(blockSize));
+        throw InvalidFormatException(BAMDbiPlugin::tr("Unexpected end of file"));
+    }
+    currentPos = offset.getUoffset();
+    endOfFile = false;
+    if((NULL != currentBlock) && (blockSize == currentPos)) {
+        releaseCurrentBlock();
+        endOfFile = !takeCurrentBlock();
+    }
+}
+
+bool BgzfReader::startReadAhead() {
+    char header[BGZF_HEADER_SIZE];
+    qint64 headerRead = 0;
+    while(headerRead < BGZF_HEADER_SIZE) {
+        qint64 returnedValue = ioAdapter.readBlock(header + headerRead, BGZF_HEADER_SIZE - headerRead);
+        if(returnedValue <= 0) {
+            break;
+        }
+        headerRead += returnedValue;
+    }
+    if((headerRead > 0) && !ioAdapter.skip(-headerRead)) {
+        coreLog.error(QString("in BgzfReader::startReadAhead, ioAdapter failed to skip back %1 bytes").arg(headerRead));
+        throw IOException(BAMDbiPlugin::tr("Can't read input"));
+    }
+    if((BGZF_HEADER_SIZE != headerRead) || !isBgzfHeader(header)) {
+        return false;
+    }
+
+    maxScheduledBlocks = BLOCKS_PER_TASK * inflater->getTasksCount();
+    return maxScheduledBlocks > 0;
+}
+
+void BgzfReader::scheduleBlocks() {
+    while(!inputEnd && (scheduledBlocks.size() < readAheadWindow)) {
+        Block *block = readCompressedBlock();
+        if(NULL == block) {
+            inputEnd = true;
+            break;
+        }
+        scheduledBlocks.enqueue(block);
+        inflater->addJob(block);
+    }
+}
+
+BgzfReader::Block *BgzfReader::readCompressedBlock() {
+    Block *block = new Block(ioAdapter.bytesRead());
+    block->compressed.resize(BGZF_HEADER_SIZE);
+    qint64 blockSize = BGZF_HEADER_SIZE;
+    qint64 bytesRead = 0;
+    while(bytesRead < blockSize) {
+        qint64 returnedValue = ioAdapter.readBlock(block->compressed.data() + bytesRead, blockSize - bytesRead);
+        if(-1 == returnedValue) {
+            coreLog.error(QString("in BgzfReader::readCompressedBlock, failed to read %1 bytes from ioAdapter, after %2 bytes already read. %3")
+                          .arg(blockSize - bytesRead)
+                          .arg(ioAdapter.bytesRead())
+                          .arg(ioAdapter.errorString()));
+            delete block;
+            throw IOException(BAMDbiPlugin::tr("Can't read input"));
+        } else if(0 == returnedValue) {
+            break;
+        }
+        bytesRead += returnedValue;
+        if((BGZF_HEADER_SIZE == bytesRead) && (BGZF_HEADER_SIZE == blockSize)) {
+            if(!isBgzfHeader(block->compressed.constData())) {
+                coreLog.error(QString("in BgzfReader::readCompressedBlock, invalid BGZF block header at offset %1").arg(block->coffset));
+                delete block;
+                throw InvalidFormatException(BAMDbiPlugin::tr("Can't decompress data"));
+            }
+            blockSize = qFromLittleEndian<quint16>((const uchar *)block->compressed.constData() + 16) + 1;
+            if(blockSize < BGZF_HEADER_SIZE + BGZF_FOOTER_SIZE) {
+                coreLog.error(QString("in BgzfReader::readCompressedBlock, invalid BGZF block size %1 at offset %2").arg(blockSize).arg(block->coffset));
+                delete block;
+                throw InvalidFormatException(BAMDbiPlugin::tr("Can't decompress data"));
+            }
+            block->compressed.resize(blockSize);
+        }
+    }
+    if(0 == bytesRead) {
+        delete block;
+        return NULL;
+    }
+    if(bytesRead < blockSize) {
+        coreLog.error(QString("in BgzfReader::readCompressedBlock, the block at offset %1 is truncated").arg(block->coffset));
+        delete block;
+        throw InvalidFormatException(BAMDbiPlugin::tr("Unexpected end of file"));
+    }
+    block->compressedSize = blockSize;
+    return block;
+}
+
+bool BgzfReader::takeCurrentBlock() {
+    while(NULL == currentBlock) {
+        scheduleBlocks();
+        if(scheduledBlocks.isEmpty()) {
+            return false;
+        }
+        Block *block = scheduledBlocks.dequeue();
+        readAheadWindow = qMin(2 * readAheadWindow, maxScheduledBlocks);
+        scheduleBlocks();
+        inflater->waitForBlock(block, stream);
+        headerOffset = block->coffset;
+        if(!block->error.isEmpty()) {
+            coreLog.error(QString("in BgzfReader::takeCurrentBlock, %1 at offset %2").arg(block->error).arg(block->coffset));
+            delete block;
+            throw InvalidFormatException(BAMDbiPlugin::tr("Can't decompress data"));
+        }
+        currentBlock = block;
+        currentPos = 0;
+        if(currentBlock->data.isEmpty()) {
+            releaseCurrentBlock();
+        }
+    }
+    return true;
+}
+
+void BgzfReader::releaseCurrentBlock() {
+    headerOffset = currentBlock->coffset + currentBlock->compressedSize;
+    delete currentBlock;
+    currentBlock = NULL;
+    currentPos = 0;
+}
+
+void BgzfReader::dropScheduledBlock() {
+    Block *block = scheduledBlocks.dequeue();
+    inflater->dropJob(block);
+    delete block;
+}
+
+void BgzfReader::dropScheduledBlocks() {
+    while(!scheduledBlocks.isEmpty()) {
+        dropScheduledBlock();
+    }
+}
+
 } // namespace BAM
 } // namespace U2
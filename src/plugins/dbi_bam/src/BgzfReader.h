@@ -22,18 +22,95 @@
 #ifndef _U2_BAM_BGZF_READER_H_
 #define _U2_BAM_BGZF_READER_H_
 
+#include <QtCore/QMutex>
+#include <QtCore/QQueue>
+#include <QtCore/QWaitCondition>
+
 #include <3rdparty/zlib/zlib.h>
 
 #include <U2Core/IOAdapter.h>
+#include <U2Core/Task.h>
 #include "VirtualOffset.h"
 
 namespace U2 {
 namespace BAM {
 
+class BgzfInflater;
+
+/** Inflates the blocks of the inflater until it is stopped or the task is canceled */
+class BgzfInflateTask : public Task {
+    Q_OBJECT
+public:
+    BgzfInflateTask(BgzfInflater *inflater);
+    void run();
+
+private:
+    BgzfInflater *inflater;
+};
+
+/**
+ * The queue of the BGZF blocks that are inflated in advance for the readers.
+ * The blocks are inflated by the tasks from createInflateTasks(), that are run by the task scheduler.
+ * If a block is needed by the reader before any task has taken it, e.g. all threads are busy,
+ * the block is inflated by the reader itself. One inflater can serve several readers one after another.
+ */
+class BgzfInflater {
+    friend class BgzfInflateTask;
+    friend class BgzfReader;
+public:
+    BgzfInflater();
+    /** The inflate tasks must be finished before the inflater is deleted */
+    ~BgzfInflater();
+
+    /** Creates the tasks to inflate the blocks in advance, the caller takes the ownership */
+    QList<Task *> createInflateTasks(int tasksCount);
+
+    /** Stops the inflate tasks, the rest blocks are inflated by the readers */
+    void stop();
+
+private:
+    struct Block {
+        Block(quint64 coffset) : coffset(coffset), compressedSize(0), ready(false) {}
+
+        quint64 coffset;
+        int compressedSize;
+        QByteArray compressed;
+        QByteArray data;
+        QString error;
+        bool ready;
+    };
+
+    void inflateBlocks(TaskStateInfo &ti);
+    Block *acquireJob(TaskStateInfo &ti);
+    void addJob(Block *block);
+    /** Waits for the block to be inflated or inflates it with @stream if no task has taken it */
+    void waitForBlock(Block *block, z_stream &stream);
+    /** Waits for the block if it is being inflated, the block must be deleted by the caller */
+    void dropJob(Block *block);
+    int getTasksCount();
+
+    static void inflateBlock(Block *block, z_stream &stream);
+
+    int tasksCount;
+    bool stopped;
+    QQueue<Block *> jobs;
+    QMutex lock;
+    QWaitCondition jobAdded;
+    QWaitCondition blockInflated;
+};
+
+/**
+ * Reads the BGZF compressed data.
+ * If the inflater with inflate tasks is given, the reader works in the read-ahead mode: the compressed blocks
+ * are read and split by their BGZF headers in the caller thread, inflated by the inflater tasks
+ * and consumed in the file order. The read-ahead window starts from one block after every seek
+ * out of the scheduled blocks and doubles with every block consumed in order.
+ * The file falls back to the sequential mode if its first block has no BGZF block size field.
+ */
 class BgzfReader
 {
 public:
-    BgzfReader(IOAdapter &ioAdapter);
+    BgzfReader(IOAdapter &ioAdapter, BgzfInflater *inflater = NULL);
     ~BgzfReader();
 
     qint64 read(char *buff, qint64 maxSize);
@@ -44,14 +121,39 @@ public:
     VirtualOffset getOffset()const;
     void seek(VirtualOffset offset);
 private:
+    typedef BgzfInflater::Block Block;
+
     void nextBlock();
 
+    // Read-ahead mode
+    qint64 readAhead(char *buff, qint64 maxSize);
+    void seekAhead(VirtualOffset offset);
+    bool startReadAhead();
+    void scheduleBlocks();
+    /** Returns NULL if the file is over */
+    Block *readCompressedBlock();
+    /** Waits for the next non-empty block, returns false if the file is over */
+    bool takeCurrentBlock();
+    void releaseCurrentBlock();
+    void dropScheduledBlock();
+    void dropScheduledBlocks();
+
     static const int BUFFER_SIZE = 16384;
+    static const int BLOCKS_PER_TASK = 4;
     IOAdapter &ioAdapter;
     z_stream stream;
     char buffer[BUFFER_SIZE];
     quint64 headerOffset;
     bool endOfFile;
+
+    BgzfInflater *inflater;
+    bool readAheadMode;
+    bool inputEnd;
+    int maxScheduledBlocks;
+    int readAheadWindow;
+    Block *currentBlock;
+    int currentPos;
+    QQueue<Block *> scheduledBlocks;
 };
 
 } // namespace BAM
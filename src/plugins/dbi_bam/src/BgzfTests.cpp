@@ -0,0 +1,173 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QtCore/QFile>
+#include <QtCore/QScopedPointer>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/IOAdapter.h>
+#include <U2Core/U2Region.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "BgzfReader.h"
+#include "BgzfTests.h"
+#include "BgzfWriter.h"
+#include "Exception.h"
+
+namespace U2 {
+namespace BAM {
+
+#define SIZE_ATTR       "size"
+#define TASKS_ATTR      "tasks"
+#define SEED_ATTR       "seed"
+
+namespace {
+
+IOAdapter * openFile(const QString &url, IOAdapterMode mode, U2OpStatus &os) {
+    IOAdapterFactory *factory = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::LOCAL_FILE);
+    SAFE_POINT_EXT(NULL != factory, os.setError("No local file IO adapter"), NULL);
+    IOAdapter *io = factory->createIOAdapter();
+    if (!io->open(url, mode)) {
+        delete io;
+        os.setError(QString("Can't open file: %1").arg(url));
+        return NULL;
+    }
+    return io;
+}
+
+}
+
+void GTest_BgzfReadAhead::init(XMLTestFormat *tf, const QDomElement &el) {
+    Q_UNUSED(tf);
+
+    bool ok = true;
+    dataSize = el.attribute(SIZE_ATTR, "1000000").toInt(&ok);
+    CHECK_EXT(ok && dataSize > 0, stateInfo.setError(GTest::tr("value incorrect for %1").arg(SIZE_ATTR)), );
+    tasksCount = el.attribute(TASKS_ATTR, "4").toInt(&ok);
+    CHECK_EXT(ok && tasksCount > 0, stateInfo.setError(GTest::tr("value incorrect for %1").arg(TASKS_ATTR)), );
+    seed = el.attribute(SEED_ATTR, "1").toULongLong(&ok);
+    CHECK_EXT(ok && 0 != seed, stateInfo.setError(GTest::tr("value incorrect for %1").arg(SEED_ATTR)), );
+
+    url = env->getVar("TEMP_DATA_DIR") + QString("/bgzf_read_ahead_%1.gz").arg(seed);
+}
+
+GTest_BgzfReadAhead::~GTest_BgzfReadAhead() {
+}
+
+void GTest_BgzfReadAhead::prepare() {
+    inflater.reset(new BgzfInflater());
+    foreach (Task *task, inflater->createInflateTasks(tasksCount)) {
+        addSubTask(task);
+    }
+}
+
+void GTest_BgzfReadAhead::run() {
+    checkReadAhead();
+    inflater->stop();
+}
+
+void GTest_BgzfReadAhead::checkReadAhead() {
+    quint64 state = seed;
+
+    // the repeated nucleotides give the blocks of different compressed sizes
+    QByteArray data(dataSize, 'A');
+    for (int i = 0; i < dataSize; i++) {
+        data[i] = (0 == XMLTestUtils::nextRandom(state) % 4) ? "ACGT"[XMLTestUtils::nextRandom(state) % 4] : data[qMax(0, i - 1)];
+    }
+
+    QList<VirtualOffset> chunkOffsets;
+    QList<U2Region> chunks;
+    try {
+        QScopedPointer<IOAdapter> io(openFile(url, IOAdapterMode_Write, stateInfo));
+        CHECK_OP(stateInfo, );
+        BgzfWriter writer(*io);
+        for (int pos = 0; pos < dataSize; ) {
+            const int length = qMin(dataSize - pos, 1 + int(XMLTestUtils::nextRandom(state) % 20000));
+            chunkOffsets << writer.getOffset();
+            chunks << U2Region(pos, length);
+            writer.write(data.constData() + pos, length);
+            pos += length;
+        }
+        writer.finish();
+    } catch (const Exception &e) {
+        setError(QString("Can't write the data: %1").arg(e.getMessage()));
+        return;
+    }
+
+    try {
+        QScopedPointer<IOAdapter> io(openFile(url, IOAdapterMode_Read, stateInfo));
+        CHECK_OP(stateInfo, );
+        BgzfReader reader(*io, inflater.data());
+        QByteArray readData(dataSize + 1, 0);
+        qint64 bytesRead = 0;
+        while (bytesRead <= dataSize) {
+            qint64 read = reader.read(readData.data() + bytesRead, qMin(qint64(dataSize + 1) - bytesRead, qint64(1 + XMLTestUtils::nextRandom(state) % 30000)));
+            if (0 == read) {
+                break;
+            }
+            bytesRead += read;
+        }
+        CHECK_EXT(bytesRead == dataSize, setError(QString("Read %1 bytes instead of %2").arg(bytesRead).arg(dataSize)), );
+        readData.resize(dataSize);
+        CHECK_EXT(readData == data, setError("The data read in order is not equal to the written one"), );
+        CHECK_EXT(reader.isEof(), setError("The end of file is not detected"), );
+    } catch (const Exception &e) {
+        setError(QString("Can't read the data in order: %1").arg(e.getMessage()));
+        return;
+    }
+
+    try {
+        QScopedPointer<IOAdapter> io(openFile(url, IOAdapterMode_Read, stateInfo));
+        CHECK_OP(stateInfo, );
+        BgzfReader reader(*io, inflater.data());
+        for (int i = 0; i < chunks.size(); i++) {
+            const int chunkIdx = int(XMLTestUtils::nextRandom(state) % chunks.size());
+            const U2Region &chunk = chunks[chunkIdx];
+            reader.seek(chunkOffsets[chunkIdx]);
+            QByteArray chunkData(chunk.length, 0);
+            qint64 bytesRead = 0;
+            while (bytesRead < chunk.length) {
+                qint64 read = reader.read(chunkData.data() + bytesRead, chunk.length - bytesRead);
+                CHECK_EXT(read > 0, setError(QString("Unexpected end of file in the chunk %1").arg(chunk.toString())), );
+                bytesRead += read;
+            }
+            CHECK_EXT(chunkData == data.mid(chunk.startPos, chunk.length),
+                setError(QString("The chunk %1 read after seek is not equal to the written one").arg(chunk.toString())), );
+        }
+    } catch (const Exception &e) {
+        setError(QString("Can't read the data after seek: %1").arg(e.getMessage()));
+        return;
+    }
+}
+
+void GTest_BgzfReadAhead::cleanup() {
+    QFile::remove(url);
+}
+
+QList<XMLTestFactory *> BgzfTests::createTestFactories() {
+    QList<XMLTestFactory *> res;
+    res.append(GTest_BgzfReadAhead::createFactory());
+    return res;
+}
+
+} // namespace BAM
+} // namespace U2
@@ -0,0 +1,68 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_BAM_BGZF_TESTS_H_
+#define _U2_BAM_BGZF_TESTS_H_
+
+#include <QtCore/QScopedPointer>
+
+#include <U2Test/XMLTestUtils.h>
+
+namespace U2 {
+namespace BAM {
+
+class BgzfInflater;
+
+/**
+ * Writes random data with BgzfWriter and reads it back with BgzfReader in the read-ahead mode:
+ * the whole data in order and the chunks at their virtual offsets in random order
+ * must be equal to the written ones. The blocks are inflated by the subtasks of the test.
+ */
+class GTest_BgzfReadAhead : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_BgzfReadAhead, "bgzf-read-ahead", TaskFlags_RBSF_FOSCOE);
+
+    ~GTest_BgzfReadAhead();
+    void prepare();
+    void run();
+    void cleanup();
+
+private:
+    void checkReadAhead();
+
+    int dataSize;
+    int tasksCount;
+    quint64 seed;
+    QString url;
+    QScopedPointer<BgzfInflater> inflater;
+};
+
+class BgzfTests {
+public:
+    static QList<XMLTestFactory *> createTestFactories();
+};
+
+} // namespace BAM
+} // namespace U2
+
+#endif // _U2_BAM_BGZF_TESTS_H_
@@ -26,6 +26,8 @@
 #include <QScopedPointer>
 
 #include <U2Core/AppContext.h>
+#include <U2Core/AppResources.h>
+#include <U2Core/AppSettings.h>
 #include <U2Core/Counter.h>
 #include <U2Core/IOAdapterUtils.h>
 #include <U2Core/L10n.h>
@@ -36,6 +38,8 @@
 #include <U2Core/U2OpStatusUtils.h>
 #include <U2Core/U2SafePoints.h>
 
+#include <U2Formats/AssemblyPackAlgorithm.h>
+
 #include "BAMDbiPlugin.h"
 #include "CancelledException.h"
 #include "ConvertToSQLiteTask.h"
@@ -50,7 +54,7 @@ namespace U2 {
 namespace BAM {
 
 ConvertToSQLiteTask::ConvertToSQLiteTask(const GUrl &_sourceUrl, const U2DbiRef &dstDbiRef, BAMInfo& _bamInfo, bool _sam):
-    Task(tr("Convert BAM to UGENE database (%1)").arg(_sourceUrl.fileName()), TaskFlag_None),
+    Task(tr("Convert BAM to UGENE database (%1)").arg(_sourceUrl.fileName()), TaskFlag_RunBeforeSubtasksFinished),
     sourceUrl(_sourceUrl),
     dstDbiRef(dstDbiRef),
     bamInfo(_bamInfo),
@@ -60,6 +64,17 @@ ConvertToSQLiteTask::ConvertToSQLiteTask(const GUrl &_sourceUrl, const U2DbiRef
     tpm = Progress_Manual;
 }
 
+ConvertToSQLiteTask::~ConvertToSQLiteTask() {
+}
+
+void ConvertToSQLiteTask::prepare() {
+    CHECK(!sam, );
+    inflater.reset(new BgzfInflater());
+    foreach (Task *task, inflater->createInflateTasks(AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount())) {
+        addSubTask(task);
+    }
+}
+
 static void enableCoverageOnImport(U2AssemblyCoverageImportInfo &cii, int referenceLength) {
     cii.computeCoverage = true;
     int coverageInfoSize = qMin(U2AssemblyUtils::MAX_COVERAGE_VECTOR_SIZE, referenceLength);
@@ -432,6 +447,42 @@ private:
 
 static const int READS_CHUNK_SIZE = 250*1000;
 
+/**
+ * Assigns packed rows to the reads of one assembly while they come sorted by the leftmost position,
+ * so that the assembly doesn't need the separate packing pass.
+ */
+class OnlineReadsPacker {
+public:
+    OnlineReadsPacker() : sorted(true), prevLeftmostPos(0) {}
+
+    void pack(U2AssemblyRead &read, U2OpStatus &os) {
+        if (!sorted) {
+            return;
+        }
+        if (read->leftmostPos < prevLeftmostPos) {
+            sorted = false;
+            return;
+        }
+        prevLeftmostPos = read->leftmostPos;
+        read->effectiveLen = read->readSequence.length() + U2AssemblyUtils::getCigarExtraLength(read->cigar);
+        read->packedViewRow = AssemblyPackAlgorithm::packRead(U2Region(read->leftmostPos, read->effectiveLen), context, os);
+    }
+
+    /** If reads are not sorted, rows of the added reads are not valid: the assembly must be packed after the import */
+    bool isSorted() const {
+        return sorted;
+    }
+
+    int getMaxProw() const {
+        return context.maxProw;
+    }
+
+private:
+    bool sorted;
+    qint64 prevLeftmostPos;
+    PackAlgorithmContext context;
+};
+
 } // namespace
 
 void ConvertToSQLiteTask::run() {
@@ -443,6 +494,8 @@ void ConvertToSQLiteTask::run() {
         time_t startTime = time(0);
 
         qint64 totalReadsImported = importReads();
+        // the inflate tasks should not keep their threads while the reads are packed
+        stopInflating();
 
         time_t packStart = time(0);
         packReads();
@@ -485,6 +538,7 @@ void ConvertToSQLiteTask::run() {
             QFile::remove(getDestinationUrl().getURLString());
         }
     }
+    stopInflating();
 }
 
 GUrl ConvertToSQLiteTask::getDestinationUrl() const {
@@ -512,7 +566,7 @@ qint64 ConvertToSQLiteTask::importReads() {
         samReader = new SamReader(*ioAdapter);
         reader.reset(samReader);
     } else {
-        bamReader = new BamReader(*ioAdapter);
+        bamReader = new BamReader(*ioAdapter, inflater.data());
         reader.reset(bamReader);
     }
 
@@ -540,12 +594,21 @@ qint64 ConvertToSQLiteTask::importReads() {
     return totalReadsImported;
 }
 
+void ConvertToSQLiteTask::stopInflating() {
+    if (!inflater.isNull()) {
+        inflater->stop();
+    }
+}
+
 void ConvertToSQLiteTask::packReads() {
     stateInfo.setDescription("Packing reads");
 
     U2OpStatusImpl opStatus;
     foreach (int referenceId, importers.keys()) {
         SAFE_POINT_EXT(importers.contains(referenceId), throw Exception("An unexpected assembly"), );
+        if (importInfos[referenceId].packed) {
+            continue;
+        }
         taskLog.details(tr("Packing reads for assembly '%1' (%2 of %3)")
                         .arg(importers[referenceId]->getAssembly().visualName)
                         .arg(referenceId + 1)
@@ -745,6 +808,8 @@ qint64 ConvertToSQLiteTask::importReadsSequentially(Iterator *iterator) {
     qint64 totalReadsImported = 0;
 
     U2OpStatusImpl opStatus;
+    // the file order is unknown but the reads of each assembly are packed while they come sorted
+    QMap<int, OnlineReadsPacker> packers;
 
     while (iterator->hasNext()) {
         QMap<int, QList<U2AssemblyRead> > reads;
@@ -755,7 +820,9 @@ qint64 ConvertToSQLiteTask::importReadsSequentially(Iterator *iterator) {
             if ((-1 == referenceId && bamInfo.isUnmappedSelected()) ||
                     bamInfo.isReferenceSelected(referenceId)) {
                 U2AssemblyReadsImportInfo &importInfo = importInfos[referenceId];
-                reads[referenceId] << iterator->next();
+                U2AssemblyRead read = iterator->next();
+                packers[referenceId].pack(read, opStatus);
+                reads[referenceId] << read;
                 readCount++;
                 importInfo.nReads++;
             } else {
@@ -764,21 +831,41 @@ qint64 ConvertToSQLiteTask::importReadsSequentially(Iterator *iterator) {
         }
 
         CHECK_EXT(!isCanceled(), throw CancelledException(BAMDbiPlugin::tr("Task was cancelled")), totalReadsImported);
+        CHECK_EXT(!opStatus.isCoR(), throw Exception(opStatus.getError()), totalReadsImported);
 
-        flushReads(reads);
+        QSet<int> packedReferenceIds;
+        foreach (int referenceId, reads.keys()) {
+            if (packers[referenceId].isSorted()) {
+                packedReferenceIds << referenceId;
+            }
+        }
+        flushReads(reads, packedReferenceIds);
         CHECK_EXT(!opStatus.isCoR(), throw Exception(opStatus.getError()), totalReadsImported);
         totalReadsImported += readCount;
     }
 
+    foreach (int referenceId, packers.keys()) {
+        if (packers[referenceId].isSorted()) {
+            U2AssemblyReadsImportInfo &importInfo = importInfos[referenceId];
+            importInfo.packed = true;
+            importInfo.packStat.readsCount = importInfo.nReads;
+            importInfo.packStat.maxProw = packers[referenceId].getMaxProw();
+        }
+    }
+
     return totalReadsImported;
 }
 
-void ConvertToSQLiteTask::flushReads(const QMap<int, QList<U2AssemblyRead> > &reads) {
+void ConvertToSQLiteTask::flushReads(const QMap<int, QList<U2AssemblyRead> > &reads, const QSet<int> &packedReferenceIds) {
     foreach (int index, reads.keys()) {
         if (!reads[index].isEmpty()) {
             BufferedDbiIterator<U2AssemblyRead> readsIterator(reads[index]);
             SAFE_POINT_EXT(importers.contains(index), throw Exception("An unexpected assembly"), );
-            importers[index]->addReads(&readsIterator);
+            if (packedReferenceIds.contains(index)) {
+                importers[index]->addPackedReads(&readsIterator);
+            } else {
+                importers[index]->addReads(&readsIterator);
+            }
         }
     }
 }
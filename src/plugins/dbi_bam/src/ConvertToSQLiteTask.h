@@ -22,6 +22,9 @@
 #ifndef _U2_BAM_CONVERT_TO_SQLITE_TASK_H_
 #define _U2_BAM_CONVERT_TO_SQLITE_TASK_H_
 
+#include <QScopedPointer>
+#include <QSet>
+
 #include <U2Core/AssemblyImporter.h>
 #include <U2Core/GUrl.h>
 #include <U2Core/Task.h>
@@ -38,6 +41,7 @@ class IOAdapter;
 namespace BAM {
 
 class BamReader;
+class BgzfInflater;
 class Iterator;
 class Reader;
 class SamReader;
@@ -46,6 +50,8 @@ class ConvertToSQLiteTask : public Task {
     Q_OBJECT
 public:
     ConvertToSQLiteTask(const GUrl &sourceUrl, const U2DbiRef &dstDbiRef, BAMInfo& bamInfo, bool sam);
+    ~ConvertToSQLiteTask();
+    virtual void prepare();
     virtual void run();
 
     GUrl getDestinationUrl() const;
@@ -55,6 +61,7 @@ private:
     bool isSorted(Reader *reader) const;
 
     qint64 importReads();
+    void stopInflating();
     void packReads();
     void updateAttributes();
 
@@ -65,7 +72,7 @@ private:
     qint64 importUnsortedReads(SamReader *samReader, BamReader *bamReader, Reader *reader, QMap<int, U2::U2AssemblyReadsImportInfo> &importInfos);
     void createAssemblyObjectForUnsortedReads(int referenceId, Reader *reader, QMap<int, U2::U2AssemblyReadsImportInfo> &importInfos);
     qint64 importReadsSequentially(Iterator *iterator);
-    void flushReads(const QMap<int, QList<U2AssemblyRead> > &reads);
+    void flushReads(const QMap<int, QList<U2AssemblyRead> > &reads, const QSet<int> &packedReferenceIds);
 
     void updateReferenceLengthAttribute(int length, const U2Assembly &assembly, U2AttributeDbi *attributeDbi);
     void updateReferenceMd5Attribute(const QByteArray &md5, const U2Assembly &assembly, U2AttributeDbi *attributeDbi);
@@ -83,6 +90,8 @@ private:
     BAMInfo bamInfo;
 
     bool sam;
+    // inflates the BAM blocks in advance by the subtasks while the reads are imported
+    QScopedPointer<BgzfInflater> inflater;
 
     QList<Header::Reference> references;
     QMap<int, U2AssemblyReadsImportInfo> importInfos;
@@ -64,6 +64,7 @@ void Dbi::init(const QHash<QString, QString> &properties, const QVariantMap & /*
         if(!ioAdapter->open(url, IOAdapterMode_Read)) {
             throw IOException(BAMDbiPlugin::tr("Can't open file '%1'").arg(url.getURLString()));
         }
+        // the reads are accessed by random seeks for the whole Dbi life, so they are not read ahead
         reader.reset(new BamReader(*ioAdapter));
         QFileInfo fileInfo(url.getURLString());
         sqliteUrl = GUrl(QDir::temp().absoluteFilePath(url.fileName() + "." + QString::number(fileInfo.lastModified().toTime_t()) + "." + QString::number(fileInfo.size()) + ".sqlite"));
@@ -306,9 +306,9 @@ void BamReader::AlignmentReader::skip() {
     r->reader.skip(blockSize - 4);
 }
 
-BamReader::BamReader(IOAdapter &ioAdapter):
+BamReader::BamReader(IOAdapter &ioAdapter, BgzfInflater *inflater):
         Reader(ioAdapter),
-        reader(ioAdapter)
+        reader(ioAdapter, inflater)
 {
     readHeader();
 }
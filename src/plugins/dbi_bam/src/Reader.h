@@ -64,7 +64,8 @@ public:
         bool readNumber(char type, QVariant &value, int &bytesRead);
     };
 
-    BamReader(IOAdapter &ioAdapter);
+    /** The inflater turns on the read-ahead decompression, see BgzfReader */
+    BamReader(IOAdapter &ioAdapter, BgzfInflater *inflater = NULL);
     const Header &getHeader()const;
     Alignment readAlignment();
     AlignmentReader getAlignmentReader();
@@ -31,6 +31,7 @@ SOURCES += src/CloningUtilTasks.cpp \
            src/EnzymesPlugin.cpp \
            src/EnzymesQuery.cpp \
            src/EnzymesTests.cpp \
+           src/FindEnzymesAlgorithm.cpp \
            src/FindEnzymesDialog.cpp \
            src/FindEnzymesTask.cpp
 RESOURCES += enzymes.qrc
@@ -29,6 +29,9 @@
 #include <U2Core/DocumentModel.h>
 #include <U2Core/GObjectRelationRoles.h>
 #include <U2Core/IOAdapter.h>
+#include <U2Core/Log.h>
+#include <U2Core/Timer.h>
+#include <U2Core/U2AlphabetUtils.h>
 #include <U2Core/U2DbiRegistry.h>
 #include <U2Core/U2OpStatusUtils.h>
 
@@ -230,6 +233,111 @@ void GTest_FindEnzymes::cleanup() {
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+class EnzymesResultsCollector : public FindEnzymesAlgListener {
+public:
+    virtual void onResult(int pos, const SEnzymeData& enzyme, const U2Strand& strand) {
+        results << QString("%1:%2:%3").arg(enzyme->id).arg(pos).arg(strand.isDirect() ? "direct" : "complementary");
+    }
+
+    QStringList results;
+};
+
+}   // namespace
+
+void GTest_FindEnzymesOnePass::init(XMLTestFormat *tf, const QDomElement& el) {
+    Q_UNUSED(tf);
+    seqObj = NULL;
+
+    seqObjCtx = el.attribute("sequence");
+    if (seqObjCtx.isEmpty()) {
+        stateInfo.setError("Sequence object context not specified");
+        return;
+    }
+
+    enzymesUrl = el.attribute("url");
+    if (enzymesUrl.isEmpty()) {
+        stateInfo.setError("Enzymes database URL not specified");
+        return;
+    }
+    enzymesUrl = env->getVar("COMMON_DATA_DIR") + "/" + enzymesUrl;
+
+    // all enzymes of the file are searched for if the list is not set
+    enzymeNames = el.attribute("enzymes").split(",", QString::SkipEmptyParts);
+}
+
+void GTest_FindEnzymesOnePass::prepare() {
+    CHECK_OP(stateInfo, );
+    seqObj = getContext<U2SequenceObject>(this, seqObjCtx);
+    if (seqObj == NULL) {
+        stateInfo.setError(QString("Sequence context not found %1").arg(seqObjCtx));
+    }
+}
+
+void GTest_FindEnzymesOnePass::run() {
+    CHECK_OP(stateInfo, );
+    const QList<SEnzymeData> allEnzymes = EnzymesIO::readEnzymes(enzymesUrl, stateInfo);
+    CHECK_OP(stateInfo, );
+
+    DNASequence sequence = seqObj->getWholeSequence(stateInfo);
+    CHECK_OP(stateInfo, );
+    sequence.circular = false;
+    const U2Region range(0, sequence.length());
+
+    QList<SEnzymeData> enzymes;
+    foreach (const SEnzymeData& enzyme, allEnzymes) {
+        if (!enzymeNames.isEmpty() && !enzymeNames.contains(enzyme->id)) {
+            continue;
+        }
+        if (enzyme->seq.isEmpty() || enzyme->seq.length() > sequence.length() || NULL == enzyme->alphabet || !enzyme->alphabet->isNucleic()) {
+            continue;
+        }
+        enzymes << enzyme;
+    }
+    CHECK_EXT(!enzymes.isEmpty(), stateInfo.setError("No enzymes to search for"), );
+
+    const bool extendedSeqAlphabet = sequence.alphabet->getId() == BaseDNAAlphabetIds::NUCL_DNA_EXTENDED()
+                                    || sequence.alphabet->getId() == BaseDNAAlphabetIds::NUCL_RNA_DEFAULT()
+                                    || sequence.alphabet->getId() == BaseDNAAlphabetIds::NUCL_RNA_EXTENDED();
+
+    // the same algorithms as FindSingleEnzymeTask runs for every enzyme
+    EnzymesResultsCollector perEnzymeResults;
+    qint64 t0 = GTimer::currentTimeMicros();
+    foreach (const SEnzymeData& enzyme, enzymes) {
+        if (extendedSeqAlphabet || enzyme->alphabet->getId() == BaseDNAAlphabetIds::NUCL_DNA_EXTENDED()) {
+            FindEnzymesAlgorithm<ExtendedDNAlphabetComparator> algo;
+            algo.run(sequence, range, enzyme, &perEnzymeResults, stateInfo);
+        } else {
+            FindEnzymesAlgorithm<ExactDNAAlphabetComparatorN1M_N2M> algo;
+            algo.run(sequence, range, enzyme, &perEnzymeResults, stateInfo);
+        }
+    }
+    const qint64 perEnzymeTime = qMax(GTimer::currentTimeMicros() - t0, qint64(1));
+    CHECK_OP(stateInfo, );
+
+    // the automaton construction is a part of the one-pass search time
+    EnzymesResultsCollector onePassResults;
+    t0 = GTimer::currentTimeMicros();
+    FindEnzymesMultiAlgorithm multiAlgorithm(enzymes, sequence.alphabet);
+    multiAlgorithm.run(sequence, range, &onePassResults, stateInfo);
+    const qint64 onePassTime = qMax(GTimer::currentTimeMicros() - t0, qint64(1));
+    CHECK_OP(stateInfo, );
+
+    perEnzymeResults.results.sort();
+    onePassResults.results.sort();
+    CHECK_EXT(perEnzymeResults.results == onePassResults.results,
+        stateInfo.setError(QString("The one-pass search results differ from the per-enzyme search results: %1 sites found, %2 expected")
+            .arg(onePassResults.results.size()).arg(perEnzymeResults.results.size())), );
+
+    // the times are only reported, they depend on the machine and its load
+    algoLog.info(QString("Search of %1 enzymes in %2 bp: per-enzyme search %3 ms, one-pass search %4 ms, %5 sites, speedup %6")
+        .arg(enzymes.size()).arg(sequence.length()).arg(perEnzymeTime / 1000.0, 0, 'f', 3).arg(onePassTime / 1000.0, 0, 'f', 3)
+        .arg(onePassResults.results.size()).arg(double(perEnzymeTime) / onePassTime, 0, 'f', 2));
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 void GTest_DigestIntoFragments::init(XMLTestFormat *tf, const QDomElement& el) {
     Q_UNUSED(tf);
     loadTask = NULL;
@@ -458,6 +566,7 @@ void GTest_LigateFragments::cleanup()
 QList<XMLTestFactory*> EnzymeTests::createTestFactories() {
     QList<XMLTestFactory*> res;
     res.append(GTest_FindEnzymes::createFactory());
+    res.append(GTest_FindEnzymesOnePass::createFactory());
     res.append(GTest_DigestIntoFragments::createFactory());
     res.append(GTest_LigateFragments::createFactory());
     return res;
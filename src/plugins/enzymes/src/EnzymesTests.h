@@ -81,6 +81,25 @@ private:
     LoadEnzymeFileTask*     loadTask;
 };
 
+/**
+ * Searches for the enzymes on the same sequence with the per-enzyme search (FindEnzymesAlgorithm)
+ * and with the one-pass search of all enzymes (FindEnzymesMultiAlgorithm). The results must be equal.
+ * The times of both searches are logged, they are not checked.
+ */
+class GTest_FindEnzymesOnePass : public GTest {
+    Q_OBJECT
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_FindEnzymesOnePass, "find-enzymes-one-pass", TaskFlags_FOSCOE);
+
+    void prepare();
+    void run();
+
+private:
+    QString                 seqObjCtx;
+    QString                 enzymesUrl;
+    QStringList             enzymeNames;
+    U2SequenceObject*       seqObj;
+};
+
 class LigateFragmentsTask;
 
 //cppcheck-suppress noConstructor
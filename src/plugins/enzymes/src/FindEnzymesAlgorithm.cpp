@@ -0,0 +1,182 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/Log.h>
+#include <U2Core/U2AlphabetUtils.h>
+
+#include "FindEnzymesAlgorithm.h"
+
+namespace U2 {
+
+namespace {
+
+bool isInExtendedComparatorIndex(char c) {
+    return c >= ' ' && c <= 'Z';
+}
+
+/** Sets the bits of the site positions that accept a character, the character rules are the same as FindEnzymesAlgorithm::matchSite() has */
+template <typename CompareFN>
+void fillSiteMasks(const CompareFN& fn, bool extendedComparator, const QByteArray& pattern, char unknownChar,
+                   int firstBit, int wordBits, quint64* charMasks, int wordsCount, int charsCount)
+{
+    for (int p = 0; p < pattern.length(); p++) {
+        const int bit = firstBit + p;
+        const quint64 bitMask = Q_UINT64_C(1) << (bit % wordBits);
+        const char patternChar = pattern[p];
+        for (int c = 0; c < charsCount; c++) {
+            const char seqChar = char(c);
+            if (seqChar == unknownChar) {
+                continue;
+            }
+            // the extended comparator has no index for other symbols
+            if (extendedComparator && seqChar != patternChar
+                    && (!isInExtendedComparatorIndex(seqChar) || !isInExtendedComparatorIndex(patternChar))) {
+                continue;
+            }
+            if (fn.equals(patternChar, seqChar)) {
+                charMasks[c * wordsCount + bit / wordBits] |= bitMask;
+            }
+        }
+    }
+}
+
+inline int lowestBitIndex(quint64 value) {
+    int index = 0;
+    while (0 == (value & 1)) {
+        value >>= 1;
+        index++;
+    }
+    return index;
+}
+
+}   // namespace
+
+FindEnzymesMultiAlgorithm::FindEnzymesMultiAlgorithm(const QList<SEnzymeData>& enzymes, const DNAAlphabet* seqAlphabet)
+    : wordsCount(0),
+      maxSiteLength(0)
+{
+    SAFE_POINT(NULL != seqAlphabet, "No sequence alphabet", );
+    const bool extendedSeqAlphabet = seqAlphabet->getId() == BaseDNAAlphabetIds::NUCL_DNA_EXTENDED()
+                                    || seqAlphabet->getId() == BaseDNAAlphabetIds::NUCL_RNA_DEFAULT()
+                                    || seqAlphabet->getId() == BaseDNAAlphabetIds::NUCL_RNA_EXTENDED();
+
+    foreach (const SEnzymeData& enzyme, enzymes) {
+        if (enzyme->seq.isEmpty()) {
+            continue;
+        }
+        if (NULL == enzyme->alphabet) {
+            coreLog.error(QString("No enzyme alphabet: %1").arg(enzyme->id));
+            continue;
+        }
+        if (!enzyme->alphabet->isNucleic()) {
+            algoLog.info(QObject::tr("Non-nucleic enzyme alphabet: %1, enzyme: %2, skipping..").arg(enzyme->alphabet->getId()).arg(enzyme->id));
+            continue;
+        }
+        const bool extendedComparator = extendedSeqAlphabet || enzyme->alphabet->getId() == BaseDNAAlphabetIds::NUCL_DNA_EXTENDED();
+        sites << Site(enzyme, enzyme->seq, U2Strand::Direct, extendedComparator);
+
+        // if enzyme is not symmetric - look in complementary strand too
+        DNATranslation* tt = AppContext::getDNATranslationRegistry()->lookupComplementTranslation(enzyme->alphabet);
+        if (NULL == tt) {
+            continue;
+        }
+        QByteArray revCompl = enzyme->seq;
+        tt->translate(revCompl.data(), revCompl.size());
+        TextUtils::reverse(revCompl.data(), revCompl.size());
+        if (revCompl != enzyme->seq) {
+            sites << Site(enzyme, revCompl, U2Strand::Complementary, extendedComparator);
+        }
+    }
+
+    buildMasks(seqAlphabet);
+}
+
+void FindEnzymesMultiAlgorithm::buildMasks(const DNAAlphabet* seqAlphabet) {
+    int bitsCount = 0;
+    foreach (const Site& site, sites) {
+        bitsCount += site.length;
+        maxSiteLength = qMax(maxSiteLength, site.length);
+    }
+    wordsCount = (bitsCount + WORD_BITS - 1) / WORD_BITS;
+
+    charMasks.fill(0, CHARS_COUNT * wordsCount);
+    startBits.fill(0, wordsCount);
+    lastBits.fill(0, wordsCount);
+    siteByLastBit.fill(-1, wordsCount * WORD_BITS);
+
+    const char unknownChar = seqAlphabet->getDefaultSymbol();
+    int firstBit = 0;
+    for (int i = 0; i < sites.size(); i++) {
+        const Site& site = sites[i];
+        if (site.extendedComparator) {
+            ExtendedDNAlphabetComparator fn(seqAlphabet, site.enzyme->alphabet);
+            fillSiteMasks(fn, true, site.pattern, unknownChar, firstBit, WORD_BITS, charMasks.data(), wordsCount, CHARS_COUNT);
+        } else {
+            ExactDNAAlphabetComparatorN1M_N2M fn(seqAlphabet, site.enzyme->alphabet);
+            fillSiteMasks(fn, false, site.pattern, unknownChar, firstBit, WORD_BITS, charMasks.data(), wordsCount, CHARS_COUNT);
+        }
+
+        const int lastBit = firstBit + site.length - 1;
+        startBits[firstBit / WORD_BITS] |= Q_UINT64_C(1) << (firstBit % WORD_BITS);
+        lastBits[lastBit / WORD_BITS] |= Q_UINT64_C(1) << (lastBit % WORD_BITS);
+        siteByLastBit[lastBit] = i;
+        firstBit = lastBit + 1;
+    }
+}
+
+void FindEnzymesMultiAlgorithm::run(const DNASequence& sequence, const U2Region& range, FindEnzymesAlgListener* l, TaskStateInfo& ti,
+                                    int resultPosShift, qint64 startPosLimit) const
+{
+    CHECK(!sites.isEmpty(), );
+
+    // bit 'b' of the state is set if the site position 'b' matches the current sequence position
+    QVector<quint64> state(wordsCount, 0);
+    quint64* d = state.data();
+    const quint64* masks = charMasks.constData();
+    const quint64* starts = startBits.constData();
+    const quint64* lasts = lastBits.constData();
+    const char* seq = sequence.constData();
+
+    for (qint64 pos = range.startPos, end = range.endPos(); pos < end && !ti.cancelFlag; pos++) {
+        const quint64* charMask = masks + uchar(seq[pos]) * wordsCount;
+        quint64 carry = 0;
+        for (int w = 0; w < wordsCount; w++) {
+            // the bits carried over a site border are overridden by the start bit of the next site
+            const quint64 prev = d[w];
+            d[w] = ((prev << 1) | carry | starts[w]) & charMask[w];
+            carry = prev >> (WORD_BITS - 1);
+
+            quint64 found = d[w] & lasts[w];
+            while (0 != found) {
+                const int bit = lowestBitIndex(found);
+                found &= found - 1;
+
+                const Site& site = sites[siteByLastBit[w * WORD_BITS + bit]];
+                const qint64 siteStartPos = pos - site.length + 1;
+                if (siteStartPos < startPosLimit) {
+                    l->onResult(resultPosShift + siteStartPos, site.enzyme, site.strand);
+                }
+            }
+        }
+    }
+}
+
+} //namespace
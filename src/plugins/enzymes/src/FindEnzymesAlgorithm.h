@@ -22,6 +22,8 @@
 #ifndef _U2_FIND_ENZYMES_ALGO_H_
 #define _U2_FIND_ENZYMES_ALGO_H_
 
+#include <climits>
+
 #include <U2Algorithm/EnzymeModel.h>
 
 #include <U2Core/Task.h>
@@ -36,6 +38,7 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QList>
+#include <QtCore/QVector>
 
 namespace U2 {
 
@@ -115,6 +118,62 @@ public:
 
 };
 
+/**
+ * Finds the sites of several enzymes in a single pass over the sequence.
+ * The sites of all enzymes on both strands are compiled into one bit-parallel Shift-And automaton:
+ * every site occupies a run of bits in a multi-word state vector, and a character mask table
+ * tells which site positions accept a sequence character. The masks are built with the same comparators
+ * FindEnzymesAlgorithm uses, so degenerate symbols in sites and in the sequence are handled the same way.
+ * The algorithm does not look at the 'circular' flag of the sequence: to find the sites
+ * crossing the origin the caller has to extend the sequence (see SequenceDbiWalkerConfig::walkCircular).
+ * The object is read-only after the construction and may be used by several threads at once.
+ */
+class FindEnzymesMultiAlgorithm {
+public:
+    FindEnzymesMultiAlgorithm(const QList<SEnzymeData>& enzymes, const DNAAlphabet* seqAlphabet);
+
+    bool isEmpty() const { return sites.isEmpty(); }
+
+    /** Returns the length of the longest site: chunks of a sequence must overlap by this length minus 1 */
+    int getMaxSiteLength() const { return maxSiteLength; }
+
+    /**
+     * Reports all sites that are located inside @range.
+     * Only sites starting before @startPosLimit are reported, it allows to skip the sites
+     * that will be found in the next overlapping chunk.
+     */
+    void run(const DNASequence& sequence, const U2Region& range, FindEnzymesAlgListener* l, TaskStateInfo& ti,
+             int resultPosShift = 0, qint64 startPosLimit = LLONG_MAX) const;
+
+private:
+    struct Site {
+        Site() : length(0) {}
+        Site(const SEnzymeData& enzyme, const QByteArray& pattern, const U2Strand& strand, bool extendedComparator)
+            : enzyme(enzyme), pattern(pattern), strand(strand), length(pattern.length()), extendedComparator(extendedComparator) {}
+
+        SEnzymeData enzyme;
+        QByteArray  pattern;
+        U2Strand    strand;
+        int         length;
+        bool        extendedComparator;
+    };
+
+    void buildMasks(const DNAAlphabet* seqAlphabet);
+
+    static const int CHARS_COUNT = 256;
+    static const int WORD_BITS = 64;
+
+    QVector<Site>       sites;
+    /** Index of the site ending at the bit, -1 for other bits */
+    QVector<int>        siteByLastBit;
+    /** CHARS_COUNT rows of 'wordsCount' words: bit is set if the site position accepts the character */
+    QVector<quint64>    charMasks;
+    QVector<quint64>    startBits;
+    QVector<quint64>    lastBits;
+    int                 wordsCount;
+    int                 maxSiteLength;
+};
+
 } //namespace
 
 #endif
@@ -116,10 +116,8 @@ FindEnzymesTask::FindEnzymesTask(const U2EntityRef& seqRef, const U2Region& regi
 
     SAFE_POINT(seq.getAlphabet()->isNucleic(), tr("Alphabet is not nucleic."), );
     seqlen = seq.getSequenceLength();
-    //for every enzymes in selection create FindSingleEnzymeTask
-    foreach(const SEnzymeData& e, enzymes) {
-        addSubTask(new FindSingleEnzymeTask(seqRef, region, e, this, circular));
-    }
+    // all enzymes in selection are searched for in one pass over the sequence
+    addSubTask(new FindMultipleEnzymesTask(seqRef, region, enzymes, this, circular));
 }
 
 void FindEnzymesTask::onResult(int pos, const SEnzymeData& enzyme, const U2Strand& strand) {
@@ -226,6 +224,23 @@ void FindEnzymesTask::cleanup() {
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+// sequence chunk loading
+
+static DNASequence getChunkSequence(const U2SequenceObject& dnaSequenceObject, qint64 sequenceLen, const U2Region& chunkRegion, TaskStateInfo& ti) {
+    DNASequence dnaSeq;
+    if (U2Region(0, sequenceLen).contains(chunkRegion)) {
+        dnaSeq = dnaSequenceObject.getSequence(chunkRegion, ti);
+    } else {
+        U2Region partOne = U2Region(0, sequenceLen).intersect(chunkRegion);
+        dnaSeq = dnaSequenceObject.getSequence(partOne, ti);
+        CHECK_OP(ti, dnaSeq);
+        U2Region partTwo = U2Region(0, chunkRegion.endPos() % sequenceLen);
+        dnaSeq.seq.append(dnaSequenceObject.getSequence(partTwo, ti).seq);
+    }
+    return dnaSeq;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // find single enzyme task
 FindSingleEnzymeTask::FindSingleEnzymeTask(const U2EntityRef& _seqRef, const U2Region& region, const SEnzymeData& _enzyme,
@@ -299,16 +314,7 @@ void FindSingleEnzymeTask::onRegion(SequenceDbiWalkerSubtask* t, TaskStateInfo&
                                 || seqAlphabet->getId() == BaseDNAAlphabetIds::NUCL_RNA_EXTENDED();
 
     U2Region chunkRegion = t->getGlobalRegion();
-    DNASequence dnaSeq;
-    if (U2Region(0, sequenceLen).contains(chunkRegion)) {
-        dnaSeq = dnaSequenceObject.getSequence(chunkRegion, ti);
-    } else {
-        U2Region partOne = U2Region(0, sequenceLen).intersect(chunkRegion);
-        dnaSeq = dnaSequenceObject.getSequence(partOne, ti);
-        CHECK_OP(ti, );
-        U2Region partTwo = U2Region(0, chunkRegion.endPos() % sequenceLen);
-        dnaSeq.seq.append(dnaSequenceObject.getSequence(partTwo, ti).seq);
-    }
+    DNASequence dnaSeq = getChunkSequence(dnaSequenceObject, sequenceLen, chunkRegion, ti);
     CHECK_OP(ti, );
 
     // Note that enzymes algorithm filters N symbols in sequence by itself
@@ -325,6 +331,66 @@ void FindSingleEnzymeTask::cleanup() {
     results.clear();
 }
 
+//////////////////////////////////////////////////////////////////////////
+// find multiple enzymes in one pass task
+FindMultipleEnzymesTask::FindMultipleEnzymesTask(const U2EntityRef& seqRef, const U2Region& region, const QList<SEnzymeData>& enzymes,
+                                                 FindEnzymesAlgListener* l, bool _circular)
+    : Task(tr("Find enzymes in one pass"), TaskFlag_NoRun),
+      dnaSeqRef(seqRef),
+      sequenceLen(0),
+      resultListener(l),
+      circular(_circular)
+{
+    SAFE_POINT(resultListener != NULL, "Result listener is NULL", );
+    U2SequenceObject dnaSeq("sequence", dnaSeqRef);
+    const DNAAlphabet* seqAlphabet = dnaSeq.getAlphabet();
+    SAFE_POINT(seqAlphabet->isNucleic(), tr("Alphabet is not nucleic."), );
+    sequenceLen = dnaSeq.getSequenceLength();
+
+    QList<SEnzymeData> fittingEnzymes;
+    foreach (const SEnzymeData& enzyme, enzymes) {
+        if (enzyme->seq.length() <= sequenceLen) {
+            fittingEnzymes << enzyme;
+        }
+    }
+    algorithm.reset(new FindEnzymesMultiAlgorithm(fittingEnzymes, seqAlphabet));
+    CHECK(!algorithm->isEmpty(), );
+
+    const int BLOCK_READ_FROM_DB = 128000;
+    static const int chunkSize = BLOCK_READ_FROM_DB;
+
+    SequenceDbiWalkerConfig swc;
+    swc.seqRef = dnaSeqRef;
+    swc.range = region;
+    swc.chunkSize = qMax(algorithm->getMaxSiteLength(), chunkSize);
+    swc.lastChunkExtraLen = swc.chunkSize/2;
+    swc.overlapSize = algorithm->getMaxSiteLength() - 1;
+    swc.walkCircular = circular;
+    swc.walkCircularDistance = swc.overlapSize;
+
+    addSubTask(new SequenceDbiWalkerTask(swc, this, tr("Find enzymes in one pass parallel")));
+}
+
+void FindMultipleEnzymesTask::onRegion(SequenceDbiWalkerSubtask* t, TaskStateInfo& ti) {
+    U2SequenceObject dnaSequenceObject("sequence", dnaSeqRef);
+    U2Region chunkRegion = t->getGlobalRegion();
+    DNASequence dnaSeq = getChunkSequence(dnaSequenceObject, sequenceLen, chunkRegion, ti);
+    CHECK_OP(ti, );
+
+    // The chunks overlap by the longest site length - 1,
+    // the shorter sites starting in the overlap are reported by the next chunk only
+    qint64 startPosLimit = chunkRegion.length;
+    if (t->hasRightOverlap()) {
+        startPosLimit -= t->getGlobalConfig().overlapSize;
+    }
+    // The circular walk repeats the sequence start after its end, the sites starting there are already found
+    if (circular) {
+        startPosLimit = qMin(startPosLimit, sequenceLen - chunkRegion.startPos);
+    }
+
+    algorithm->run(dnaSeq, U2Region(0, chunkRegion.length), resultListener, ti, chunkRegion.startPos, startPosLimit);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // find enzymes auto annotation updater
 
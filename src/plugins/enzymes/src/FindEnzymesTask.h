@@ -27,6 +27,7 @@
 #include <QtCore/QList>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
 
 #include <U2Algorithm/EnzymeModel.h>
 
@@ -139,6 +140,26 @@ private:
     bool                        circular;
 };
 
+/**
+ * Searches for the sites of all enzymes in one pass over every sequence chunk,
+ * see FindEnzymesMultiAlgorithm. The results are passed to the listener.
+ */
+class FindMultipleEnzymesTask : public Task, public SequenceDbiWalkerCallback {
+    Q_OBJECT
+public:
+    FindMultipleEnzymesTask(const U2EntityRef& seqRef, const U2Region& region, const QList<SEnzymeData>& enzymes,
+                            FindEnzymesAlgListener* l, bool circular = false);
+
+    virtual void onRegion(SequenceDbiWalkerSubtask* t, TaskStateInfo& ti);
+
+private:
+    U2EntityRef                                 dnaSeqRef;
+    qint64                                      sequenceLen;
+    FindEnzymesAlgListener*                     resultListener;
+    bool                                        circular;
+    QScopedPointer<FindEnzymesMultiAlgorithm>   algorithm;
+};
+
 class FindEnzymesAutoAnnotationUpdater : public AutoAnnotationsUpdater {
     Q_OBJECT
 public:
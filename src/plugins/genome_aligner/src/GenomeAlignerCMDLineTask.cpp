@@ -43,6 +43,7 @@ namespace U2 {
 #define OPTION_BEST_MODE    "best"
 #define OPTION_OMIT         "omit-size"
 #define OPTION_SAM          "sam"
+#define OPTION_PIPELINED    "pipelined"
 
 
  GenomeAlignerCMDLineTask::GenomeAlignerCMDLineTask()
@@ -58,6 +59,7 @@ namespace U2 {
     bestMode = false;
     onlyBuildIndex = false;
     samOutput = false;
+    pipelined = false;
 
     // parse options
 
@@ -110,6 +112,8 @@ namespace U2 {
             }
         } else if (opt.first == OPTION_SAM) {
             samOutput = true;
+        } else if (opt.first == OPTION_PIPELINED) {
+            pipelined = true;
         }
     }
 
@@ -168,6 +172,7 @@ void GenomeAlignerCMDLineTask::prepare()
     settings.setCustomValue(GenomeAlignerTask::OPTION_PERCENTAGE_MISMATCHES, ptMismatchCount);
     settings.setCustomValue(GenomeAlignerTask::OPTION_BEST, bestMode);
     settings.setCustomValue(GenomeAlignerTask::OPTION_QUAL_THRESHOLD, qualityThreshold);
+    settings.setCustomValue(GenomeAlignerTask::OPTION_PIPELINED, pipelined);
 
 
     GenomeAlignerTask* task = new GenomeAlignerTask(settings, onlyBuildIndex);
@@ -192,6 +197,7 @@ QString GenomeAlignerCMDLineTask::getArgumentsDescritption()
     desc += tr("  --%1    Report only about best alignments (in terms of mismatches).\n\n").arg(OPTION_BEST_MODE, fieldSize);
     desc += tr("  --%1    Omit reads with qualities lower than the specified value. Reads which have no qualities are not omitted. Default value is 0.\n\n").arg(OPTION_OMIT, fieldSize);
     desc += tr("  --%1    Output aligned reads in SAM format. Default value is false.\n\n").arg(OPTION_SAM, fieldSize);
+    desc += tr("  --%1    Search and align short reads in a pipeline of concurrent stages. Ignored if --%2 is set. Default value is false.\n\n").arg(OPTION_PIPELINED, fieldSize).arg(OPTION_USE_OPENCL);
 
     return desc;
 }
@@ -38,7 +38,7 @@ public:
 private:
     int mismatchCount, ptMismatchCount, memSize, refSize, qualityThreshold;
     bool useOpenCL;
-    bool alignRevCompl, bestMode, samOutput;
+    bool alignRevCompl, bestMode, samOutput, pipelined;
     DnaAssemblyToRefTaskSettings settings;
     QString indexPath, resultPath, refPath;
     bool onlyBuildIndex;
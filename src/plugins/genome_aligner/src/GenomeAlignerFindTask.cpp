@@ -31,6 +31,8 @@
 #include "GenomeAlignerIndex.h"
 #include "GenomeAlignerTask.h"
 
+#include <QtCore/QSet>
+
 #include <time.h>
 
 #include "GenomeAlignerFindTask.h"
@@ -39,7 +41,7 @@ namespace U2 {
 
 GenomeAlignerFindTask::GenomeAlignerFindTask(U2::GenomeAlignerIndex *i, AlignContext *s, GenomeAlignerWriteTask *w)
 : Task("GenomeAlignerFindTask", TaskFlag_None),
-index(i), writeTask(w), alignContext(s)
+index(i), writeTask(w), alignContext(s), pipelineItems(PIPELINE_QUEUE_SIZE)
 {
     nextElementToGive = 0;
     indexLoadTime = 0;
@@ -47,6 +49,17 @@ index(i), writeTask(w), alignContext(s)
     alignerTaskCount = 0;
 }
 
+GenomeAlignerFindTask::~GenomeAlignerFindTask() {
+    // the pipeline can be interrupted by cancelling
+    QSet<PipelineBunch*> bunches;
+    PipelineItem *item = NULL;
+    while (pipelineItems.tryPop(item)) {
+        bunches.insert(item->bunch);
+        delete item;
+    }
+    qDeleteAll(bunches);
+}
+
 void GenomeAlignerFindTask::prepare() {
     alignerTaskCount = alignContext->openCL ? 1 : AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount();
     if (alignContext->openCL) {
@@ -139,6 +152,7 @@ void GenomeAlignerFindTask::requirePartForAligning(int part) {
     alignContext->requireIndexWait.wait(&alignContext->indexLock);
 
     nextElementToGive = 0;
+    nextBunchToTake.store(0);
 }
 
 DataBunch* GenomeAlignerFindTask::waitForDataBunch() {
@@ -175,6 +189,59 @@ DataBunch* GenomeAlignerFindTask::waitForDataBunch() {
     }
 }
 
+DataBunch* GenomeAlignerFindTask::tryTakeDataBunch(bool &noMoreData) {
+    bool isReadingStarted = false;
+    bool isReadingFinished = false;
+    {
+        QMutexLocker readingLock(&alignContext->readingStatusMutex);
+        isReadingStarted = alignContext->isReadingStarted;
+        isReadingFinished = alignContext->isReadingFinished;
+    }
+    noMoreData = false;
+    CHECK(isReadingStarted, NULL);
+
+    // ReadShortReadsSubTask can add new data
+    QReadLocker locker(&alignContext->listM);
+    const int dataBunchesCount = alignContext->data.size();
+    forever {
+        const int next = nextBunchToTake.load();
+        if (next >= dataBunchesCount) {
+            noMoreData = isReadingFinished;
+            return NULL;
+        }
+        if (nextBunchToTake.testAndSetOrdered(next, next + 1)) {
+            return alignContext->data.at(next);
+        }
+    }
+}
+
+static bool isReadBoundary(const DataBunch *dataBunch, int i) {
+    const int rn = dataBunch->readNumbersV.at(i);
+    const int prevRn = dataBunch->readNumbersV.at(i - 1);
+    // a read and its reverse complement are checked together in the best mode, so they are never separated
+    return rn != prevRn && dataBunch->queries.at(prevRn)->getRevCompl() != dataBunch->queries.at(rn);
+}
+
+QList<PipelineItem*> GenomeAlignerFindTask::createPipelineItems(PipelineBunch *bunch, PipelineItem::Stage stage) const {
+    QList<PipelineItem*> items;
+    const DataBunch *dataBunch = bunch->dataBunch;
+    const int length = dataBunch->bitValuesV.size();
+    int begin = 0;
+    while (begin < length) {
+        int end = qMin(length, begin + PIPELINE_ITEM_SIZE);
+        if (PipelineItem::Align == stage) {
+            // the results of a read are written when its last window is aligned
+            while (end < length && !isReadBoundary(dataBunch, end)) {
+                end++;
+            }
+        }
+        items << new PipelineItem(stage, bunch, begin, end);
+        begin = end;
+    }
+    bunch->unfinishedItems.store(items.size());
+    return items;
+}
+
 #define GA_CHECK_BREAK(a) {if (!(a)) {algoLog.trace("Break because of ![" #a "]"); break;}}
 #define GA_CHECK_CONTINUE(a) {if (!(a)) {algoLog.trace("Continue because of ![" #a "]"); continue;}}
 
@@ -209,6 +276,11 @@ void ShortReadAlignerCPU::run() {
             continue;
         }
 
+        if (alignContext->pipelined) {
+            runPipeline(parent);
+            continue;
+        }
+
         do {
             if (isCanceled()) {
                 break;
@@ -272,6 +344,105 @@ void ShortReadAlignerCPU::run() {
     }
 }
 
+/**
+ * Every aligner thread takes the first available stage: queued search and align items go first,
+ * a new data bunch is sorted and split into items only when the queue is empty.
+ * So the searching of one bunch, the aligning of another one and the reading and the writing tasks
+ * work at the same time, and all threads are busy even if there is only one big bunch.
+ */
+void ShortReadAlignerCPU::runPipeline(GenomeAlignerFindTask *parent) {
+    while (!isCanceled()) {
+        PipelineItem *item = NULL;
+        if (parent->pipelineItems.tryPop(item)) {
+            processPipelineItem(parent, item);
+            continue;
+        }
+
+        bool noMoreData = false;
+        parent->bunchesInWork.ref();
+        DataBunch *dataBunch = parent->tryTakeDataBunch(noMoreData);
+        if (NULL == dataBunch || dataBunch->bitValuesV.isEmpty()) {
+            const bool idle = !parent->bunchesInWork.deref();
+            if (NULL != dataBunch) {
+                continue;
+            }
+            if (noMoreData && idle && parent->pipelineItems.isEmpty()) {
+                break;
+            }
+            QMutexLocker readingLock(&alignContext->readingStatusMutex);
+            alignContext->readShortReadsWait.wait(&alignContext->readingStatusMutex, GenomeAlignerFindTask::PIPELINE_IDLE_WAIT_MS);
+            continue;
+        }
+
+        quint64 t0 = GTimer::currentTimeMicros();
+        dataBunch->prepareSorted();
+        PipelineBunch *bunch = new PipelineBunch(dataBunch);
+        bunch->binarySearchResults.resize(dataBunch->bitValuesV.size());
+        algoLog.trace(QString("[%1] Sorted %2 windows in %3 ms").arg(taskNo).arg(dataBunch->bitValuesV.size()).arg((GTimer::currentTimeMicros() - t0) / double(1000), 0, 'f', 3));
+
+        schedulePipelineItems(parent, parent->createPipelineItems(bunch, PipelineItem::Search));
+    }
+}
+
+void ShortReadAlignerCPU::schedulePipelineItems(GenomeAlignerFindTask *parent, const QList<PipelineItem*> &items) {
+    foreach (PipelineItem *item, items) {
+        // the queue is full: other threads are busy, do the work right here
+        if (!parent->pipelineItems.tryPush(item)) {
+            processPipelineItem(parent, item);
+        }
+    }
+}
+
+void ShortReadAlignerCPU::processPipelineItem(GenomeAlignerFindTask *parent, PipelineItem *item) {
+    PipelineBunch *bunch = item->bunch;
+    DataBunch *dataBunch = bunch->dataBunch;
+    const int length = dataBunch->bitValuesV.size();
+
+    if (PipelineItem::Search == item->stage) {
+        for (int i = item->begin; i < item->end; i++) {
+            const int sortedIndex = dataBunch->sortedIndexes[i];
+            int currentW = dataBunch->windowSizes.at(sortedIndex);
+            GA_CHECK_CONTINUE(0 != currentW);
+            BMType currentBitFilter = ((quint64)0 - 1) << (62 - currentW * 2);
+            bunch->binarySearchResults[sortedIndex] = index->bitMaskBinarySearch(dataBunch->sortedBitValuesV.at(i), currentBitFilter);
+        }
+    } else {
+        QVector<WriteData> *results = alignContext->bestMode ? NULL : new QVector<WriteData>();
+        for (int i = item->begin; i < item->end; i++) {
+            ShortReadData srData(dataBunch, i);
+            GA_CHECK_CONTINUE(srData.valid);
+            if (alignContext->bestMode && srData.haveExactResult()) {
+                continue;
+            }
+
+            BinarySearchResult bmr = bunch->binarySearchResults[i];
+            index->alignShortRead(srData.shortRead, srData.bv, srData.pos, bmr, alignContext, srData.currentBitFilter, srData.currentW);
+
+            if (NULL != results) {
+                if ((i == length - 1) || (srData.nextRn != srData.rn)) {
+                    if (srData.shortRead->haveResult()) {
+                        GenomeAlignerWriteTask::appendResults(srData.shortRead, *results);
+                    }
+                    srData.shortRead->onPartChanged();
+                }
+            }
+        }
+        if (NULL != results) {
+            writeTask->addResults(results);
+        }
+    }
+
+    const PipelineItem::Stage stage = item->stage;
+    delete item;
+    if (!bunch->unfinishedItems.deref()) {
+        if (PipelineItem::Search == stage) {
+            schedulePipelineItems(parent, parent->createPipelineItems(bunch, PipelineItem::Align));
+        } else {
+            delete bunch;
+            parent->bunchesInWork.deref();
+        }
+    }
+}
 
 ShortReadAlignerOpenCL::ShortReadAlignerOpenCL(int taskNo, GenomeAlignerIndex *i, AlignContext *s, GenomeAlignerWriteTask *w)
 : Task("ShortReadAlignerOpenCL", TaskFlag_None), taskNo(taskNo), index(i), alignContext(s), writeTask(w)
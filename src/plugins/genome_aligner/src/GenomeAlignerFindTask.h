@@ -26,6 +26,7 @@
 #include "GenomeAlignerWriteTask.h"
 #include "DataBunch.h"
 
+#include <U2Core/BoundedLockFreeQueue.h>
 #include <U2Core/Task.h>
 #include <U2Core/U2Region.h>
 #include <U2Core/DNASequence.h>
@@ -86,7 +87,7 @@ struct ShortReadData {
 class AlignContext {
 public:
     AlignContext(): w(-1), ptMismatches(0), nMismatches(0), absMismatches(0), bestMode(false),
-        openCL(false), minReadLength(-1), maxReadLength(-1), isReadingFinished(false), isReadingStarted(false),
+        openCL(false), pipelined(false), minReadLength(-1), maxReadLength(-1), isReadingFinished(false), isReadingStarted(false),
         needIndex(true), indexLoaded(-1) {}
     ~AlignContext() {
         cleanVectors();
@@ -97,6 +98,7 @@ public:
     bool absMismatches;
     bool bestMode;
     bool openCL;
+    bool pipelined;
     int minReadLength;
     int maxReadLength;
 
@@ -116,6 +118,35 @@ public:
     }
 };
 
+/**
+ * A data bunch that is being processed by the pipelined CPU aligners.
+ * The bunch is split into items: at first the sorted bit values are searched in the index
+ * by several "search" items, then the reads are aligned by several "align" items.
+ */
+struct PipelineBunch {
+    PipelineBunch(DataBunch *dataBunch): dataBunch(dataBunch) {}
+
+    DataBunch *dataBunch;
+    QVector<BinarySearchResult> binarySearchResults;
+    // the count of unprocessed items of the current stage
+    QAtomicInt unfinishedItems;
+};
+
+struct PipelineItem {
+    enum Stage {
+        Search,
+        Align
+    };
+
+    PipelineItem(Stage stage, PipelineBunch *bunch, int begin, int end)
+        : stage(stage), bunch(bunch), begin(begin), end(end) {}
+
+    Stage stage;
+    PipelineBunch *bunch;
+    int begin;
+    int end;
+};
+
 #define MAX_PERCENTAGE 100
 class GenomeAlignerFindTask : public Task {
     Q_OBJECT
@@ -123,6 +154,7 @@ class GenomeAlignerFindTask : public Task {
     friend class ShortReadAlignerOpenCL;
 public:
     GenomeAlignerFindTask(GenomeAlignerIndex *i, AlignContext *s, GenomeAlignerWriteTask *writeTask);
+    ~GenomeAlignerFindTask();
     virtual void run();
     virtual void prepare();
 
@@ -132,6 +164,10 @@ protected:
     void requirePartForAligning(int part);
     DataBunch *waitForDataBunch();
 
+    // pipelined mode
+    DataBunch *tryTakeDataBunch(bool &noMoreData);
+    QList<PipelineItem*> createPipelineItems(PipelineBunch *bunch, PipelineItem::Stage stage) const;
+
 private:
     GenomeAlignerIndex *index;
     GenomeAlignerWriteTask *writeTask;
@@ -142,6 +178,14 @@ private:
     int nextElementToGive;
     qint64 indexLoadTime;
 
+    BoundedLockFreeQueue<PipelineItem*> pipelineItems;
+    QAtomicInt nextBunchToTake;
+    QAtomicInt bunchesInWork;
+
+    static const int PIPELINE_ITEM_SIZE = 16384;
+    static const int PIPELINE_QUEUE_SIZE = 1024;
+    static const int PIPELINE_IDLE_WAIT_MS = 1;
+
     QMutex loadPartMutex;
     QMutex waitDataForAligningMutex;
     QMutex waitMutex;
@@ -169,6 +213,10 @@ public:
     ShortReadAlignerCPU(int taskNo, GenomeAlignerIndex *index, AlignContext *alignContext, GenomeAlignerWriteTask *writeTask);
     virtual void run();
 private:
+    void runPipeline(GenomeAlignerFindTask *parent);
+    void schedulePipelineItems(GenomeAlignerFindTask *parent, const QList<PipelineItem*> &items);
+    void processPipelineItem(GenomeAlignerFindTask *parent, PipelineItem *item);
+
     int taskNo;
     GenomeAlignerIndex *index;
     AlignContext *alignContext;
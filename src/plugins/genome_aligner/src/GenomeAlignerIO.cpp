@@ -44,7 +44,15 @@ namespace U2 {
 /************************************************************************/
 
 GenomeAlignerUrlReader::GenomeAlignerUrlReader(const QList<GUrl> &dnaList) {
-    initOk = reader.init(dnaList);
+    initOk = reader.init(dnaList, true);
+}
+
+QList<Task*> GenomeAlignerUrlReader::createParallelReadingTasks(int tasksCount) {
+    return reader.createParallelReadingTasks(tasksCount);
+}
+
+void GenomeAlignerUrlReader::stopParallelReading() {
+    reader.stopParallelReading();
 }
 
 bool GenomeAlignerUrlReader::isEnd() {
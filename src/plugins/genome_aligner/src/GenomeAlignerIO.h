@@ -98,6 +98,9 @@ public:
     inline SearchQuery *read();
     inline bool isEnd();
     int getProgress();
+    /** FASTQ files are parsed in advance by these tasks, see StreamSequenceReader::createParallelReadingTasks() */
+    QList<Task*> createParallelReadingTasks(int tasksCount);
+    void stopParallelReading();
 private:
     bool initOk;
     StreamSequenceReader reader;
@@ -21,6 +21,7 @@
 
 #include <U2Core/Timer.h>
 #include <U2Core/Counter.h>
+#include <U2Core/U2SafePoints.h>
 #include <U2Algorithm/BinaryFindOpenCL.h>
 #include <U2Algorithm/SyncSort.h>
 #include <QtCore/QFile>
@@ -240,35 +241,26 @@ bool GenomeAlignerIndex::loadPart(int part) {
             build = false;
             serialize(baseFileName + "." + REF_INDEX_EXTENSION);
         }
+        buildLookupTable();
         return true;
     } else {
         GTIMER(c, v, "GenomeAlignerIndex::load");
-        return indexPart.load(part);
+        lookupTable.clear();
+        CHECK(indexPart.load(part), false);
+        buildLookupTable();
+        return true;
     }
 }
 
+void GenomeAlignerIndex::buildLookupTable() {
+    qint64 t0 = GTimer::currentTimeMicros();
+    lookupTable.build(indexPart.bitMask, indexPart.getLoadedPartSize(), 2 * MAX_BIT_MASK_LENGTH);
+    algoLog.trace(QString("loadPart::lookup table of %1 bits (%2 Kb) built in %3 ms")
+        .arg(lookupTable.getPrefixBits()).arg(lookupTable.getMemoryUsage() / 1024).arg((GTimer::currentTimeMicros() - t0) / double(1000), 0, 'f', 3));
+}
+
 BinarySearchResult GenomeAlignerIndex::bitMaskBinarySearch(BMType bitValue, BMType bitFilter) {
-    int low = 0;
-    int high = indexPart.getLoadedPartSize() - 1;
-    BMType *a = indexPart.bitMask;
-    qint64 rc = 0;
-    while (low <= high) {
-        int mid = (low + high) / 2;
-        rc = (a[mid]&bitFilter) - (bitValue&bitFilter);
-        if (rc < 0) {
-            low = mid + 1;
-        } else if (rc > 0) {
-            high = mid - 1;
-        } else {
-            for(high=mid-1;high >= 0 && (a[high]&bitFilter)==(bitValue&bitFilter); high--){};
-            high++;
-            break;
-        }
-    }
-    if (0==rc) {
-        return high;
-    }
-    return -1;
+    return lookupTable.find(bitValue, bitFilter);
 }
 
 #ifdef OPENCL_SUPPORT
@@ -23,6 +23,7 @@
 #define _U2_GENOME_ALIGNER_INDEX_H_
 
 #include <U2Core/Task.h>
+#include <U2Algorithm/BitMaskLookupTable.h>
 #include <U2Algorithm/BitsTable.h>
 #include <QtCore/QFile>
 #include "GenomeAlignerIndexPart.h"
@@ -75,12 +76,14 @@ private:
     QString         seqObjName;
     int             currentPart;
     IndexPart       indexPart;
+    BitMaskLookupTable lookupTable;  //accelerates bitMaskBinarySearch in the loaded part
     bool            build;
     char            unknownChar;
 
     void serialize(const QString &refFileName);
     bool deserialize(QByteArray &error);
     bool openIndexFiles();
+    void buildLookupTable();
     inline bool isValidPos(SAType offset, int startPos, int length, SAType &fisrtSymbol, SearchQuery *qu, SAType &loadedSeqStart);
     inline bool compare(const char *sourceSeq, const char *querySeq, int startPos, int w, int &c, int CMAX, int length);
     inline void fullBitMaskOptimization(int CMAX, BMType bitValue, BMType bitMaskValue, int restBits, int w, int &bits, int &c);
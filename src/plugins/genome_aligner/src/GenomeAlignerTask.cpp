@@ -64,6 +64,7 @@ const QString GenomeAlignerTask::OPTION_DBI_IO("dbi_io");
 const QString GenomeAlignerTask::OPTION_QUAL_THRESHOLD("quality_threshold");
 const QString GenomeAlignerTask::OPTION_READS_MEMORY_SIZE("reads_mem_size");
 const QString GenomeAlignerTask::OPTION_SEQ_PART_SIZE("seq_part_size");
+const QString GenomeAlignerTask::OPTION_PIPELINED("pipelined");
 
 GenomeAlignerTask::GenomeAlignerTask( const DnaAssemblyToRefTaskSettings& _settings, bool _justBuildIndex )
 : DnaAssemblyToReferenceTask(_settings, TaskFlags_NR_FOSE_COSC | TaskFlag_ReportingIsSupported | TaskFlag_ReportingIsEnabled, _justBuildIndex),
@@ -101,6 +102,7 @@ GenomeAlignerTask::GenomeAlignerTask( const DnaAssemblyToRefTaskSettings& _setti
     alignContext.ptMismatches = settings.getCustomValue(OPTION_PERCENTAGE_MISMATCHES, 0).toInt();
     qualityThreshold = settings.getCustomValue(OPTION_QUAL_THRESHOLD, 0).toInt();
     alignContext.bestMode = settings.getCustomValue(OPTION_BEST, false).toBool();
+    alignContext.pipelined = !alignContext.openCL && settings.getCustomValue(OPTION_PIPELINED, false).toBool();
     seqPartSize = settings.getCustomValue(OPTION_SEQ_PART_SIZE, 10).toInt();
     readMemSize = settings.getCustomValue(OPTION_READS_MEMORY_SIZE, 10).toInt();
     prebuiltIndex = settings.prebuiltIndex;
@@ -193,6 +195,9 @@ QList<Task*> GenomeAlignerTask::onSubTaskFinished( Task* subTask ) {
         if (!justBuildIndex && !alignContext.bestMode) {
             pWriteTask->setFinished();
         }
+        if (NULL != seqReader) {
+            seqReader->stopParallelReading();
+        }
         return subTasks;
     }
 
@@ -229,6 +234,11 @@ QList<Task*> GenomeAlignerTask::onSubTaskFinished( Task* subTask ) {
             pWriteTask->setSeqWriter(seqWriter);
         }
         taskLog.details(QString("Genome aligner index creation time: %1 sec.").arg((double)time/(1000*1000)));
+
+        foreach (Task* parseTask, seqReader->createParallelReadingTasks(AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount())) {
+            parseTask->setSubtaskProgressWeight(0.0f);
+            subTasks.append(parseTask);
+        }
     }
 
     if (subTask == findTask) {
@@ -65,6 +65,7 @@ public:
     static const QString OPTION_DBI_IO;
     static const QString OPTION_READS_MEMORY_SIZE;
     static const QString OPTION_SEQ_PART_SIZE;
+    static const QString OPTION_PIPELINED;
     static const int MIN_SHORT_READ_LENGTH = 30;
     static int calculateWindowSize(bool absMismatches, int nMismatches, int ptMismatches, int minReadLength, int maxReadLength);
 
@@ -78,7 +79,7 @@ private:
     GenomeAlignerWriteTask *pWriteTask;
     Task* unzipTask;
 
-    GenomeAlignerReader *seqReader;
+    GenomeAlignerUrlReader *seqReader;
     GenomeAlignerWriter *seqWriter;
     AlignContext alignContext;
 
@@ -19,38 +19,86 @@
 * MA 02110-1301, USA.
 */
 
+#include <QThread>
+
+#include <U2Core/U2SafePoints.h>
+
 #include "GenomeAlignerWriteTask.h"
 
 namespace U2 {
 
 GenomeAlignerWriteTask::GenomeAlignerWriteTask(GenomeAlignerWriter *s)
 : Task("WriteAlignedReadsSubTask", TaskFlag_None),
-seqWriter(s), end(false), writing(false), readsWritten(0)
+seqWriter(s), batches(MAX_BATCHES_COUNT), end(false), writing(false), readsWritten(0)
 {
 }
 
+GenomeAlignerWriteTask::~GenomeAlignerWriteTask() {
+    QVector<WriteData> *batch = NULL;
+    while (batches.tryPop(batch)) {
+        delete batch;
+    }
+}
+
 void GenomeAlignerWriteTask::setSeqWriter(GenomeAlignerWriter *seqWriter) {
     this->seqWriter = seqWriter;
 }
 
-void GenomeAlignerWriteTask::addResult(SearchQuery *qu) {
-    listMutex.lock();
+void GenomeAlignerWriteTask::appendResults(SearchQuery *qu, QVector<WriteData> &batch) {
     WriteData data;
-
     foreach (SAType offset, qu->getResults()) {
         data.qu = qu;
         data.offset = offset;
-        results.append(data);
+        batch.append(data);
     }
+}
+
+void GenomeAlignerWriteTask::addResult(SearchQuery *qu) {
+    listMutex.lock();
+    appendResults(qu, results);
+    const bool wake = results.size() > MAX_LIST_SIZE;
+    listMutex.unlock();
+
+    if (wake) {
+        wakeWriter();
+    }
+}
 
-    if (!writing && results.size() > 1000) {
+void GenomeAlignerWriteTask::addResults(QVector<WriteData> *batch) {
+    CHECK_EXT(!batch->isEmpty(), delete batch, );
+    // the queue is bounded: producers wait for the writer instead of piling up results in memory
+    while (!batches.tryPush(batch)) {
+        if (!wakeWriter()) {
+            delete batch;
+            return;
+        }
+        QThread::yieldCurrentThread();
+    }
+    wakeWriter();
+}
+
+bool GenomeAlignerWriteTask::wakeWriter() {
+    QMutexLocker locker(&waitMutex);
+    if (!writing) {
         writing = true;
         waiter.wakeAll();
     }
-    listMutex.unlock();
+    return !end;
+}
+
+void GenomeAlignerWriteTask::writeBatches() {
+    QVector<WriteData> *batch = NULL;
+    while (batches.tryPop(batch)) {
+        foreach (const WriteData &data, *batch) {
+            seqWriter->write(data.qu, data.offset);
+            setReadWritten(data.qu, data.qu->getRevCompl());
+        }
+        delete batch;
+    }
 }
 
 void GenomeAlignerWriteTask::setFinished() {
+    QMutexLocker locker(&waitMutex);
     end = true;
     waiter.wakeAll();
 }
@@ -63,6 +111,7 @@ void GenomeAlignerWriteTask::flush() {
             setReadWritten(data.qu, data.qu->getRevCompl());
         }
         results.clear();
+        writeBatches();
         writeMutex.unlock();
     } catch (QString exeptionMessage) {
         setError(exeptionMessage);
@@ -72,12 +121,16 @@ void GenomeAlignerWriteTask::flush() {
 void GenomeAlignerWriteTask::run() {
     stateInfo.setProgress(0);
     try {
-        do {
+        forever {
+            // the flags are changed under the mutex only, so a signal can't be lost between the check and the wait
             waitMutex.lock();
+            while (!writing && !end) {
+                waiter.wait(&waitMutex);
+            }
             writing = false;
-            waiter.wait(&waitMutex);
-            if (end) {
-                writing = false;
+            const bool finished = end;
+            waitMutex.unlock();
+            if (finished) {
                 break;
             }
 
@@ -86,15 +139,15 @@ void GenomeAlignerWriteTask::run() {
             newResults += (results);
             results.clear();
             listMutex.unlock();
-            waitMutex.unlock();
 
             writeMutex.lock();
             foreach (WriteData data, newResults) {
                 seqWriter->write(data.qu, data.offset);
                 setReadWritten(data.qu, data.qu->getRevCompl());
             }
+            writeBatches();
             writeMutex.unlock();
-        } while (!end);
+        }
     } catch (QString exeptionMessage) {
         setError(exeptionMessage);
     }
@@ -26,6 +26,8 @@
 #include "GenomeAlignerIO.h"
 #include "GenomeAlignerSearchQuery.h"
 
+#include <U2Core/BoundedLockFreeQueue.h>
+
 #include <QWaitCondition>
 #include <QMutex>
 #include <QList>
@@ -42,9 +44,13 @@ class GenomeAlignerWriteTask : public Task {
     Q_OBJECT
 public:
     GenomeAlignerWriteTask(GenomeAlignerWriter *seqWriter);
+    ~GenomeAlignerWriteTask();
     virtual void run();
 
     void addResult(SearchQuery *qu);
+    /** Lock-free variant for the pipelined aligner: takes the ownership of the batch */
+    void addResults(QVector<WriteData> *batch);
+    static void appendResults(SearchQuery *qu, QVector<WriteData> &batch);
     void flush();
     void setFinished();
     quint64 getWrittenReadsCount() const {return readsWritten;}
@@ -52,6 +58,7 @@ public:
 private:
     GenomeAlignerWriter *seqWriter;
     QVector<WriteData> results;
+    BoundedLockFreeQueue<QVector<WriteData>*> batches;
     bool end;
     bool writing;
     quint64 readsWritten;
@@ -62,7 +69,11 @@ private:
     QWaitCondition waiter;
 
     static const int MAX_LIST_SIZE = 1000;
+    static const int MAX_BATCHES_COUNT = 256;
 
+    /** Returns false if the task is finished and the results are not written anymore */
+    bool wakeWriter();
+    void writeBatches();
     inline void setReadWritten(SearchQuery *read, SearchQuery *revCompl);
 };
 } //namespace
@@ -13,9 +13,11 @@ HEADERS += src/FindRepeatsDialog.h \
            src/RFBase.h \
            src/RFConstants.h \
            src/RFDiagonal.h \
+           src/RFNestedRepeatsFilter.h \
            src/RFSArray.h \
            src/RFSArrayWK.h \
            src/RFTaskFactory.h \
+           src/RFUniqueRepeatsFilter.h \
            src/RepeatQuery.h \
            src/TandemQuery.h
 FORMS += src/FindRepeatsDialog.ui src/FindTandemsDialog.ui
@@ -29,9 +31,11 @@ SOURCES += src/FindRepeatsDialog.cpp \
            src/RF_SuffixArray.cpp \
            src/RFBase.cpp \
            src/RFDiagonal.cpp \
+           src/RFNestedRepeatsFilter.cpp \
            src/RFSArray.cpp \
            src/RFSArrayWK.cpp \
            src/RFTaskFactory.cpp \
+           src/RFUniqueRepeatsFilter.cpp \
            src/RepeatQuery.cpp \
            src/TandemQuery.cpp
 RESOURCES += repeat_finder.qrc
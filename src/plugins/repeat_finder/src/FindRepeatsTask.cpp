@@ -78,6 +78,9 @@ seq1(seq), seq2(seq2), tandemTask1(NULL), tandemTask2(NULL)
         settings.seq2Region = U2Region(0, seq2.length());
     }
 
+    // nesting with mismatches is not transitive, the result of the sorted filter depends on the order
+    filterNestedOnline = settings.filter == DisjointRepeats && settings.mismatches == 0;
+
     revComplTask = NULL;
     rfTask = NULL;
     startTime = GTimer::currentTimeMicros();
@@ -176,12 +179,16 @@ void FindRepeatsTask::run()
         if (settings.filter == UniqueRepeats)
         {
             stateInfo.setDescription(tr("Filtering unique results"));
-            filterUniqueRepeats();
+            takeUniqueFilterResults();
         }
         if (settings.filter == DisjointRepeats)
         {
             stateInfo.setDescription(tr("Filtering nested results"));
-            filterNestedRepeats();
+            if (filterNestedOnline) {
+                takeNestedFilterResults();
+            } else {
+                filterNestedRepeats();
+            }
         }
     }
 }
@@ -196,60 +203,21 @@ Task::ReportResult FindRepeatsTask::report() {
     return ReportResult_Finished;
 }
 
-bool CompareResultLen(RFResult r1, RFResult r2)
-{
-    return r1.l < r2.l;
-}
-
-void FindRepeatsTask::filterUniqueRepeats()
-{
+void FindRepeatsTask::filterNestedRepeats() {
     quint64 t1 = GTimer::currentTimeMicros();
-
-    qSort(results.begin(), results.end(), CompareResultLen);
-
-    bool changed = false;
-    for (int i=0, n = results.size(); i < n; i++)
-    {
-        RFResult& ri = results[i];
-
-        for (int j = i+1; j < results.size(); j++)
-        {
-            int Index = results[j].fragment.indexOf(ri.fragment);
-            if (Index != -1)
-            {
-                changed = true;
-                ri.l = -1;
-                break;
-            }
-        }
-    }
     int nBefore = results.size();
-    if (changed)
-    {
-        QVector<RFResult> prev = results;
-        results.clear();
-        foreach(const RFResult& r, prev)
-        {
-            if (r.l!=-1)
-            {
-                results.append(r);
-            }
-        }
-    }
+    removeNestedRepeats(results, settings.mismatches); //extra len added to repeat region to search for duplicates
     int nAfter = results.size();
     quint64 t2 = GTimer::currentTimeMicros();
-    perfLog.details(tr("Unique repeats filtering time %1 sec, results before: %2, filtered: %3, after %4")
+    perfLog.details(tr("Nested repeats filtering time %1 sec, results before: %2, filtered: %3, after %4")
         .arg(double((t2-t1))/(1000*1000)).arg(nBefore).arg(nBefore - nAfter).arg(nAfter));
 }
 
-void FindRepeatsTask::filterNestedRepeats() {
+void FindRepeatsTask::removeNestedRepeats(QVector<RFResult>& results, int extraLen) {
     //if one repeats fits into another repeat -> filter it
-    quint64 t1 = GTimer::currentTimeMicros();
-
     qSort(results);
 
     bool changed = false;
-    int extraLen = settings.mismatches; //extra len added to repeat region to search for duplicates
     for (int i=0, n = results.size(); i < n; i++) {
         RFResult& ri = results[i];
         if (ri.l == -1) { //this result was filtered
@@ -287,7 +255,6 @@ void FindRepeatsTask::filterNestedRepeats() {
             }
         }
     }
-    int nBefore = results.size();
     if (changed) {
         QVector<RFResult> prev = results;
         results.clear();
@@ -297,15 +264,33 @@ void FindRepeatsTask::filterNestedRepeats() {
             }
         }
     }
+}
+
+void FindRepeatsTask::takeNestedFilterResults() {
+    results = nestedRepeatsFilter.getResults();
+    const qint64 nBefore = nestedRepeatsFilter.getAddedCount();
+    nestedRepeatsFilter.clear();
+
     int nAfter = results.size();
-    quint64 t2 = GTimer::currentTimeMicros();
-    perfLog.details(tr("Nested repeats filtering time %1 sec, results before: %2, filtered: %3, after %4")
-        .arg(double((t2-t1))/(1000*1000)).arg(nBefore).arg(nBefore - nAfter).arg(nAfter));
+    perfLog.details(tr("Nested repeats were filtered while searching, results before: %1, filtered: %2, after %3")
+        .arg(nBefore).arg(nBefore - nAfter).arg(nAfter));
+}
+
+void FindRepeatsTask::takeUniqueFilterResults() {
+    results = uniqueRepeatsFilter.getResults();
+    const qint64 nBefore = uniqueRepeatsFilter.getAddedCount();
+    uniqueRepeatsFilter.clear();
+
+    int nAfter = results.size();
+    perfLog.details(tr("Unique repeats were filtered while searching, results before: %1, filtered: %2, after %3")
+        .arg(nBefore).arg(nBefore - nAfter).arg(nAfter));
 }
 
 void FindRepeatsTask::cleanup() {
     seq1.seq.clear();
     results.clear();
+    nestedRepeatsFilter.clear();
+    uniqueRepeatsFilter.clear();
 }
 
 void FindRepeatsTask::addResult(const RFResult& r)
@@ -353,15 +338,24 @@ void FindRepeatsTask::_addResult(int x, int y, int l, int c)
 {
     const QByteArray& locDNA = seq1.constSequence();
 
+    RFResult r;
     if (settings.reportReflected || x <= y)
     {
         QString locFragment = QString(locDNA.mid(x,l));
-        results.append(RFResult(x, y, l, c, locFragment));
+        r = RFResult(x, y, l, c, locFragment);
     }
     else
     {
         QString locFragment = QString(locDNA.mid(y,l));
-        results.append(RFResult(y, x, l, c, locFragment));
+        r = RFResult(y, x, l, c, locFragment);
+    }
+
+    if (filterNestedOnline) {
+        nestedRepeatsFilter.addResult(r);
+    } else if (settings.filter == UniqueRepeats) {
+        uniqueRepeatsFilter.addResult(r);
+    } else {
+        results.append(r);
     }
 }
 
@@ -23,6 +23,8 @@
 #define _U2_FIND_REPEATS_TASK_H_
 
 #include "RFBase.h"
+#include "RFNestedRepeatsFilter.h"
+#include "RFUniqueRepeatsFilter.h"
 
 #include <U2Core/Task.h>
 #include <U2Core/GObjectReference.h>
@@ -102,13 +104,17 @@ public:
     QVector<RFResult> getResults() const {return results;} // used if createAnnotations == false
     const FindRepeatsTaskSettings&  getSettings() const {return settings;}
 
+    /** Removes the repeats that fit into other repeats with 'extraLen' positions of slack. Sorts the results */
+    static void removeNestedRepeats(QVector<RFResult>& results, int extraLen);
+
 protected:
     void addResult(const RFResult& r);
     void _addResult(int x, int y, int l, int c);
     bool isFilteredByRegions(const RFResult& r);
     RFAlgorithmBase* createRFTask();
     void filterNestedRepeats();
-    void filterUniqueRepeats();
+    void takeNestedFilterResults();
+    void takeUniqueFilterResults();
     Task *createRepeatFinderTask();
     void filterTandems(const QList<SharedAnnotationData> &tandems, DNASequence &se);
 
@@ -116,6 +122,10 @@ protected:
     FindRepeatsTaskSettings     settings;
     DNASequence                 seq1, seq2;
     QVector<RFResult>           results;
+    // filters nested repeats while they are found, it is used for the repeats without mismatches
+    bool                        filterNestedOnline;
+    RFNestedRepeatsFilter       nestedRepeatsFilter;
+    RFUniqueRepeatsFilter       uniqueRepeatsFilter;
     QMutex                      resultsLock;
     RevComplSequenceTask*       revComplTask;
     RFAlgorithmBase*            rfTask;
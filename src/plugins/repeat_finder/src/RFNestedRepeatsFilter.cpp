@@ -0,0 +1,130 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QtCore/QtAlgorithms>
+
+#include "RFNestedRepeatsFilter.h"
+
+namespace U2 {
+
+const int RFNestedRepeatsFilter::BUCKET_SIZE = 1024;
+
+RFNestedRepeatsFilter::RFNestedRepeatsFilter()
+    : addedCount(0)
+{
+
+}
+
+void RFNestedRepeatsFilter::addResult(const RFResult& r) {
+    addedCount++;
+
+    // a repeat that contains the new one intersects the bucket of its start
+    const QVector<int> candidates = slotsByBucket.value(getFirstBucket(r));
+    foreach (int slot, candidates) {
+        if (contains(results[slot], r)) {
+            return;
+        }
+    }
+
+    // the repeats contained in the new one start in its buckets
+    QVector<int> nestedSlots;
+    for (int bucket = getFirstBucket(r), lastBucket = getLastBucket(r); bucket <= lastBucket; bucket++) {
+        const QVector<int> bucketSlots = slotsByBucket.value(bucket);
+        foreach (int slot, bucketSlots) {
+            const RFResult& kept = results[slot];
+            if (getFirstBucket(kept) == bucket && contains(r, kept)) {
+                nestedSlots << slot;
+            }
+        }
+    }
+    foreach (int slot, nestedSlots) {
+        removeResult(slot);
+    }
+
+    int slot = results.size();
+    if (freeSlots.isEmpty()) {
+        results.append(r);
+    } else {
+        slot = freeSlots.last();
+        freeSlots.resize(freeSlots.size() - 1);
+        results[slot] = r;
+    }
+    for (int bucket = getFirstBucket(r), lastBucket = getLastBucket(r); bucket <= lastBucket; bucket++) {
+        slotsByBucket[bucket].append(slot);
+    }
+}
+
+QVector<RFResult> RFNestedRepeatsFilter::getResults() const {
+    QVector<RFResult> res;
+    res.reserve(getResultsCount());
+    foreach (const RFResult& r, results) {
+        if (r.l >= 0) {
+            res.append(r);
+        }
+    }
+    qSort(res);
+    return res;
+}
+
+qint64 RFNestedRepeatsFilter::getAddedCount() const {
+    return addedCount;
+}
+
+int RFNestedRepeatsFilter::getResultsCount() const {
+    return results.size() - freeSlots.size();
+}
+
+void RFNestedRepeatsFilter::clear() {
+    results.clear();
+    freeSlots.clear();
+    slotsByBucket.clear();
+    addedCount = 0;
+}
+
+bool RFNestedRepeatsFilter::contains(const RFResult& outer, const RFResult& inner) {
+    return outer.x <= inner.x && inner.x + inner.l <= outer.x + outer.l
+        && outer.y <= inner.y && inner.y + inner.l <= outer.y + outer.l;
+}
+
+int RFNestedRepeatsFilter::getFirstBucket(const RFResult& r) {
+    return r.x / BUCKET_SIZE;
+}
+
+int RFNestedRepeatsFilter::getLastBucket(const RFResult& r) {
+    return (r.x + qMax(r.l, 1) - 1) / BUCKET_SIZE;
+}
+
+void RFNestedRepeatsFilter::removeResult(int slot) {
+    RFResult& r = results[slot];
+    for (int bucket = getFirstBucket(r), lastBucket = getLastBucket(r); bucket <= lastBucket; bucket++) {
+        QVector<int>& bucketSlots = slotsByBucket[bucket];
+        bucketSlots.remove(bucketSlots.indexOf(slot));
+        if (bucketSlots.isEmpty()) {
+            slotsByBucket.remove(bucket);
+        }
+    }
+    r = RFResult();
+    r.l = -1;
+    freeSlots.append(slot);
+}
+
+}   // namespace U2
@@ -0,0 +1,77 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_RF_NESTED_REPEATS_FILTER_H_
+#define _U2_RF_NESTED_REPEATS_FILTER_H_
+
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+#include "RFBase.h"
+
+namespace U2 {
+
+/**
+ * Filters the repeats that fit into other repeats: both regions of a nested repeat
+ * are inside the corresponding regions of a longer repeat. Equal repeats are kept once.
+ *
+ * The repeats are filtered while they are added, so only the kept ones are stored.
+ * They are indexed by the buckets of the first region positions: a repeat is registered in every bucket
+ * its first region intersects, so the repeats that may contain a new one are found in the bucket of its start.
+ * The index is not keyed by the diagonal (y - x): in periodic regions a repeat contains shorter repeats
+ * of the neighbour diagonals, e.g. (0, 2, 20) contains (2, 6, 10) in "ACAC...", and they must be filtered too.
+ * The result does not depend on the order the repeats are added in.
+ */
+class RFNestedRepeatsFilter {
+public:
+    RFNestedRepeatsFilter();
+
+    void addResult(const RFResult& r);
+
+    /** The kept repeats sorted by their positions */
+    QVector<RFResult> getResults() const;
+
+    qint64 getAddedCount() const;
+
+    int getResultsCount() const;
+
+    void clear();
+
+    static const int BUCKET_SIZE;
+
+private:
+    static bool contains(const RFResult& outer, const RFResult& inner);
+    static int getFirstBucket(const RFResult& r);
+    static int getLastBucket(const RFResult& r);
+
+    void removeResult(int slot);
+
+    // the kept repeats, the free slots have a negative length
+    QVector<RFResult> results;
+    QVector<int> freeSlots;
+    QHash<int, QVector<int> > slotsByBucket;
+    qint64 addedCount;
+};
+
+}   // namespace U2
+
+#endif // _U2_RF_NESTED_REPEATS_FILTER_H_
@@ -0,0 +1,114 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QtCore/QtAlgorithms>
+
+#include "RFUniqueRepeatsFilter.h"
+
+namespace U2 {
+
+namespace {
+
+bool lessByLength(const RFResult& r1, const RFResult& r2) {
+    return (r1.l != r2.l) ? r1.l < r2.l : r1 < r2;
+}
+
+}
+
+RFUniqueRepeatsFilter::RFUniqueRepeatsFilter()
+    : addedCount(0)
+{
+
+}
+
+void RFUniqueRepeatsFilter::addResult(const RFResult& r) {
+    addedCount++;
+
+    const int equalSlot = slotByFragment.value(r.fragment, -1);
+    if (-1 != equalSlot) {
+        if (r < results[equalSlot]) {
+            results[equalSlot] = r;
+        }
+        return;
+    }
+
+    QVector<int> includedSlots;
+    for (int slot = 0; slot < results.size(); slot++) {
+        const RFResult& kept = results[slot];
+        if (kept.l < 0) {
+            continue;
+        }
+        if (kept.fragment.length() > r.fragment.length()) {
+            if (kept.fragment.contains(r.fragment)) {
+                return;
+            }
+        } else if (r.fragment.contains(kept.fragment)) {
+            includedSlots << slot;
+        }
+    }
+    foreach (int slot, includedSlots) {
+        removeResult(slot);
+    }
+
+    int slot = results.size();
+    if (freeSlots.isEmpty()) {
+        results.append(r);
+    } else {
+        slot = freeSlots.last();
+        freeSlots.resize(freeSlots.size() - 1);
+        results[slot] = r;
+    }
+    slotByFragment.insert(r.fragment, slot);
+}
+
+QVector<RFResult> RFUniqueRepeatsFilter::getResults() const {
+    QVector<RFResult> res;
+    res.reserve(results.size() - freeSlots.size());
+    foreach (const RFResult& r, results) {
+        if (r.l >= 0) {
+            res.append(r);
+        }
+    }
+    qSort(res.begin(), res.end(), lessByLength);
+    return res;
+}
+
+qint64 RFUniqueRepeatsFilter::getAddedCount() const {
+    return addedCount;
+}
+
+void RFUniqueRepeatsFilter::clear() {
+    results.clear();
+    freeSlots.clear();
+    slotByFragment.clear();
+    addedCount = 0;
+}
+
+void RFUniqueRepeatsFilter::removeResult(int slot) {
+    RFResult& r = results[slot];
+    slotByFragment.remove(r.fragment);
+    r = RFResult();
+    r.l = -1;
+    freeSlots.append(slot);
+}
+
+}   // namespace U2
@@ -0,0 +1,66 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_RF_UNIQUE_REPEATS_FILTER_H_
+#define _U2_RF_UNIQUE_REPEATS_FILTER_H_
+
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+#include "RFBase.h"
+
+namespace U2 {
+
+/**
+ * Filters the repeats whose fragment is a part of a fragment of another repeat.
+ * Of the repeats with equal fragments the first one by position is kept.
+ *
+ * The repeats are filtered while they are added, so only the kept ones are stored:
+ * equal fragments are found by a hash, a new fragment is searched in the kept fragments only.
+ * The result does not depend on the order the repeats are added in.
+ */
+class RFUniqueRepeatsFilter {
+public:
+    RFUniqueRepeatsFilter();
+
+    void addResult(const RFResult& r);
+
+    /** The kept repeats sorted by their lengths and positions */
+    QVector<RFResult> getResults() const;
+
+    qint64 getAddedCount() const;
+
+    void clear();
+
+private:
+    void removeResult(int slot);
+
+    // the kept repeats, the free slots have a negative length
+    QVector<RFResult> results;
+    QVector<int> freeSlots;
+    QHash<QString, int> slotByFragment;
+    qint64 addedCount;
+};
+
+}   // namespace U2
+
+#endif // _U2_RF_UNIQUE_REPEATS_FILTER_H_
@@ -22,6 +22,8 @@
 #include "RepeatFinderTests.h"
 
 #include "FindRepeatsTask.h"
+#include "RFNestedRepeatsFilter.h"
+#include "RFUniqueRepeatsFilter.h"
 #include "RF_SArray_TandemFinder.h"
 #include <U2Core/DNAAlphabet.h>
 #include <U2Core/AppContext.h>
@@ -51,6 +53,7 @@ namespace U2 {
 #define QUERY       "query"
 #define USE_BITMASK "bit-mask"
 #define MISMATCHES  "mismatches"
+#define INDEX_TASK  "index-task"
 #define ALG_ATTR    "alg"
 
 
@@ -583,6 +586,10 @@ void GTest_SArrayBasedFindTask::init(XMLTestFormat *tf, const QDomElement& el) {
 
     useBitMask = el.attribute(USE_BITMASK) == "true";
 
+    useIndexTask = el.attribute(INDEX_TASK) == "true";
+    indexTask = NULL;
+    findTask = NULL;
+
     query = el.attribute(QUERY);
     if (query.isEmpty()) {
         stateInfo.setError(QString("Value not found: '%1'").arg(QUERY));
@@ -623,23 +630,38 @@ void GTest_SArrayBasedFindTask::prepare() {
 
     wholeSeq = seqObj->getWholeSequenceData(stateInfo);
     CHECK_OP(stateInfo, );
+
+    settings.query = query.toLatin1();
+    settings.useBitMask = useBitMask;
+    settings.bitMask = bitMask;
+    settings.nMismatches = nMismatches;
+    settings.bitMaskCharBitsNum = bitCharLen;
+    settings.unknownChar = unknownChar;
+
+    if (useIndexTask) {
+        indexTask = new CreateSArrayIndexTask(wholeSeq.constData(), seqObj->getSequenceLength(), prefixSize, unknownChar, bitMask, bitCharLen);
+        addSubTask(indexTask);
+        return;
+    }
+
     index = new SArrayIndex(wholeSeq.constData(), seqObj->getSequenceLength(), prefixSize, stateInfo, unknownChar, bitMask, bitCharLen);
 
     if (hasError()) {
         return;
     }
 
-    SArrayBasedSearchSettings s;
-    s.query = query.toLatin1();
-    s.useBitMask = useBitMask;
-    s.bitMask = bitMask;
-    s.nMismatches = nMismatches;
-    s.bitMaskCharBitsNum = bitCharLen;
-    s.unknownChar = unknownChar;
-    findTask = new SArrayBasedFindTask(index, s);
+    findTask = new SArrayBasedFindTask(index, settings);
     addSubTask( findTask );
 }
 
+QList<Task*> GTest_SArrayBasedFindTask::onSubTaskFinished(Task* subTask) {
+    QList<Task*> res;
+    CHECK(subTask == indexTask && !hasError() && !isCanceled(), res);
+    findTask = new SArrayBasedFindTask(indexTask->index, settings);
+    res << findTask;
+    return res;
+}
+
 void GTest_SArrayBasedFindTask::run()
 {
     if (hasError() || isCanceled()) {
@@ -673,12 +695,171 @@ void GTest_SArrayBasedFindTask::run()
 //---------------------------------------------------------------------------------------------------------
 //---------------------------------------------------------------------------------------------------------
 
+#define SEQ_LENGTH_ATTR     "sequence-length"
+#define REPEATS_COUNT_ATTR  "repeats-count"
+#define MIN_LENGTH_ATTR     "min-length"
+#define MAX_LENGTH_ATTR     "max-length"
+#define SEED_ATTR           "seed"
+
+namespace {
+
+int randomInt(quint64 &state, int min, int max) {
+    return min + int(XMLTestUtils::nextRandom(state) % quint64(max - min + 1));
+}
+
+bool lessByFragment(const RFResult& r1, const RFResult& r2) {
+    return r1.fragment < r2.fragment;
+}
+
+}
+
+void GTest_RepeatsFilters::init(XMLTestFormat *, const QDomElement& el) {
+    seed = 1;
+    bool ok = false;
+    sequenceLength = el.attribute(SEQ_LENGTH_ATTR).toInt(&ok);
+    if (!ok || sequenceLength <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEQ_LENGTH_ATTR));
+        return;
+    }
+    repeatsCount = el.attribute(REPEATS_COUNT_ATTR).toInt(&ok);
+    if (!ok || repeatsCount <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(REPEATS_COUNT_ATTR));
+        return;
+    }
+    minLength = el.attribute(MIN_LENGTH_ATTR).toInt(&ok);
+    if (!ok || minLength <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(MIN_LENGTH_ATTR));
+        return;
+    }
+    maxLength = el.attribute(MAX_LENGTH_ATTR).toInt(&ok);
+    if (!ok || maxLength < minLength || maxLength > sequenceLength) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(MAX_LENGTH_ATTR));
+        return;
+    }
+    if (el.hasAttribute(SEED_ATTR)) {
+        seed = el.attribute(SEED_ATTR).toULongLong(&ok);
+        if (!ok || 0 == seed) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEED_ATTR));
+            return;
+        }
+    }
+}
+
+void GTest_RepeatsFilters::run() {
+    static const char CHARS[] = "ACGT";
+    quint64 state = seed;
+    QByteArray sequence(sequenceLength, 'A');
+    for (int i = 0; i < sequenceLength; i++) {
+        sequence[i] = CHARS[XMLTestUtils::nextRandom(state) % 4];
+    }
+
+    QVector<RFResult> repeats;
+    for (int i = 0; i < repeatsCount; i++) {
+        RFResult r;
+        const RFResult parent = repeats.isEmpty() ? RFResult() : repeats[randomInt(state, 0, repeats.size() - 1)];
+        switch (repeats.isEmpty() || parent.l <= minLength ? 0 : i % 4) {
+        case 1: {
+            // nested on the same diagonal
+            const int shift = randomInt(state, 0, parent.l - minLength);
+            r.l = randomInt(state, minLength, parent.l - shift);
+            r.x = parent.x + shift;
+            r.y = parent.y + shift;
+            break;
+        }
+        case 2:
+            r = parent;
+            break;
+        case 3:
+            // nested on another diagonal
+            r.l = randomInt(state, minLength, parent.l - 1);
+            r.x = parent.x + randomInt(state, 0, parent.l - r.l);
+            r.y = parent.y + randomInt(state, 0, parent.l - r.l);
+            break;
+        default:
+            r.l = randomInt(state, minLength, maxLength);
+            r.x = randomInt(state, 0, sequenceLength - r.l);
+            r.y = randomInt(state, 0, sequenceLength - r.l);
+            break;
+        }
+        r.c = r.l;
+        r.fragment = QString(sequence.mid(r.x, r.l));
+        repeats << r;
+    }
+
+    QVector<RFResult> shuffled = repeats;
+    for (int i = shuffled.size() - 1; i > 0; i--) {
+        qSwap(shuffled[i], shuffled[randomInt(state, 0, i)]);
+    }
+
+    checkNestedFilter(repeats, shuffled);
+    CHECK_OP(stateInfo, );
+    checkUniqueFilter(repeats, shuffled);
+}
+
+void GTest_RepeatsFilters::checkNestedFilter(const QVector<RFResult>& repeats, const QVector<RFResult>& shuffled) {
+    QVector<RFResult> expected = repeats;
+    FindRepeatsTask::removeNestedRepeats(expected, 0);
+
+    RFNestedRepeatsFilter filter;
+    foreach (const RFResult& r, shuffled) {
+        filter.addResult(r);
+    }
+    const QVector<RFResult> actual = filter.getResults();
+
+    CHECK_EXT(expected.size() == actual.size(),
+        stateInfo.setError(QString("Nested filter: expected %1 repeats, got %2").arg(expected.size()).arg(actual.size())), );
+    for (int i = 0; i < expected.size(); i++) {
+        CHECK_EXT(expected[i] == actual[i], stateInfo.setError(QString("Nested filter: expected repeat (%1, %2, %3), got (%4, %5, %6)")
+            .arg(expected[i].x).arg(expected[i].y).arg(expected[i].l).arg(actual[i].x).arg(actual[i].y).arg(actual[i].l)), );
+    }
+}
+
+void GTest_RepeatsFilters::checkUniqueFilter(const QVector<RFResult>& repeats, const QVector<RFResult>& shuffled) {
+    // the first repeat by position of each fragment
+    QHash<QString, RFResult> firstByFragment;
+    foreach (const RFResult& r, repeats) {
+        if (!firstByFragment.contains(r.fragment) || r < firstByFragment[r.fragment]) {
+            firstByFragment[r.fragment] = r;
+        }
+    }
+    QVector<RFResult> expected;
+    foreach (const RFResult& r, firstByFragment) {
+        bool included = false;
+        foreach (const QString& fragment, firstByFragment.keys()) {
+            if (fragment.length() > r.fragment.length() && fragment.contains(r.fragment)) {
+                included = true;
+                break;
+            }
+        }
+        if (!included) {
+            expected << r;
+        }
+    }
+    qSort(expected.begin(), expected.end(), lessByFragment);
+
+    RFUniqueRepeatsFilter filter;
+    foreach (const RFResult& r, shuffled) {
+        filter.addResult(r);
+    }
+    QVector<RFResult> actual = filter.getResults();
+    qSort(actual.begin(), actual.end(), lessByFragment);
+
+    CHECK_EXT(expected.size() == actual.size(),
+        stateInfo.setError(QString("Unique filter: expected %1 repeats, got %2").arg(expected.size()).arg(actual.size())), );
+    for (int i = 0; i < expected.size(); i++) {
+        CHECK_EXT(expected[i] == actual[i] && expected[i].fragment == actual[i].fragment,
+            stateInfo.setError(QString("Unique filter: expected repeat (%1, %2, %3), got (%4, %5, %6)")
+            .arg(expected[i].x).arg(expected[i].y).arg(expected[i].l).arg(actual[i].x).arg(actual[i].y).arg(actual[i].l)), );
+    }
+}
+
 QList<XMLTestFactory*> RepeatFinderTests::createTestFactories() {
     QList<XMLTestFactory*> res;
     res.append(GTest_FindSingleSequenceRepeatsTask::createFactory());
     res.append(GTest_FindTandemRepeatsTask::createFactory());
     res.append(GTest_FindRealTandemRepeatsTask::createFactory());
     res.append( GTest_SArrayBasedFindTask::createFactory() );
+    res.append(GTest_RepeatsFilters::createFactory());
     return res;
 }
 
@@ -34,6 +34,7 @@
 #include <U2Core/AppContext.h>
 #include <U2Algorithm/BitsTable.h>
 #include <U2Algorithm/RepeatFinderSettings.h>
+#include <U2Algorithm/SArrayBasedFindTask.h>
 
 
 #include <QtXml/QDomElement>
@@ -121,14 +122,19 @@ public:
 };
 
 class SArrayIndex;
-class SArrayBasedFindTask;
+class CreateSArrayIndexTask;
 
+/**
+ * Searches the query with SArrayBasedFindTask.
+ * If the "index-task" attribute is set, the index is built by CreateSArrayIndexTask, that sorts big indexes in subtasks.
+ */
 class GTest_SArrayBasedFindTask : public GTest {
     Q_OBJECT
 public:
     SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_SArrayBasedFindTask, "sarray-based-find", TaskFlags_FOSCOE);
 
     void prepare();
+    QList<Task*> onSubTaskFinished(Task* subTask);
     void run();
     void cleanup();
 
@@ -137,13 +143,40 @@ public:
     bool                    useBitMask;
     BitsTable               bt;
     int                     nMismatches;
+    bool                    useIndexTask;
     DNASequence*            seqObj;
     QByteArray              wholeSeq;
     SArrayIndex*            index;
+    CreateSArrayIndexTask*  indexTask;
+    SArrayBasedSearchSettings settings;
     SArrayBasedFindTask*    findTask;
     QList<int>              expectedResults;
 };
 
+/**
+ * Adds random repeats of a random sequence to RFNestedRepeatsFilter and RFUniqueRepeatsFilter in a random order.
+ * The repeats include duplicates, repeats nested on the same and on other diagonals and repeats longer than the filter buckets.
+ * The nested filter results must be equal to the results of FindRepeatsTask::removeNestedRepeats(),
+ * the unique filter must keep the fragments that are not parts of other fragments, each once by its first repeat.
+ */
+class GTest_RepeatsFilters : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_RepeatsFilters, "repeats-filters", TaskFlags_FOSCOE);
+
+    void run();
+
+private:
+    void checkNestedFilter(const QVector<RFResult>& repeats, const QVector<RFResult>& shuffled);
+    void checkUniqueFilter(const QVector<RFResult>& repeats, const QVector<RFResult>& shuffled);
+
+    int         sequenceLength;
+    int         repeatsCount;
+    int         minLength;
+    int         maxLength;
+    quint64     seed;
+};
+
 class RepeatFinderTests {
 public:
     static QList<XMLTestFactory*> createTestFactories();
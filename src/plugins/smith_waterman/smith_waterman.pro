@@ -4,6 +4,7 @@ include (smith_waterman.pri)
 HEADERS += src/PairAlignSequences.h \
            src/SmithWatermanAlgorithm.h \
            src/SmithWatermanAlgorithmSSE2.h \
+           src/SmithWatermanAlgorithmAVX2.h \
            src/SWAlgorithmPlugin.h \
            src/SWAlgorithmTask.h \
            src/SmithWatermanAlgorithmCUDA.h \
@@ -18,6 +19,7 @@ HEADERS += src/PairAlignSequences.h \
 SOURCES += src/PairAlignSequences.cpp \
            src/SmithWatermanAlgorithm.cpp \
            src/SmithWatermanAlgorithmSSE2.cpp \
+           src/SmithWatermanAlgorithmAVX2.cpp \
            src/SWAlgorithmPlugin.cpp \
            src/SWAlgorithmTask.cpp \
            src/SmithWatermanAlgorithmCUDA.cpp \
@@ -117,6 +117,22 @@ SWAlgorithmPlugin::SWAlgorithmPlugin()
                                                                  "SSE2");
 #endif
 
+#ifdef SW2_BUILD_WITH_AVX2
+    if (AppResourcePool::isAVX2Enabled()) {
+        coreLog.trace("Registering AVX2 SW implementation");
+        swar->registerFactory(new SWTaskFactory(SW_avx2), QString("AVX2"));
+        par->getAlgorithm("Smith-Waterman")->addAlgorithmRealization(new PairwiseAlignmentSmithWatermanTaskFactory(SW_avx2),
+                                                                     new PairwiseAlignmentSmithWatermanGUIExtensionFactory(SW_avx2),
+                                                                     "AVX2");
+    }
+#endif
+
+    coreLog.trace("Registering automatically chosen SW implementation");
+    swar->registerFactory(new SWTaskFactory(SW_auto), SWTaskFactory::AUTO_REALIZATION);
+    par->getAlgorithm("Smith-Waterman")->addAlgorithmRealization(new PairwiseAlignmentSmithWatermanTaskFactory(SW_auto),
+                                                                 new PairwiseAlignmentSmithWatermanGUIExtensionFactory(SW_auto),
+                                                                 SWTaskFactory::AUTO_REALIZATION);
+
     this->connect(AppContext::getPluginSupport(), SIGNAL(si_allStartUpPluginsLoaded()), SLOT(regDependedIMPLFromOtherPlugins()));
 }
 
@@ -124,6 +140,8 @@ QList<XMLTestFactory*> SWAlgorithmTests::createTestFactories() {
     QList<XMLTestFactory*> res;
     res.append(GTest_SmithWatermnan::createFactory());
     res.append(GTest_SmithWatermnanPerf::createFactory());
+    res.append(GTest_SmithWatermanBatch::createFactory());
+    res.append(GTest_SmithWatermanRealizations::createFactory());
     return res;
 }
 
@@ -27,6 +27,7 @@
 
 #include "SmithWatermanAlgorithmCUDA.h"
 #include "SmithWatermanAlgorithmSSE2.h"
+#include "SmithWatermanAlgorithmAVX2.h"
 #include "SmithWatermanAlgorithmOPENCL.h"
 #include "sw_cuda_cpp.h"
 
@@ -46,6 +47,7 @@
 #include <U2Algorithm/SubstMatrixRegistry.h>
 
 #include <QtCore/QMutexLocker>
+#include <QtCore/QScopedPointer>
 #include <QtCore/QMap>
 #include <QtCore/QVariant>
 
@@ -67,8 +69,8 @@ SWAlgorithmTask::SWAlgorithmTask(const SmithWatermanSettings& s,
 {
     GCOUNTER( cvar, tvar, "SWAlgorithmTask" );
 
-    algType = _algType;
-    if (algType == SW_sse2) {
+    algType = resolveAlgType(_algType);
+    if (algType == SW_sse2 || algType == SW_avx2) {
         if (sWatermanConfig.ptrn.length() < 8) {
             algType = SW_classic;
         }
@@ -121,6 +123,7 @@ void SWAlgorithmTask::setupTask(int maxScore) {
 
     switch(algType) {
         case SW_sse2:
+        case SW_avx2:
             computationMatrixSquare = 1619582300.0; //this constant is considered to be optimal computation matrix square (square = localSequence.length * pattern.length) for given algorithm realization and the least minimum score value
             c.nThreads = idealThreadCount * 2.5;
             break;
@@ -189,6 +192,15 @@ void SWAlgorithmTask::setupTask(int maxScore) {
                     sWatermanConfig.sqnc.left(c.chunkSize * c.nThreads), sWatermanConfig.gapModel.scoreGapOpen,
                     sWatermanConfig.gapModel.scoreGapExtd, minScore, maxScore, sWatermanConfig.resultView),
                 true));
+#endif
+            break;
+        case SW_avx2:
+#ifdef SW2_BUILD_WITH_AVX2
+            addTaskResource(TaskResourceUsage(RESOURCE_MEMORY,
+                SmithWatermanAlgorithmAVX2::estimateNeededRamAmount(sWatermanConfig.ptrn,
+                    sWatermanConfig.sqnc.left(c.chunkSize * c.nThreads), sWatermanConfig.gapModel.scoreGapOpen,
+                    sWatermanConfig.gapModel.scoreGapExtd, minScore, maxScore, sWatermanConfig.resultView),
+                true));
 #endif
             break;
         default:
@@ -259,38 +271,41 @@ QList<PairAlignSequences> &  SWAlgorithmTask::getResult() {
     return pairAlignSequences;
 }
 
+namespace {
+
+void convertToSearchRegionCoordinates(QList<PairAlignSequences> &res, SequenceWalkerSubtask *t, const U2Region &globalRegion) {
+    for (int i = 0; i < res.size(); i++) {
+        res[i].isDNAComplemented = t->isDNAComplemented();
+        res[i].isAminoTranslated = t->isAminoTranslated();
+
+        if (t->isAminoTranslated()) {
+            res[i].refSubseqInterval.startPos *= 3;
+            res[i].refSubseqInterval.length *= 3;
+        }
+
+
+        if (t->isDNAComplemented()) {
+            const U2Region& wr = t->getGlobalRegion();
+            res[i].refSubseqInterval.startPos =
+                wr.endPos() - res[i].refSubseqInterval.endPos() - globalRegion.startPos;
+        }
+        else {
+            res[i].refSubseqInterval.startPos +=
+                (t->getGlobalRegion().startPos - globalRegion.startPos);
+        }
+    }
+}
+
+}
+
 void SWAlgorithmTask::onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti) {
     Q_UNUSED(ti);
 
     int regionLen = t->getRegionSequenceLen();
     QByteArray localSeq(t->getRegionSequence(), regionLen);
 
-    SmithWatermanAlgorithm * sw = NULL;
-    if (algType == SW_sse2) {
-#ifdef SW2_BUILD_WITH_SSE2
-        sw = new SmithWatermanAlgorithmSSE2;
-#else
-        coreLog.error( "SSE2 was not enabled in this build" );
-        return;
-#endif //SW2_BUILD_WITH_SSE2
-    } else if (algType == SW_cuda) {
-#ifdef SW2_BUILD_WITH_CUDA
-        sw = new SmithWatermanAlgorithmCUDA;
-#else
-        coreLog.error( "CUDA was not enabled in this build" );
-        return;
-#endif //SW2_BUILD_WITH_CUDA
-    } else if (algType == SW_opencl) {
-#ifdef SW2_BUILD_WITH_OPENCL
-        sw = new SmithWatermanAlgorithmOPENCL;
-#else
-        coreLog.error( "OPENCL was not enabled in this build" );
-        return;
-#endif //SW2_BUILD_WITH_OPENCL
-    } else {
-        assert(algType == SW_classic);
-        sw = new SmithWatermanAlgorithm;
-    }
+    SmithWatermanAlgorithm * sw = createAlgorithm(algType);
+    CHECK(NULL != sw, );
 
     // this substitution is needed for the case when annotation are required as result
     // as well as pattern subsequence
@@ -318,27 +333,7 @@ void SWAlgorithmTask::onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti) {
     perfLog.details(QString("\n%1 %2 run time is %3\n").arg(testName).arg(algName).arg(GTimer::secsBetween(t1, GTimer::currentTimeMicros())));
 
     QList<PairAlignSequences> res = sw->getResults();
-
-    for (int i = 0; i < res.size(); i++) {
-        res[i].isDNAComplemented = t->isDNAComplemented();
-        res[i].isAminoTranslated = t->isAminoTranslated();
-
-        if (t->isAminoTranslated()) {
-            res[i].refSubseqInterval.startPos *= 3;
-            res[i].refSubseqInterval.length *= 3;
-        }
-
-
-        if (t->isDNAComplemented()) {
-            const U2Region& wr = t->getGlobalRegion();
-            res[i].refSubseqInterval.startPos =
-                wr.endPos() - res[i].refSubseqInterval.endPos() - sWatermanConfig.globalRegion.startPos;
-        }
-        else {
-            res[i].refSubseqInterval.startPos +=
-                (t->getGlobalRegion().startPos - sWatermanConfig.globalRegion.startPos);
-        }
-    }
+    convertToSearchRegionCoordinates(res, t, sWatermanConfig.globalRegion);
 
     addResult(res);
 
@@ -346,6 +341,54 @@ void SWAlgorithmTask::onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti) {
     delete sw;
 }
 
+SW_AlgType SWAlgorithmTask::resolveAlgType(SW_AlgType algType) {
+    CHECK(SW_auto == algType, algType);
+#ifdef SW2_BUILD_WITH_AVX2
+    if (AppResourcePool::isAVX2Enabled()) {
+        return SW_avx2;
+    }
+#endif
+#ifdef SW2_BUILD_WITH_SSE2
+    if (AppResourcePool::isSSE2Enabled()) {
+        return SW_sse2;
+    }
+#endif
+    return SW_classic;
+}
+
+SmithWatermanAlgorithm * SWAlgorithmTask::createAlgorithm(SW_AlgType algType) {
+    SmithWatermanAlgorithm * sw = NULL;
+    if (algType == SW_sse2) {
+#ifdef SW2_BUILD_WITH_SSE2
+        sw = new SmithWatermanAlgorithmSSE2;
+#else
+        coreLog.error( "SSE2 was not enabled in this build" );
+#endif //SW2_BUILD_WITH_SSE2
+    } else if (algType == SW_avx2) {
+#ifdef SW2_BUILD_WITH_AVX2
+        sw = new SmithWatermanAlgorithmAVX2;
+#else
+        coreLog.error( "AVX2 was not enabled in this build" );
+#endif //SW2_BUILD_WITH_AVX2
+    } else if (algType == SW_cuda) {
+#ifdef SW2_BUILD_WITH_CUDA
+        sw = new SmithWatermanAlgorithmCUDA;
+#else
+        coreLog.error( "CUDA was not enabled in this build" );
+#endif //SW2_BUILD_WITH_CUDA
+    } else if (algType == SW_opencl) {
+#ifdef SW2_BUILD_WITH_OPENCL
+        sw = new SmithWatermanAlgorithmOPENCL;
+#else
+        coreLog.error( "OPENCL was not enabled in this build" );
+#endif //SW2_BUILD_WITH_OPENCL
+    } else {
+        assert(algType == SW_classic);
+        sw = new SmithWatermanAlgorithm;
+    }
+    return sw;
+}
+
 void SWAlgorithmTask::removeResultFromOverlap(QList<PairAlignSequences> & res) {
     for (int i = 0; i < res.size() - 1; i++) {
         for (int j = i + 1; j < res.size(); j++) {
@@ -488,6 +531,187 @@ void SWResultsPostprocessingTask::run(){
     }
 }
 
+SWBatchAlgorithmTask::SWBatchAlgorithmTask(const QList<SmithWatermanSettings>& _configs, const QString& taskName, SW_AlgType _algType)
+    : Task(taskName, TaskFlag_NoRun), configs(_configs), algType(_algType), t(NULL)
+{
+    GCOUNTER( cvar, tvar, "SWBatchAlgorithmTask" );
+    SAFE_POINT(!configs.isEmpty(), "No patterns for the batch Smith-Waterman search", );
+    SAFE_POINT(isBatchSupported(algType), "Batch Smith-Waterman search is not supported by the realization", );
+
+    algType = SWAlgorithmTask::resolveAlgType(algType);
+    foreach (const SmithWatermanSettings &s, configs) {
+        // the vectorized realizations are not efficient for short patterns
+        algTypes << ((s.ptrn.length() < 8) ? SW_classic : algType);
+
+        int maxScore = SWAlgorithmTask::calculateMaxScore(s.ptrn, s.pSm);
+        int minScore = (maxScore * s.percentOfScore) / 100;
+        if ( (maxScore * (int)s.percentOfScore) % 100 != 0) minScore += 1;
+        maxScores << maxScore;
+        minScores << minScore;
+    }
+    pairAlignSequences.resize(configs.size());
+
+    setupTask();
+}
+
+SWBatchAlgorithmTask::~SWBatchAlgorithmTask() {
+    foreach (const SmithWatermanSettings &s, configs) {
+        delete s.resultListener;
+        delete s.resultCallback;
+    }
+}
+
+bool SWBatchAlgorithmTask::isBatchSupported(SW_AlgType algType) {
+    // GPU realizations load a whole chunk on the device for a single pattern
+    return SW_classic == algType || SW_sse2 == algType || SW_avx2 == algType || SW_auto == algType;
+}
+
+void SWBatchAlgorithmTask::setupTask() {
+    const SmithWatermanSettings &first = configs.first();
+
+    SequenceWalkerConfig c;
+    c.seq = first.sqnc.constData();
+    c.seqSize = first.sqnc.size();
+    c.range = first.globalRegion;
+    c.complTT = first.complTT;
+    c.aminoTT = first.aminoTT;
+    c.strandToWalk = first.strand;
+
+    const int patternLengthFactor = (first.aminoTT == NULL ? 1 : 3);
+    quint64 overlapSize = 0;
+    int maxPatternLength = 0;
+    qint64 patternsLength = 0;
+    for (int i = 0; i < configs.size(); i++) {
+        const SmithWatermanSettings &s = configs[i];
+        const quint64 patternOverlap = SWAlgorithmTask::calculateMatrixLength(first.sqnc.length(),
+            s.ptrn.length() * patternLengthFactor, s.gapModel.scoreGapOpen, s.gapModel.scoreGapExtd,
+            maxScores[i], minScores[i]);
+        overlapSize = qMax(overlapSize, patternOverlap);
+        maxPatternLength = qMax(maxPatternLength, s.ptrn.length());
+        patternsLength += s.ptrn.length();
+    }
+
+    int idealThreadCount = AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount();
+    double computationMatrixSquare = 0.0;
+    if (SW_classic == algType) {
+        computationMatrixSquare = 751948900.29; // the same constants as SWAlgorithmTask uses for a single pattern
+        c.nThreads = idealThreadCount;
+    } else {
+        computationMatrixSquare = 1619582300.0;
+        c.nThreads = idealThreadCount * 2.5;
+    }
+
+    c.walkCircular = first.searchCircular;
+    c.walkCircularDistance = c.walkCircular ? maxPatternLength - 1 : 0;
+
+    // the chunks are sized for all patterns together, each chunk is prepared once for the batch
+    qint64 partsNumber = static_cast<qint64>((first.sqnc.size() + c.walkCircularDistance) / (computationMatrixSquare / patternsLength) + 1.0);
+    if (partsNumber < c.nThreads) {
+        c.nThreads = partsNumber;
+    }
+
+    c.chunkSize = (c.seqSize + c.walkCircularDistance + overlapSize * (partsNumber - 1)) / partsNumber;
+    if (c.chunkSize <= overlapSize) {
+        c.chunkSize = overlapSize + 1;
+    }
+    if (c.chunkSize < (quint64)maxPatternLength * patternLengthFactor) {
+        c.chunkSize = maxPatternLength * patternLengthFactor;
+    }
+    c.overlapSize = overlapSize;
+    c.lastChunkExtraLen = partsNumber - 1;
+
+    // every thread aligns one pattern at a time
+    quint64 neededRam = 0;
+    const QByteArray threadsData = first.sqnc.left(c.chunkSize * c.nThreads);
+    for (int i = 0; i < configs.size(); i++) {
+        neededRam = qMax(neededRam, estimateNeededRamAmount(i, threadsData));
+    }
+    addTaskResource(TaskResourceUsage(RESOURCE_MEMORY, neededRam, true));
+
+    t = new SequenceWalkerTask(c, this, tr("Smith Waterman2 SequenceWalker"));
+    addSubTask(t);
+}
+
+quint64 SWBatchAlgorithmTask::estimateNeededRamAmount(int patternIdx, const QByteArray & searchSeq) const {
+    const SmithWatermanSettings &s = configs[patternIdx];
+    switch (algTypes[patternIdx]) {
+        case SW_classic:
+            return SmithWatermanAlgorithm::estimateNeededRamAmount(s.gapModel.scoreGapOpen, s.gapModel.scoreGapExtd,
+                minScores[patternIdx], maxScores[patternIdx], s.ptrn, searchSeq, s.resultView);
+        case SW_sse2:
+#ifdef SW2_BUILD_WITH_SSE2
+            return SmithWatermanAlgorithmSSE2::estimateNeededRamAmount(s.ptrn, searchSeq, s.gapModel.scoreGapOpen,
+                s.gapModel.scoreGapExtd, minScores[patternIdx], maxScores[patternIdx], s.resultView);
+#endif
+            break;
+        case SW_avx2:
+#ifdef SW2_BUILD_WITH_AVX2
+            return SmithWatermanAlgorithmAVX2::estimateNeededRamAmount(s.ptrn, searchSeq, s.gapModel.scoreGapOpen,
+                s.gapModel.scoreGapExtd, minScores[patternIdx], maxScores[patternIdx], s.resultView);
+#endif
+            break;
+        default:
+            assert(0);
+    }
+    return 0;
+}
+
+void SWBatchAlgorithmTask::onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti) {
+    const int regionLen = t->getRegionSequenceLen();
+    const QByteArray localSeq(t->getRegionSequence(), regionLen);
+
+    for (int i = 0; i < configs.size() && !ti.isCoR(); i++) {
+        const SmithWatermanSettings &s = configs[i];
+        QScopedPointer<SmithWatermanAlgorithm> sw(SWAlgorithmTask::createAlgorithm(algTypes[i]));
+        CHECK(!sw.isNull(), );
+
+        const SmithWatermanSettings::SWResultView resultView =
+            ( SmithWatermanSettings::ANNOTATIONS == s.resultView && s.includePatternContent )
+            ? SmithWatermanSettings::MULTIPLE_ALIGNMENT : s.resultView;
+        sw->launch(s.pSm, s.ptrn, localSeq, s.gapModel.scoreGapOpen + s.gapModel.scoreGapExtd,
+            s.gapModel.scoreGapExtd, minScores[i], resultView);
+
+        QList<PairAlignSequences> res = sw->getResults();
+        convertToSearchRegionCoordinates(res, t, s.globalRegion);
+
+        QMutexLocker ml(&lock);
+        pairAlignSequences[i] += res;
+    }
+}
+
+QList<Task*> SWBatchAlgorithmTask::onSubTaskFinished(Task* subTask) {
+    QList<Task*> res;
+    CHECK(!hasError() && !isCanceled(), res);
+
+    if (subTask == t) {
+        QList<SmithWatermanResult> resultList;
+        for (int i = 0; i < configs.size(); i++) {
+            SWAlgorithmTask::removeResultFromOverlap(pairAlignSequences[i]);
+            SmithWatermanAlgorithm::sortByScore(pairAlignSequences[i]);
+            res.append(new SWResultsPostprocessingTask(configs[i], resultList, pairAlignSequences[i]));
+        }
+    }
+    return res;
+}
+
+Task::ReportResult SWBatchAlgorithmTask::report() {
+    int resultsNum = 0;
+    foreach (const SmithWatermanSettings &s, configs) {
+        QList<SmithWatermanResult> resultList = s.resultListener->getResults();
+        resultsNum += resultList.size();
+
+        if (NULL != s.resultCallback) {
+            QString res = s.resultCallback->report(resultList);
+            if (!res.isEmpty()) {
+                stateInfo.setError(res);
+            }
+        }
+    }
+    algoLog.details(tr("%1 results found for %2 patterns").arg(resultsNum).arg(configs.size()));
+
+    return ReportResult_Finished;
+}
+
 PairwiseAlignmentSmithWatermanTaskSettings::PairwiseAlignmentSmithWatermanTaskSettings(const PairwiseAlignmentTaskSettings &s) :
     PairwiseAlignmentTaskSettings(s), 
     reportCallback(NULL),
@@ -550,8 +774,8 @@ PairwiseAlignmentSmithWatermanTask::PairwiseAlignmentSmithWatermanTask(PairwiseA
         ptrn = &second;
     }
 
-    algType = _algType;
-    if (algType == SW_sse2) {
+    algType = SWAlgorithmTask::resolveAlgType(_algType);
+    if (algType == SW_sse2 || algType == SW_avx2) {
         if (ptrn->length() < 8) {
             algType = SW_classic;
             settings->setCustomValue("realizationName", "SW_classic");
@@ -597,6 +821,13 @@ void PairwiseAlignmentSmithWatermanTask::onRegion(SequenceWalkerSubtask *t, Task
         coreLog.error( "SSE2 was not enabled in this build" );
         return;
 #endif //SW2_BUILD_WITH_SSE2
+    } else if (algType == SW_avx2) {
+#ifdef SW2_BUILD_WITH_AVX2
+        sw = new SmithWatermanAlgorithmAVX2;
+#else
+        coreLog.error( "AVX2 was not enabled in this build" );
+        return;
+#endif //SW2_BUILD_WITH_AVX2
     } else if (algType == SW_cuda) {
 #ifdef SW2_BUILD_WITH_CUDA
         sw = new SmithWatermanAlgorithmCUDA;
@@ -703,6 +934,7 @@ void PairwiseAlignmentSmithWatermanTask::setupTask() {
 
     switch(algType) {
         case SW_sse2:
+        case SW_avx2:
             computationMatrixSquare = 16195823.0; //this constant is considered to be optimal computation matrix square (square = localSequence.length * pattern.length) for given algorithm realization and the least minimum score value
             c.nThreads = idealThreadCount * 2.5;
             break;
@@ -765,6 +997,15 @@ void PairwiseAlignmentSmithWatermanTask::setupTask() {
                     sqnc->left(c.chunkSize * c.nThreads), settings->gapOpen, settings->gapExtd,
                     minScore, maxScore, SmithWatermanSettings::MULTIPLE_ALIGNMENT),
                 true));
+#endif
+            break;
+        case SW_avx2:
+#ifdef SW2_BUILD_WITH_AVX2
+            addTaskResource(TaskResourceUsage(RESOURCE_MEMORY,
+                SmithWatermanAlgorithmAVX2::estimateNeededRamAmount(*ptrn,
+                    sqnc->left(c.chunkSize * c.nThreads), settings->gapOpen, settings->gapExtd,
+                    minScore, maxScore, SmithWatermanSettings::MULTIPLE_ALIGNMENT),
+                true));
 #endif
             break;
         default:
@@ -37,7 +37,7 @@
 
 namespace U2 {
 
-enum SW_AlgType {SW_classic, SW_sse2, SW_cuda, SW_opencl};
+enum SW_AlgType {SW_classic, SW_sse2, SW_cuda, SW_opencl, SW_avx2, SW_auto};
 
 class CudaGpuModel;
 class OpenCLGpuModel;
@@ -59,12 +59,17 @@ public:
 
     QList<Task*> onSubTaskFinished(Task* subTask);
 
+    static int calculateMatrixLength(int searchSeqLen, int patternLen, int gapOpen, int gapExtension, int maxScore, int minScore);
+    static void removeResultFromOverlap(QList<PairAlignSequences> & res);
+    static int calculateMaxScore(const QByteArray & seq, const SMatrix& substitutionMatrix);
+    static SmithWatermanAlgorithm * createAlgorithm(SW_AlgType algType);
+    // SW_auto is resolved to the fastest CPU realization supported by the build and the processor,
+    // an explicitly chosen realization is returned as is
+    static SW_AlgType resolveAlgType(SW_AlgType algType);
+
 private:
 
     void addResult(QList<PairAlignSequences> & res);
-    int calculateMatrixLength(int searchSeqLen, int patternLen, int gapOpen, int gapExtension, int maxScore, int minScore);
-    void removeResultFromOverlap(QList<PairAlignSequences> & res);
-    int calculateMaxScore(const QByteArray & seq, const SMatrix& substitutionMatrix);
 
     void setupTask(int maxScore);
 
@@ -98,6 +103,41 @@ private:
     QList<PairAlignSequences> resPAS;
 };
 
+/**
+ * Searches many patterns in one sequence with one sequence walker: each chunk is prepared
+ * (complemented or translated) once and then all patterns are aligned against it one by one.
+ * The alignment itself is the same as SWAlgorithmTask does for every pattern.
+ * The settings must differ only in patterns, result listeners and callbacks.
+ */
+class SWBatchAlgorithmTask : public Task, public SequenceWalkerCallback {
+    Q_OBJECT
+public:
+    SWBatchAlgorithmTask(const QList<SmithWatermanSettings>& configs, const QString& taskName, SW_AlgType algType);
+    ~SWBatchAlgorithmTask();
+
+    virtual void onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti);
+
+    ReportResult report();
+
+    QList<Task*> onSubTaskFinished(Task* subTask);
+
+    static bool isBatchSupported(SW_AlgType algType);
+
+private:
+    void setupTask();
+    quint64 estimateNeededRamAmount(int patternIdx, const QByteArray & searchSeq) const;
+
+    QList<SmithWatermanSettings> configs;
+    SW_AlgType algType;
+    QList<SW_AlgType> algTypes;
+    QList<int> minScores;
+    QList<int> maxScores;
+    QVector<QList<PairAlignSequences> > pairAlignSequences;
+
+    QMutex lock;
+    SequenceWalkerTask* t;
+};
+
 class PairwiseAlignmentSmithWatermanTaskSettings : public PairwiseAlignmentTaskSettings {
 public:
     PairwiseAlignmentSmithWatermanTaskSettings(const PairwiseAlignmentTaskSettings &s);
@@ -20,6 +20,7 @@
  */
 
 #include "SWQuery.h"
+#include "SWTaskFactory.h"
 
 #include <U2Core/AppContext.h>
 #include <U2Core/DNATranslation.h>
@@ -58,7 +59,7 @@ void SWAlgoEditor::populate() {
         items.insert(n,n);
     }
 
-    algAttr->setAttributeValue(algoLst.first());
+    algAttr->setAttributeValue(algoLst.contains(SWTaskFactory::AUTO_REALIZATION) ? SWTaskFactory::AUTO_REALIZATION : algoLst.first());
 }
 
 /************************************************************************/
@@ -33,6 +33,8 @@
 
 namespace U2 {
 
+const QString SWTaskFactory::AUTO_REALIZATION("Auto");
+
 SWTaskFactory::SWTaskFactory(SW_AlgType _algType) {
     algType = _algType;
 }
@@ -44,6 +46,11 @@ Task* SWTaskFactory::getTaskInstance( const SmithWatermanSettings& config, const
     return new SWAlgorithmTask(config, taskName, algType);
 }
 
+Task* SWTaskFactory::getBatchTaskInstance(const QList<SmithWatermanSettings>& configs, const QString& taskName) const {
+    CHECK(SWBatchAlgorithmTask::isBatchSupported(algType) && !configs.isEmpty(), NULL);
+    return new SWBatchAlgorithmTask(configs, taskName, algType);
+}
+
 bool SWTaskFactory::isValidParameters(const SmithWatermanSettings& sWatermanConfig,  SequenceWalkerSubtask* t) const {
     Q_UNUSED(sWatermanConfig);
     Q_UNUSED(t);
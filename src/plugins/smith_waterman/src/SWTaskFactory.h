@@ -43,6 +43,10 @@ public:
     SWTaskFactory(SW_AlgType _algType);
     virtual ~SWTaskFactory();
     virtual Task* getTaskInstance(const SmithWatermanSettings& config, const QString& taskName) const;
+    virtual Task* getBatchTaskInstance(const QList<SmithWatermanSettings>& configs, const QString& taskName) const;
+
+    // the realization that lets the CPU dispatch choose the kernel, see SWAlgorithmTask::resolveAlgType
+    static const QString AUTO_REALIZATION;
 
 private:
     bool isValidParameters(const SmithWatermanSettings& sWatermanConfig,  SequenceWalkerSubtask* t) const;      //not realized
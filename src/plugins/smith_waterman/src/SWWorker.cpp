@@ -59,6 +59,7 @@
 #include <U2Lang/WorkflowEnv.h>
 
 #include "SWWorker.h"
+#include "SWTaskFactory.h"
 
 namespace U2 {
 namespace LocalWorkflow {
@@ -94,7 +95,7 @@ void SWAlgoEditor::populate() {
     QList<Attribute*> lst = proto->getAttributes();
     foreach(Attribute* a, lst) {
         if (a->getId() == ALGO_ATTR) {
-            a->setAttributeValue(algoLst.first());
+            a->setAttributeValue(algoLst.contains(SWTaskFactory::AUTO_REALIZATION) ? SWTaskFactory::AUTO_REALIZATION : algoLst.first());
             break;
         }
     }
@@ -480,7 +481,8 @@ Task* SWWorker::tick() {
             algoLog.error(tr("Incorrect value: search pattern, pattern is empty"));
             return new FailTask(tr("Incorrect value: search pattern, pattern is empty"));
         }
-        QList<Task*> subs;
+        QList<SmithWatermanSettings> configs;
+        QList<SmithWatermanReportCallbackAnnotImpl*> rcbs;
         foreach(QByteArray p, patternList) {
             if(!cfg.pSm.getAlphabet()->containsAll(p.constData(), p.length())) {
                 algoLog.error(tr("Incorrect value: pattern alphabet doesn't match sequence alphabet "));
@@ -499,10 +501,26 @@ Task* SWWorker::tick() {
             config.resultCallback = rcb;
             config.resultListener = new SmithWatermanResultListener();
 
-            Task * swTask = algo->getTaskInstance(config, tr("smith_waterman_task"));
-            callbacks.insert(swTask, rcb);
-            patterns.insert(swTask, config.ptrn);
-            subs << swTask;
+            configs << config;
+            rcbs << rcb;
+        }
+
+        // all patterns are searched in the same sequence, so it is walked once if the algorithm supports it
+        QList<Task*> subs;
+        Task * batchTask = algo->getBatchTaskInstance(configs, tr("smith_waterman_task"));
+        if (NULL != batchTask) {
+            callbacks.insert(batchTask, rcbs);
+            foreach (const SmithWatermanSettings &config, configs) {
+                patterns[batchTask] << config.ptrn;
+            }
+            subs << batchTask;
+        } else {
+            for (int i = 0; i < configs.size(); i++) {
+                Task * swTask = algo->getTaskInstance(configs[i], tr("smith_waterman_task"));
+                callbacks[swTask] << rcbs[i];
+                patterns[swTask] << configs[i].ptrn;
+                subs << swTask;
+            }
         }
         assert(!subs.isEmpty());
 
@@ -528,20 +546,25 @@ void SWWorker::sl_taskFinished(Task* t) {
         if (sub->isCanceled()) {
             return;
         }
-        SmithWatermanReportCallbackAnnotImpl* rcb = callbacks.take(sub);
-        assert(rcb != NULL);
-        if(rcb) {
-            // crop long names
-            const QString qualifierName = actor->getParameter(PATTERN_NAME_QUAL_ATTR)->getAttributeValue<QString>(context);
-            foreach(SharedAnnotationData a, rcb->getAnotations()) {
-                QString pattern = patterns.value(sub);
-                if(!patternNames[pattern].isEmpty()) {
-                    a->qualifiers.push_back(U2Qualifier(qualifierName, patternNames[pattern]));
+        const QList<SmithWatermanReportCallbackAnnotImpl*> rcbs = callbacks.take(sub);
+        const QList<QByteArray> subPatterns = patterns.take(sub);
+        SAFE_POINT(rcbs.size() == subPatterns.size(), "Invalid Smith-Waterman callbacks",);
+        for (int i = 0; i < rcbs.size(); i++) {
+            SmithWatermanReportCallbackAnnotImpl* rcb = rcbs[i];
+            assert(rcb != NULL);
+            if(rcb) {
+                // crop long names
+                const QString qualifierName = actor->getParameter(PATTERN_NAME_QUAL_ATTR)->getAttributeValue<QString>(context);
+                foreach(SharedAnnotationData a, rcb->getAnotations()) {
+                    const QString pattern = subPatterns[i];
+                    if(!patternNames[pattern].isEmpty()) {
+                        a->qualifiers.push_back(U2Qualifier(qualifierName, patternNames[pattern]));
+                    }
+                    annData << a;
                 }
-                annData << a;
             }
+            ptrns << subPatterns[i];
         }
-        ptrns << patterns.value(sub);
     }
 
     assert(output != NULL);
@@ -65,9 +65,10 @@ private slots:
 
 private:
     IntegralBus *input, *patternPort, *output;
-    QMap<Task*, SmithWatermanReportCallbackAnnotImpl*> callbacks;
+    // a batch task searches several patterns, callbacks and patterns of a task are in the same order
+    QMap<Task*, QList<SmithWatermanReportCallbackAnnotImpl*> > callbacks;
     QList<QByteArray> patternList;
-    QMap<Task*, QByteArray> patterns;
+    QMap<Task*, QList<QByteArray> > patterns;
     QMap<QString, QString> patternNames;
 };
 
@@ -0,0 +1,472 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifdef SW2_BUILD_WITH_AVX2
+
+#include "SmithWatermanAlgorithmAVX2.h"
+
+#include <immintrin.h>
+
+// The plugin itself is built for SSE2, so the AVX2 code is enabled per function
+// and is called only after the CPU has been checked at runtime.
+#if defined(__GNUC__) && !defined(__AVX2__)
+#define SW_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define SW_AVX2_TARGET
+#endif
+
+namespace U2 {
+
+namespace {
+
+const int N_BYTES_IN_VEC = 32;
+const int N_WORDS_IN_VEC = 16;
+
+// Shifts the vector up by one element crossing the 128-bit lane boundary,
+// the element 0 becomes zero. The same as _mm_slli_si128 for a single lane.
+SW_AVX2_TARGET inline __m256i shiftWordsUp(__m256i v) {
+    return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(v, v, 0x08), 14);
+}
+
+SW_AVX2_TARGET inline __m256i shiftBytesUp(__m256i v) {
+    return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(v, v, 0x08), 15);
+}
+
+SW_AVX2_TARGET inline bool isAnyGreaterU8(__m256i a, __m256i b) {
+    return -1 != _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_subs_epu8(a, b), _mm256_setzero_si256()));
+}
+
+SW_AVX2_TARGET inline bool isAnyGreaterI16(__m256i a, __m256i b) {
+    return 0 != _mm256_movemask_epi8(_mm256_cmpgt_epi16(a, b));
+}
+
+SW_AVX2_TARGET inline int getMaxU8(__m256i v) {
+    __m128i m = _mm_max_epu8(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 8));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 4));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 2));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 1));
+    return _mm_cvtsi128_si32(m) & 0xFF;
+}
+
+SW_AVX2_TARGET inline int getMaxI16(__m256i v) {
+    __m128i m = _mm_max_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    m = _mm_max_epi16(m, _mm_srli_si128(m, 8));
+    m = _mm_max_epi16(m, _mm_srli_si128(m, 4));
+    m = _mm_max_epi16(m, _mm_srli_si128(m, 2));
+    return (short)_mm_cvtsi128_si32(m);
+}
+
+/**
+ * Score-only pass with 32 unsigned byte lanes. Scores are biased to be non-negative.
+ * Returns -1 if the scores do not fit into a byte.
+ */
+SW_AVX2_TARGET int calculateMaxScoreWithBytes(const SMatrix &substitutionMatrix, const QByteArray &patternSeq,
+                                              const QByteArray &searchSeq, int gapOpen, int gapExtension) {
+    const int queryLength = patternSeq.length();
+    const int iter = (queryLength + N_BYTES_IN_VEC - 1) / N_BYTES_IN_VEC;
+    const char *pat = patternSeq.constData();
+
+    QByteArray alphaChars = substitutionMatrix.getAlphabet()->getAlphabetChars();
+    int minWeight = 0;
+    int maxWeight = 0;
+    foreach (char ch, alphaChars) {
+        for (int k = 0; k < queryLength; k++) {
+            int weight = substitutionMatrix.getScore(ch, pat[k]);
+            minWeight = qMin(minWeight, weight);
+            maxWeight = qMax(maxWeight, weight);
+        }
+    }
+    const int bias = -minWeight;
+    if (maxWeight + bias >= 0xFF) {
+        return -1;
+    }
+
+    __m256i *pvQueryProf = (__m256i*)_mm_malloc(0x80 * iter * sizeof(__m256i), 32);
+    memset(pvQueryProf, bias, 0x80 * iter * sizeof(__m256i));
+    foreach (char ch, alphaChars) {
+        quint8 *weight = (quint8*)(pvQueryProf + (quint8)ch * iter);
+        for (int j = 0; j < iter; j++) {
+            for (int k = j, n = 0; n < N_BYTES_IN_VEC; n++, k += iter) {
+                *weight++ = (k < queryLength) ? substitutionMatrix.getScore(ch, pat[k]) + bias : bias;
+            }
+        }
+    }
+
+    __m256i *pvHLoad = (__m256i*)_mm_malloc(iter * sizeof(__m256i), 32);
+    __m256i *pvHStore = (__m256i*)_mm_malloc(iter * sizeof(__m256i), 32);
+    __m256i *pvE = (__m256i*)_mm_malloc(iter * sizeof(__m256i), 32);
+    memset(pvHStore, 0, iter * sizeof(__m256i));
+    memset(pvE, 0, iter * sizeof(__m256i));
+
+    const __m256i vBias = _mm256_set1_epi8((char)bias);
+    const __m256i vGapOpen = _mm256_set1_epi8((char)qMin(-gapOpen, 0xFF));
+    const __m256i vGapExtend = _mm256_set1_epi8((char)qMin(-gapExtension, 0xFF));
+    const __m256i vLimit = _mm256_set1_epi8((char)(0xFF - bias));
+    __m256i vMaxScore = _mm256_setzero_si256();
+
+    const unsigned char *src = (const unsigned char*)searchSeq.constData();
+    const int srcLength = searchSeq.length();
+    bool overflow = false;
+    for (int i = 0; i < srcLength && !overflow; i++) {
+        const __m256i *pvScore = pvQueryProf + src[i] * iter;
+
+        __m256i vF = _mm256_setzero_si256();
+        __m256i vH = shiftBytesUp(_mm256_load_si256(pvHStore + iter - 1));
+        qSwap(pvHLoad, pvHStore);
+
+        for (int j = 0; j < iter; j++) {
+            vH = _mm256_subs_epu8(_mm256_adds_epu8(vH, _mm256_load_si256(pvScore + j)), vBias);
+            vMaxScore = _mm256_max_epu8(vMaxScore, vH);
+
+            __m256i vE = _mm256_load_si256(pvE + j);
+            vH = _mm256_max_epu8(vH, vE);
+            vH = _mm256_max_epu8(vH, vF);
+            _mm256_store_si256(pvHStore + j, vH);
+
+            vH = _mm256_subs_epu8(vH, vGapOpen);
+            vE = _mm256_max_epu8(_mm256_subs_epu8(vE, vGapExtend), vH);
+            _mm256_store_si256(pvE + j, vE);
+            vF = _mm256_max_epu8(_mm256_subs_epu8(vF, vGapExtend), vH);
+
+            vH = _mm256_load_si256(pvHLoad + j);
+        }
+
+        // the horizontal gaps are carried over the segment boundaries lazily
+        int j = 0;
+        vF = shiftBytesUp(vF);
+        vH = _mm256_load_si256(pvHStore);
+        while (isAnyGreaterU8(vF, _mm256_subs_epu8(vH, vGapOpen))) {
+            __m256i vKept = _mm256_cmpeq_epi8(_mm256_max_epu8(vH, vF), vH);
+            vH = _mm256_max_epu8(vH, vF);
+            _mm256_store_si256(pvHStore + j, vH);
+            vH = _mm256_subs_epu8(vH, vGapOpen);
+            _mm256_store_si256(pvE + j, _mm256_max_epu8(_mm256_load_si256(pvE + j), vH));
+            // a gap opened from the updated score is cheaper to extend if the extension penalty is greater
+            vF = _mm256_max_epu8(_mm256_subs_epu8(vF, vGapExtend), _mm256_andnot_si256(vKept, vH));
+            if (++j >= iter) {
+                j = 0;
+                vF = shiftBytesUp(vF);
+            }
+            vH = _mm256_load_si256(pvHStore + j);
+        }
+
+        overflow = 0 != _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(vMaxScore, vLimit), vMaxScore));
+    }
+
+    _mm_free(pvHLoad);
+    _mm_free(pvHStore);
+    _mm_free(pvE);
+    _mm_free(pvQueryProf);
+
+    return overflow ? -1 : getMaxU8(vMaxScore);
+}
+
+/**
+ * Score-only pass with 16 signed word lanes. Zero is biased to -32768 to get
+ * the full 16 bit range, so the result is saturated at 0xFFFF.
+ */
+SW_AVX2_TARGET int calculateMaxScoreWithWords(const SMatrix &substitutionMatrix, const QByteArray &patternSeq,
+                                              const QByteArray &searchSeq, int gapOpen, int gapExtension) {
+    const int queryLength = patternSeq.length();
+    const int iter = (queryLength + N_WORDS_IN_VEC - 1) / N_WORDS_IN_VEC;
+    const char *pat = patternSeq.constData();
+
+    __m256i *pvQueryProf = (__m256i*)_mm_malloc(0x80 * iter * sizeof(__m256i), 32);
+    memset(pvQueryProf, 0, 0x80 * iter * sizeof(__m256i));
+    QByteArray alphaChars = substitutionMatrix.getAlphabet()->getAlphabetChars();
+    foreach (char ch, alphaChars) {
+        qint16 *weight = (qint16*)(pvQueryProf + (quint8)ch * iter);
+        for (int j = 0; j < iter; j++) {
+            for (int k = j, n = 0; n < N_WORDS_IN_VEC; n++, k += iter) {
+                *weight++ = (k < queryLength) ? substitutionMatrix.getScore(ch, pat[k]) : 0;
+            }
+        }
+    }
+
+    const __m256i vZeroScore = _mm256_set1_epi16(-0x8000);
+    const __m256i vMin = _mm256_setr_epi16(-0x8000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i vGapOpen = _mm256_set1_epi16((short)qMin(-gapOpen, 0x7FFF));
+    const __m256i vGapExtend = _mm256_set1_epi16((short)qMin(-gapExtension, 0x7FFF));
+    __m256i vMaxScore = vZeroScore;
+
+    __m256i *pvHLoad = (__m256i*)_mm_malloc(iter * sizeof(__m256i), 32);
+    __m256i *pvHStore = (__m256i*)_mm_malloc(iter * sizeof(__m256i), 32);
+    __m256i *pvE = (__m256i*)_mm_malloc(iter * sizeof(__m256i), 32);
+    for (int j = 0; j < iter; j++) {
+        _mm256_store_si256(pvHStore + j, vZeroScore);
+        _mm256_store_si256(pvE + j, vZeroScore);
+    }
+
+    const unsigned char *src = (const unsigned char*)searchSeq.constData();
+    const int srcLength = searchSeq.length();
+    for (int i = 0; i < srcLength; i++) {
+        const __m256i *pvScore = pvQueryProf + src[i] * iter;
+
+        __m256i vF = vZeroScore;
+        __m256i vH = _mm256_or_si256(shiftWordsUp(_mm256_load_si256(pvHStore + iter - 1)), vMin);
+        qSwap(pvHLoad, pvHStore);
+
+        for (int j = 0; j < iter; j++) {
+            vH = _mm256_adds_epi16(vH, _mm256_load_si256(pvScore + j));
+            vMaxScore = _mm256_max_epi16(vMaxScore, vH);
+
+            __m256i vE = _mm256_load_si256(pvE + j);
+            vH = _mm256_max_epi16(vH, vE);
+            vH = _mm256_max_epi16(vH, vF);
+            _mm256_store_si256(pvHStore + j, vH);
+
+            vH = _mm256_subs_epi16(vH, vGapOpen);
+            vE = _mm256_max_epi16(_mm256_subs_epi16(vE, vGapExtend), vH);
+            _mm256_store_si256(pvE + j, vE);
+            vF = _mm256_max_epi16(_mm256_subs_epi16(vF, vGapExtend), vH);
+
+            vH = _mm256_load_si256(pvHLoad + j);
+        }
+
+        int j = 0;
+        vF = _mm256_or_si256(shiftWordsUp(vF), vMin);
+        vH = _mm256_load_si256(pvHStore);
+        while (isAnyGreaterI16(vF, _mm256_subs_epi16(vH, vGapOpen))) {
+            __m256i vKept = _mm256_cmpeq_epi16(_mm256_max_epi16(vH, vF), vH);
+            vH = _mm256_max_epi16(vH, vF);
+            _mm256_store_si256(pvHStore + j, vH);
+            vH = _mm256_subs_epi16(vH, vGapOpen);
+            _mm256_store_si256(pvE + j, _mm256_max_epi16(_mm256_load_si256(pvE + j), vH));
+            vF = _mm256_max_epi16(_mm256_subs_epi16(vF, vGapExtend), _mm256_blendv_epi8(vH, vZeroScore, vKept));
+            if (++j >= iter) {
+                j = 0;
+                vF = _mm256_or_si256(shiftWordsUp(vF), vMin);
+            }
+            vH = _mm256_load_si256(pvHStore + j);
+        }
+    }
+
+    _mm_free(pvHLoad);
+    _mm_free(pvHStore);
+    _mm_free(pvE);
+    _mm_free(pvQueryProf);
+
+    return getMaxI16(vMaxScore) + 0x8000;
+}
+
+/**
+ * 16-lane version of SmithWatermanAlgorithmSSE2::calculateMatrixForAnnotationsResultWithShort.
+ * Every segment keeps 5 vectors: score and start position for two rows, and the vertical gap score.
+ * Start positions are stored modulo 0x10000, so the matrix length must be less than that.
+ */
+SW_AVX2_TARGET void calculateAnnotationsWithWords(const SMatrix &substitutionMatrix, const QByteArray &patternSeq,
+                                                  const QByteArray &searchSeq, int gapOpen, int gapExtension, int minScore,
+                                                  QList<PairAlignSequences> &pairAlignmentStrings) {
+    const int patLength = patternSeq.length();
+    const int srcLength = searchSeq.length();
+    const char *pat = patternSeq.constData();
+    const unsigned char *src = (const unsigned char*)searchSeq.constData();
+    const int iter = (patLength + N_WORDS_IN_VEC - 1) / N_WORDS_IN_VEC;
+
+    const int n = (iter + 1) * 5;
+    __m256i *matrix = (__m256i*)_mm_malloc((n + iter * 0x80) * sizeof(__m256i), 32);
+    __m256i *profile = matrix + n;
+    memset(matrix, 0, (n + iter * 0x80) * sizeof(__m256i));
+
+    QByteArray alphaChars = substitutionMatrix.getAlphabet()->getAlphabetChars();
+    foreach (char ch, alphaChars) {
+        qint16 *weight = (qint16*)(profile + (quint8)ch * iter);
+        for (int j = 0; j < iter; j++) {
+            for (int k = j, l = 0; l < N_WORDS_IN_VEC; l++, k += iter) {
+                *weight++ = (k < patLength) ? substitutionMatrix.getScore(ch, pat[k]) : -0x8000;
+            }
+        }
+    }
+
+    const __m256i vZero = _mm256_setzero_si256();
+    const __m256i vOpen = _mm256_set1_epi16((short)gapOpen);
+    const __m256i vExt = _mm256_set1_epi16((short)gapExtension);
+    __m256i *segments = matrix + 5;
+
+    PairAlignSequences p;
+    p.refSubseqInterval.startPos = 0;
+    p.score = 0;
+
+    for (int i = 1; i <= srcLength; i++) {
+        // rows are stored alternately at offsets 0 and 2 of a segment
+        const int cur = (i & 1) ? 0 : 2;
+        const int prev = 2 - cur;
+        const __m256i *score = profile + src[i - 1] * iter;
+        const __m256i vI = _mm256_set1_epi16((short)i);
+
+        __m256i xMax = vZero;
+        __m256i xPos = vZero;
+        __m256i vH = shiftWordsUp(_mm256_load_si256(segments + (iter - 1) * 5 + prev));
+        __m256i vP = _mm256_insert_epi16(shiftWordsUp(_mm256_load_si256(segments + (iter - 1) * 5 + prev + 1)), (short)(i - 1), 0);
+        __m256i e1 = vZero;
+        __m256i leftPos = vZero;
+
+        for (int j = 0; j < iter; j++) {
+            __m256i *seg = segments + j * 5;
+            __m256i h = _mm256_max_epi16(_mm256_adds_epi16(vH, _mm256_load_si256(score + j)), vZero);
+            __m256i pos = _mm256_blendv_epi8(vP, vI, _mm256_cmpeq_epi16(h, vZero));
+
+            xMax = _mm256_max_epi16(xMax, h);
+            xPos = _mm256_blendv_epi8(xPos, pos, _mm256_cmpeq_epi16(h, xMax));
+
+            __m256i f = _mm256_load_si256(seg + 4);
+            __m256i hf = _mm256_max_epi16(h, f);
+            pos = _mm256_blendv_epi8(_mm256_load_si256(seg + prev + 1), pos, _mm256_cmpeq_epi16(h, hf));
+            __m256i he = _mm256_max_epi16(e1, hf);
+            pos = _mm256_blendv_epi8(leftPos, pos, _mm256_cmpeq_epi16(hf, he));
+
+            vH = _mm256_load_si256(seg + prev);
+            vP = _mm256_load_si256(seg + prev + 1);
+            _mm256_store_si256(seg + cur, he);
+            _mm256_store_si256(seg + cur + 1, pos);
+
+            __m256i open = _mm256_adds_epi16(he, vOpen);
+            e1 = _mm256_max_epi16(_mm256_adds_epi16(e1, vExt), open);
+            _mm256_store_si256(seg + 4, _mm256_max_epi16(_mm256_adds_epi16(f, vExt), open));
+            leftPos = pos;
+        }
+
+        // carry the horizontal gaps over the segment boundaries
+        int j = 0;
+        e1 = shiftWordsUp(e1);
+        leftPos = shiftWordsUp(leftPos);
+        for (;;) {
+            __m256i *seg = segments + j * 5;
+            __m256i h = _mm256_load_si256(seg + cur);
+            if (!isAnyGreaterI16(e1, _mm256_max_epi16(vZero, _mm256_adds_epi16(h, vOpen)))) {
+                break;
+            }
+            __m256i he = _mm256_max_epi16(e1, h);
+            __m256i kept = _mm256_cmpeq_epi16(h, he);
+            __m256i pos = _mm256_blendv_epi8(leftPos, _mm256_load_si256(seg + cur + 1), kept);
+            _mm256_store_si256(seg + cur, he);
+            _mm256_store_si256(seg + cur + 1, pos);
+
+            __m256i open = _mm256_adds_epi16(he, vOpen);
+            _mm256_store_si256(seg + 4, _mm256_max_epi16(_mm256_load_si256(seg + 4), open));
+            e1 = _mm256_max_epi16(_mm256_adds_epi16(e1, vExt), _mm256_andnot_si256(kept, open));
+            leftPos = pos;
+            if (++j >= iter) {
+                j = 0;
+                e1 = shiftWordsUp(e1);
+                leftPos = shiftWordsUp(leftPos);
+            }
+        }
+
+        // the last lane wins on equal scores, as the greatest pattern position does in the classic realization
+        short maxes[N_WORDS_IN_VEC];
+        short positions[N_WORDS_IN_VEC];
+        _mm256_storeu_si256((__m256i*)maxes, xMax);
+        _mm256_storeu_si256((__m256i*)positions, xPos);
+        int max1 = maxes[0];
+        int lane = 0;
+        for (int k = 1; k < N_WORDS_IN_VEC; k++) {
+            if (maxes[k] >= max1) {
+                max1 = maxes[k];
+                lane = k;
+            }
+        }
+
+        if (max1 >= minScore) {
+            int startPos = ((positions[lane] - i - 1) | -0x10000) + i + 1;
+            p.refSubseqInterval.startPos = startPos;
+            p.refSubseqInterval.length = i - startPos;
+            p.score = max1;
+            pairAlignmentStrings.append(p);
+        }
+    }
+
+    _mm_free(matrix);
+}
+
+}
+
+quint64 SmithWatermanAlgorithmAVX2::estimateNeededRamAmount(const QByteArray & _patternSeq,
+    const QByteArray & _searchSeq, const qint32 gapOpen, const qint32 gapExtension,
+    const quint32 minScore, const quint32 maxScore,
+    const SmithWatermanSettings::SWResultView resultView)
+{
+    const double b_to_mb_factor = 1048576.0;
+
+    const quint64 iter = (_patternSeq.length() + N_WORDS_IN_VEC - 1) / N_WORDS_IN_VEC;
+    const quint64 memNeeded = ((iter + 1) * 5 + iter * 0x80) * sizeof(__m256i);
+
+    // the kernels with traceback and with int scores are shared with SSE2
+    const quint64 sse2MemNeeded = SmithWatermanAlgorithmSSE2::estimateNeededRamAmount(_patternSeq, _searchSeq,
+        gapOpen, gapExtension, minScore, maxScore, resultView);
+
+    return qMax(static_cast<quint64>(memNeeded / b_to_mb_factor), sse2MemNeeded);
+}
+
+void SmithWatermanAlgorithmAVX2::launch(const SMatrix& _substitutionMatrix, const QByteArray & _patternSeq,
+    const QByteArray & _searchSeq, int _gapOpen, int _gapExtension, int _minScore, SmithWatermanSettings::SWResultView _resultView) {
+    setValues(_substitutionMatrix, _patternSeq, _searchSeq, _gapOpen, _gapExtension, _minScore, _resultView);
+    if (!isValidParams() || !calculateMatrixLength()) {
+        return;
+    }
+
+    const int maxScore = calculateMaxScore();
+    if (minScore > maxScore) {
+        return;
+    }
+
+    if (maxScore >= 0x8000 || matrixLength >= 0x10000) {
+        switch(resultView) {
+        case SmithWatermanSettings::MULTIPLE_ALIGNMENT:
+            calculateMatrixForMultipleAlignmentResultWithInt();
+            break;
+        case SmithWatermanSettings::ANNOTATIONS:
+            calculateMatrixForAnnotationsResultWithInt();
+            break;
+        default:
+            assert(false);
+        }
+    } else {
+        switch(resultView) {
+        case SmithWatermanSettings::MULTIPLE_ALIGNMENT:
+            calculateMatrixForMultipleAlignmentResultWithShort();
+            break;
+        case SmithWatermanSettings::ANNOTATIONS:
+            calculateMatrixForAnnotationsResultWithShortAVX2();
+            break;
+        default:
+            assert(false);
+        }
+    }
+}
+
+int SmithWatermanAlgorithmAVX2::calculateMaxScore() {
+    int maxScore = calculateMaxScoreWithBytes(substitutionMatrix, patternSeq, searchSeq, gapOpen, gapExtension);
+    if (-1 == maxScore) {
+        maxScore = calculateMaxScoreWithWords(substitutionMatrix, patternSeq, searchSeq, gapOpen, gapExtension);
+    }
+    return maxScore;
+}
+
+void SmithWatermanAlgorithmAVX2::calculateMatrixForAnnotationsResultWithShortAVX2() {
+    calculateAnnotationsWithWords(substitutionMatrix, patternSeq, searchSeq, gapOpen, gapExtension, minScore,
+        pairAlignmentStrings);
+}
+
+} //namespace
+#endif //SW2_BUILD_WITH_AVX2
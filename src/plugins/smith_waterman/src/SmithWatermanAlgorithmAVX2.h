@@ -0,0 +1,59 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifdef SW2_BUILD_WITH_AVX2
+
+#ifndef _SMITHWATERMANALGORITHM_AVX2_H
+#define _SMITHWATERMANALGORITHM_AVX2_H
+
+#include "SmithWatermanAlgorithmSSE2.h"
+
+namespace U2 {
+
+/**
+ * Striped Smith-Waterman on 256-bit registers.
+ * The best score is estimated with 32 unsigned byte lanes first and recomputed
+ * with 16 word lanes if the byte lanes saturate. Annotation results are collected
+ * by the 16-lane word kernel, other cases are delegated to the SSE2 kernels,
+ * so the results are the same as the classic realization gives.
+ * Must be used only if AppResourcePool::isAVX2Enabled() returns true.
+ */
+class SmithWatermanAlgorithmAVX2 : public SmithWatermanAlgorithmSSE2 {
+public:
+    virtual void launch(const SMatrix& substitutionMatrix, const QByteArray & _patternSeq,
+        const QByteArray & _searchSeq, int _gapOpen, int _gapExtension, int _minScore,
+        SmithWatermanSettings::SWResultView resultView);
+
+    static quint64 estimateNeededRamAmount(const QByteArray & _patternSeq,
+        const QByteArray & _searchSeq, const qint32 gapOpen, const qint32 gapExtension,
+        const quint32 minScore, const quint32 maxScore,
+        const SmithWatermanSettings::SWResultView resultView);
+
+private:
+    int calculateMaxScore();
+    void calculateMatrixForAnnotationsResultWithShortAVX2();
+};
+
+} // namespace
+
+#endif
+#endif //SW2_BUILD_WITH_AVX2
@@ -43,13 +43,15 @@ public:
         const quint32 minScore, const quint32 maxScore,
         const SmithWatermanSettings::SWResultView resultView);
 
-private:
-    static const int nElementsInVec = 8;
-    void printVector(__m128i &toprint, int add);
+protected:
     void calculateMatrixForMultipleAlignmentResultWithShort();
     void calculateMatrixForAnnotationsResultWithShort();
     void calculateMatrixForMultipleAlignmentResultWithInt();
     void calculateMatrixForAnnotationsResultWithInt();
+
+private:
+    static const int nElementsInVec = 8;
+    void printVector(__m128i &toprint, int add);
     int calculateMatrixSSE2(unsigned queryLength, unsigned char *dbSeq, unsigned dbLength,
         unsigned short gapOpenOrig, unsigned short gapExtend);
 };
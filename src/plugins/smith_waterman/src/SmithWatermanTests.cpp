@@ -20,8 +20,13 @@
  */
 
 #include "SmithWatermanTests.h"
+#include "SWAlgorithmTask.h"
+#include "SmithWatermanAlgorithm.h"
 
+#include <U2Core/AppResources.h>
+#include <U2Core/DNAAlphabet.h>
 #include <U2Core/DNASequenceObject.h>
+#include <U2Core/Log.h>
 
 #include <U2Algorithm/SmithWatermanTaskFactoryRegistry.h>
 #include <U2Core/AppContext.h>
@@ -32,6 +37,8 @@
 #include <U2Core/SMatrix.h>
 #include <U2Core/U2SafePoints.h>
 
+#include <QtCore/QScopedPointer>
+
 
 #define FILE_SUBSTITUTION_MATRIX_ATTR "subst_f"
 #define FILE_FASTA_CONTAIN_SEQUENCE_ATTR "seq_f"
@@ -42,6 +49,13 @@
 #define EXPECTED_RESULT_ATTR "expected_res"
 #define ENV_IMPL_ATTR "IMPL"
 #define IMPL_ATTR "impl"
+#define PATTERNS_ATTR "patterns"
+#define RUNS_COUNT_ATTR "runs"
+#define PATTERN_LENGTH_ATTR "pattern_length"
+#define SEQUENCE_LENGTH_ATTR "seq_length"
+#define MAX_MATCH_SCORE_ATTR "max_match_score"
+#define BYTE_OVERFLOW_ATTR "byte_overflow"
+#define SEED_ATTR "seed"
 
 using namespace std;
 namespace U2 {
@@ -305,6 +319,306 @@ Task::ReportResult GTest_SmithWatermnan::report() {
 }
 
 
+void GTest_SmithWatermanBatch::init(XMLTestFormat *tf, const QDomElement& el) {
+    Q_UNUSED(tf);
+
+    searchSeqDocName = el.attribute(FILE_FASTA_CONTAIN_SEQUENCE_ATTR);
+    if (searchSeqDocName.isEmpty()) {
+        failMissingValue(FILE_FASTA_CONTAIN_SEQUENCE_ATTR);
+        return;
+    }
+
+    pathToSubst = el.attribute(FILE_SUBSTITUTION_MATRIX_ATTR);
+    if (pathToSubst.isEmpty()) {
+        failMissingValue(FILE_SUBSTITUTION_MATRIX_ATTR);
+        return;
+    }
+
+    QString patterns = el.attribute(PATTERNS_ATTR);
+    if (patterns.isEmpty()) {
+        failMissingValue(PATTERNS_ATTR);
+        return;
+    }
+    foreach (const QString &region, patterns.split(",", QString::SkipEmptyParts)) {
+        QStringList bounds = region.split("..");
+        bool startOk = false;
+        bool endOk = false;
+        int start = bounds.first().toInt(&startOk);
+        int end = bounds.last().toInt(&endOk);
+        if (bounds.size() != 2 || !startOk || !endOk || end <= start) {
+            stateInfo.setError(QString("wrong pattern region: %1").arg(region));
+            return;
+        }
+        patternRegions << U2Region(start, end - start);
+    }
+
+    gapOpen = el.attribute(GAP_OPEN_ATTR, "-10").toInt();
+    gapExtension = el.attribute(GAP_EXT_ATTR, "-1").toInt();
+    percentOfScore = el.attribute(PERCENT_OF_SCORE_ATTR, "90").toFloat();
+
+    impl = env->getVar(ENV_IMPL_ATTR);
+    if (impl.isEmpty()) {
+        failMissingValue(ENV_IMPL_ATTR);
+        return;
+    }
+}
+
+SmithWatermanSettings GTest_SmithWatermanBatch::createSettings(const SMatrix &mtx, const QByteArray &searchSeq, const QByteArray &patternSeq) const {
+    SmithWatermanSettings settings;
+    settings.pSm = mtx;
+    settings.sqnc = searchSeq;
+    settings.ptrn = patternSeq;
+    settings.globalRegion = U2Region(0, searchSeq.length());
+    settings.gapModel.scoreGapOpen = gapOpen;
+    settings.gapModel.scoreGapExtd = gapExtension;
+    settings.percentOfScore = percentOfScore;
+    settings.aminoTT = NULL;
+    settings.complTT = NULL;
+    settings.strand = StrandOption_DirectOnly;
+    settings.resultCallback = NULL;
+    settings.resultFilter = 0;
+    settings.resultListener = new SmithWatermanResultListener();
+    return settings;
+}
+
+void GTest_SmithWatermanBatch::prepare() {
+    U2SequenceObject *searchSeqObj = getContext<U2SequenceObject>(this, searchSeqDocName);
+    if (NULL == searchSeqObj) {
+        stateInfo.setError(QString("error can't cast to sequence from GObject"));
+        return;
+    }
+    QByteArray searchSeq = searchSeqObj->getWholeSequenceData(stateInfo);
+    CHECK_OP(stateInfo, );
+
+    QString error;
+    SMatrix mtx = SubstMatrixRegistry::readMatrixFromFile(getEnv()->getVar("COMMON_DATA_DIR") + "/" + pathToSubst, error);
+    if (mtx.isEmpty()) {
+        stateInfo.setError(QString("value not set %1").arg(FILE_SUBSTITUTION_MATRIX_ATTR));
+        return;
+    }
+
+    SmithWatermanTaskFactory *factory = AppContext::getSmithWatermanTaskFactoryRegistry()->getFactory(impl);
+    if (NULL == factory) {
+        stateInfo.setError(QString("Not known impl of Smith-Waterman: %1").arg(impl));
+        return;
+    }
+
+    foreach (const U2Region &region, patternRegions) {
+        CHECK_EXT(region.endPos() <= searchSeq.length(), setError(QString("The pattern region is out of the sequence: %1").arg(region.toString())), );
+        const QByteArray patternSeq = searchSeq.mid(region.startPos, region.length);
+        batchSettings << createSettings(mtx, searchSeq, patternSeq);
+        singleSettings << createSettings(mtx, searchSeq, patternSeq);
+    }
+
+    Task *batchTask = factory->getBatchTaskInstance(batchSettings, "tests SmithWaterman batch");
+    if (NULL == batchTask) {
+        foreach (const SmithWatermanSettings &settings, batchSettings + singleSettings) {
+            delete settings.resultListener;
+        }
+        batchSettings.clear();
+        singleSettings.clear();
+        stateInfo.setError(QString("The batch search is not supported by Smith-Waterman impl: %1").arg(impl));
+        return;
+    }
+    addSubTask(batchTask);
+    foreach (const SmithWatermanSettings &settings, singleSettings) {
+        addSubTask(factory->getTaskInstance(settings, "tests SmithWaterman"));
+    }
+}
+
+Task::ReportResult GTest_SmithWatermanBatch::report() {
+    propagateSubtaskError();
+    CHECK_OP(stateInfo, ReportResult_Finished);
+
+    for (int i = 0; i < batchSettings.size(); i++) {
+        QList<SmithWatermanResult> batchResults = batchSettings[i].resultListener->getResults();
+        QList<SmithWatermanResult> singleResults = singleSettings[i].resultListener->getResults();
+        GTest_SmithWatermnan::sortByScore(batchResults);
+        GTest_SmithWatermnan::sortByScore(singleResults);
+
+        if (batchResults.size() != singleResults.size()) {
+            stateInfo.setError(QString("Results count of the pattern %1 are not equal: batch %2, single %3")
+                .arg(patternRegions[i].toString()).arg(batchResults.size()).arg(singleResults.size()));
+            return ReportResult_Finished;
+        }
+        for (int j = 0; j < batchResults.size(); j++) {
+            const SmithWatermanResult &batchResult = batchResults[j];
+            const SmithWatermanResult &singleResult = singleResults[j];
+            if (batchResult.score != singleResult.score || batchResult.refSubseq != singleResult.refSubseq
+                || batchResult.ptrnSubseq != singleResult.ptrnSubseq || batchResult.strand != singleResult.strand) {
+                stateInfo.setError(QString("Results of the pattern %1 are not equal: batch %2 (%3), single %4 (%5)")
+                    .arg(patternRegions[i].toString())
+                    .arg(batchResult.refSubseq.toString()).arg(batchResult.score)
+                    .arg(singleResult.refSubseq.toString()).arg(singleResult.score));
+                return ReportResult_Finished;
+            }
+        }
+    }
+    return ReportResult_Finished;
+}
+
+namespace {
+
+int randomInt(quint64 &state, int min, int max) {
+    return min + int(XMLTestUtils::nextRandom(state) % quint64(max - min + 1));
+}
+
+QByteArray randomNucleotides(int length, quint64 &state) {
+    static const char CHARS[] = "ACGT";
+    QByteArray res(length, 'A');
+    for (int i = 0; i < length; i++) {
+        res[i] = CHARS[XMLTestUtils::nextRandom(state) % 4];
+    }
+    return res;
+}
+
+QByteArray mutate(const QByteArray &seq, quint64 &state) {
+    QByteArray res = seq;
+    const int mutationsCount = randomInt(state, 1, qMax(1, seq.length() / 10));
+    for (int i = 0; i < mutationsCount && res.length() > 1; i++) {
+        const int pos = randomInt(state, 0, res.length() - 1);
+        switch (randomInt(state, 0, 2)) {
+        case 0:
+            res[pos] = "ACGT"[XMLTestUtils::nextRandom(state) % 4];
+            break;
+        case 1:
+            res.insert(pos, "ACGT"[XMLTestUtils::nextRandom(state) % 4]);
+            break;
+        default:
+            res.remove(pos, 1);
+            break;
+        }
+    }
+    return res;
+}
+
+}
+
+void GTest_SmithWatermanRealizations::init(XMLTestFormat *, const QDomElement& el) {
+    seed = 1;
+    bool ok = false;
+    runsCount = el.attribute(RUNS_COUNT_ATTR, "1").toInt(&ok);
+    if (!ok || runsCount <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(RUNS_COUNT_ATTR));
+        return;
+    }
+    patternLength = el.attribute(PATTERN_LENGTH_ATTR).toInt(&ok);
+    if (!ok || patternLength < 8) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(PATTERN_LENGTH_ATTR));
+        return;
+    }
+    sequenceLength = el.attribute(SEQUENCE_LENGTH_ATTR).toInt(&ok);
+    if (!ok || sequenceLength < 2 * patternLength) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEQUENCE_LENGTH_ATTR));
+        return;
+    }
+    maxMatchScore = el.attribute(MAX_MATCH_SCORE_ATTR, "5").toInt(&ok);
+    if (!ok || maxMatchScore <= 0 || maxMatchScore > 100) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(MAX_MATCH_SCORE_ATTR));
+        return;
+    }
+    percentOfScore = el.attribute(PERCENT_OF_SCORE_ATTR, "70").toFloat(&ok);
+    if (!ok || percentOfScore <= 0 || percentOfScore > 100) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(PERCENT_OF_SCORE_ATTR));
+        return;
+    }
+    byteOverflow = "true" == el.attribute(BYTE_OVERFLOW_ATTR, "false");
+    if (el.hasAttribute(SEED_ATTR)) {
+        seed = el.attribute(SEED_ATTR).toULongLong(&ok);
+        if (!ok || 0 == seed) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEED_ATTR));
+            return;
+        }
+    }
+}
+
+void GTest_SmithWatermanRealizations::run() {
+#ifdef SW2_BUILD_WITH_AVX2
+    if (!AppResourcePool::isAVX2Enabled()) {
+        taskLog.info(QString("%1: AVX2 is not supported by the processor, the test is skipped").arg(getTaskName()));
+        return;
+    }
+
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    CHECK_EXT(NULL != alphabet, stateInfo.setError("No DNA alphabet"), );
+    const QByteArray alphabetChars = alphabet->getAlphabetChars();
+
+    quint64 state = seed;
+    for (int run = 0; run < runsCount; run++) {
+        // mismatches are not rewarded, so the score of an exact copy of the pattern is the maximal one
+        QList<SScore> scores;
+        for (int i = 0; i < alphabetChars.size(); i++) {
+            for (int j = i; j < alphabetChars.size(); j++) {
+                const float score = (i == j) ? randomInt(state, 1, maxMatchScore) : randomInt(state, -maxMatchScore, 0);
+                scores << SScore(alphabetChars[i], alphabetChars[j], score);
+                if (i != j) {
+                    scores << SScore(alphabetChars[j], alphabetChars[i], score);
+                }
+            }
+        }
+        const SMatrix mtx("random", alphabet, scores);
+
+        const QByteArray patternSeq = randomNucleotides(patternLength, state);
+        QByteArray searchSeq = randomNucleotides(sequenceLength, state);
+        const int copiesCount = sequenceLength / (2 * patternLength);
+        for (int i = 0; i < copiesCount; i++) {
+            const QByteArray copy = (0 == i) ? patternSeq : mutate(patternSeq, state);
+            const int pos = randomInt(state, 0, sequenceLength - copy.length());
+            searchSeq.replace(pos, copy.length(), copy);
+        }
+        const int gapOpen = randomInt(state, -2 * maxMatchScore, -1);
+        const int gapExtension = randomInt(state, gapOpen, -1);
+
+        const int maxScore = SWAlgorithmTask::calculateMaxScore(patternSeq, mtx);
+        int minScore = int(maxScore * percentOfScore) / 100;
+        if (int(maxScore * percentOfScore) % 100 != 0) {
+            minScore += 1;
+        }
+        CHECK_EXT(!byteOverflow || maxScore >= 0xFF,
+            stateInfo.setError(QString("Run %1: the maximal score %2 does not overflow the byte scores").arg(run).arg(maxScore)), );
+
+        foreach (SmithWatermanSettings::SWResultView view, QList<SmithWatermanSettings::SWResultView>()
+                 << SmithWatermanSettings::ANNOTATIONS << SmithWatermanSettings::MULTIPLE_ALIGNMENT) {
+            const QString error = compareResults(mtx, patternSeq, searchSeq, gapOpen, gapExtension, minScore, view);
+            CHECK_EXT(error.isEmpty(), stateInfo.setError(QString("Run %1, %2: %3").arg(run)
+                .arg(SmithWatermanSettings::ANNOTATIONS == view ? "annotations" : "multiple alignment").arg(error)), );
+        }
+    }
+#else
+    taskLog.info(QString("%1: AVX2 is not enabled in this build, the test is skipped").arg(getTaskName()));
+#endif
+}
+
+QString GTest_SmithWatermanRealizations::compareResults(const SMatrix &mtx, const QByteArray &patternSeq, const QByteArray &searchSeq,
+    int gapOpen, int gapExtension, int minScore, SmithWatermanSettings::SWResultView view) const
+{
+    QScopedPointer<SmithWatermanAlgorithm> classic(SWAlgorithmTask::createAlgorithm(SW_classic));
+    QScopedPointer<SmithWatermanAlgorithm> avx2(SWAlgorithmTask::createAlgorithm(SW_avx2));
+    CHECK(NULL != classic.data() && NULL != avx2.data(), "Can't create the algorithm");
+
+    classic->launch(mtx, patternSeq, searchSeq, gapOpen, gapExtension, minScore, view);
+    avx2->launch(mtx, patternSeq, searchSeq, gapOpen, gapExtension, minScore, view);
+
+    QList<PairAlignSequences> expected = classic->getResults();
+    QList<PairAlignSequences> actual = avx2->getResults();
+    SmithWatermanAlgorithm::sortByScore(expected);
+    SmithWatermanAlgorithm::sortByScore(actual);
+
+    CHECK(!expected.isEmpty(), "No results are found");
+    CHECK(expected.size() == actual.size(), QString("Results count: classic %1, AVX2 %2").arg(expected.size()).arg(actual.size()));
+    for (int i = 0; i < expected.size(); i++) {
+        const PairAlignSequences &e = expected[i];
+        const PairAlignSequences &a = actual[i];
+        if (e.score != a.score || e.refSubseqInterval != a.refSubseqInterval || e.ptrnSubseqInterval != a.ptrnSubseqInterval
+            || e.pairAlignment != a.pairAlignment) {
+            return QString("Result %1: classic %2 %3 (%4), AVX2 %5 %6 (%7)").arg(i)
+                .arg(e.refSubseqInterval.toString()).arg(e.ptrnSubseqInterval.toString()).arg(e.score)
+                .arg(a.refSubseqInterval.toString()).arg(a.ptrnSubseqInterval.toString()).arg(a.score);
+        }
+    }
+    return QString();
+}
+
 void GTest_SmithWatermnanPerf::init(XMLTestFormat *tf, const QDomElement& el) {
     Q_UNUSED(tf);
 
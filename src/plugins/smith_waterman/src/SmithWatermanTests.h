@@ -23,6 +23,7 @@
 #define _U2_SW_ALHORITHM_TESTS_H_
 
 #include <U2Core/GObject.h>
+#include <U2Core/SMatrix.h>
 #include <U2Core/U2Region.h>
 
 #include <U2Test/XMLTestUtils.h>
@@ -75,6 +76,62 @@ private:
     QString machinePath;
 };
 
+/**
+ * Searches several patterns in one sequence with the batch task and with a single pattern task per pattern,
+ * checks that the results of every pattern are the same.
+ * The patterns are the regions of the search sequence, e.g. "10..40,100..112".
+ */
+class GTest_SmithWatermanBatch : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY(GTest_SmithWatermanBatch, "plugin_sw-batch-algorithm");
+
+    void prepare();
+    Task::ReportResult report();
+
+private:
+    SmithWatermanSettings createSettings(const SMatrix &mtx, const QByteArray &searchSeq, const QByteArray &patternSeq) const;
+
+    QString searchSeqDocName;
+    QList<U2Region> patternRegions;
+    QString pathToSubst;
+    QString impl;
+    int gapOpen;
+    int gapExtension;
+    float percentOfScore;
+
+    QList<SmithWatermanSettings> batchSettings;
+    QList<SmithWatermanSettings> singleSettings;
+};
+
+/**
+ * Runs the AVX2 and the classic realizations on random sequences and a random substitution matrix
+ * in both result views and checks that all results are the same.
+ * Exact and mutated copies of the pattern are planted in the sequence, so the results are not empty.
+ * If "byte_overflow" is set, the matrix scores must overflow the byte lanes of the AVX2 kernel,
+ * so the word fallback is checked.
+ * The test is skipped if AVX2 is not supported by the build or by the processor.
+ */
+class GTest_SmithWatermanRealizations : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_SmithWatermanRealizations, "plugin_sw-realizations", TaskFlags_FOSCOE);
+
+    void run();
+
+private:
+    QString compareResults(const SMatrix &mtx, const QByteArray &patternSeq, const QByteArray &searchSeq,
+        int gapOpen, int gapExtension, int minScore, SmithWatermanSettings::SWResultView view) const;
+
+    int runsCount;
+    int patternLength;
+    int sequenceLength;
+    int maxMatchScore;
+    float percentOfScore;
+    bool byteOverflow;
+    quint64 seed;
+};
+
 class GTest_SmithWatermnanPerf : public GTest {
     Q_OBJECT
 public:
@@ -21,10 +21,157 @@
 
 #include "WeightMatrixAlgorithm.h"
 
+#include <U2Core/AppResources.h>
 #include <U2Core/DIProperties.h>
+#include <U2Core/U2SafePoints.h>
+
+#ifdef WM_BUILD_WITH_AVX2
+#include <immintrin.h>
+
+// The plugin is built for the generic CPU, so the AVX2 code is enabled per function
+// and is called only after the CPU has been checked at runtime.
+#if defined(__GNUC__) && !defined(__AVX2__)
+#define WM_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define WM_AVX2_TARGET
+#endif
+#endif
 
 namespace U2 {
 
+namespace {
+
+/** Number of windows scored at once, the accumulators of a block stay in the L1 cache */
+const int SCAN_BLOCK_SIZE = 256;
+
+#ifdef WM_BUILD_WITH_AVX2
+/**
+ * Adds the column values of 8 windows at once, the values are gathered by the nucleotide codes.
+ * Every window gets the same single addition as in the scalar loop, so the sums are equal.
+ * Returns the count of processed windows.
+ */
+WM_AVX2_TARGET int accumulateWithAVX2(const float* column, const quint8* codes, int count, float* acc) {
+    int p = 0;
+    for (; p + 8 <= count; p += 8) {
+        const __m256i indexes = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(codes + p)));
+        const __m256 values = _mm256_i32gather_ps(column, indexes, 4);
+        _mm256_storeu_ps(acc + p, _mm256_add_ps(_mm256_loadu_ps(acc + p), values));
+    }
+    return p;
+}
+#endif
+
+/** Matrix values in the window order, the values of a column are stored contiguously to be addressed by the nucleotide index */
+class ScanMatrix {
+public:
+    ScanMatrix(const WeightMatrixEncodedSequence& seq, const PWMatrix& m, const quint8* monoCodes, const quint8* diCodes, float minScore, bool useAVX2)
+        : length(m.getLength()), codes(NULL), lower(m.getMinSum()), upper(m.getMaxSum()), minScore(minScore), useAVX2(useAVX2)
+    {
+        const bool mono = m.getType() == PWM_MONONUCLEOTIDE;
+        const int rows = mono ? 4 : 16;
+        codes = mono ? monoCodes : diCodes;
+        values.resize(length * rows);
+        offsets.resize(length);
+        maxTailSums.fill(0, length + 1);
+        for (int i = length - 1; i >= 0; i--) {
+            float maxValue = m.getValue(0, i);
+            for (int r = 0; r < rows; r++) {
+                const float v = m.getValue(r, i);
+                values[i * rows + r] = v;
+                maxValue = qMax(maxValue, v);
+            }
+            maxTailSums[i] = maxTailSums[i + 1] + maxValue;
+            // see WeightMatrixAlgorithm::getScore(): the complementary window is read backwards from its last position
+            if (!seq.isComplemented()) {
+                offsets[i] = i;
+            } else {
+                offsets[i] = mono ? length - i : length - i - 1;
+            }
+        }
+        // a block is abandoned when none of its windows can reach the threshold, the slack covers the rounding errors
+        canAbandon = minScore > 0 && upper - lower > 1e-9;
+        abandonThreshold = lower + (upper - lower) * minScore / 100 - 1e-4f * (qAbs(lower) + qAbs(upper));
+    }
+
+    /** Adds found windows of the block [start, start + count) to the 'hits' */
+    void scanBlock(int start, int count, float* acc, QList<WeightMatrixHit>& hits) const {
+        const int rows = values.size() / length;
+        for (int p = 0; p < count; p++) {
+            acc[p] = 0;
+        }
+        for (int i = 0; i < length; i++) {
+            // the same summation order as in getScore(), so the scores are equal
+            const float* column = values.constData() + i * rows;
+            const quint8* c = codes + start + offsets[i];
+            int p = 0;
+#ifdef WM_BUILD_WITH_AVX2
+            if (useAVX2) {
+                p = accumulateWithAVX2(column, c, count, acc);
+            }
+#endif
+            for (; p < count; p++) {
+                acc[p] += column[c[p]];
+            }
+            if (canAbandon && (i & 3) == 3 && i + 1 < length) {
+                float best = acc[0];
+                for (int p = 1; p < count; p++) {
+                    best = qMax(best, acc[p]);
+                }
+                if (best + maxTailSums[i + 1] < abandonThreshold) {
+                    return;
+                }
+            }
+        }
+        for (int p = 0; p < count; p++) {
+            const float psum = (acc[p] - lower) / (upper - lower);
+            const float score = 100 * psum;
+            if (score >= minScore) {
+                hits << WeightMatrixHit(start + p, score);
+            }
+        }
+    }
+
+    int getLength() const { return length; }
+
+private:
+    int             length;
+    const quint8*   codes;
+    QVector<float>  values;
+    QVector<int>    offsets;
+    QVector<float>  maxTailSums;
+    float           lower;
+    float           upper;
+    float           minScore;
+    bool            canAbandon;
+    float           abandonThreshold;
+    bool            useAVX2;
+};
+
+}   // namespace
+
+WeightMatrixEncodedSequence::WeightMatrixEncodedSequence(const char* seq, int len, DNATranslation* complMap)
+    : len(len), complemented(NULL != complMap)
+{
+    quint8 charCodes[256];
+    const QByteArray complMapper = complemented ? complMap->getOne2OneMapper() : QByteArray();
+    for (int c = 0; c < 256; c++) {
+        charCodes[c] = DiProperty::index(complemented ? complMapper[c] : char(c));
+    }
+
+    monoCodes.resize(len + 1);
+    quint8* mono = monoCodes.data();
+    for (int i = 0; i < len; i++) {
+        mono[i] = charCodes[uchar(seq[i])];
+    }
+    mono[len] = 0;
+
+    diCodes.resize(len);
+    quint8* di = diCodes.data();
+    for (int i = 0; i < len; i++) {
+        di[i] = complemented ? (mono[i + 1] << 2) + mono[i] : (mono[i] << 2) + mono[i + 1];
+    }
+}
+
 float WeightMatrixAlgorithm::getScore(const char* seq, int len, const PWMatrix& m, DNATranslation* complMap) {
     int l = m.getLength();
 
@@ -49,4 +196,45 @@ float WeightMatrixAlgorithm::getScore(const char* seq, int len, const PWMatrix&
     return (curr - lower) / (upper - lower);
 }
 
+void WeightMatrixAlgorithm::scan(const WeightMatrixEncodedSequence& seq, const QList<PWMatrix>& matrices, const QVector<float>& minScores,
+                                 QVector< QList<WeightMatrixHit> >& hits, TaskStateInfo& ti)
+{
+    SAFE_POINT(matrices.size() == minScores.size(), "Invalid count of the matrix thresholds", );
+    hits.fill(QList<WeightMatrixHit>(), matrices.size());
+
+#ifdef WM_BUILD_WITH_AVX2
+    const bool useAVX2 = AppResourcePool::isAVX2Enabled();
+#else
+    const bool useAVX2 = false;
+#endif
+    QList<ScanMatrix> scanMatrices;
+    int minLength = seq.getLength() + 1;
+    for (int i = 0; i < matrices.size(); i++) {
+        scanMatrices << ScanMatrix(seq, matrices[i], seq.monoCodes.constData(), seq.diCodes.constData(), minScores[i], useAVX2);
+        minLength = qMin(minLength, matrices[i].getLength());
+    }
+    const int maxWindowsCount = seq.getLength() - minLength + 1;
+    CHECK(maxWindowsCount > 0, );
+
+    // all matrices are applied to a block before the next one, so the block codes are read from the cache
+    float acc[SCAN_BLOCK_SIZE];
+    ti.progress = 0;
+    for (int start = 0; start < maxWindowsCount && !ti.cancelFlag; start += SCAN_BLOCK_SIZE) {
+        for (int i = 0; i < scanMatrices.size(); i++) {
+            const ScanMatrix& m = scanMatrices[i];
+            const int count = qMin(SCAN_BLOCK_SIZE, seq.getLength() - m.getLength() + 1 - start);
+            if (count > 0 && m.getLength() > 0) {
+                m.scanBlock(start, count, acc, hits[i]);
+            }
+        }
+        ti.progress = int(100 * qint64(start) / maxWindowsCount);
+    }
+}
+
+QList<WeightMatrixHit> WeightMatrixAlgorithm::scan(const WeightMatrixEncodedSequence& seq, const PWMatrix& m, float minScore, TaskStateInfo& ti) {
+    QVector< QList<WeightMatrixHit> > hits;
+    scan(seq, QList<PWMatrix>() << m, QVector<float>(1, minScore), hits, ti);
+    return hits.first();
+}
+
 } //namespace
@@ -25,6 +25,9 @@
 #include <U2Algorithm/PWMConversionAlgorithm.h>
 
 #include <U2Core/DNATranslation.h>
+#include <U2Core/Task.h>
+
+#include <QtCore/QVector>
 
 namespace U2 {
 
@@ -48,10 +51,50 @@ public:
     MatrixBuldTarget            target;
 };
 
+/** A window of the scanned chunk: 'pos' is the window start in the chunk, 'score' is the matrix score in percents */
+class WeightMatrixHit {
+public:
+    WeightMatrixHit(int pos = 0, float score = 0) : pos(pos), score(score) {}
+
+    int     pos;
+    float   score;
+};
+
+/**
+ * Nucleotide indexes of a sequence chunk, they are computed once and shared by all matrices scanned over the chunk.
+ * A complemented chunk keeps the indexes of the complementary characters in the direct order,
+ * the window 'i' of the complementary strand covers the chunk positions from 'i + 1' to 'i + matrix length'.
+ * The position after the chunk end is encoded as 'A', the same as DiProperty::index() does for unknown characters.
+ */
+class WeightMatrixEncodedSequence {
+    friend class WeightMatrixAlgorithm;
+public:
+    WeightMatrixEncodedSequence(const char* seq, int len, DNATranslation* complMap);
+
+    int getLength() const { return len; }
+    bool isComplemented() const { return complemented; }
+
+private:
+    int             len;
+    bool            complemented;
+    QVector<quint8> monoCodes;  // 'len' + 1 indexes of DiProperty::index(char)
+    QVector<quint8> diCodes;    // 'len' indexes of DiProperty::index(char, char) in the matrix order of the strand
+};
+
 class WeightMatrixAlgorithm : public QObject {
     Q_OBJECT
 public:
     static float getScore(const char* seq, int len, const PWMatrix& m, DNATranslation* complMap);
+
+    /**
+     * Scores every window of the chunk with every matrix and puts the windows with the score
+     * not less than 'minScores[i]' percents to 'hits[i]' in the order of positions.
+     * The scores are equal to the 100 * getScore() values of the same windows.
+     */
+    static void scan(const WeightMatrixEncodedSequence& seq, const QList<PWMatrix>& matrices, const QVector<float>& minScores,
+                     QVector< QList<WeightMatrixHit> >& hits, TaskStateInfo& ti);
+
+    static QList<WeightMatrixHit> scan(const WeightMatrixEncodedSequence& seq, const PWMatrix& m, float minScore, TaskStateInfo& ti);
 };
 
 } //namespace
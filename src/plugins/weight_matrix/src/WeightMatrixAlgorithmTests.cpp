@@ -0,0 +1,159 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QDomElement>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/DNATranslation.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "WeightMatrixAlgorithm.h"
+#include "WeightMatrixAlgorithmTests.h"
+
+namespace U2 {
+
+/* attributes */
+static const QString MATRICES("matrices");              // comma separated matrices: "mono:<length>" or "di:<length>"
+static const QString SEQUENCE_LENGTH("sequence-length");
+static const QString COMPLEMENT("complement");          // scan the complementary strand, optional
+static const QString MIN_SCORE("min-score");            // threshold in percents, optional
+static const QString SEED("seed");                      // random generator seed, optional
+
+QList<XMLTestFactory*> WeightMatrixAlgorithmTests::createTestFactories() {
+    QList<XMLTestFactory*> res;
+    res.append(GTest_WeightMatrixScan::createFactory());
+    return res;
+}
+
+namespace {
+
+PWMatrix createRandomMatrix(PWMatrixType type, int length, quint64 &state) {
+    const int rows = PWM_MONONUCLEOTIDE == type ? 4 : 16;
+    QVarLengthArray<float> data(rows * length);
+    for (int i = 0; i < data.size(); i++) {
+        data[i] = float(int(XMLTestUtils::nextRandom(state) % 2001) - 1000) / 100;
+    }
+    return PWMatrix(data, type);
+}
+
+}
+
+void GTest_WeightMatrixScan::init(XMLTestFormat *, const QDomElement &el) {
+    complement = false;
+    minScore = 0;
+    seed = 1;
+
+    const QString matrices = el.attribute(MATRICES);
+    if (matrices.isEmpty()) {
+        failMissingValue(MATRICES);
+        return;
+    }
+    foreach (const QString &matrix, matrices.split(",")) {
+        const QStringList typeAndLength = matrix.trimmed().split(":");
+        bool ok = false;
+        const int length = typeAndLength.size() == 2 ? typeAndLength[1].toInt(&ok) : 0;
+        if (!ok || length <= 0 || (typeAndLength[0] != "mono" && typeAndLength[0] != "di")) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(MATRICES));
+            return;
+        }
+        matrixTypes << (typeAndLength[0] == "mono" ? PWM_MONONUCLEOTIDE : PWM_DINUCLEOTIDE);
+        matrixLengths << length;
+    }
+
+    bool ok = false;
+    sequenceLength = el.attribute(SEQUENCE_LENGTH).toInt(&ok);
+    if (!ok || sequenceLength <= 0) {
+        stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEQUENCE_LENGTH));
+        return;
+    }
+
+    if (el.hasAttribute(COMPLEMENT)) {
+        complement = el.attribute(COMPLEMENT) == "true";
+    }
+
+    if (el.hasAttribute(MIN_SCORE)) {
+        minScore = el.attribute(MIN_SCORE).toFloat(&ok);
+        if (!ok || minScore < 0 || minScore > 100) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(MIN_SCORE));
+            return;
+        }
+    }
+
+    if (el.hasAttribute(SEED)) {
+        seed = el.attribute(SEED).toULongLong(&ok);
+        if (!ok || 0 == seed) {
+            stateInfo.setError(QString("Invalid value of the attribute: %1").arg(SEED));
+            return;
+        }
+    }
+}
+
+void GTest_WeightMatrixScan::run() {
+    DNATranslation *complTT = NULL;
+    if (complement) {
+        const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+        SAFE_POINT_EXT(NULL != alphabet, stateInfo.setError("The DNA alphabet is not found"), );
+        complTT = AppContext::getDNATranslationRegistry()->lookupComplementTranslation(alphabet);
+        SAFE_POINT_EXT(NULL != complTT, stateInfo.setError("The complement translation is not found"), );
+    }
+
+    static const QByteArray CHARS("ACGTN");
+    quint64 state = seed;
+    // scan() reads the position after the chunk as 'A' of the scanned strand, getScore() reads it from the buffer
+    QByteArray sequence(sequenceLength + 1, complement ? 'T' : 'A');
+    for (int i = 0; i < sequenceLength; i++) {
+        sequence[i] = CHARS[int(XMLTestUtils::nextRandom(state) % CHARS.length())];
+    }
+
+    QList<PWMatrix> matrices;
+    for (int i = 0; i < matrixTypes.size(); i++) {
+        matrices << createRandomMatrix(matrixTypes[i], matrixLengths[i], state);
+    }
+
+    const WeightMatrixEncodedSequence encodedSeq(sequence.constData(), sequenceLength, complTT);
+    QVector< QList<WeightMatrixHit> > hits;
+    WeightMatrixAlgorithm::scan(encodedSeq, matrices, QVector<float>(matrices.size(), minScore), hits, stateInfo);
+    CHECK_OP(stateInfo, );
+    CHECK_EXT(hits.size() == matrices.size(), stateInfo.setError(QString("Expected hits of %1 matrices, got %2").arg(matrices.size()).arg(hits.size())), );
+
+    for (int i = 0; i < matrices.size(); i++) {
+        const PWMatrix &m = matrices[i];
+        QList<WeightMatrixHit> expected;
+        for (int pos = 0; pos + m.getLength() <= sequenceLength; pos++) {
+            const float score = 100 * WeightMatrixAlgorithm::getScore(sequence.constData() + pos, m.getLength(), m, complTT);
+            if (score >= minScore) {
+                expected << WeightMatrixHit(pos, score);
+            }
+        }
+        CHECK_EXT(expected.size() == hits[i].size(),
+                  stateInfo.setError(QString("Matrix %1: expected %2 hits, got %3").arg(i).arg(expected.size()).arg(hits[i].size())), );
+        for (int j = 0; j < expected.size(); j++) {
+            const WeightMatrixHit &hit = hits[i][j];
+            CHECK_EXT(expected[j].pos == hit.pos && expected[j].score == hit.score,
+                      stateInfo.setError(QString("Matrix %1: expected the score %2 at %3, got %4 at %5")
+                               .arg(i).arg(expected[j].score).arg(expected[j].pos).arg(hit.score).arg(hit.pos)), );
+        }
+    }
+}
+
+}   // namespace U2
@@ -0,0 +1,59 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2016 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_WEIGHT_MATRIX_ALGORITHM_TESTS_H_
+#define _U2_WEIGHT_MATRIX_ALGORITHM_TESTS_H_
+
+#include <U2Core/PWMatrix.h>
+
+#include <U2Test/XMLTestUtils.h>
+
+namespace U2 {
+
+/**
+ * Scans a random sequence with random weight matrices by WeightMatrixAlgorithm::scan()
+ * and checks that the found windows and their scores are equal to the WeightMatrixAlgorithm::getScore() values at every offset.
+ */
+class GTest_WeightMatrixScan : public GTest {
+    Q_OBJECT
+public:
+    SIMPLE_XML_TEST_BODY_WITH_FACTORY_EXT(GTest_WeightMatrixScan, "weight-matrix-scan", TaskFlags_FOSCOE);
+
+    void run();
+
+private:
+    QList<PWMatrixType> matrixTypes;
+    QList<int>          matrixLengths;
+    int                 sequenceLength;
+    bool                complement;
+    float               minScore;
+    quint64             seed;
+};
+
+class WeightMatrixAlgorithmTests {
+public:
+    static QList<XMLTestFactory*> createTestFactories();
+};
+
+}   // namespace U2
+
+#endif // _U2_WEIGHT_MATRIX_ALGORITHM_TESTS_H_
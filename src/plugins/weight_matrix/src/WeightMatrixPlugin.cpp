@@ -24,6 +24,7 @@
 #include <U2Algorithm/PWMConversionAlgorithm.h>
 
 #include <U2Core/AppContext.h>
+#include <U2Core/GAutoDeleteList.h>
 
 #include <U2Gui/GUIUtils.h>
 #include <U2Gui/LastUsedDirHelper.h>
@@ -32,6 +33,9 @@
 
 #include <U2Lang/QueryDesignerRegistry.h>
 
+#include <U2Test/GTestFrameworkComponents.h>
+#include <U2Test/XMLTestFormat.h>
+
 #include <U2View/ADVConstants.h>
 #include <U2View/ADVSequenceObjectContext.h>
 #include <U2View/ADVUtils.h>
@@ -41,6 +45,7 @@
 #include "PWMBuildDialogController.h"
 #include "PWMSearchDialogController.h"
 #include "WMQuery.h"
+#include "WeightMatrixAlgorithmTests.h"
 #include "WeightMatrixIO.h"
 #include "WeightMatrixPlugin.h"
 #include "WeightMatrixWorkers.h"
@@ -87,6 +92,19 @@ WeightMatrixPlugin::WeightMatrixPlugin() : Plugin(tr("Weight matrix"), tr("Searc
 
     QDActorPrototypeRegistry* qdpr = AppContext::getQDActorProtoRegistry();
     qdpr->registerProto(new QDWMActorPrototype);
+
+    //tests
+    GTestFormatRegistry* tfr = AppContext::getTestFramework()->getTestFormatRegistry();
+    XMLTestFormat *xmlTestFormat = qobject_cast<XMLTestFormat*>(tfr->findFormat("XML"));
+    assert(xmlTestFormat!=NULL);
+
+    GAutoDeleteList<XMLTestFactory>* l = new GAutoDeleteList<XMLTestFactory>(this);
+    l->qlist = WeightMatrixAlgorithmTests::createTestFactories();
+
+    foreach(XMLTestFactory* f, l->qlist) {
+        bool res = xmlTestFormat->registerTestFactory(f);
+        assert(res); Q_UNUSED(res);
+    }
 }
 
 WeightMatrixPlugin::~WeightMatrixPlugin() {
@@ -34,7 +34,6 @@
 namespace U2 {
 
 class WeightMatrixADVContext;
-class XMLTestFactory;
 
 class WeightMatrixPlugin : public Plugin {
     Q_OBJECT
@@ -60,11 +59,6 @@ protected:
     virtual void initViewContext(GObjectView* view);
 };
 
-class WeightMatrixAlgorithmTests {
-public:
-    static QList<XMLTestFactory*> createTestFactories();
-};
-
 } //namespace
 
 #endif
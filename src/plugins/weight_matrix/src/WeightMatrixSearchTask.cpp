@@ -20,20 +20,123 @@
  */
 
 #include <U2Core/Counter.h>
+#include <U2Core/U2SafePoints.h>
 
 #include "WeightMatrixSearchTask.h"
 
 namespace U2 {
+
+namespace {
+
+const int SEARCH_CHUNK_SIZE = 1024 * 1024;
+
+/** Converts the hits of the walker chunk, the windows starting in the right overlap are left to the next chunk */
+QList<WeightMatrixSearchResult> toResults(const QList<WeightMatrixHit>& hits, const PWMatrix& model, const WeightMatrixSearchCfg& cfg,
+                                          SequenceWalkerSubtask* t, int resultsOffset)
+{
+    QList<WeightMatrixSearchResult> results;
+    const U2Region globalRegion = t->getGlobalRegion();
+    const qint64 chunkStart = globalRegion.startPos + resultsOffset;
+    const qint64 reportedWindowsEnd = t->hasRightOverlap() ? globalRegion.length - t->getGlobalConfig().overlapSize : globalRegion.length;
+    foreach (const WeightMatrixHit& hit, hits) {
+        if (hit.pos >= reportedWindowsEnd) {
+            break;
+        }
+        WeightMatrixSearchResult r;
+        r.score = hit.score;
+        r.region.startPos = chunkStart + hit.pos;
+        if (t->isDNAComplemented()) {
+            r.strand = U2Strand::Complementary;
+            r.region.startPos += 1;
+        } else {
+            r.strand = U2Strand::Direct;
+        }
+        r.region.length = model.getLength();
+        r.qual = model.getProperties();
+        r.modelInfo = cfg.modelName.split("/").last();
+        results << r;
+    }
+    return results;
+}
+
+/**
+ * The overlap is not less than the longest model: a window of the complementary strand or of a dinucleotide model
+ * reads one character after the window, so all windows of the chunk before its overlap are read inside the chunk
+ */
+SequenceWalkerConfig createWalkerConfig(const QByteArray& seq, DNATranslation* complTT, int maxModelLength) {
+    SequenceWalkerConfig c;
+    c.walkCircular = false;
+    c.seq = seq.constData();
+    c.seqSize = seq.length();
+    c.complTrans  = complTT;
+    c.strandToWalk = complTT == NULL ? StrandOption_DirectOnly : StrandOption_Both;
+    c.aminoTrans = NULL;
+
+    c.overlapSize = maxModelLength;
+    c.chunkSize = qMax(SEARCH_CHUNK_SIZE, 2 * c.overlapSize);
+    c.lastChunkExtraLen = c.chunkSize / 2;
+    c.nThreads = MAX_PARALLEL_SUBTASKS_AUTO;
+    return c;
+}
+
+}   // namespace
+
 //Weight matrix multiple search
-WeightMatrixSearchTask::WeightMatrixSearchTask(const QList<QPair<PWMatrix,WeightMatrixSearchCfg> > &m, const QByteArray& seq, int ro)
-: Task(tr("Weight matrix multiple search"), TaskFlags_NR_FOSCOE), models(m), resultsOffset(ro)
+WeightMatrixSearchTask::WeightMatrixSearchTask(const QList<QPair<PWMatrix,WeightMatrixSearchCfg> > &m, const QByteArray& _seq, int ro)
+: Task(tr("Weight matrix multiple search"), TaskFlags_NR_FOSCOE), models(m), resultsOffset(ro), seq(_seq)
 {
+    CHECK(!models.isEmpty(), );
+    DNATranslation* complTT = NULL;
+    int maxModelLength = 0;
     for (int i = 0, n = m.size(); i < n; i++) {
-        addSubTask(new WeightMatrixSingleSearchTask(m[i].first, seq, m[i].second, ro));
+        complTT = (NULL == complTT) ? m[i].second.complTT : complTT;
+        maxModelLength = qMax(maxModelLength, m[i].first.getLength());
+    }
+    // the walker translation only enables the complementary strand, the models are scanned with their own translations
+    addSubTask(new SequenceWalkerTask(createWalkerConfig(seq, complTT, maxModelLength), this, tr("Weight matrix search parallel")));
+}
+
+void WeightMatrixSearchTask::onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti) {
+    const bool complemented = t->isDNAComplemented();
+    // the chunk is encoded once for all models of the strand that share the translation
+    QList<DNATranslation*> translations;
+    QList< QList<int> > modelsByTranslation;
+    for (int i = 0, n = models.size(); i < n; i++) {
+        const WeightMatrixSearchCfg& cfg = models[i].second;
+        if (complemented ? NULL == cfg.complTT : cfg.complOnly) {
+            continue;
+        }
+        DNATranslation* complTT = complemented ? cfg.complTT : NULL;
+        int index = translations.indexOf(complTT);
+        if (-1 == index) {
+            index = translations.size();
+            translations << complTT;
+            modelsByTranslation << QList<int>();
+        }
+        modelsByTranslation[index] << i;
+    }
+
+    const U2Region globalRegion = t->getGlobalRegion();
+    for (int i = 0; i < translations.size(); i++) {
+        QList<PWMatrix> strandModels;
+        QVector<float> minScores;
+        foreach (int modelIndex, modelsByTranslation[i]) {
+            strandModels << models[modelIndex].first;
+            minScores << models[modelIndex].second.minPSUM;
+        }
+
+        const WeightMatrixEncodedSequence encodedSeq(t->getGlobalConfig().seq + globalRegion.startPos, globalRegion.length, translations[i]);
+        QVector< QList<WeightMatrixHit> > hits;
+        WeightMatrixAlgorithm::scan(encodedSeq, strandModels, minScores, hits, ti);
+        CHECK(!ti.isCoR(), );
+
+        for (int j = 0; j < strandModels.size(); j++) {
+            addResults(toResults(hits[j], strandModels[j], models[modelsByTranslation[i][j]].second, t, resultsOffset));
+        }
     }
 }
 
-void WeightMatrixSearchTask::addResult(const WeightMatrixSearchResult& r) {
+void WeightMatrixSearchTask::addResults(const QList<WeightMatrixSearchResult>& r) {
     lock.lock();
     results.append(r);
     lock.unlock();
@@ -41,12 +144,8 @@ void WeightMatrixSearchTask::addResult(const WeightMatrixSearchResult& r) {
 
 QList<WeightMatrixSearchResult> WeightMatrixSearchTask::takeResults() {
     lock.lock();
-    QList<WeightMatrixSearchResult> res;
-    QList<Task*> sub = getSubtasks();
-    foreach (Task* task, sub) {
-        WeightMatrixSingleSearchTask* curr = static_cast<WeightMatrixSingleSearchTask*>(task);
-        res.append(curr->takeResults());
-    }
+    QList<WeightMatrixSearchResult> res = results;
+    results.clear();
     lock.unlock();
     return res;
 }
@@ -56,18 +155,7 @@ WeightMatrixSingleSearchTask::WeightMatrixSingleSearchTask(const PWMatrix& m, co
 : Task(tr("Weight matrix search"), TaskFlags_NR_FOSCOE), model(m), cfg(cfg), resultsOffset(ro), seq(_seq)
 {
     GCOUNTER( cvar, tvar, "WeightMatrixSingleSearchTask" );
-    SequenceWalkerConfig c;
-    c.walkCircular = false;
-    c.seq = seq.constData();
-    c.seqSize = seq.length();
-    c.complTrans  = cfg.complTT;
-    c.strandToWalk = cfg.complTT == NULL ? StrandOption_DirectOnly : StrandOption_Both;
-    c.aminoTrans = NULL;
-
-    c.chunkSize = seq.length();
-    c.overlapSize = 0;
-
-    SequenceWalkerTask* t = new SequenceWalkerTask(c, this, tr("Weight matrix search parallel"));
+    SequenceWalkerTask* t = new SequenceWalkerTask(createWalkerConfig(seq, cfg.complTT, model.getLength()), this, tr("Weight matrix search parallel"));
     addSubTask(t);
 }
 
@@ -77,43 +165,14 @@ void WeightMatrixSingleSearchTask::onRegion(SequenceWalkerSubtask* t, TaskStateI
         return;
     }
     U2Region globalRegion = t->getGlobalRegion();
-    int seqLen = globalRegion.length;
-    const char* seq = t->getGlobalConfig().seq + globalRegion.startPos;
-    int modelSize = model.getLength();
-    ti.progress =0;
-    int lenPerPercent = seqLen / 100;
-    int pLeft = lenPerPercent;
     DNATranslation* complTT = t->isDNAComplemented() ? t->getGlobalConfig().complTrans : NULL;
-    for (int i = 0, n = seqLen - modelSize; i <= n && !ti.cancelFlag; i++, --pLeft) {
-        float psum = WeightMatrixAlgorithm::getScore(seq + i, modelSize, model, complTT);
-        if (psum < -1e-6 || psum > 1 + 1e-6) {
-            ti.setError(  tr("Internal error invalid psum: %1").arg(psum) );
-            return;
-        }
-        WeightMatrixSearchResult r;
-        r.score = 100*psum;
-        if (r.score >= cfg.minPSUM) {//report result
-            r.region.startPos = globalRegion.startPos +  i + resultsOffset;
-            if(t->isDNAComplemented()){
-                r.strand = U2Strand::Complementary;
-                r.region.startPos += 1;
-            }else{
-                r.strand = U2Strand::Direct;
-            }
-            r.region.length = modelSize;
-            r.qual = model.getProperties();
-            r.modelInfo = cfg.modelName.split("/").last();
-            addResult(r);
-        }
-        if (pLeft == 0) {
-            ti.progress++;
-            pLeft = lenPerPercent;
-        }
-    }
+    WeightMatrixEncodedSequence encodedSeq(t->getGlobalConfig().seq + globalRegion.startPos, globalRegion.length, complTT);
+    QList<WeightMatrixHit> hits = WeightMatrixAlgorithm::scan(encodedSeq, model, cfg.minPSUM, ti);
+    CHECK(!ti.isCoR(), );
+    addResults(toResults(hits, model, cfg, t, resultsOffset));
 }
 
-
-void WeightMatrixSingleSearchTask::addResult(const WeightMatrixSearchResult& r) {
+void WeightMatrixSingleSearchTask::addResults(const QList<WeightMatrixSearchResult>& r) {
     lock.lock();
     results.append(r);
     lock.unlock();
@@ -90,20 +90,23 @@ public:
     }
 };
 
-class WeightMatrixSearchTask : public Task {
+/** Scans all models over the sequence in one pass, each model is scanned with its own complement translation */
+class WeightMatrixSearchTask : public Task, public SequenceWalkerCallback {
     Q_OBJECT
 public:
     WeightMatrixSearchTask(const QList< QPair< PWMatrix, WeightMatrixSearchCfg > >& models, const QByteArray& seq, int resultsOffset);
 
+    virtual void onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti);
     QList<WeightMatrixSearchResult> takeResults();
 
 private:
-    void addResult(const WeightMatrixSearchResult& r);
+    void addResults(const QList<WeightMatrixSearchResult>& r);
 
     QMutex                                              lock;
     QList< QPair<PWMatrix, WeightMatrixSearchCfg> >     models;
     QList<WeightMatrixSearchResult>                     results;
     int                                                 resultsOffset;
+    QByteArray                                          seq;
 };
 
 class WeightMatrixSingleSearchTask : public Task, public SequenceWalkerCallback {
@@ -115,7 +118,7 @@ public:
     QList<WeightMatrixSearchResult> takeResults();
 
 private:
-    void addResult(const WeightMatrixSearchResult& r);
+    void addResults(const QList<WeightMatrixSearchResult>& r);
 
     QMutex                              lock;
     PWMatrix                            model;
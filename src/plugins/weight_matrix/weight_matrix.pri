@@ -7,3 +7,8 @@ PLUGIN_VENDOR=Unipro
 include( ../../ugene_plugin_common.pri )
 
 unix: QMAKE_CXXFLAGS += -Wno-char-subscripts
+
+use_sse2() {
+    #the AVX2 scan is compiled per function and is enabled at runtime by CPUID
+    DEFINES += WM_BUILD_WITH_AVX2
+}
@@ -9,6 +9,7 @@ HEADERS += src/WeightMatrixPlugin.h \
            src/SetParametersDialogController.h \
 		   src/PMatrixFormat.h \
            src/WeightMatrixAlgorithm.h \
+           src/WeightMatrixAlgorithmTests.h \
            src/WeightMatrixSearchTask.h \
            src/WeightMatrixIO.h \
            src/WeightMatrixIOWorkers.h \
@@ -30,6 +31,7 @@ SOURCES += src/WeightMatrixPlugin.cpp \
            src/SetParametersDialogController.cpp \
 		   src/PMatrixFormat.cpp \
            src/WeightMatrixAlgorithm.cpp \
+           src/WeightMatrixAlgorithmTests.cpp \
            src/WeightMatrixSearchTask.cpp \
            src/WeightMatrixIO.cpp \
            src/WeightMatrixIOWorkers.cpp \
@@ -44,6 +44,9 @@ AppSettingsGUIPageState* WorkflowSettingsPageController::getSavedState() {
     state->snap2grid = WorkflowSettings::snap2Grid();
     state->lockRun = WorkflowSettings::monitorRun();
     state->enableDebugger = WorkflowSettings::isDebuggerEnabled();
+    state->runInParallel = WorkflowSettings::isParallelRunEnabled();
+    state->inMemoryStorage = WorkflowSettings::isInMemoryDataStorageEnabled();
+    state->inMemoryStorageLimit = WorkflowSettings::getInMemoryDataStorageLimit();
     state->style = WorkflowSettings::defaultStyle();
     state->font = WorkflowSettings::defaultFont();
     state->path = WorkflowSettings::getUserDirectory();
@@ -60,6 +63,9 @@ void WorkflowSettingsPageController::saveState(AppSettingsGUIPageState* s) {
     WorkflowSettings::setSnap2Grid(state->snap2grid);
     WorkflowSettings::setMonitorRun(state->lockRun);
     WorkflowSettings::setDebuggerEnabled(state->enableDebugger);
+    WorkflowSettings::setParallelRunEnabled(state->runInParallel);
+    WorkflowSettings::setInMemoryDataStorageEnabled(state->inMemoryStorage);
+    WorkflowSettings::setInMemoryDataStorageLimit(state->inMemoryStorageLimit);
     WorkflowSettings::setDefaultStyle(state->style);
     WorkflowSettings::setDefaultFont(state->font);
     WorkflowSettings::setUserDirectory(state->path);
@@ -85,6 +91,7 @@ WorkflowSettingsPageWidget::WorkflowSettingsPageWidget(WorkflowSettingsPageContr
     connect(extToolDirButton, SIGNAL(clicked()), SLOT(sl_getExternalToolCfgDir()));
     connect(includedDirButton, SIGNAL(clicked()), SLOT(sl_getIncludedElementsDir()));
     connect(workflowOutputButton, SIGNAL(clicked()), SLOT(sl_getWorkflowOutputDir()));
+    connect(memoryStorageBox, SIGNAL(toggled(bool)), memoryStorageLimitSpin, SLOT(setEnabled(bool)));
     colorWidget->setMinimumHeight(label->height());
     colorWidget->installEventFilter(this);
 }
@@ -128,6 +135,10 @@ void WorkflowSettingsPageWidget::setState(AppSettingsGUIPageState* s) {
     snapBox->setChecked(state->snap2grid);
     lockBox->setChecked(state->lockRun);
     debuggerBox->setChecked(state->enableDebugger);
+    parallelBox->setChecked(state->runInParallel);
+    memoryStorageBox->setChecked(state->inMemoryStorage);
+    memoryStorageLimitSpin->setValue(state->inMemoryStorageLimit);
+    memoryStorageLimitSpin->setEnabled(state->inMemoryStorage);
     int idx = styleCombo->findData(state->style);
     if (idx < 0) idx = 1;
     styleCombo->setCurrentIndex(idx);
@@ -148,6 +159,9 @@ AppSettingsGUIPageState* WorkflowSettingsPageWidget::getState(QString& ) const {
     state->snap2grid = snapBox->isChecked();
     state->lockRun = lockBox->isChecked();
     state->enableDebugger = debuggerBox->isChecked();
+    state->runInParallel = parallelBox->isChecked();
+    state->inMemoryStorage = memoryStorageBox->isChecked();
+    state->inMemoryStorageLimit = memoryStorageLimitSpin->value();
     state->style = styleCombo->itemData(styleCombo->currentIndex()).toString();
     state->font = fontCombo->currentFont();
     state->path = dirEdit->text();
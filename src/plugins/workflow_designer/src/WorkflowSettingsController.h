@@ -55,6 +55,9 @@ public:
     bool snap2grid;
     bool lockRun;
     bool enableDebugger;
+    bool runInParallel;
+    bool inMemoryStorage;
+    int inMemoryStorageLimit;
     QString style;
     QFont font;
     QString path;
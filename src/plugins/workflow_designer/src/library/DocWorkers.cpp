@@ -376,11 +376,10 @@ void FastQWriter::storeEntry(IOAdapter *io, const QVariantMap &data, int entryNu
 void FastQWriter::data2document(Document* doc, const QVariantMap& data, WorkflowContext *context) {
     CHECK(data.contains(BaseSlots::DNA_SEQUENCE_SLOT().getId()), );
     SharedDbiDataHandler seqId = data[BaseSlots::DNA_SEQUENCE_SLOT().getId()].value<SharedDbiDataHandler>();
-    QScopedPointer<U2SequenceObject> seqObj(StorageUtils::getSequenceObject(context->getDataStorage(), seqId));
-    SAFE_POINT(NULL != seqObj.data(), tr("Fastq writer: NULL sequence object"), );
+    SAFE_POINT(NULL != seqId.constData(), tr("Fastq writer: NULL sequence object"), );
 
     U2OpStatusImpl os;
-    DNASequence seq = seqObj->getWholeSequence(os);
+    DNASequence seq = StorageUtils::getSequence(context->getDataStorage(), seqId, os);
     SAFE_POINT_OP(os, );
 
     if (seq.getName().isEmpty()) {
@@ -431,11 +430,10 @@ void RawSeqWriter::storeEntry(IOAdapter *io, const QVariantMap &data, int entryN
 void RawSeqWriter::data2document(Document* doc, const QVariantMap& data, WorkflowContext *context) {
     CHECK(data.contains(BaseSlots::DNA_SEQUENCE_SLOT().getId()), );
     SharedDbiDataHandler seqId = data[BaseSlots::DNA_SEQUENCE_SLOT().getId()].value<SharedDbiDataHandler>();
-    QScopedPointer<U2SequenceObject> seqObj(StorageUtils::getSequenceObject(context->getDataStorage(), seqId));
-    SAFE_POINT(NULL != seqObj.data(), tr("Raw sequence writer: NULL sequence object"), );
+    SAFE_POINT(NULL != seqId.constData(), tr("Raw sequence writer: NULL sequence object"), );
 
     U2OpStatusImpl os;
-    DNASequence seq = seqObj->getWholeSequence(os);
+    DNASequence seq = StorageUtils::getSequence(context->getDataStorage(), seqId, os);
     SAFE_POINT_OP(os, );
 
     if (seq.getName().isEmpty()) {
@@ -363,18 +363,17 @@ Task* FindWorker::tick() {
         // sequence
         QVariantMap qm = inputMessage.getData().toMap();
         SharedDbiDataHandler seqId = qm.value(BaseSlots::DNA_SEQUENCE_SLOT().getId()).value<SharedDbiDataHandler>();
-        QScopedPointer<U2SequenceObject> seqObj(StorageUtils::getSequenceObject(context->getDataStorage(), seqId));
-        if (NULL == seqObj.data()) {
+        if (NULL == seqId.constData()) {
             return NULL;
         }
         U2OpStatusImpl os;
-        DNASequence seq = seqObj->getWholeSequence(os);
+        DNASequence seq = StorageUtils::getSequence(context->getDataStorage(), seqId, os);
         CHECK_OP(os, new FailTask(os.getError()));
         if(seq.isNull()) {
             return new FailTask(tr("Null sequence supplied to FindWorker: %1").arg(seq.getName()));
         }
         cfg.sequence = QByteArray(seq.constData(), seq.length());
-        cfg.searchIsCircular = seqObj->isCircular();
+        cfg.searchIsCircular = seq.circular;
         cfg.searchRegion.length = seq.length();
 
         // other parameters
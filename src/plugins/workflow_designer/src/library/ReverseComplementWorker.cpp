@@ -97,12 +97,11 @@ Task* RCWorker::tick() {
         }
         QVariantMap qm = inputMessage.getData().toMap();
         SharedDbiDataHandler seqId = qm.value(BaseSlots::DNA_SEQUENCE_SLOT().getId()).value<SharedDbiDataHandler>();
-        QScopedPointer<U2SequenceObject> seqObj(StorageUtils::getSequenceObject(context->getDataStorage(), seqId));
-        if (seqObj.isNull()) {
+        if (NULL == seqId.constData()) {
             return new FailTask(tr("Null sequence object supplied to FindWorker"));
         }
         U2OpStatusImpl os;
-        DNASequence seq = seqObj->getWholeSequence(os);
+        DNASequence seq = StorageUtils::getSequence(context->getDataStorage(), seqId, os);
         CHECK_OP(os, new FailTask(os.getError()));
         if(seq.isNull()) {
             return new FailTask(tr("Null sequence supplied to FindWorker: %1").arg(seq.getName()));
@@ -55,12 +55,11 @@ Task* SequencesToMSAWorker::tick() {
         Message inputMessage = getMessageAndSetupScriptValues(inPort);
         QVariantMap qm = inputMessage.getData().toMap();
         SharedDbiDataHandler seqId = qm.value(BaseSlots::DNA_SEQUENCE_SLOT().getId()).value<SharedDbiDataHandler>();
-        QScopedPointer<U2SequenceObject> seqObj(StorageUtils::getSequenceObject(context->getDataStorage(), seqId));
-        if (seqObj.isNull()) {
+        if (NULL == seqId.constData()) {
             return NULL;
         }
         U2OpStatusImpl os;
-        DNASequence seq = seqObj->getWholeSequence(os);
+        DNASequence seq = StorageUtils::getSequence(context->getDataStorage(), seqId, os);
         CHECK_OP(os, new FailTask(os.getError()));
         data.append(seq);
     }